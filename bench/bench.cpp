@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "../src/types.hpp"
+#include "../src/lexer.hpp"
+#include "../src/program.hpp"
+#include "../src/simulator.hpp"
+
+using namespace riscv;
+
+// Every heap allocation in the process goes through these, so a run's allocation count is the
+// difference of the counter around it.
+static std::atomic<uint64_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+inline constexpr uint32_t DEFAULT_BENCH_CYCLES = 20000000;
+inline constexpr const char* DEFAULT_BENCH_DIRECTORY = "bench/programs";
+// Short programs and runs are repeated until a sample takes this long, so their rates are not
+// dominated by timer resolution.
+inline constexpr double MIN_SAMPLE_SECONDS = 0.05;
+
+// The engine configurations reachable through setEnvironment.
+struct BenchConfig {
+    const char* name;
+    bool pipeline;
+    bool dataForwarding;
+    bool branchPrediction;
+    bool functional;
+};
+
+inline constexpr BenchConfig BENCH_CONFIGS[] = {
+    {"functional", false, false, false, true},
+    {"single", false, false, false, false},
+    {"pipeline", true, false, false, false},
+    {"pipeline+forwarding", true, true, false, false},
+    {"pipeline+prediction", true, false, true, false},
+    {"pipeline+forwarding+prediction", true, true, true, false},
+};
+
+struct BenchResult {
+    std::string program;
+    std::string config;
+    size_t lines;
+    double lexLinesPerSecond;
+    double assembleLinesPerSecond;
+    uint64_t instructions;
+    uint64_t cycles;
+    double seconds;
+    double instructionsPerSecond;
+    double cyclesPerSecond;
+    uint64_t peakRssKiB;
+    double allocationsPerCycle;
+    bool completed;
+    // Whether the run ended with the functional run's registers and instruction count; runs that
+    // hit the cycle limit are not compared and never match.
+    bool matchesFunctional;
+    std::array<uint32_t, NUM_REGISTERS> registers;
+
+    BenchResult() : lines(0), lexLinesPerSecond(0.0), assembleLinesPerSecond(0.0), instructions(0), cycles(0), seconds(0.0),
+                    instructionsPerSecond(0.0), cyclesPerSecond(0.0), peakRssKiB(0), allocationsPerCycle(0.0), completed(false),
+                    matchesFunctional(false), registers{} {}
+};
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Writing 5 to clear_refs resets the peak to the current RSS (Linux 4.0+), so VmHWM after a run
+// is that run's peak. Elsewhere the process-wide maximum is reported instead.
+bool resetPeakRss() {
+    std::ofstream file("/proc/self/clear_refs");
+    if (!file.is_open()) return false;
+    file << "5";
+    file.flush();
+    return file.good();
+}
+
+uint64_t peakRssKiB() {
+    std::ifstream file("/proc/self/status");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::strtoull(line.c_str() + 6, nullptr, 10);
+    }
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<uint64_t>(usage.ru_maxrss);
+}
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Seconds per call of fn: the best of `repeat` samples, each the mean over as many calls as
+// fill MIN_SAMPLE_SECONDS.
+template <typename Fn>
+double bestOf(uint32_t repeat, Fn&& fn) {
+    double best = 0.0;
+    for (uint32_t i = 0; i < repeat; i++) {
+        uint64_t calls = 0;
+        auto start = std::chrono::steady_clock::now();
+        double seconds = 0.0;
+        do {
+            fn();
+            calls++;
+            seconds = elapsedSeconds(start);
+        } while (seconds < MIN_SAMPLE_SECONDS);
+        seconds /= calls;
+        if (i == 0 || seconds < best) best = seconds;
+    }
+    return best;
+}
+
+// Only runCycles is timed; constructing and loading the simulator is not. Allocations are those
+// made while the program runs, so the node pool filling up counts but loading does not.
+BenchResult runBenchConfig(const std::shared_ptr<const ProgramImage>& program, const BenchConfig& config, uint32_t maxCycles, uint32_t repeat) {
+    BenchResult result;
+    result.config = config.name;
+    for (uint32_t i = 0; i < repeat; i++) {
+        bool rssReset = resetPeakRss();
+        uint64_t runs = 0;
+        double seconds = 0.0;
+        do {
+            Simulator sim;
+            sim.loadProgram(program);
+            sim.setEnvironment(config.pipeline, config.dataForwarding, config.branchPrediction, UINT32_MAX, config.functional);
+            uint64_t allocations = allocationCount.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            RunSummary summary = sim.runCycles(maxCycles);
+            seconds += elapsedSeconds(start);
+            allocations = allocationCount.load(std::memory_order_relaxed) - allocations;
+            if (runs++ == 0) {
+                result.instructions = sim.getStats().instructionsExecuted;
+                result.cycles = sim.getCycles();
+                result.completed = summary.reason == StopReason::TERMINATED;
+                std::copy(sim.getRegisters(), sim.getRegisters() + NUM_REGISTERS, result.registers.begin());
+                result.allocationsPerCycle = result.cycles > 0 ? static_cast<double>(allocations) / result.cycles : 0.0;
+            }
+        } while (seconds < MIN_SAMPLE_SECONDS);
+        seconds /= runs;
+        if (i == 0 || seconds < result.seconds) result.seconds = seconds;
+        if (i == 0 || rssReset) result.peakRssKiB = peakRssKiB();
+    }
+    if (result.seconds > 0.0) {
+        result.instructionsPerSecond = result.instructions / result.seconds;
+        result.cyclesPerSecond = result.cycles / result.seconds;
+    }
+    return result;
+}
+
+std::vector<BenchResult> benchProgram(const std::string& path, uint32_t maxCycles, uint32_t repeat) {
+    std::string source = readFile(path);
+    size_t lines = std::count(source.begin(), source.end(), '\n') + (!source.empty() && source.back() != '\n');
+    std::shared_ptr<const ProgramImage> program;
+    double lexSeconds = bestOf(repeat, [&]() { Lexer::scan(source); });
+    double assembleSeconds = bestOf(repeat, [&]() { program = assembleProgram(source); });
+
+    std::vector<BenchResult> results;
+    for (const BenchConfig& config : BENCH_CONFIGS) {
+        BenchResult result = runBenchConfig(program, config, maxCycles, repeat);
+        result.program = std::filesystem::path(path).stem().string();
+        result.lines = lines;
+        result.lexLinesPerSecond = lexSeconds > 0.0 ? lines / lexSeconds : 0.0;
+        result.assembleLinesPerSecond = assembleSeconds > 0.0 ? lines / assembleSeconds : 0.0;
+        results.push_back(result);
+    }
+    // BENCH_CONFIGS starts with the functional engine, which every other configuration must agree with.
+    const BenchResult& reference = results.front();
+    for (BenchResult& result : results) {
+        result.matchesFunctional = reference.completed && result.completed && result.instructions == reference.instructions &&
+                                   result.registers == reference.registers;
+    }
+    return results;
+}
+
+void writeBenchCsv(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "program,config,lines,lex_lines_per_s,assemble_lines_per_s,instructions,cycles,seconds,"
+        << "instructions_per_s,cycles_per_s,peak_rss_kib,allocations_per_cycle,completed,matches_functional\n";
+    for (const BenchResult& r : results) {
+        out << r.program << "," << r.config << "," << r.lines << "," << std::llround(r.lexLinesPerSecond) << "," << std::llround(r.assembleLinesPerSecond) << ","
+            << r.instructions << "," << r.cycles << "," << r.seconds << "," << std::llround(r.instructionsPerSecond) << "," << std::llround(r.cyclesPerSecond) << ","
+            << r.peakRssKiB << "," << r.allocationsPerCycle << "," << r.completed << "," << r.matchesFunctional << "\n";
+    }
+}
+
+void writeBenchJson(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "  {\"program\": \"" << r.program << "\", \"config\": \"" << r.config << "\", \"lines\": " << r.lines
+            << ", \"lexLinesPerSecond\": " << std::llround(r.lexLinesPerSecond) << ", \"assembleLinesPerSecond\": " << std::llround(r.assembleLinesPerSecond)
+            << ", \"instructions\": " << r.instructions << ", \"cycles\": " << r.cycles << ", \"seconds\": " << r.seconds
+            << ", \"instructionsPerSecond\": " << std::llround(r.instructionsPerSecond) << ", \"cyclesPerSecond\": " << std::llround(r.cyclesPerSecond)
+            << ", \"peakRssKiB\": " << r.peakRssKiB << ", \"allocationsPerCycle\": " << r.allocationsPerCycle
+            << ", \"completed\": " << std::boolalpha << r.completed << ", \"matchesFunctional\": " << r.matchesFunctional << std::noboolalpha
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+void writeBenchReport(std::ostream& out, const std::vector<BenchResult>& results) {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::dec << std::left << std::setw(16) << "Program" << std::setw(32) << "Config" << std::right
+        << std::setw(12) << "Instr/s" << std::setw(12) << "Cycles/s" << std::setw(12) << "Peak KiB" << std::setw(14) << "Allocs/cycle" << "\n";
+    std::string program;
+    for (const BenchResult& r : results) {
+        if (r.program != program) {
+            program = r.program;
+            out << std::fixed << std::setprecision(0) << r.program << ": " << r.lines << " lines, lexer " << r.lexLinesPerSecond
+                << " lines/s, assembler " << r.assembleLinesPerSecond << " lines/s\n";
+        }
+        out << std::left << std::setw(16) << "" << std::setw(32) << (std::string(r.config) + (!r.completed ? " (limit)" : r.matchesFunctional ? "" : " (mismatch)")) << std::right
+            << std::fixed << std::setprecision(0) << std::setw(12) << r.instructionsPerSecond << std::setw(12) << r.cyclesPerSecond
+            << std::setw(12) << r.peakRssKiB << std::setprecision(4) << std::setw(14) << r.allocationsPerCycle << "\n";
+    }
+    out.flags(flags);
+}
+
+void printUsage() {
+    std::cout << GREEN << "RISC-V Simulator Benchmark Usage:" << RESET << std::endl;
+    std::cout << YELLOW << "  riscv_bench [options] [PROGRAM.asm ...]   (default: every .asm in " << DEFAULT_BENCH_DIRECTORY << ")" << RESET << std::endl;
+    std::cout << YELLOW << "  --cycles N                 Cycle limit per run (default: " << DEFAULT_BENCH_CYCLES << ")" << RESET << std::endl;
+    std::cout << YELLOW << "  --repeat N                 Runs per measurement, the fastest is kept (default: 3)" << RESET << std::endl;
+    std::cout << YELLOW << "  --format csv|json          Result format (default: json)" << RESET << std::endl;
+    std::cout << YELLOW << "  -o, --output FILE          Result file (default: bench.json or bench.csv)" << RESET << std::endl;
+    std::cout << YELLOW << "  -h, --help                 Display this help message" << RESET << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t maxCycles = DEFAULT_BENCH_CYCLES;
+    uint32_t repeat = 3;
+    bool json = true;
+    std::string outputFile;
+    std::vector<std::string> programs;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cycles") == 0 || strcmp(argv[i], "--repeat") == 0) {
+            uint32_t& value = strcmp(argv[i], "--cycles") == 0 ? maxCycles : repeat;
+            if (i + 1 >= argc || parseUnsigned(argv[i + 1], value) != NumberError::NONE || value == 0) {
+                std::cerr << "Error: Missing or invalid number after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--format") == 0) {
+            if (i + 1 >= argc || (strcmp(argv[i + 1], "csv") != 0 && strcmp(argv[i + 1], "json") != 0)) {
+                std::cerr << "Error: Expected result format (csv, json)" << std::endl;
+                printUsage();
+                return 1;
+            }
+            json = strcmp(argv[++i], "json") == 0;
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: Missing output file name" << std::endl;
+                printUsage();
+                return 1;
+            }
+            outputFile = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            printUsage();
+            return 0;
+        } else if (argv[i][0] == '-') {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            printUsage();
+            return 1;
+        } else {
+            programs.push_back(argv[i]);
+        }
+    }
+
+    if (programs.empty()) {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(DEFAULT_BENCH_DIRECTORY, error)) {
+            if (entry.path().extension() == ".asm") programs.push_back(entry.path().string());
+        }
+        std::sort(programs.begin(), programs.end());
+        if (programs.empty()) {
+            std::cerr << "Error: No programs given and none found in " << DEFAULT_BENCH_DIRECTORY << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (const std::string& program : programs) {
+        std::cout << "Benchmarking " << program << "..." << std::endl;
+        try {
+            std::vector<BenchResult> programResults = benchProgram(program, maxCycles, repeat);
+            results.insert(results.end(), programResults.begin(), programResults.end());
+        } catch (const std::exception& e) {
+            std::cerr << "Error benchmarking " << program << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    writeBenchReport(std::cout, results);
+
+    if (outputFile.empty()) {
+        outputFile = json ? "bench.json" : "bench.csv";
+    }
+    std::ofstream out(outputFile);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << outputFile << " for writing" << std::endl;
+        return 1;
+    }
+    if (json) {
+        writeBenchJson(out, results);
+    } else {
+        writeBenchCsv(out, results);
+    }
+    std::cout << "Benchmark results written to " << outputFile << std::endl;
+
+    bool mismatch = false;
+    for (const BenchResult& r : results) {
+        if (r.completed && !r.matchesFunctional) {
+            std::cerr << RED << "Error: " << r.program << " under " << r.config
+                      << " ends with different registers or instruction count than the functional run" << RESET << std::endl;
+            mismatch = true;
+        }
+    }
+    return mismatch ? 1 : 0;
+}
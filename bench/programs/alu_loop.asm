@@ -0,0 +1,16 @@
+# Tight ALU loop: a chain of dependent register operations with one branch per iteration.
+.text
+    addi x5, x0, 0
+    lui x6, 49                  # 200704 iterations
+    addi x7, x0, 3
+    addi x8, x0, 1
+    addi x9, x0, 0
+loop:
+    add x9, x9, x7
+    xor x10, x9, x5
+    mul x11, x10, x7
+    sub x9, x11, x8
+    sll x12, x9, x8
+    sra x9, x12, x8
+    addi x5, x5, 1
+    blt x5, x6, loop
@@ -0,0 +1,41 @@
+# Branchy sorting: bubble sort of 256 pseudo-random words, data-dependent branches throughout.
+.data
+values: .word 7862 4541 4685 3217 1211 1071 4168 8840 5456 4143 6100 6601 3003 4060 3929 8047
+values_1: .word 1168 9388 1289 6966 6846 863 7200 5729 198 7839 4144 2253 5535 9994 3726 8589
+values_2: .word 2309 1617 6421 4948 615 8691 1391 2788 7529 2484 4342 8852 834 2832 246 7406
+values_3: .word 2477 5674 9405 9415 6812 1064 5044 7171 7661 5778 207 5913 2571 4348 2911 7913
+values_4: .word 5855 8461 1007 8476 4083 2784 3407 8014 9104 1498 5481 5543 937 6440 5631 1872
+values_5: .word 4947 4167 9107 1350 4912 7480 7593 4665 8408 1922 9598 368 4668 3548 7825 9081
+values_6: .word 8890 1981 63 9708 942 6109 3107 4852 1590 526 9210 6928 6727 7546 56 2960
+values_7: .word 5762 238 3116 3716 6241 3142 5396 6286 1028 5650 695 3005 1024 1283 4824 3813
+values_8: .word 2248 7575 9909 7823 1679 3808 9746 6037 4593 497 8043 2642 5116 8764 7658 3503
+values_9: .word 7162 4980 3333 8345 2461 5440 9315 951 3715 2047 7689 9962 9962 1298 3999 7106
+values_10: .word 5208 5016 715 2067 1695 6563 1422 6134 3344 2718 8942 332 3070 7274 827 9506
+values_11: .word 9790 8537 7272 9861 830 3635 4592 8853 3320 1544 9149 9803 8949 7268 5990 5401
+values_12: .word 8232 3415 6420 3125 2650 138 5728 3942 8538 3283 5273 6225 7708 5538 1084 4010
+values_13: .word 9747 1204 9537 785 2131 768 9909 8025 8921 1535 7336 1697 2199 5032 9397 7963
+values_14: .word 5433 8673 8853 6264 5505 1038 8190 5662 5925 7900 4931 7989 3081 3625 8655 9111
+values_15: .word 3932 3652 5720 1770 5051 4837 2702 6606 8005 4365 6883 4290 465 2944 1794 8624
+.text
+    lui x20, 0x10000            # values
+    addi x21, x0, 255           # last index
+outer:
+    addi x5, x0, 0
+    add x7, x20, x0
+    addi x13, x0, 0             # swapped
+inner:
+    lw x8, 0(x7)
+    lw x9, 4(x7)
+    bge x9, x8, ordered
+    sw x9, 0(x7)
+    sw x8, 4(x7)
+    addi x13, x0, 1
+ordered:
+    addi x7, x7, 4
+    addi x5, x5, 1
+    blt x5, x21, inner
+    addi x21, x21, -1
+    beq x13, x0, done
+    blt x0, x21, outer
+done:
+    addi x10, x0, 0
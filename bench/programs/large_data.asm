@@ -0,0 +1,529 @@
+# Large data section: 32 KiB of initialized words, assembled and then summed in a strided walk.
+.data
+table0: .word 0 35761 71522 7283 43044 78805 14566 50327 86088 21849 57610 93371 29132 64893 654 36415
+table0_1: .word 72176 7937 43698 79459 15220 50981 86742 22503 58264 94025 29786 65547 1308 37069 72830 8591
+table0_2: .word 44352 80113 15874 51635 87396 23157 58918 94679 30440 66201 1962 37723 73484 9245 45006 80767
+table0_3: .word 16528 52289 88050 23811 59572 95333 31094 66855 2616 38377 74138 9899 45660 81421 17182 52943
+table0_4: .word 88704 24465 60226 95987 31748 67509 3270 39031 74792 10553 46314 82075 17836 53597 89358 25119
+table0_5: .word 60880 96641 32402 68163 3924 39685 75446 11207 46968 82729 18490 54251 90012 25773 61534 97295
+table0_6: .word 33056 68817 4578 40339 76100 11861 47622 83383 19144 54905 90666 26427 62188 97949 33710 69471
+table0_7: .word 5232 40993 76754 12515 48276 84037 19798 55559 91320 27081 62842 98603 34364 70125 5886 41647
+table0_8: .word 77408 13169 48930 84691 20452 56213 91974 27735 63496 99257 35018 70779 6540 42301 78062 13823
+table0_9: .word 49584 85345 21106 56867 92628 28389 64150 99911 35672 71433 7194 42955 78716 14477 50238 85999
+table0_10: .word 21760 57521 93282 29043 64804 565 36326 72087 7848 43609 79370 15131 50892 86653 22414 58175
+table0_11: .word 93936 29697 65458 1219 36980 72741 8502 44263 80024 15785 51546 87307 23068 58829 94590 30351
+table0_12: .word 66112 1873 37634 73395 9156 44917 80678 16439 52200 87961 23722 59483 95244 31005 66766 2527
+table0_13: .word 38288 74049 9810 45571 81332 17093 52854 88615 24376 60137 95898 31659 67420 3181 38942 74703
+table0_14: .word 10464 46225 81986 17747 53508 89269 25030 60791 96552 32313 68074 3835 39596 75357 11118 46879
+table0_15: .word 82640 18401 54162 89923 25684 61445 97206 32967 68728 4489 40250 76011 11772 47533 83294 19055
+table0_16: .word 54816 90577 26338 62099 97860 33621 69382 5143 40904 76665 12426 48187 83948 19709 55470 91231
+table0_17: .word 26992 62753 98514 34275 70036 5797 41558 77319 13080 48841 84602 20363 56124 91885 27646 63407
+table0_18: .word 99168 34929 70690 6451 42212 77973 13734 49495 85256 21017 56778 92539 28300 64061 99822 35583
+table0_19: .word 71344 7105 42866 78627 14388 50149 85910 21671 57432 93193 28954 64715 476 36237 71998 7759
+table0_20: .word 43520 79281 15042 50803 86564 22325 58086 93847 29608 65369 1130 36891 72652 8413 44174 79935
+table0_21: .word 15696 51457 87218 22979 58740 94501 30262 66023 1784 37545 73306 9067 44828 80589 16350 52111
+table0_22: .word 87872 23633 59394 95155 30916 66677 2438 38199 73960 9721 45482 81243 17004 52765 88526 24287
+table0_23: .word 60048 95809 31570 67331 3092 38853 74614 10375 46136 81897 17658 53419 89180 24941 60702 96463
+table0_24: .word 32224 67985 3746 39507 75268 11029 46790 82551 18312 54073 89834 25595 61356 97117 32878 68639
+table0_25: .word 4400 40161 75922 11683 47444 83205 18966 54727 90488 26249 62010 97771 33532 69293 5054 40815
+table0_26: .word 76576 12337 48098 83859 19620 55381 91142 26903 62664 98425 34186 69947 5708 41469 77230 12991
+table0_27: .word 48752 84513 20274 56035 91796 27557 63318 99079 34840 70601 6362 42123 77884 13645 49406 85167
+table0_28: .word 20928 56689 92450 28211 63972 99733 35494 71255 7016 42777 78538 14299 50060 85821 21582 57343
+table0_29: .word 93104 28865 64626 387 36148 71909 7670 43431 79192 14953 50714 86475 22236 57997 93758 29519
+table0_30: .word 65280 1041 36802 72563 8324 44085 79846 15607 51368 87129 22890 58651 94412 30173 65934 1695
+table0_31: .word 37456 73217 8978 44739 80500 16261 52022 87783 23544 59305 95066 30827 66588 2349 38110 73871
+table0_32: .word 9632 45393 81154 16915 52676 88437 24198 59959 95720 31481 67242 3003 38764 74525 10286 46047
+table0_33: .word 81808 17569 53330 89091 24852 60613 96374 32135 67896 3657 39418 75179 10940 46701 82462 18223
+table0_34: .word 53984 89745 25506 61267 97028 32789 68550 4311 40072 75833 11594 47355 83116 18877 54638 90399
+table0_35: .word 26160 61921 97682 33443 69204 4965 40726 76487 12248 48009 83770 19531 55292 91053 26814 62575
+table0_36: .word 98336 34097 69858 5619 41380 77141 12902 48663 84424 20185 55946 91707 27468 63229 98990 34751
+table0_37: .word 70512 6273 42034 77795 13556 49317 85078 20839 56600 92361 28122 63883 99644 35405 71166 6927
+table0_38: .word 42688 78449 14210 49971 85732 21493 57254 93015 28776 64537 298 36059 71820 7581 43342 79103
+table0_39: .word 14864 50625 86386 22147 57908 93669 29430 65191 952 36713 72474 8235 43996 79757 15518 51279
+table0_40: .word 87040 22801 58562 94323 30084 65845 1606 37367 73128 8889 44650 80411 16172 51933 87694 23455
+table0_41: .word 59216 94977 30738 66499 2260 38021 73782 9543 45304 81065 16826 52587 88348 24109 59870 95631
+table0_42: .word 31392 67153 2914 38675 74436 10197 45958 81719 17480 53241 89002 24763 60524 96285 32046 67807
+table0_43: .word 3568 39329 75090 10851 46612 82373 18134 53895 89656 25417 61178 96939 32700 68461 4222 39983
+table0_44: .word 75744 11505 47266 83027 18788 54549 90310 26071 61832 97593 33354 69115 4876 40637 76398 12159
+table0_45: .word 47920 83681 19442 55203 90964 26725 62486 98247 34008 69769 5530 41291 77052 12813 48574 84335
+table0_46: .word 20096 55857 91618 27379 63140 98901 34662 70423 6184 41945 77706 13467 49228 84989 20750 56511
+table0_47: .word 92272 28033 63794 99555 35316 71077 6838 42599 78360 14121 49882 85643 21404 57165 92926 28687
+table0_48: .word 64448 209 35970 71731 7492 43253 79014 14775 50536 86297 22058 57819 93580 29341 65102 863
+table0_49: .word 36624 72385 8146 43907 79668 15429 51190 86951 22712 58473 94234 29995 65756 1517 37278 73039
+table0_50: .word 8800 44561 80322 16083 51844 87605 23366 59127 94888 30649 66410 2171 37932 73693 9454 45215
+table0_51: .word 80976 16737 52498 88259 24020 59781 95542 31303 67064 2825 38586 74347 10108 45869 81630 17391
+table0_52: .word 53152 88913 24674 60435 96196 31957 67718 3479 39240 75001 10762 46523 82284 18045 53806 89567
+table0_53: .word 25328 61089 96850 32611 68372 4133 39894 75655 11416 47177 82938 18699 54460 90221 25982 61743
+table0_54: .word 97504 33265 69026 4787 40548 76309 12070 47831 83592 19353 55114 90875 26636 62397 98158 33919
+table0_55: .word 69680 5441 41202 76963 12724 48485 84246 20007 55768 91529 27290 63051 98812 34573 70334 6095
+table0_56: .word 41856 77617 13378 49139 84900 20661 56422 92183 27944 63705 99466 35227 70988 6749 42510 78271
+table0_57: .word 14032 49793 85554 21315 57076 92837 28598 64359 120 35881 71642 7403 43164 78925 14686 50447
+table0_58: .word 86208 21969 57730 93491 29252 65013 774 36535 72296 8057 43818 79579 15340 51101 86862 22623
+table0_59: .word 58384 94145 29906 65667 1428 37189 72950 8711 44472 80233 15994 51755 87516 23277 59038 94799
+table0_60: .word 30560 66321 2082 37843 73604 9365 45126 80887 16648 52409 88170 23931 59692 95453 31214 66975
+table0_61: .word 2736 38497 74258 10019 45780 81541 17302 53063 88824 24585 60346 96107 31868 67629 3390 39151
+table0_62: .word 74912 10673 46434 82195 17956 53717 89478 25239 61000 96761 32522 68283 4044 39805 75566 11327
+table0_63: .word 47088 82849 18610 54371 90132 25893 61654 97415 33176 68937 4698 40459 76220 11981 47742 83503
+table0_64: .word 19264 55025 90786 26547 62308 98069 33830 69591 5352 41113 76874 12635 48396 84157 19918 55679
+table0_65: .word 91440 27201 62962 98723 34484 70245 6006 41767 77528 13289 49050 84811 20572 56333 92094 27855
+table0_66: .word 63616 99377 35138 70899 6660 42421 78182 13943 49704 85465 21226 56987 92748 28509 64270 31
+table0_67: .word 35792 71553 7314 43075 78836 14597 50358 86119 21880 57641 93402 29163 64924 685 36446 72207
+table0_68: .word 7968 43729 79490 15251 51012 86773 22534 58295 94056 29817 65578 1339 37100 72861 8622 44383
+table0_69: .word 80144 15905 51666 87427 23188 58949 94710 30471 66232 1993 37754 73515 9276 45037 80798 16559
+table0_70: .word 52320 88081 23842 59603 95364 31125 66886 2647 38408 74169 9930 45691 81452 17213 52974 88735
+table0_71: .word 24496 60257 96018 31779 67540 3301 39062 74823 10584 46345 82106 17867 53628 89389 25150 60911
+table0_72: .word 96672 32433 68194 3955 39716 75477 11238 46999 82760 18521 54282 90043 25804 61565 97326 33087
+table0_73: .word 68848 4609 40370 76131 11892 47653 83414 19175 54936 90697 26458 62219 97980 33741 69502 5263
+table0_74: .word 41024 76785 12546 48307 84068 19829 55590 91351 27112 62873 98634 34395 70156 5917 41678 77439
+table0_75: .word 13200 48961 84722 20483 56244 92005 27766 63527 99288 35049 70810 6571 42332 78093 13854 49615
+table0_76: .word 85376 21137 56898 92659 28420 64181 99942 35703 71464 7225 42986 78747 14508 50269 86030 21791
+table0_77: .word 57552 93313 29074 64835 596 36357 72118 7879 43640 79401 15162 50923 86684 22445 58206 93967
+table0_78: .word 29728 65489 1250 37011 72772 8533 44294 80055 15816 51577 87338 23099 58860 94621 30382 66143
+table0_79: .word 1904 37665 73426 9187 44948 80709 16470 52231 87992 23753 59514 95275 31036 66797 2558 38319
+table0_80: .word 74080 9841 45602 81363 17124 52885 88646 24407 60168 95929 31690 67451 3212 38973 74734 10495
+table0_81: .word 46256 82017 17778 53539 89300 25061 60822 96583 32344 68105 3866 39627 75388 11149 46910 82671
+table0_82: .word 18432 54193 89954 25715 61476 97237 32998 68759 4520 40281 76042 11803 47564 83325 19086 54847
+table0_83: .word 90608 26369 62130 97891 33652 69413 5174 40935 76696 12457 48218 83979 19740 55501 91262 27023
+table0_84: .word 62784 98545 34306 70067 5828 41589 77350 13111 48872 84633 20394 56155 91916 27677 63438 99199
+table0_85: .word 34960 70721 6482 42243 78004 13765 49526 85287 21048 56809 92570 28331 64092 99853 35614 71375
+table0_86: .word 7136 42897 78658 14419 50180 85941 21702 57463 93224 28985 64746 507 36268 72029 7790 43551
+table0_87: .word 79312 15073 50834 86595 22356 58117 93878 29639 65400 1161 36922 72683 8444 44205 79966 15727
+table0_88: .word 51488 87249 23010 58771 94532 30293 66054 1815 37576 73337 9098 44859 80620 16381 52142 87903
+table0_89: .word 23664 59425 95186 30947 66708 2469 38230 73991 9752 45513 81274 17035 52796 88557 24318 60079
+table0_90: .word 95840 31601 67362 3123 38884 74645 10406 46167 81928 17689 53450 89211 24972 60733 96494 32255
+table0_91: .word 68016 3777 39538 75299 11060 46821 82582 18343 54104 89865 25626 61387 97148 32909 68670 4431
+table0_92: .word 40192 75953 11714 47475 83236 18997 54758 90519 26280 62041 97802 33563 69324 5085 40846 76607
+table0_93: .word 12368 48129 83890 19651 55412 91173 26934 62695 98456 34217 69978 5739 41500 77261 13022 48783
+table0_94: .word 84544 20305 56066 91827 27588 63349 99110 34871 70632 6393 42154 77915 13676 49437 85198 20959
+table0_95: .word 56720 92481 28242 64003 99764 35525 71286 7047 42808 78569 14330 50091 85852 21613 57374 93135
+table0_96: .word 28896 64657 418 36179 71940 7701 43462 79223 14984 50745 86506 22267 58028 93789 29550 65311
+table0_97: .word 1072 36833 72594 8355 44116 79877 15638 51399 87160 22921 58682 94443 30204 65965 1726 37487
+table0_98: .word 73248 9009 44770 80531 16292 52053 87814 23575 59336 95097 30858 66619 2380 38141 73902 9663
+table0_99: .word 45424 81185 16946 52707 88468 24229 59990 95751 31512 67273 3034 38795 74556 10317 46078 81839
+table0_100: .word 17600 53361 89122 24883 60644 96405 32166 67927 3688 39449 75210 10971 46732 82493 18254 54015
+table0_101: .word 89776 25537 61298 97059 32820 68581 4342 40103 75864 11625 47386 83147 18908 54669 90430 26191
+table0_102: .word 61952 97713 33474 69235 4996 40757 76518 12279 48040 83801 19562 55323 91084 26845 62606 98367
+table0_103: .word 34128 69889 5650 41411 77172 12933 48694 84455 20216 55977 91738 27499 63260 99021 34782 70543
+table0_104: .word 6304 42065 77826 13587 49348 85109 20870 56631 92392 28153 63914 99675 35436 71197 6958 42719
+table0_105: .word 78480 14241 50002 85763 21524 57285 93046 28807 64568 329 36090 71851 7612 43373 79134 14895
+table0_106: .word 50656 86417 22178 57939 93700 29461 65222 983 36744 72505 8266 44027 79788 15549 51310 87071
+table0_107: .word 22832 58593 94354 30115 65876 1637 37398 73159 8920 44681 80442 16203 51964 87725 23486 59247
+table0_108: .word 95008 30769 66530 2291 38052 73813 9574 45335 81096 16857 52618 88379 24140 59901 95662 31423
+table0_109: .word 67184 2945 38706 74467 10228 45989 81750 17511 53272 89033 24794 60555 96316 32077 67838 3599
+table0_110: .word 39360 75121 10882 46643 82404 18165 53926 89687 25448 61209 96970 32731 68492 4253 40014 75775
+table0_111: .word 11536 47297 83058 18819 54580 90341 26102 61863 97624 33385 69146 4907 40668 76429 12190 47951
+table0_112: .word 83712 19473 55234 90995 26756 62517 98278 34039 69800 5561 41322 77083 12844 48605 84366 20127
+table0_113: .word 55888 91649 27410 63171 98932 34693 70454 6215 41976 77737 13498 49259 85020 20781 56542 92303
+table0_114: .word 28064 63825 99586 35347 71108 6869 42630 78391 14152 49913 85674 21435 57196 92957 28718 64479
+table0_115: .word 240 36001 71762 7523 43284 79045 14806 50567 86328 22089 57850 93611 29372 65133 894 36655
+table0_116: .word 72416 8177 43938 79699 15460 51221 86982 22743 58504 94265 30026 65787 1548 37309 73070 8831
+table0_117: .word 44592 80353 16114 51875 87636 23397 59158 94919 30680 66441 2202 37963 73724 9485 45246 81007
+table0_118: .word 16768 52529 88290 24051 59812 95573 31334 67095 2856 38617 74378 10139 45900 81661 17422 53183
+table0_119: .word 88944 24705 60466 96227 31988 67749 3510 39271 75032 10793 46554 82315 18076 53837 89598 25359
+table0_120: .word 61120 96881 32642 68403 4164 39925 75686 11447 47208 82969 18730 54491 90252 26013 61774 97535
+table0_121: .word 33296 69057 4818 40579 76340 12101 47862 83623 19384 55145 90906 26667 62428 98189 33950 69711
+table0_122: .word 5472 41233 76994 12755 48516 84277 20038 55799 91560 27321 63082 98843 34604 70365 6126 41887
+table0_123: .word 77648 13409 49170 84931 20692 56453 92214 27975 63736 99497 35258 71019 6780 42541 78302 14063
+table0_124: .word 49824 85585 21346 57107 92868 28629 64390 151 35912 71673 7434 43195 78956 14717 50478 86239
+table0_125: .word 22000 57761 93522 29283 65044 805 36566 72327 8088 43849 79610 15371 51132 86893 22654 58415
+table0_126: .word 94176 29937 65698 1459 37220 72981 8742 44503 80264 16025 51786 87547 23308 59069 94830 30591
+table0_127: .word 66352 2113 37874 73635 9396 45157 80918 16679 52440 88201 23962 59723 95484 31245 67006 2767
+table1: .word 38528 74289 10050 45811 81572 17333 53094 88855 24616 60377 96138 31899 67660 3421 39182 74943
+table1_1: .word 10704 46465 82226 17987 53748 89509 25270 61031 96792 32553 68314 4075 39836 75597 11358 47119
+table1_2: .word 82880 18641 54402 90163 25924 61685 97446 33207 68968 4729 40490 76251 12012 47773 83534 19295
+table1_3: .word 55056 90817 26578 62339 98100 33861 69622 5383 41144 76905 12666 48427 84188 19949 55710 91471
+table1_4: .word 27232 62993 98754 34515 70276 6037 41798 77559 13320 49081 84842 20603 56364 92125 27886 63647
+table1_5: .word 99408 35169 70930 6691 42452 78213 13974 49735 85496 21257 57018 92779 28540 64301 62 35823
+table1_6: .word 71584 7345 43106 78867 14628 50389 86150 21911 57672 93433 29194 64955 716 36477 72238 7999
+table1_7: .word 43760 79521 15282 51043 86804 22565 58326 94087 29848 65609 1370 37131 72892 8653 44414 80175
+table1_8: .word 15936 51697 87458 23219 58980 94741 30502 66263 2024 37785 73546 9307 45068 80829 16590 52351
+table1_9: .word 88112 23873 59634 95395 31156 66917 2678 38439 74200 9961 45722 81483 17244 53005 88766 24527
+table1_10: .word 60288 96049 31810 67571 3332 39093 74854 10615 46376 82137 17898 53659 89420 25181 60942 96703
+table1_11: .word 32464 68225 3986 39747 75508 11269 47030 82791 18552 54313 90074 25835 61596 97357 33118 68879
+table1_12: .word 4640 40401 76162 11923 47684 83445 19206 54967 90728 26489 62250 98011 33772 69533 5294 41055
+table1_13: .word 76816 12577 48338 84099 19860 55621 91382 27143 62904 98665 34426 70187 5948 41709 77470 13231
+table1_14: .word 48992 84753 20514 56275 92036 27797 63558 99319 35080 70841 6602 42363 78124 13885 49646 85407
+table1_15: .word 21168 56929 92690 28451 64212 99973 35734 71495 7256 43017 78778 14539 50300 86061 21822 57583
+table1_16: .word 93344 29105 64866 627 36388 72149 7910 43671 79432 15193 50954 86715 22476 58237 93998 29759
+table1_17: .word 65520 1281 37042 72803 8564 44325 80086 15847 51608 87369 23130 58891 94652 30413 66174 1935
+table1_18: .word 37696 73457 9218 44979 80740 16501 52262 88023 23784 59545 95306 31067 66828 2589 38350 74111
+table1_19: .word 9872 45633 81394 17155 52916 88677 24438 60199 95960 31721 67482 3243 39004 74765 10526 46287
+table1_20: .word 82048 17809 53570 89331 25092 60853 96614 32375 68136 3897 39658 75419 11180 46941 82702 18463
+table1_21: .word 54224 89985 25746 61507 97268 33029 68790 4551 40312 76073 11834 47595 83356 19117 54878 90639
+table1_22: .word 26400 62161 97922 33683 69444 5205 40966 76727 12488 48249 84010 19771 55532 91293 27054 62815
+table1_23: .word 98576 34337 70098 5859 41620 77381 13142 48903 84664 20425 56186 91947 27708 63469 99230 34991
+table1_24: .word 70752 6513 42274 78035 13796 49557 85318 21079 56840 92601 28362 64123 99884 35645 71406 7167
+table1_25: .word 42928 78689 14450 50211 85972 21733 57494 93255 29016 64777 538 36299 72060 7821 43582 79343
+table1_26: .word 15104 50865 86626 22387 58148 93909 29670 65431 1192 36953 72714 8475 44236 79997 15758 51519
+table1_27: .word 87280 23041 58802 94563 30324 66085 1846 37607 73368 9129 44890 80651 16412 52173 87934 23695
+table1_28: .word 59456 95217 30978 66739 2500 38261 74022 9783 45544 81305 17066 52827 88588 24349 60110 95871
+table1_29: .word 31632 67393 3154 38915 74676 10437 46198 81959 17720 53481 89242 25003 60764 96525 32286 68047
+table1_30: .word 3808 39569 75330 11091 46852 82613 18374 54135 89896 25657 61418 97179 32940 68701 4462 40223
+table1_31: .word 75984 11745 47506 83267 19028 54789 90550 26311 62072 97833 33594 69355 5116 40877 76638 12399
+table1_32: .word 48160 83921 19682 55443 91204 26965 62726 98487 34248 70009 5770 41531 77292 13053 48814 84575
+table1_33: .word 20336 56097 91858 27619 63380 99141 34902 70663 6424 42185 77946 13707 49468 85229 20990 56751
+table1_34: .word 92512 28273 64034 99795 35556 71317 7078 42839 78600 14361 50122 85883 21644 57405 93166 28927
+table1_35: .word 64688 449 36210 71971 7732 43493 79254 15015 50776 86537 22298 58059 93820 29581 65342 1103
+table1_36: .word 36864 72625 8386 44147 79908 15669 51430 87191 22952 58713 94474 30235 65996 1757 37518 73279
+table1_37: .word 9040 44801 80562 16323 52084 87845 23606 59367 95128 30889 66650 2411 38172 73933 9694 45455
+table1_38: .word 81216 16977 52738 88499 24260 60021 95782 31543 67304 3065 38826 74587 10348 46109 81870 17631
+table1_39: .word 53392 89153 24914 60675 96436 32197 67958 3719 39480 75241 11002 46763 82524 18285 54046 89807
+table1_40: .word 25568 61329 97090 32851 68612 4373 40134 75895 11656 47417 83178 18939 54700 90461 26222 61983
+table1_41: .word 97744 33505 69266 5027 40788 76549 12310 48071 83832 19593 55354 91115 26876 62637 98398 34159
+table1_42: .word 69920 5681 41442 77203 12964 48725 84486 20247 56008 91769 27530 63291 99052 34813 70574 6335
+table1_43: .word 42096 77857 13618 49379 85140 20901 56662 92423 28184 63945 99706 35467 71228 6989 42750 78511
+table1_44: .word 14272 50033 85794 21555 57316 93077 28838 64599 360 36121 71882 7643 43404 79165 14926 50687
+table1_45: .word 86448 22209 57970 93731 29492 65253 1014 36775 72536 8297 44058 79819 15580 51341 87102 22863
+table1_46: .word 58624 94385 30146 65907 1668 37429 73190 8951 44712 80473 16234 51995 87756 23517 59278 95039
+table1_47: .word 30800 66561 2322 38083 73844 9605 45366 81127 16888 52649 88410 24171 59932 95693 31454 67215
+table1_48: .word 2976 38737 74498 10259 46020 81781 17542 53303 89064 24825 60586 96347 32108 67869 3630 39391
+table1_49: .word 75152 10913 46674 82435 18196 53957 89718 25479 61240 97001 32762 68523 4284 40045 75806 11567
+table1_50: .word 47328 83089 18850 54611 90372 26133 61894 97655 33416 69177 4938 40699 76460 12221 47982 83743
+table1_51: .word 19504 55265 91026 26787 62548 98309 34070 69831 5592 41353 77114 12875 48636 84397 20158 55919
+table1_52: .word 91680 27441 63202 98963 34724 70485 6246 42007 77768 13529 49290 85051 20812 56573 92334 28095
+table1_53: .word 63856 99617 35378 71139 6900 42661 78422 14183 49944 85705 21466 57227 92988 28749 64510 271
+table1_54: .word 36032 71793 7554 43315 79076 14837 50598 86359 22120 57881 93642 29403 65164 925 36686 72447
+table1_55: .word 8208 43969 79730 15491 51252 87013 22774 58535 94296 30057 65818 1579 37340 73101 8862 44623
+table1_56: .word 80384 16145 51906 87667 23428 59189 94950 30711 66472 2233 37994 73755 9516 45277 81038 16799
+table1_57: .word 52560 88321 24082 59843 95604 31365 67126 2887 38648 74409 10170 45931 81692 17453 53214 88975
+table1_58: .word 24736 60497 96258 32019 67780 3541 39302 75063 10824 46585 82346 18107 53868 89629 25390 61151
+table1_59: .word 96912 32673 68434 4195 39956 75717 11478 47239 83000 18761 54522 90283 26044 61805 97566 33327
+table1_60: .word 69088 4849 40610 76371 12132 47893 83654 19415 55176 90937 26698 62459 98220 33981 69742 5503
+table1_61: .word 41264 77025 12786 48547 84308 20069 55830 91591 27352 63113 98874 34635 70396 6157 41918 77679
+table1_62: .word 13440 49201 84962 20723 56484 92245 28006 63767 99528 35289 71050 6811 42572 78333 14094 49855
+table1_63: .word 85616 21377 57138 92899 28660 64421 182 35943 71704 7465 43226 78987 14748 50509 86270 22031
+table1_64: .word 57792 93553 29314 65075 836 36597 72358 8119 43880 79641 15402 51163 86924 22685 58446 94207
+table1_65: .word 29968 65729 1490 37251 73012 8773 44534 80295 16056 51817 87578 23339 59100 94861 30622 66383
+table1_66: .word 2144 37905 73666 9427 45188 80949 16710 52471 88232 23993 59754 95515 31276 67037 2798 38559
+table1_67: .word 74320 10081 45842 81603 17364 53125 88886 24647 60408 96169 31930 67691 3452 39213 74974 10735
+table1_68: .word 46496 82257 18018 53779 89540 25301 61062 96823 32584 68345 4106 39867 75628 11389 47150 82911
+table1_69: .word 18672 54433 90194 25955 61716 97477 33238 68999 4760 40521 76282 12043 47804 83565 19326 55087
+table1_70: .word 90848 26609 62370 98131 33892 69653 5414 41175 76936 12697 48458 84219 19980 55741 91502 27263
+table1_71: .word 63024 98785 34546 70307 6068 41829 77590 13351 49112 84873 20634 56395 92156 27917 63678 99439
+table1_72: .word 35200 70961 6722 42483 78244 14005 49766 85527 21288 57049 92810 28571 64332 93 35854 71615
+table1_73: .word 7376 43137 78898 14659 50420 86181 21942 57703 93464 29225 64986 747 36508 72269 8030 43791
+table1_74: .word 79552 15313 51074 86835 22596 58357 94118 29879 65640 1401 37162 72923 8684 44445 80206 15967
+table1_75: .word 51728 87489 23250 59011 94772 30533 66294 2055 37816 73577 9338 45099 80860 16621 52382 88143
+table1_76: .word 23904 59665 95426 31187 66948 2709 38470 74231 9992 45753 81514 17275 53036 88797 24558 60319
+table1_77: .word 96080 31841 67602 3363 39124 74885 10646 46407 82168 17929 53690 89451 25212 60973 96734 32495
+table1_78: .word 68256 4017 39778 75539 11300 47061 82822 18583 54344 90105 25866 61627 97388 33149 68910 4671
+table1_79: .word 40432 76193 11954 47715 83476 19237 54998 90759 26520 62281 98042 33803 69564 5325 41086 76847
+table1_80: .word 12608 48369 84130 19891 55652 91413 27174 62935 98696 34457 70218 5979 41740 77501 13262 49023
+table1_81: .word 84784 20545 56306 92067 27828 63589 99350 35111 70872 6633 42394 78155 13916 49677 85438 21199
+table1_82: .word 56960 92721 28482 64243 4 35765 71526 7287 43048 78809 14570 50331 86092 21853 57614 93375
+table1_83: .word 29136 64897 658 36419 72180 7941 43702 79463 15224 50985 86746 22507 58268 94029 29790 65551
+table1_84: .word 1312 37073 72834 8595 44356 80117 15878 51639 87400 23161 58922 94683 30444 66205 1966 37727
+table1_85: .word 73488 9249 45010 80771 16532 52293 88054 23815 59576 95337 31098 66859 2620 38381 74142 9903
+table1_86: .word 45664 81425 17186 52947 88708 24469 60230 95991 31752 67513 3274 39035 74796 10557 46318 82079
+table1_87: .word 17840 53601 89362 25123 60884 96645 32406 68167 3928 39689 75450 11211 46972 82733 18494 54255
+table1_88: .word 90016 25777 61538 97299 33060 68821 4582 40343 76104 11865 47626 83387 19148 54909 90670 26431
+table1_89: .word 62192 97953 33714 69475 5236 40997 76758 12519 48280 84041 19802 55563 91324 27085 62846 98607
+table1_90: .word 34368 70129 5890 41651 77412 13173 48934 84695 20456 56217 91978 27739 63500 99261 35022 70783
+table1_91: .word 6544 42305 78066 13827 49588 85349 21110 56871 92632 28393 64154 99915 35676 71437 7198 42959
+table1_92: .word 78720 14481 50242 86003 21764 57525 93286 29047 64808 569 36330 72091 7852 43613 79374 15135
+table1_93: .word 50896 86657 22418 58179 93940 29701 65462 1223 36984 72745 8506 44267 80028 15789 51550 87311
+table1_94: .word 23072 58833 94594 30355 66116 1877 37638 73399 9160 44921 80682 16443 52204 87965 23726 59487
+table1_95: .word 95248 31009 66770 2531 38292 74053 9814 45575 81336 17097 52858 88619 24380 60141 95902 31663
+table1_96: .word 67424 3185 38946 74707 10468 46229 81990 17751 53512 89273 25034 60795 96556 32317 68078 3839
+table1_97: .word 39600 75361 11122 46883 82644 18405 54166 89927 25688 61449 97210 32971 68732 4493 40254 76015
+table1_98: .word 11776 47537 83298 19059 54820 90581 26342 62103 97864 33625 69386 5147 40908 76669 12430 48191
+table1_99: .word 83952 19713 55474 91235 26996 62757 98518 34279 70040 5801 41562 77323 13084 48845 84606 20367
+table1_100: .word 56128 91889 27650 63411 99172 34933 70694 6455 42216 77977 13738 49499 85260 21021 56782 92543
+table1_101: .word 28304 64065 99826 35587 71348 7109 42870 78631 14392 50153 85914 21675 57436 93197 28958 64719
+table1_102: .word 480 36241 72002 7763 43524 79285 15046 50807 86568 22329 58090 93851 29612 65373 1134 36895
+table1_103: .word 72656 8417 44178 79939 15700 51461 87222 22983 58744 94505 30266 66027 1788 37549 73310 9071
+table1_104: .word 44832 80593 16354 52115 87876 23637 59398 95159 30920 66681 2442 38203 73964 9725 45486 81247
+table1_105: .word 17008 52769 88530 24291 60052 95813 31574 67335 3096 38857 74618 10379 46140 81901 17662 53423
+table1_106: .word 89184 24945 60706 96467 32228 67989 3750 39511 75272 11033 46794 82555 18316 54077 89838 25599
+table1_107: .word 61360 97121 32882 68643 4404 40165 75926 11687 47448 83209 18970 54731 90492 26253 62014 97775
+table1_108: .word 33536 69297 5058 40819 76580 12341 48102 83863 19624 55385 91146 26907 62668 98429 34190 69951
+table1_109: .word 5712 41473 77234 12995 48756 84517 20278 56039 91800 27561 63322 99083 34844 70605 6366 42127
+table1_110: .word 77888 13649 49410 85171 20932 56693 92454 28215 63976 99737 35498 71259 7020 42781 78542 14303
+table1_111: .word 50064 85825 21586 57347 93108 28869 64630 391 36152 71913 7674 43435 79196 14957 50718 86479
+table1_112: .word 22240 58001 93762 29523 65284 1045 36806 72567 8328 44089 79850 15611 51372 87133 22894 58655
+table1_113: .word 94416 30177 65938 1699 37460 73221 8982 44743 80504 16265 52026 87787 23548 59309 95070 30831
+table1_114: .word 66592 2353 38114 73875 9636 45397 81158 16919 52680 88441 24202 59963 95724 31485 67246 3007
+table1_115: .word 38768 74529 10290 46051 81812 17573 53334 89095 24856 60617 96378 32139 67900 3661 39422 75183
+table1_116: .word 10944 46705 82466 18227 53988 89749 25510 61271 97032 32793 68554 4315 40076 75837 11598 47359
+table1_117: .word 83120 18881 54642 90403 26164 61925 97686 33447 69208 4969 40730 76491 12252 48013 83774 19535
+table1_118: .word 55296 91057 26818 62579 98340 34101 69862 5623 41384 77145 12906 48667 84428 20189 55950 91711
+table1_119: .word 27472 63233 98994 34755 70516 6277 42038 77799 13560 49321 85082 20843 56604 92365 28126 63887
+table1_120: .word 99648 35409 71170 6931 42692 78453 14214 49975 85736 21497 57258 93019 28780 64541 302 36063
+table1_121: .word 71824 7585 43346 79107 14868 50629 86390 22151 57912 93673 29434 65195 956 36717 72478 8239
+table1_122: .word 44000 79761 15522 51283 87044 22805 58566 94327 30088 65849 1610 37371 73132 8893 44654 80415
+table1_123: .word 16176 51937 87698 23459 59220 94981 30742 66503 2264 38025 73786 9547 45308 81069 16830 52591
+table1_124: .word 88352 24113 59874 95635 31396 67157 2918 38679 74440 10201 45962 81723 17484 53245 89006 24767
+table1_125: .word 60528 96289 32050 67811 3572 39333 75094 10855 46616 82377 18138 53899 89660 25421 61182 96943
+table1_126: .word 32704 68465 4226 39987 75748 11509 47270 83031 18792 54553 90314 26075 61836 97597 33358 69119
+table1_127: .word 4880 40641 76402 12163 47924 83685 19446 55207 90968 26729 62490 98251 34012 69773 5534 41295
+table2: .word 77056 12817 48578 84339 20100 55861 91622 27383 63144 98905 34666 70427 6188 41949 77710 13471
+table2_1: .word 49232 84993 20754 56515 92276 28037 63798 99559 35320 71081 6842 42603 78364 14125 49886 85647
+table2_2: .word 21408 57169 92930 28691 64452 213 35974 71735 7496 43257 79018 14779 50540 86301 22062 57823
+table2_3: .word 93584 29345 65106 867 36628 72389 8150 43911 79672 15433 51194 86955 22716 58477 94238 29999
+table2_4: .word 65760 1521 37282 73043 8804 44565 80326 16087 51848 87609 23370 59131 94892 30653 66414 2175
+table2_5: .word 37936 73697 9458 45219 80980 16741 52502 88263 24024 59785 95546 31307 67068 2829 38590 74351
+table2_6: .word 10112 45873 81634 17395 53156 88917 24678 60439 96200 31961 67722 3483 39244 75005 10766 46527
+table2_7: .word 82288 18049 53810 89571 25332 61093 96854 32615 68376 4137 39898 75659 11420 47181 82942 18703
+table2_8: .word 54464 90225 25986 61747 97508 33269 69030 4791 40552 76313 12074 47835 83596 19357 55118 90879
+table2_9: .word 26640 62401 98162 33923 69684 5445 41206 76967 12728 48489 84250 20011 55772 91533 27294 63055
+table2_10: .word 98816 34577 70338 6099 41860 77621 13382 49143 84904 20665 56426 92187 27948 63709 99470 35231
+table2_11: .word 70992 6753 42514 78275 14036 49797 85558 21319 57080 92841 28602 64363 124 35885 71646 7407
+table2_12: .word 43168 78929 14690 50451 86212 21973 57734 93495 29256 65017 778 36539 72300 8061 43822 79583
+table2_13: .word 15344 51105 86866 22627 58388 94149 29910 65671 1432 37193 72954 8715 44476 80237 15998 51759
+table2_14: .word 87520 23281 59042 94803 30564 66325 2086 37847 73608 9369 45130 80891 16652 52413 88174 23935
+table2_15: .word 59696 95457 31218 66979 2740 38501 74262 10023 45784 81545 17306 53067 88828 24589 60350 96111
+table2_16: .word 31872 67633 3394 39155 74916 10677 46438 82199 17960 53721 89482 25243 61004 96765 32526 68287
+table2_17: .word 4048 39809 75570 11331 47092 82853 18614 54375 90136 25897 61658 97419 33180 68941 4702 40463
+table2_18: .word 76224 11985 47746 83507 19268 55029 90790 26551 62312 98073 33834 69595 5356 41117 76878 12639
+table2_19: .word 48400 84161 19922 55683 91444 27205 62966 98727 34488 70249 6010 41771 77532 13293 49054 84815
+table2_20: .word 20576 56337 92098 27859 63620 99381 35142 70903 6664 42425 78186 13947 49708 85469 21230 56991
+table2_21: .word 92752 28513 64274 35 35796 71557 7318 43079 78840 14601 50362 86123 21884 57645 93406 29167
+table2_22: .word 64928 689 36450 72211 7972 43733 79494 15255 51016 86777 22538 58299 94060 29821 65582 1343
+table2_23: .word 37104 72865 8626 44387 80148 15909 51670 87431 23192 58953 94714 30475 66236 1997 37758 73519
+table2_24: .word 9280 45041 80802 16563 52324 88085 23846 59607 95368 31129 66890 2651 38412 74173 9934 45695
+table2_25: .word 81456 17217 52978 88739 24500 60261 96022 31783 67544 3305 39066 74827 10588 46349 82110 17871
+table2_26: .word 53632 89393 25154 60915 96676 32437 68198 3959 39720 75481 11242 47003 82764 18525 54286 90047
+table2_27: .word 25808 61569 97330 33091 68852 4613 40374 76135 11896 47657 83418 19179 54940 90701 26462 62223
+table2_28: .word 97984 33745 69506 5267 41028 76789 12550 48311 84072 19833 55594 91355 27116 62877 98638 34399
+table2_29: .word 70160 5921 41682 77443 13204 48965 84726 20487 56248 92009 27770 63531 99292 35053 70814 6575
+table2_30: .word 42336 78097 13858 49619 85380 21141 56902 92663 28424 64185 99946 35707 71468 7229 42990 78751
+table2_31: .word 14512 50273 86034 21795 57556 93317 29078 64839 600 36361 72122 7883 43644 79405 15166 50927
+table2_32: .word 86688 22449 58210 93971 29732 65493 1254 37015 72776 8537 44298 80059 15820 51581 87342 23103
+table2_33: .word 58864 94625 30386 66147 1908 37669 73430 9191 44952 80713 16474 52235 87996 23757 59518 95279
+table2_34: .word 31040 66801 2562 38323 74084 9845 45606 81367 17128 52889 88650 24411 60172 95933 31694 67455
+table2_35: .word 3216 38977 74738 10499 46260 82021 17782 53543 89304 25065 60826 96587 32348 68109 3870 39631
+table2_36: .word 75392 11153 46914 82675 18436 54197 89958 25719 61480 97241 33002 68763 4524 40285 76046 11807
+table2_37: .word 47568 83329 19090 54851 90612 26373 62134 97895 33656 69417 5178 40939 76700 12461 48222 83983
+table2_38: .word 19744 55505 91266 27027 62788 98549 34310 70071 5832 41593 77354 13115 48876 84637 20398 56159
+table2_39: .word 91920 27681 63442 99203 34964 70725 6486 42247 78008 13769 49530 85291 21052 56813 92574 28335
+table2_40: .word 64096 99857 35618 71379 7140 42901 78662 14423 50184 85945 21706 57467 93228 28989 64750 511
+table2_41: .word 36272 72033 7794 43555 79316 15077 50838 86599 22360 58121 93882 29643 65404 1165 36926 72687
+table2_42: .word 8448 44209 79970 15731 51492 87253 23014 58775 94536 30297 66058 1819 37580 73341 9102 44863
+table2_43: .word 80624 16385 52146 87907 23668 59429 95190 30951 66712 2473 38234 73995 9756 45517 81278 17039
+table2_44: .word 52800 88561 24322 60083 95844 31605 67366 3127 38888 74649 10410 46171 81932 17693 53454 89215
+table2_45: .word 24976 60737 96498 32259 68020 3781 39542 75303 11064 46825 82586 18347 54108 89869 25630 61391
+table2_46: .word 97152 32913 68674 4435 40196 75957 11718 47479 83240 19001 54762 90523 26284 62045 97806 33567
+table2_47: .word 69328 5089 40850 76611 12372 48133 83894 19655 55416 91177 26938 62699 98460 34221 69982 5743
+table2_48: .word 41504 77265 13026 48787 84548 20309 56070 91831 27592 63353 99114 34875 70636 6397 42158 77919
+table2_49: .word 13680 49441 85202 20963 56724 92485 28246 64007 99768 35529 71290 7051 42812 78573 14334 50095
+table2_50: .word 85856 21617 57378 93139 28900 64661 422 36183 71944 7705 43466 79227 14988 50749 86510 22271
+table2_51: .word 58032 93793 29554 65315 1076 36837 72598 8359 44120 79881 15642 51403 87164 22925 58686 94447
+table2_52: .word 30208 65969 1730 37491 73252 9013 44774 80535 16296 52057 87818 23579 59340 95101 30862 66623
+table2_53: .word 2384 38145 73906 9667 45428 81189 16950 52711 88472 24233 59994 95755 31516 67277 3038 38799
+table2_54: .word 74560 10321 46082 81843 17604 53365 89126 24887 60648 96409 32170 67931 3692 39453 75214 10975
+table2_55: .word 46736 82497 18258 54019 89780 25541 61302 97063 32824 68585 4346 40107 75868 11629 47390 83151
+table2_56: .word 18912 54673 90434 26195 61956 97717 33478 69239 5000 40761 76522 12283 48044 83805 19566 55327
+table2_57: .word 91088 26849 62610 98371 34132 69893 5654 41415 77176 12937 48698 84459 20220 55981 91742 27503
+table2_58: .word 63264 99025 34786 70547 6308 42069 77830 13591 49352 85113 20874 56635 92396 28157 63918 99679
+table2_59: .word 35440 71201 6962 42723 78484 14245 50006 85767 21528 57289 93050 28811 64572 333 36094 71855
+table2_60: .word 7616 43377 79138 14899 50660 86421 22182 57943 93704 29465 65226 987 36748 72509 8270 44031
+table2_61: .word 79792 15553 51314 87075 22836 58597 94358 30119 65880 1641 37402 73163 8924 44685 80446 16207
+table2_62: .word 51968 87729 23490 59251 95012 30773 66534 2295 38056 73817 9578 45339 81100 16861 52622 88383
+table2_63: .word 24144 59905 95666 31427 67188 2949 38710 74471 10232 45993 81754 17515 53276 89037 24798 60559
+table2_64: .word 96320 32081 67842 3603 39364 75125 10886 46647 82408 18169 53930 89691 25452 61213 96974 32735
+table2_65: .word 68496 4257 40018 75779 11540 47301 83062 18823 54584 90345 26106 61867 97628 33389 69150 4911
+table2_66: .word 40672 76433 12194 47955 83716 19477 55238 90999 26760 62521 98282 34043 69804 5565 41326 77087
+table2_67: .word 12848 48609 84370 20131 55892 91653 27414 63175 98936 34697 70458 6219 41980 77741 13502 49263
+table2_68: .word 85024 20785 56546 92307 28068 63829 99590 35351 71112 6873 42634 78395 14156 49917 85678 21439
+table2_69: .word 57200 92961 28722 64483 244 36005 71766 7527 43288 79049 14810 50571 86332 22093 57854 93615
+table2_70: .word 29376 65137 898 36659 72420 8181 43942 79703 15464 51225 86986 22747 58508 94269 30030 65791
+table2_71: .word 1552 37313 73074 8835 44596 80357 16118 51879 87640 23401 59162 94923 30684 66445 2206 37967
+table2_72: .word 73728 9489 45250 81011 16772 52533 88294 24055 59816 95577 31338 67099 2860 38621 74382 10143
+table2_73: .word 45904 81665 17426 53187 88948 24709 60470 96231 31992 67753 3514 39275 75036 10797 46558 82319
+table2_74: .word 18080 53841 89602 25363 61124 96885 32646 68407 4168 39929 75690 11451 47212 82973 18734 54495
+table2_75: .word 90256 26017 61778 97539 33300 69061 4822 40583 76344 12105 47866 83627 19388 55149 90910 26671
+table2_76: .word 62432 98193 33954 69715 5476 41237 76998 12759 48520 84281 20042 55803 91564 27325 63086 98847
+table2_77: .word 34608 70369 6130 41891 77652 13413 49174 84935 20696 56457 92218 27979 63740 99501 35262 71023
+table2_78: .word 6784 42545 78306 14067 49828 85589 21350 57111 92872 28633 64394 155 35916 71677 7438 43199
+table2_79: .word 78960 14721 50482 86243 22004 57765 93526 29287 65048 809 36570 72331 8092 43853 79614 15375
+table2_80: .word 51136 86897 22658 58419 94180 29941 65702 1463 37224 72985 8746 44507 80268 16029 51790 87551
+table2_81: .word 23312 59073 94834 30595 66356 2117 37878 73639 9400 45161 80922 16683 52444 88205 23966 59727
+table2_82: .word 95488 31249 67010 2771 38532 74293 10054 45815 81576 17337 53098 88859 24620 60381 96142 31903
+table2_83: .word 67664 3425 39186 74947 10708 46469 82230 17991 53752 89513 25274 61035 96796 32557 68318 4079
+table2_84: .word 39840 75601 11362 47123 82884 18645 54406 90167 25928 61689 97450 33211 68972 4733 40494 76255
+table2_85: .word 12016 47777 83538 19299 55060 90821 26582 62343 98104 33865 69626 5387 41148 76909 12670 48431
+table2_86: .word 84192 19953 55714 91475 27236 62997 98758 34519 70280 6041 41802 77563 13324 49085 84846 20607
+table2_87: .word 56368 92129 27890 63651 99412 35173 70934 6695 42456 78217 13978 49739 85500 21261 57022 92783
+table2_88: .word 28544 64305 66 35827 71588 7349 43110 78871 14632 50393 86154 21915 57676 93437 29198 64959
+table2_89: .word 720 36481 72242 8003 43764 79525 15286 51047 86808 22569 58330 94091 29852 65613 1374 37135
+table2_90: .word 72896 8657 44418 80179 15940 51701 87462 23223 58984 94745 30506 66267 2028 37789 73550 9311
+table2_91: .word 45072 80833 16594 52355 88116 23877 59638 95399 31160 66921 2682 38443 74204 9965 45726 81487
+table2_92: .word 17248 53009 88770 24531 60292 96053 31814 67575 3336 39097 74858 10619 46380 82141 17902 53663
+table2_93: .word 89424 25185 60946 96707 32468 68229 3990 39751 75512 11273 47034 82795 18556 54317 90078 25839
+table2_94: .word 61600 97361 33122 68883 4644 40405 76166 11927 47688 83449 19210 54971 90732 26493 62254 98015
+table2_95: .word 33776 69537 5298 41059 76820 12581 48342 84103 19864 55625 91386 27147 62908 98669 34430 70191
+table2_96: .word 5952 41713 77474 13235 48996 84757 20518 56279 92040 27801 63562 99323 35084 70845 6606 42367
+table2_97: .word 78128 13889 49650 85411 21172 56933 92694 28455 64216 99977 35738 71499 7260 43021 78782 14543
+table2_98: .word 50304 86065 21826 57587 93348 29109 64870 631 36392 72153 7914 43675 79436 15197 50958 86719
+table2_99: .word 22480 58241 94002 29763 65524 1285 37046 72807 8568 44329 80090 15851 51612 87373 23134 58895
+table2_100: .word 94656 30417 66178 1939 37700 73461 9222 44983 80744 16505 52266 88027 23788 59549 95310 31071
+table2_101: .word 66832 2593 38354 74115 9876 45637 81398 17159 52920 88681 24442 60203 95964 31725 67486 3247
+table2_102: .word 39008 74769 10530 46291 82052 17813 53574 89335 25096 60857 96618 32379 68140 3901 39662 75423
+table2_103: .word 11184 46945 82706 18467 54228 89989 25750 61511 97272 33033 68794 4555 40316 76077 11838 47599
+table2_104: .word 83360 19121 54882 90643 26404 62165 97926 33687 69448 5209 40970 76731 12492 48253 84014 19775
+table2_105: .word 55536 91297 27058 62819 98580 34341 70102 5863 41624 77385 13146 48907 84668 20429 56190 91951
+table2_106: .word 27712 63473 99234 34995 70756 6517 42278 78039 13800 49561 85322 21083 56844 92605 28366 64127
+table2_107: .word 99888 35649 71410 7171 42932 78693 14454 50215 85976 21737 57498 93259 29020 64781 542 36303
+table2_108: .word 72064 7825 43586 79347 15108 50869 86630 22391 58152 93913 29674 65435 1196 36957 72718 8479
+table2_109: .word 44240 80001 15762 51523 87284 23045 58806 94567 30328 66089 1850 37611 73372 9133 44894 80655
+table2_110: .word 16416 52177 87938 23699 59460 95221 30982 66743 2504 38265 74026 9787 45548 81309 17070 52831
+table2_111: .word 88592 24353 60114 95875 31636 67397 3158 38919 74680 10441 46202 81963 17724 53485 89246 25007
+table2_112: .word 60768 96529 32290 68051 3812 39573 75334 11095 46856 82617 18378 54139 89900 25661 61422 97183
+table2_113: .word 32944 68705 4466 40227 75988 11749 47510 83271 19032 54793 90554 26315 62076 97837 33598 69359
+table2_114: .word 5120 40881 76642 12403 48164 83925 19686 55447 91208 26969 62730 98491 34252 70013 5774 41535
+table2_115: .word 77296 13057 48818 84579 20340 56101 91862 27623 63384 99145 34906 70667 6428 42189 77950 13711
+table2_116: .word 49472 85233 20994 56755 92516 28277 64038 99799 35560 71321 7082 42843 78604 14365 50126 85887
+table2_117: .word 21648 57409 93170 28931 64692 453 36214 71975 7736 43497 79258 15019 50780 86541 22302 58063
+table2_118: .word 93824 29585 65346 1107 36868 72629 8390 44151 79912 15673 51434 87195 22956 58717 94478 30239
+table2_119: .word 66000 1761 37522 73283 9044 44805 80566 16327 52088 87849 23610 59371 95132 30893 66654 2415
+table2_120: .word 38176 73937 9698 45459 81220 16981 52742 88503 24264 60025 95786 31547 67308 3069 38830 74591
+table2_121: .word 10352 46113 81874 17635 53396 89157 24918 60679 96440 32201 67962 3723 39484 75245 11006 46767
+table2_122: .word 82528 18289 54050 89811 25572 61333 97094 32855 68616 4377 40138 75899 11660 47421 83182 18943
+table2_123: .word 54704 90465 26226 61987 97748 33509 69270 5031 40792 76553 12314 48075 83836 19597 55358 91119
+table2_124: .word 26880 62641 98402 34163 69924 5685 41446 77207 12968 48729 84490 20251 56012 91773 27534 63295
+table2_125: .word 99056 34817 70578 6339 42100 77861 13622 49383 85144 20905 56666 92427 28188 63949 99710 35471
+table2_126: .word 71232 6993 42754 78515 14276 50037 85798 21559 57320 93081 28842 64603 364 36125 71886 7647
+table2_127: .word 43408 79169 14930 50691 86452 22213 57974 93735 29496 65257 1018 36779 72540 8301 44062 79823
+table3: .word 15584 51345 87106 22867 58628 94389 30150 65911 1672 37433 73194 8955 44716 80477 16238 51999
+table3_1: .word 87760 23521 59282 95043 30804 66565 2326 38087 73848 9609 45370 81131 16892 52653 88414 24175
+table3_2: .word 59936 95697 31458 67219 2980 38741 74502 10263 46024 81785 17546 53307 89068 24829 60590 96351
+table3_3: .word 32112 67873 3634 39395 75156 10917 46678 82439 18200 53961 89722 25483 61244 97005 32766 68527
+table3_4: .word 4288 40049 75810 11571 47332 83093 18854 54615 90376 26137 61898 97659 33420 69181 4942 40703
+table3_5: .word 76464 12225 47986 83747 19508 55269 91030 26791 62552 98313 34074 69835 5596 41357 77118 12879
+table3_6: .word 48640 84401 20162 55923 91684 27445 63206 98967 34728 70489 6250 42011 77772 13533 49294 85055
+table3_7: .word 20816 56577 92338 28099 63860 99621 35382 71143 6904 42665 78426 14187 49948 85709 21470 57231
+table3_8: .word 92992 28753 64514 275 36036 71797 7558 43319 79080 14841 50602 86363 22124 57885 93646 29407
+table3_9: .word 65168 929 36690 72451 8212 43973 79734 15495 51256 87017 22778 58539 94300 30061 65822 1583
+table3_10: .word 37344 73105 8866 44627 80388 16149 51910 87671 23432 59193 94954 30715 66476 2237 37998 73759
+table3_11: .word 9520 45281 81042 16803 52564 88325 24086 59847 95608 31369 67130 2891 38652 74413 10174 45935
+table3_12: .word 81696 17457 53218 88979 24740 60501 96262 32023 67784 3545 39306 75067 10828 46589 82350 18111
+table3_13: .word 53872 89633 25394 61155 96916 32677 68438 4199 39960 75721 11482 47243 83004 18765 54526 90287
+table3_14: .word 26048 61809 97570 33331 69092 4853 40614 76375 12136 47897 83658 19419 55180 90941 26702 62463
+table3_15: .word 98224 33985 69746 5507 41268 77029 12790 48551 84312 20073 55834 91595 27356 63117 98878 34639
+table3_16: .word 70400 6161 41922 77683 13444 49205 84966 20727 56488 92249 28010 63771 99532 35293 71054 6815
+table3_17: .word 42576 78337 14098 49859 85620 21381 57142 92903 28664 64425 186 35947 71708 7469 43230 78991
+table3_18: .word 14752 50513 86274 22035 57796 93557 29318 65079 840 36601 72362 8123 43884 79645 15406 51167
+table3_19: .word 86928 22689 58450 94211 29972 65733 1494 37255 73016 8777 44538 80299 16060 51821 87582 23343
+table3_20: .word 59104 94865 30626 66387 2148 37909 73670 9431 45192 80953 16714 52475 88236 23997 59758 95519
+table3_21: .word 31280 67041 2802 38563 74324 10085 45846 81607 17368 53129 88890 24651 60412 96173 31934 67695
+table3_22: .word 3456 39217 74978 10739 46500 82261 18022 53783 89544 25305 61066 96827 32588 68349 4110 39871
+table3_23: .word 75632 11393 47154 82915 18676 54437 90198 25959 61720 97481 33242 69003 4764 40525 76286 12047
+table3_24: .word 47808 83569 19330 55091 90852 26613 62374 98135 33896 69657 5418 41179 76940 12701 48462 84223
+table3_25: .word 19984 55745 91506 27267 63028 98789 34550 70311 6072 41833 77594 13355 49116 84877 20638 56399
+table3_26: .word 92160 27921 63682 99443 35204 70965 6726 42487 78248 14009 49770 85531 21292 57053 92814 28575
+table3_27: .word 64336 97 35858 71619 7380 43141 78902 14663 50424 86185 21946 57707 93468 29229 64990 751
+table3_28: .word 36512 72273 8034 43795 79556 15317 51078 86839 22600 58361 94122 29883 65644 1405 37166 72927
+table3_29: .word 8688 44449 80210 15971 51732 87493 23254 59015 94776 30537 66298 2059 37820 73581 9342 45103
+table3_30: .word 80864 16625 52386 88147 23908 59669 95430 31191 66952 2713 38474 74235 9996 45757 81518 17279
+table3_31: .word 53040 88801 24562 60323 96084 31845 67606 3367 39128 74889 10650 46411 82172 17933 53694 89455
+table3_32: .word 25216 60977 96738 32499 68260 4021 39782 75543 11304 47065 82826 18587 54348 90109 25870 61631
+table3_33: .word 97392 33153 68914 4675 40436 76197 11958 47719 83480 19241 55002 90763 26524 62285 98046 33807
+table3_34: .word 69568 5329 41090 76851 12612 48373 84134 19895 55656 91417 27178 62939 98700 34461 70222 5983
+table3_35: .word 41744 77505 13266 49027 84788 20549 56310 92071 27832 63593 99354 35115 70876 6637 42398 78159
+table3_36: .word 13920 49681 85442 21203 56964 92725 28486 64247 8 35769 71530 7291 43052 78813 14574 50335
+table3_37: .word 86096 21857 57618 93379 29140 64901 662 36423 72184 7945 43706 79467 15228 50989 86750 22511
+table3_38: .word 58272 94033 29794 65555 1316 37077 72838 8599 44360 80121 15882 51643 87404 23165 58926 94687
+table3_39: .word 30448 66209 1970 37731 73492 9253 45014 80775 16536 52297 88058 23819 59580 95341 31102 66863
+table3_40: .word 2624 38385 74146 9907 45668 81429 17190 52951 88712 24473 60234 95995 31756 67517 3278 39039
+table3_41: .word 74800 10561 46322 82083 17844 53605 89366 25127 60888 96649 32410 68171 3932 39693 75454 11215
+table3_42: .word 46976 82737 18498 54259 90020 25781 61542 97303 33064 68825 4586 40347 76108 11869 47630 83391
+table3_43: .word 19152 54913 90674 26435 62196 97957 33718 69479 5240 41001 76762 12523 48284 84045 19806 55567
+table3_44: .word 91328 27089 62850 98611 34372 70133 5894 41655 77416 13177 48938 84699 20460 56221 91982 27743
+table3_45: .word 63504 99265 35026 70787 6548 42309 78070 13831 49592 85353 21114 56875 92636 28397 64158 99919
+table3_46: .word 35680 71441 7202 42963 78724 14485 50246 86007 21768 57529 93290 29051 64812 573 36334 72095
+table3_47: .word 7856 43617 79378 15139 50900 86661 22422 58183 93944 29705 65466 1227 36988 72749 8510 44271
+table3_48: .word 80032 15793 51554 87315 23076 58837 94598 30359 66120 1881 37642 73403 9164 44925 80686 16447
+table3_49: .word 52208 87969 23730 59491 95252 31013 66774 2535 38296 74057 9818 45579 81340 17101 52862 88623
+table3_50: .word 24384 60145 95906 31667 67428 3189 38950 74711 10472 46233 81994 17755 53516 89277 25038 60799
+table3_51: .word 96560 32321 68082 3843 39604 75365 11126 46887 82648 18409 54170 89931 25692 61453 97214 32975
+table3_52: .word 68736 4497 40258 76019 11780 47541 83302 19063 54824 90585 26346 62107 97868 33629 69390 5151
+table3_53: .word 40912 76673 12434 48195 83956 19717 55478 91239 27000 62761 98522 34283 70044 5805 41566 77327
+table3_54: .word 13088 48849 84610 20371 56132 91893 27654 63415 99176 34937 70698 6459 42220 77981 13742 49503
+table3_55: .word 85264 21025 56786 92547 28308 64069 99830 35591 71352 7113 42874 78635 14396 50157 85918 21679
+table3_56: .word 57440 93201 28962 64723 484 36245 72006 7767 43528 79289 15050 50811 86572 22333 58094 93855
+table3_57: .word 29616 65377 1138 36899 72660 8421 44182 79943 15704 51465 87226 22987 58748 94509 30270 66031
+table3_58: .word 1792 37553 73314 9075 44836 80597 16358 52119 87880 23641 59402 95163 30924 66685 2446 38207
+table3_59: .word 73968 9729 45490 81251 17012 52773 88534 24295 60056 95817 31578 67339 3100 38861 74622 10383
+table3_60: .word 46144 81905 17666 53427 89188 24949 60710 96471 32232 67993 3754 39515 75276 11037 46798 82559
+table3_61: .word 18320 54081 89842 25603 61364 97125 32886 68647 4408 40169 75930 11691 47452 83213 18974 54735
+table3_62: .word 90496 26257 62018 97779 33540 69301 5062 40823 76584 12345 48106 83867 19628 55389 91150 26911
+table3_63: .word 62672 98433 34194 69955 5716 41477 77238 12999 48760 84521 20282 56043 91804 27565 63326 99087
+table3_64: .word 34848 70609 6370 42131 77892 13653 49414 85175 20936 56697 92458 28219 63980 99741 35502 71263
+table3_65: .word 7024 42785 78546 14307 50068 85829 21590 57351 93112 28873 64634 395 36156 71917 7678 43439
+table3_66: .word 79200 14961 50722 86483 22244 58005 93766 29527 65288 1049 36810 72571 8332 44093 79854 15615
+table3_67: .word 51376 87137 22898 58659 94420 30181 65942 1703 37464 73225 8986 44747 80508 16269 52030 87791
+table3_68: .word 23552 59313 95074 30835 66596 2357 38118 73879 9640 45401 81162 16923 52684 88445 24206 59967
+table3_69: .word 95728 31489 67250 3011 38772 74533 10294 46055 81816 17577 53338 89099 24860 60621 96382 32143
+table3_70: .word 67904 3665 39426 75187 10948 46709 82470 18231 53992 89753 25514 61275 97036 32797 68558 4319
+table3_71: .word 40080 75841 11602 47363 83124 18885 54646 90407 26168 61929 97690 33451 69212 4973 40734 76495
+table3_72: .word 12256 48017 83778 19539 55300 91061 26822 62583 98344 34105 69866 5627 41388 77149 12910 48671
+table3_73: .word 84432 20193 55954 91715 27476 63237 98998 34759 70520 6281 42042 77803 13564 49325 85086 20847
+table3_74: .word 56608 92369 28130 63891 99652 35413 71174 6935 42696 78457 14218 49979 85740 21501 57262 93023
+table3_75: .word 28784 64545 306 36067 71828 7589 43350 79111 14872 50633 86394 22155 57916 93677 29438 65199
+table3_76: .word 960 36721 72482 8243 44004 79765 15526 51287 87048 22809 58570 94331 30092 65853 1614 37375
+table3_77: .word 73136 8897 44658 80419 16180 51941 87702 23463 59224 94985 30746 66507 2268 38029 73790 9551
+table3_78: .word 45312 81073 16834 52595 88356 24117 59878 95639 31400 67161 2922 38683 74444 10205 45966 81727
+table3_79: .word 17488 53249 89010 24771 60532 96293 32054 67815 3576 39337 75098 10859 46620 82381 18142 53903
+table3_80: .word 89664 25425 61186 96947 32708 68469 4230 39991 75752 11513 47274 83035 18796 54557 90318 26079
+table3_81: .word 61840 97601 33362 69123 4884 40645 76406 12167 47928 83689 19450 55211 90972 26733 62494 98255
+table3_82: .word 34016 69777 5538 41299 77060 12821 48582 84343 20104 55865 91626 27387 63148 98909 34670 70431
+table3_83: .word 6192 41953 77714 13475 49236 84997 20758 56519 92280 28041 63802 99563 35324 71085 6846 42607
+table3_84: .word 78368 14129 49890 85651 21412 57173 92934 28695 64456 217 35978 71739 7500 43261 79022 14783
+table3_85: .word 50544 86305 22066 57827 93588 29349 65110 871 36632 72393 8154 43915 79676 15437 51198 86959
+table3_86: .word 22720 58481 94242 30003 65764 1525 37286 73047 8808 44569 80330 16091 51852 87613 23374 59135
+table3_87: .word 94896 30657 66418 2179 37940 73701 9462 45223 80984 16745 52506 88267 24028 59789 95550 31311
+table3_88: .word 67072 2833 38594 74355 10116 45877 81638 17399 53160 88921 24682 60443 96204 31965 67726 3487
+table3_89: .word 39248 75009 10770 46531 82292 18053 53814 89575 25336 61097 96858 32619 68380 4141 39902 75663
+table3_90: .word 11424 47185 82946 18707 54468 90229 25990 61751 97512 33273 69034 4795 40556 76317 12078 47839
+table3_91: .word 83600 19361 55122 90883 26644 62405 98166 33927 69688 5449 41210 76971 12732 48493 84254 20015
+table3_92: .word 55776 91537 27298 63059 98820 34581 70342 6103 41864 77625 13386 49147 84908 20669 56430 92191
+table3_93: .word 27952 63713 99474 35235 70996 6757 42518 78279 14040 49801 85562 21323 57084 92845 28606 64367
+table3_94: .word 128 35889 71650 7411 43172 78933 14694 50455 86216 21977 57738 93499 29260 65021 782 36543
+table3_95: .word 72304 8065 43826 79587 15348 51109 86870 22631 58392 94153 29914 65675 1436 37197 72958 8719
+table3_96: .word 44480 80241 16002 51763 87524 23285 59046 94807 30568 66329 2090 37851 73612 9373 45134 80895
+table3_97: .word 16656 52417 88178 23939 59700 95461 31222 66983 2744 38505 74266 10027 45788 81549 17310 53071
+table3_98: .word 88832 24593 60354 96115 31876 67637 3398 39159 74920 10681 46442 82203 17964 53725 89486 25247
+table3_99: .word 61008 96769 32530 68291 4052 39813 75574 11335 47096 82857 18618 54379 90140 25901 61662 97423
+table3_100: .word 33184 68945 4706 40467 76228 11989 47750 83511 19272 55033 90794 26555 62316 98077 33838 69599
+table3_101: .word 5360 41121 76882 12643 48404 84165 19926 55687 91448 27209 62970 98731 34492 70253 6014 41775
+table3_102: .word 77536 13297 49058 84819 20580 56341 92102 27863 63624 99385 35146 70907 6668 42429 78190 13951
+table3_103: .word 49712 85473 21234 56995 92756 28517 64278 39 35800 71561 7322 43083 78844 14605 50366 86127
+table3_104: .word 21888 57649 93410 29171 64932 693 36454 72215 7976 43737 79498 15259 51020 86781 22542 58303
+table3_105: .word 94064 29825 65586 1347 37108 72869 8630 44391 80152 15913 51674 87435 23196 58957 94718 30479
+table3_106: .word 66240 2001 37762 73523 9284 45045 80806 16567 52328 88089 23850 59611 95372 31133 66894 2655
+table3_107: .word 38416 74177 9938 45699 81460 17221 52982 88743 24504 60265 96026 31787 67548 3309 39070 74831
+table3_108: .word 10592 46353 82114 17875 53636 89397 25158 60919 96680 32441 68202 3963 39724 75485 11246 47007
+table3_109: .word 82768 18529 54290 90051 25812 61573 97334 33095 68856 4617 40378 76139 11900 47661 83422 19183
+table3_110: .word 54944 90705 26466 62227 97988 33749 69510 5271 41032 76793 12554 48315 84076 19837 55598 91359
+table3_111: .word 27120 62881 98642 34403 70164 5925 41686 77447 13208 48969 84730 20491 56252 92013 27774 63535
+table3_112: .word 99296 35057 70818 6579 42340 78101 13862 49623 85384 21145 56906 92667 28428 64189 99950 35711
+table3_113: .word 71472 7233 42994 78755 14516 50277 86038 21799 57560 93321 29082 64843 604 36365 72126 7887
+table3_114: .word 43648 79409 15170 50931 86692 22453 58214 93975 29736 65497 1258 37019 72780 8541 44302 80063
+table3_115: .word 15824 51585 87346 23107 58868 94629 30390 66151 1912 37673 73434 9195 44956 80717 16478 52239
+table3_116: .word 88000 23761 59522 95283 31044 66805 2566 38327 74088 9849 45610 81371 17132 52893 88654 24415
+table3_117: .word 60176 95937 31698 67459 3220 38981 74742 10503 46264 82025 17786 53547 89308 25069 60830 96591
+table3_118: .word 32352 68113 3874 39635 75396 11157 46918 82679 18440 54201 89962 25723 61484 97245 33006 68767
+table3_119: .word 4528 40289 76050 11811 47572 83333 19094 54855 90616 26377 62138 97899 33660 69421 5182 40943
+table3_120: .word 76704 12465 48226 83987 19748 55509 91270 27031 62792 98553 34314 70075 5836 41597 77358 13119
+table3_121: .word 48880 84641 20402 56163 91924 27685 63446 99207 34968 70729 6490 42251 78012 13773 49534 85295
+table3_122: .word 21056 56817 92578 28339 64100 99861 35622 71383 7144 42905 78666 14427 50188 85949 21710 57471
+table3_123: .word 93232 28993 64754 515 36276 72037 7798 43559 79320 15081 50842 86603 22364 58125 93886 29647
+table3_124: .word 65408 1169 36930 72691 8452 44213 79974 15735 51496 87257 23018 58779 94540 30301 66062 1823
+table3_125: .word 37584 73345 9106 44867 80628 16389 52150 87911 23672 59433 95194 30955 66716 2477 38238 73999
+table3_126: .word 9760 45521 81282 17043 52804 88565 24326 60087 95848 31609 67370 3131 38892 74653 10414 46175
+table3_127: .word 81936 17697 53458 89219 24980 60741 96502 32263 68024 3785 39546 75307 11068 46829 82590 18351
+.text
+    addi x22, x0, 0
+    addi x23, x0, 20            # passes
+pass:
+    lui x7, 0x10000
+    lui x6, 0x10008             # end of the four tables
+walk:
+    lw x8, 0(x7)
+    lw x9, 1024(x7)
+    add x10, x10, x8
+    xor x10, x10, x9
+    addi x7, x7, 4
+    blt x7, x6, walk
+    addi x22, x22, 1
+    blt x22, x23, pass
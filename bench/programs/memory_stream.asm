@@ -0,0 +1,27 @@
+# Load/store streams: copy and accumulate a 1 KiB array through word, half and byte accesses.
+.data
+src: .word 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16
+.text
+    lui x20, 0x10000            # source
+    lui x21, 0x10001            # destination
+    addi x22, x0, 0
+    addi x23, x0, 1000          # passes
+pass:
+    addi x5, x0, 0
+    addi x6, x0, 1024
+    add x7, x20, x0
+    add x8, x21, x0
+copy:
+    lw x9, 0(x7)
+    add x10, x10, x9
+    sw x10, 0(x8)
+    lh x11, 4(x7)
+    sh x11, 4(x8)
+    lb x12, 6(x7)
+    sb x12, 7(x8)
+    addi x7, x7, 8
+    addi x8, x8, 8
+    addi x5, x5, 8
+    blt x5, x6, copy
+    addi x22, x22, 1
+    blt x22, x23, pass
@@ -0,0 +1,25 @@
+# Recursive calls: naive fib(22) through jal/jalr with a stack frame per call.
+.text
+    addi x10, x0, 22
+    jal x1, fib
+    jal x0, end
+fib:
+    addi x5, x0, 2
+    blt x10, x5, leaf
+    addi x2, x2, -12
+    sw x1, 0(x2)
+    sw x10, 4(x2)
+    addi x10, x10, -1
+    jal x1, fib
+    sw x10, 8(x2)
+    lw x10, 4(x2)
+    addi x10, x10, -2
+    jal x1, fib
+    lw x6, 8(x2)
+    add x10, x10, x6
+    lw x1, 0(x2)
+    addi x2, x2, 12
+leaf:
+    jalr x0, x1, 0
+end:
+    addi x11, x10, 0
@@ -1,5 +1,17 @@
 /** @type {import('next').NextConfig} */
 const nextConfig = {
+    // Cross-origin isolation lets the simulator worker share its state buffer with the page.
+    async headers() {
+        return [
+            {
+                source: "/:path*",
+                headers: [
+                    { key: "Cross-Origin-Opener-Policy", value: "same-origin" },
+                    { key: "Cross-Origin-Embedder-Policy", value: "require-corp" },
+                ],
+            },
+        ];
+    },
     webpack(config) {
         config.module.rules.push({
             test: /\.svg$/,
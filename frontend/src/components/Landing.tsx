@@ -6,18 +6,11 @@ import Simulator from "@/components/Simulator";
 import { Sidebar } from "@/components/Sidebar";
 import { Github, Loader2, AlertCircle, AlertTriangle } from 'lucide-react';
 import { useState, useEffect } from "react";
-import { useSimulator } from '@/hooks/useSimulator';
-import Script from 'next/script';
+import { useSimulatorWorker } from '@/hooks/useSimulatorWorker';
 import { Card, CardContent } from "@/components/ui/card";
 import { Button } from "@/components/ui/button";
 import { useRouter } from "next/navigation";
 
-declare global {
-  interface Window {
-    simulatorScriptLoaded?: boolean;
-  }
-}
-
 export type SimulationControls = {
   pipelining: boolean;
   dataForwarding: boolean;
@@ -25,7 +18,7 @@ export type SimulationControls = {
 
 export default function Landing() {
   const router = useRouter();
-  const { simulator, loading, error } = useSimulator();
+  const { worker, loading, error } = useSimulatorWorker();
   const [activeTab, setActiveTab] = useState<"editor" | "simulator">("editor");
   const [isOpen, setIsOpen] = useState(false);
   const [isRunning, setIsRunning] = useState(false);
@@ -41,11 +34,6 @@ add x5,x1,x2 # 0110011-000-0000000-00101-00001-00010-NULL
 and x6,x3,x4 # 0110011-111-0000000-00110-00011-00100-NULL
 or x7,x5,x6 # 0110011-110-0000000-00111-00101-00110-NULL`);
 
-  const handleScriptLoad = () => {
-    window.simulatorScriptLoaded = true;
-    window.dispatchEvent(new Event('simulator-ready'));
-  };
-
   const handlePipelining = (enabled: boolean) => {
     setSimulationControls(prev => ({ ...prev, pipelining: enabled }));
     console.log('Pipelining:', enabled);
@@ -82,18 +70,9 @@ or x7,x5,x6 # 0110011-110-0000000-00111-00101-00110-NULL`);
     fetchSvg();
   }, []);
 
-  const scriptElement = (
-    <Script
-      src="/wasm/simulator.js"
-      strategy="afterInteractive"
-      onLoad={handleScriptLoad}
-    />
-  );
-
   if (loading) {
     return (
       <>
-        {scriptElement}
         <div className="h-screen flex items-center justify-center bg-gray-50 p-4">
           <Card className="w-full max-w-md shadow-lg">
             <CardContent className="p-6">
@@ -114,7 +93,6 @@ or x7,x5,x6 # 0110011-110-0000000-00111-00101-00110-NULL`);
   if (error) {
     return (
       <>
-        {scriptElement}
         <div className="h-screen flex items-center justify-center bg-gray-50 p-4">
           <Card className="w-full max-w-md border-red-300 shadow-lg">
             <CardContent className="p-6">
@@ -139,10 +117,9 @@ or x7,x5,x6 # 0110011-110-0000000-00111-00101-00110-NULL`);
     );
   }
 
-  if (!simulator) {
+  if (!worker) {
     return (
       <>
-        {scriptElement}
         <div className="h-screen flex items-center justify-center bg-gray-50 p-4">
           <Card className="w-full max-w-md border-amber-300 shadow-lg">
             <CardContent className="p-6">
@@ -172,7 +149,6 @@ or x7,x5,x6 # 0110011-110-0000000-00111-00101-00110-NULL`);
 
   return (
     <main className="h-screen w-screen bg-gray-50 flex justify-center items-center">
-      {scriptElement}
       <Link href="https://github.com/rit3sh-x/RISC-V-Aseembler" target="_blank">
         <Github className="fixed top-4 right-4 text-gray-500 hover:text-gray-700 transition-colors" />
       </Link>
@@ -208,7 +184,7 @@ or x7,x5,x6 # 0110011-110-0000000-00111-00101-00110-NULL`);
         ) : (
           <Simulator
             text={code}
-            simulatorInstance={simulator}
+            worker={worker}
             controls={simulationControls}
             onSidebarOpenChange={handleSidebarOpenChange}
             onRunningChange={handleRunningChange}
@@ -3,8 +3,9 @@
 import React, { useState, useEffect, useCallback, useMemo, memo } from "react"
 import { Tabs, TabsContent, TabsList, TabsTrigger } from "@/components/ui/tabs"
 import { Button } from "@/components/ui/button"
-import { RefreshCw, Play, StepForward, ChevronUp, ChevronDown, Hash, SquareCode } from "lucide-react"
-import type { Simulator as SimulatorType } from "@/types/simulator"
+import { RefreshCw, Play, Pause, StepForward, ChevronUp, ChevronDown, Hash, SquareCode } from "lucide-react"
+import type { SimulatorWorker } from "@/hooks/useSimulatorWorker"
+import type { SimulatorSnapshot } from "@/lib/simulatorSnapshot"
 import {
   Dialog,
   DialogContent,
@@ -75,7 +76,7 @@ interface UIResponse {
 
 interface SimulatorProps {
   text: string;
-  simulatorInstance: SimulatorType;
+  worker: SimulatorWorker;
   controls: SimulationControls;
   onSidebarOpenChange: (open: boolean) => void;
   onRunningChange: (running: boolean) => void;
@@ -291,7 +292,7 @@ interface TextMapEntry {
 
 export default function Simulator({
   text,
-  simulatorInstance,
+  worker,
   controls,
   onSidebarOpenChange,
   onRunningChange,
@@ -303,6 +304,7 @@ export default function Simulator({
   const [textMap, setTextMap] = useState<Record<string, { first: number, second: string }>>({});
   const [terminal, setTerminal] = useState<Record<string, string>>({});
   const [running, setRunning] = useState<boolean>(false);
+  const [batchRunning, setBatchRunning] = useState<boolean>(false);
   const [activeTab, setActiveTab] = useState<string>("registers");
   const [consoleActiveTab, setConsoleActiveTab] = useState<string>("pipeline");
   
@@ -361,35 +363,83 @@ export default function Simulator({
       description: errorMessage
     });
     setIsDialogOpen(true);
-    if (simulatorInstance) {
-      simulatorInstance.reset();
-    }
-  }, [simulatorInstance]);
-
-  const updateSimulatorState = useCallback(() => {
-    if (!simulatorInstance) return;
+    worker.reset(true);
+  }, [worker]);
 
-    setUIResponse(simulatorInstance.getUIResponse());
+  const applySnapshot = useCallback((snapshot: SimulatorSnapshot) => {
+    setUIResponse(snapshot.uiResponse);
 
-    const newTerminal = simulatorInstance.getLogs();
+    const newTerminal = snapshot.logs;
     setTerminal(newTerminal);
 
-    setRegisters(simulatorInstance.getRegisters());
-    setCycles(simulatorInstance.getCycles());
-    setDataMap(simulatorInstance.getDataMap());
-    setTextMap(simulatorInstance.getTextMap());
-    setStalls(simulatorInstance.getStalls());
-    setActiveStates(simulatorInstance.getActiveStages());
-    setRunning(simulatorInstance.isRunning());
-    setPipelineRegisters(simulatorInstance.getInstructionRegisters());
-    setInstruction(simulatorInstance.getPC());
-    setStats(simulatorInstance.getStats());
-    setPipelineDiag(simulatorInstance.getPipelineDiagramInfo());
+    setRegisters(snapshot.registers);
+    setCycles(snapshot.cycles);
+    setDataMap(snapshot.dataMap);
+    setTextMap(snapshot.textMap);
+    setStalls(snapshot.stalls);
+    setActiveStates(snapshot.activeStages);
+    setRunning(snapshot.running);
+    const { RA, RB, RM, RY, RZ } = snapshot.instructionRegisters;
+    setPipelineRegisters(new InstructionRegisters(RA, RB, RM, RY, RZ));
+    setInstruction(snapshot.pc);
+    setStats(snapshot.stats);
+    setPipelineDiag(snapshot.pipelineDiagramInfo);
     
     if (newTerminal["404"]) {
       setTimeout(() => showTerminalErrorDialog(newTerminal["404"]), 0);
     }
-  }, [simulatorInstance, showTerminalErrorDialog]);
+  }, [showTerminalErrorDialog]);
+
+  useEffect(() => {
+    return worker.subscribe((message) => {
+      switch (message.type) {
+        case "loaded":
+          if (message.success) {
+            toast.success("Program Loaded", { description: "RISC-V program loaded successfully.", });
+          } else {
+            toast.error("Load Failed", { description: "Failed to load program: " });
+          }
+          setBatchRunning(false);
+          applySnapshot(message.snapshot);
+          break;
+        case "state":
+          setBatchRunning(false);
+          applySnapshot(message.snapshot);
+          break;
+        case "stopped":
+          setBatchRunning(false);
+          applySnapshot(message.snapshot);
+          if (message.reason === "limit") {
+            toast.warning("Run Stopped", { description: "The cycle limit was reached." });
+          }
+          break;
+        case "error":
+          setBatchRunning(false);
+          toast.error("Simulator Error", { description: message.message });
+          break;
+      }
+    });
+  }, [worker, applySnapshot]);
+
+  // While the worker runs a batch, the view follows the state it publishes once per frame.
+  useEffect(() => {
+    if (!batchRunning) return;
+    let frame = 0;
+    const update = () => {
+      const live = worker.readLiveState();
+      if (live) {
+        setRegisters(live.registers);
+        setCycles(live.cycles);
+        setStalls(live.stalls);
+        setActiveStates(live.activeStages);
+        setInstruction(live.pc);
+        setRunning(live.running);
+      }
+      frame = requestAnimationFrame(update);
+    };
+    frame = requestAnimationFrame(update);
+    return () => cancelAnimationFrame(frame);
+  }, [batchRunning, worker]);
 
   const memoizedUpdateMemoryEntries = useMemo(() => {
     return () => {
@@ -458,20 +508,21 @@ export default function Simulator({
   }, [memoryStartIndex, isHex, textMap, dataMap]);
 
   const handleStep = useCallback(() => {
-    simulatorInstance.step();
-    updateSimulatorState();
-  }, [simulatorInstance, updateSimulatorState]);
+    worker.step();
+  }, [worker]);
 
   const resetRegistersAndMemory = useCallback(() => {
-    simulatorInstance.reset();
-    updateSimulatorState();
-    memoizedUpdateMemoryEntries();
-  }, [simulatorInstance, updateSimulatorState, memoizedUpdateMemoryEntries]);
+    worker.reset();
+  }, [worker]);
 
   const handleRun = useCallback(() => {
-    simulatorInstance.run();
-    updateSimulatorState();
-  }, [simulatorInstance, updateSimulatorState]);
+    setBatchRunning(true);
+    worker.run();
+  }, [worker]);
+
+  const handlePause = useCallback(() => {
+    worker.pause();
+  }, [worker]);
 
   useEffect(() => {
     if (uiResponse.isFlushed) {
@@ -498,18 +549,12 @@ export default function Simulator({
   }, [uiResponse.isProgramTerminated]);
 
   const handleAssemble = useCallback(() => {
-    const success = simulatorInstance.loadProgram(text);
-    if (success) {
-      toast.success("Program Loaded", { description: "RISC-V program loaded successfully.", });
-    } else {
-      toast.error("Load Failed", { description: "Failed to load program: " });
-    }
-    updateSimulatorState();
-  }, [text, simulatorInstance, updateSimulatorState]);
+    worker.load(text);
+  }, [text, worker]);
 
   useEffect(() => {
-    updateSimulatorState();
-  }, [updateSimulatorState]);
+    worker.refresh();
+  }, [worker]);
 
   useEffect(() => {
     memoizedUpdateMemoryEntries();
@@ -523,13 +568,11 @@ export default function Simulator({
   }, [running, onSidebarOpenChange, onRunningChange]);
 
   useEffect(() => {
-    if (!simulatorInstance) return;
-    simulatorInstance.setEnvironment(
+    worker.setEnvironment(
       controls.pipelining,
       controls.dataForwarding
     );
-    updateSimulatorState();
-  }, [controls.pipelining, controls.dataForwarding, simulatorInstance, updateSimulatorState]);
+  }, [controls.pipelining, controls.dataForwarding, worker]);
 
   const navigateMemoryUp = () => {
     setMemoryStartIndex(prev => Math.max(0, prev - ITEMS_PER_PAGE * 4));
@@ -716,20 +759,31 @@ export default function Simulator({
                         variant="outline"
                         size="sm"
                         onClick={handleStep}
-                        disabled={!running}
+                        disabled={!running || batchRunning}
                       >
                         <StepForward className="h-4 w-4 mr-2" />
                         Step
                       </Button>
-                      <Button
-                        variant="default"
-                        size="sm"
-                        onClick={handleRun}
-                        disabled={!running}
-                      >
-                        <Play className="h-4 w-4 mr-2" />
-                        Run
-                      </Button>
+                      {batchRunning ? (
+                        <Button
+                          variant="default"
+                          size="sm"
+                          onClick={handlePause}
+                        >
+                          <Pause className="h-4 w-4 mr-2" />
+                          Pause
+                        </Button>
+                      ) : (
+                        <Button
+                          variant="default"
+                          size="sm"
+                          onClick={handleRun}
+                          disabled={!running}
+                        >
+                          <Play className="h-4 w-4 mr-2" />
+                          Run
+                        </Button>
+                      )}
                     </div>
                   </div>
                 </div>
@@ -0,0 +1,106 @@
+import { useState, useEffect, useMemo, useRef } from 'react';
+import { clearLiveState, createSharedState, readLiveState, setPauseRequested, type LiveState } from '@/lib/sharedState';
+import type { WorkerRequest, WorkerResponse } from '@/lib/simulatorWorkerProtocol';
+
+export type SimulatorWorkerListener = (message: WorkerResponse) => void;
+
+export interface SimulatorWorker {
+  refresh(): void;
+  load(source: string): void;
+  step(): void;
+  run(maxCycles?: number): void;
+  pause(): void;
+  reset(silent?: boolean): void;
+  setEnvironment(pipeline: boolean, dataForwarding: boolean): void;
+  // Latest state published during a run: read straight from shared memory when the page is
+  // cross-origin isolated, otherwise the last 'live' message received.
+  readLiveState(): LiveState | null;
+  subscribe(listener: SimulatorWorkerListener): () => void;
+}
+
+export const useSimulatorWorker = () => {
+  const [ready, setReady] = useState(false);
+  const [loading, setLoading] = useState(true);
+  const [error, setError] = useState<string | null>(null);
+  const workerRef = useRef<Worker | null>(null);
+  const sharedRef = useRef<Int32Array | null>(null);
+  const liveRef = useRef<LiveState | null>(null);
+  const listenersRef = useRef(new Set<SimulatorWorkerListener>());
+
+  useEffect(() => {
+    let worker: Worker;
+    try {
+      worker = new Worker(new URL('../workers/simulator.worker.ts', import.meta.url));
+    } catch (err) {
+      console.error('Simulator worker error:', err);
+      setError(err instanceof Error ? err.message : 'Failed to start simulator worker');
+      setLoading(false);
+      return;
+    }
+
+    const shared = createSharedState();
+    sharedRef.current = shared ? new Int32Array(shared) : null;
+    workerRef.current = worker;
+
+    let initialized = false;
+    worker.onmessage = (event: MessageEvent<WorkerResponse>) => {
+      const message = event.data;
+      if (message.type === 'live') {
+        liveRef.current = message.state;
+        return;
+      }
+      if (message.type === 'ready') {
+        initialized = true;
+        setReady(true);
+        setLoading(false);
+      } else if (message.type === 'error' && !initialized) {
+        setError(message.message);
+        setLoading(false);
+      }
+      listenersRef.current.forEach((listener) => listener(message));
+    };
+    worker.onerror = (event) => {
+      console.error('Simulator worker error:', event.message);
+      setError(event.message || 'Failed to load simulator');
+      setLoading(false);
+    };
+
+    const init: WorkerRequest = { type: 'init', shared };
+    worker.postMessage(init);
+
+    return () => {
+      worker.terminate();
+      workerRef.current = null;
+      sharedRef.current = null;
+    };
+  }, []);
+
+  const worker = useMemo<SimulatorWorker>(() => {
+    const send = (request: WorkerRequest) => workerRef.current?.postMessage(request);
+    return {
+      refresh: () => send({ type: 'snapshot' }),
+      load: (source) => send({ type: 'load', source }),
+      step: () => send({ type: 'step' }),
+      run: (maxCycles) => {
+        liveRef.current = null;
+        if (sharedRef.current) clearLiveState(sharedRef.current);
+        send({ type: 'run', maxCycles });
+      },
+      pause: () => {
+        if (sharedRef.current) setPauseRequested(sharedRef.current, true);
+        send({ type: 'pause' });
+      },
+      reset: (silent) => send({ type: 'reset', silent }),
+      setEnvironment: (pipeline, dataForwarding) => send({ type: 'setEnvironment', pipeline, dataForwarding }),
+      readLiveState: () => (sharedRef.current ? readLiveState(sharedRef.current) : liveRef.current),
+      subscribe: (listener) => {
+        listenersRef.current.add(listener);
+        return () => {
+          listenersRef.current.delete(listener);
+        };
+      },
+    };
+  }, []);
+
+  return { worker: ready ? worker : null, loading, error };
+};
@@ -0,0 +1,130 @@
+// Int32 word layout of the buffer shared between the simulator worker and the page. The worker
+// bumps SEQUENCE to an odd value before writing and back to even afterwards; readers retry
+// while it is odd or changes underneath them. A SEQUENCE of 0 means nothing was published yet.
+export const SharedSlot = {
+  SEQUENCE: 0,
+  CONTROL: 1,
+  STATUS: 2,
+  PC: 3,
+  CYCLES: 4,
+  STALLS: 5,
+  STAGE_ACTIVE: 6,
+  STAGE_PC: 11,
+  REGISTERS: 16,
+  SIZE: 48,
+} as const;
+
+export const ControlFlag = {
+  PAUSE: 1,
+} as const;
+
+const STAGE_COUNT = 5;
+const REGISTER_COUNT = 32;
+const READ_ATTEMPTS = 8;
+
+export interface LiveState {
+  running: boolean;
+  pc: number;
+  cycles: number;
+  stalls: number;
+  activeStages: Record<number, { active: boolean, instruction: number }>;
+  registers: number[];
+}
+
+// SharedArrayBuffer is only exposed on cross-origin isolated pages (COOP/COEP headers).
+export const createSharedState = (): SharedArrayBuffer | null => {
+  if (typeof SharedArrayBuffer === 'undefined' || !globalThis.crossOriginIsolated) {
+    return null;
+  }
+  return new SharedArrayBuffer(SharedSlot.SIZE * Int32Array.BYTES_PER_ELEMENT);
+};
+
+// Word offsets into Simulator.getStateView(), see PipelineState in wasm.cpp.
+const StateWord = {
+  PC: 0,
+  CYCLES: 1,
+  STALLS: 2,
+  RUNNING: 3,
+  STAGE_ACTIVE: 4,
+  STAGE_PC: 9,
+} as const;
+
+// Reads the live fields straight from the engine's views. The views are copied here, since
+// they are invalidated when the WASM heap grows.
+export const liveStateFromViews = (state: Uint32Array, registers: Uint32Array): LiveState => {
+  const activeStages: LiveState['activeStages'] = {};
+  for (let stage = 0; stage < STAGE_COUNT; stage++) {
+    activeStages[stage] = {
+      active: state[StateWord.STAGE_ACTIVE + stage] !== 0,
+      instruction: state[StateWord.STAGE_PC + stage],
+    };
+  }
+  return {
+    running: state[StateWord.RUNNING] !== 0,
+    pc: state[StateWord.PC],
+    cycles: state[StateWord.CYCLES],
+    stalls: state[StateWord.STALLS],
+    activeStages,
+    registers: Array.from(registers),
+  };
+};
+
+export const writeLiveState = (words: Int32Array, state: LiveState) => {
+  const sequence = Atomics.add(words, SharedSlot.SEQUENCE, 1) + 1;
+  words[SharedSlot.STATUS] = state.running ? 1 : 0;
+  words[SharedSlot.PC] = state.pc;
+  words[SharedSlot.CYCLES] = state.cycles;
+  words[SharedSlot.STALLS] = state.stalls;
+  for (let stage = 0; stage < STAGE_COUNT; stage++) {
+    const entry = state.activeStages[stage];
+    words[SharedSlot.STAGE_ACTIVE + stage] = entry?.active ? 1 : 0;
+    words[SharedSlot.STAGE_PC + stage] = entry?.instruction ?? 0;
+  }
+  for (let reg = 0; reg < REGISTER_COUNT; reg++) {
+    words[SharedSlot.REGISTERS + reg] = state.registers[reg] ?? 0;
+  }
+  Atomics.store(words, SharedSlot.SEQUENCE, sequence + 1);
+};
+
+export const readLiveState = (words: Int32Array): LiveState | null => {
+  for (let attempt = 0; attempt < READ_ATTEMPTS; attempt++) {
+    const before = Atomics.load(words, SharedSlot.SEQUENCE);
+    if (before === 0) return null;
+    if (before & 1) continue;
+
+    const activeStages: LiveState['activeStages'] = {};
+    for (let stage = 0; stage < STAGE_COUNT; stage++) {
+      activeStages[stage] = {
+        active: words[SharedSlot.STAGE_ACTIVE + stage] !== 0,
+        instruction: words[SharedSlot.STAGE_PC + stage] >>> 0,
+      };
+    }
+    const state: LiveState = {
+      running: words[SharedSlot.STATUS] !== 0,
+      pc: words[SharedSlot.PC] >>> 0,
+      cycles: words[SharedSlot.CYCLES] >>> 0,
+      stalls: words[SharedSlot.STALLS] >>> 0,
+      activeStages,
+      registers: Array.from(words.subarray(SharedSlot.REGISTERS, SharedSlot.REGISTERS + REGISTER_COUNT)),
+    };
+    if (Atomics.load(words, SharedSlot.SEQUENCE) === before) {
+      return state;
+    }
+  }
+  return null;
+};
+
+export const clearLiveState = (words: Int32Array) => {
+  Atomics.store(words, SharedSlot.SEQUENCE, 0);
+};
+
+export const setPauseRequested = (words: Int32Array, paused: boolean) => {
+  if (paused) {
+    Atomics.or(words, SharedSlot.CONTROL, ControlFlag.PAUSE);
+  } else {
+    Atomics.and(words, SharedSlot.CONTROL, ~ControlFlag.PAUSE);
+  }
+};
+
+export const isPauseRequested = (words: Int32Array) =>
+  (Atomics.load(words, SharedSlot.CONTROL) & ControlFlag.PAUSE) !== 0;
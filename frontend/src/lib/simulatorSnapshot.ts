@@ -0,0 +1,39 @@
+import type { Simulator } from '@/types/simulator';
+
+type Snapshot<K extends keyof Simulator> = Simulator[K] extends () => infer R ? R : never;
+
+export interface SimulatorSnapshot {
+  uiResponse: Snapshot<'getUIResponse'>;
+  logs: Record<string, string>;
+  registers: number[];
+  cycles: number;
+  dataMap: Record<string, number>;
+  textMap: Record<string, { first: number, second: string }>;
+  stalls: number;
+  activeStages: Record<number, { active: boolean, instruction: number }>;
+  running: boolean;
+  instructionRegisters: { RA: number, RB: number, RM: number, RY: number, RZ: number };
+  pc: number;
+  stats: Snapshot<'getStats'>;
+  pipelineDiagramInfo: Snapshot<'getPipelineDiagramInfo'>;
+}
+
+// Plain-object copy of everything the simulator view renders, so it can cross postMessage.
+export const takeSnapshot = (sim: Simulator): SimulatorSnapshot => {
+  const registers = sim.getInstructionRegisters();
+  return {
+    uiResponse: { ...sim.getUIResponse() },
+    logs: sim.getLogs(),
+    registers: Array.from(sim.getRegisters()),
+    cycles: sim.getCycles(),
+    dataMap: sim.getDataMap(),
+    textMap: sim.getTextMap(),
+    stalls: sim.getStalls(),
+    activeStages: sim.getActiveStages(),
+    running: sim.isRunning(),
+    instructionRegisters: { RA: registers.RA, RB: registers.RB, RM: registers.RM, RY: registers.RY, RZ: registers.RZ },
+    pc: sim.getPC(),
+    stats: { ...sim.getStats() },
+    pipelineDiagramInfo: { ...sim.getPipelineDiagramInfo() },
+  };
+};
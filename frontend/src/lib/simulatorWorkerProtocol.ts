@@ -0,0 +1,24 @@
+import type { SimulatorSnapshot } from '@/lib/simulatorSnapshot';
+import type { LiveState } from '@/lib/sharedState';
+
+export type StopReason = 'paused' | 'finished' | 'limit';
+
+export type WorkerRequest =
+  | { type: 'init', shared: SharedArrayBuffer | null }
+  | { type: 'snapshot' }
+  | { type: 'load', source: string }
+  | { type: 'step' }
+  | { type: 'stepBack' }
+  | { type: 'seek', cycle: number }
+  | { type: 'run', maxCycles?: number }
+  | { type: 'pause' }
+  | { type: 'reset', silent?: boolean }
+  | { type: 'setEnvironment', pipeline: boolean, dataForwarding: boolean };
+
+export type WorkerResponse =
+  | { type: 'ready', shared: boolean }
+  | { type: 'loaded', success: boolean, snapshot: SimulatorSnapshot }
+  | { type: 'state', snapshot: SimulatorSnapshot }
+  | { type: 'live', state: LiveState }
+  | { type: 'stopped', reason: StopReason, snapshot: SimulatorSnapshot }
+  | { type: 'error', message: string };
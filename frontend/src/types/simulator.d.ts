@@ -48,12 +48,58 @@ declare namespace createSimulator {
     ExToBranch: boolean;
   }
 
+  export interface ProgramDiff {
+    success: boolean;
+    reencoded: number;
+    text: {
+      changed: { address: number, code: number, text: string }[];
+      removed: number[];
+    };
+    data: {
+      changed: { address: number, value: number }[];
+      removed: number[];
+    };
+  }
+
+  export interface DataPage {
+    base: number;
+    bytes: Uint8Array;
+  }
+
+  export interface DirtyRanges {
+    pagesChanged: boolean;
+    ranges: Uint32Array;
+  }
+
+  export interface RunSummary {
+    reason: 'cycleLimit' | 'terminated' | 'breakpoint' | 'watchpoint';
+    cycles: number;
+    address: number;
+    running: boolean;
+    state: Uint32Array;
+    dirty: DirtyRanges;
+  }
+
   export interface Simulator {
     loadProgram(input: string): boolean;
+    updateProgram(firstLine: number, removedLines: number, lines: string[]): ProgramDiff;
     step(): boolean;
     run(): void;
+    runCycles(cycles: number): RunSummary;
+    runUntil(breakpoints: number[], watchpoints: number[], maxCycles: number): RunSummary;
+    // Restore the closest checkpoint and re-simulate up to the previous / given cycle. False if
+    // there is no earlier state or the program ends first.
+    stepBack(): boolean;
+    seekCycle(cycle: number): boolean;
     reset(): void;
     getRegisters(): number[];
+    getRegisterView(): Uint32Array;
+    // Words: pc, cycles, stalls, running, stageActive[5], stagePC[5], RA, RB, RM, RY, RZ,
+    // isFlushed, isStalled, isDataForwarded, isProgramTerminated, ExExForwarding,
+    // MemMemForwarding, MemExForwarding, BranchToFetch, ExToBranch.
+    getStateView(): Uint32Array;
+    getDataPages(): DataPage[];
+    takeDirtyRanges(): DirtyRanges;
     getPC(): number;
     getCycles(): number;
     getDataMap(): Record<string, number>;
@@ -0,0 +1,177 @@
+import type { Simulator, SimulatorModuleInstance } from '@/types/simulator';
+import { takeSnapshot } from '@/lib/simulatorSnapshot';
+import { isPauseRequested, liveStateFromViews, setPauseRequested, writeLiveState, type LiveState } from '@/lib/sharedState';
+import type { StopReason, WorkerRequest, WorkerResponse } from '@/lib/simulatorWorkerProtocol';
+
+declare function importScripts(...urls: string[]): void;
+
+interface WorkerScope {
+  createSimulator?: (options: { locateFile: (path: string) => string }) => Promise<SimulatorModuleInstance>;
+  postMessage(message: WorkerResponse): void;
+  onmessage: ((event: MessageEvent<WorkerRequest>) => void) | null;
+}
+
+const scope = self as unknown as WorkerScope;
+
+// Same cap as MAX_STEPS in the engine, so a runaway program stops here too.
+const DEFAULT_MAX_CYCLES = 100000;
+// A run is executed in slices of about this many milliseconds; between slices the worker
+// publishes live state and yields so a pause message can be delivered.
+const SLICE_MS = 8;
+const CYCLES_PER_CALL = 256;
+
+let sim: Simulator | null = null;
+let shared: Int32Array | null = null;
+let pauseMessage = false;
+let runToken = 0;
+let queue: Promise<void> = Promise.resolve();
+
+const post = (message: WorkerResponse) => scope.postMessage(message);
+
+// Live state is a handful of words, so it is read from the state and register views rather than
+// a full snapshot: that would build the data and text maps on every slice and drain the log
+// map, whose entries the 'stopped' snapshot has to carry. Older builds use the plain getters.
+const liveState = (instance: Simulator): LiveState => {
+  if (typeof (instance as Partial<Simulator>).getStateView === 'function') {
+    return liveStateFromViews(instance.getStateView(), instance.getRegisterView());
+  }
+  return {
+    running: instance.isRunning(),
+    pc: instance.getPC(),
+    cycles: instance.getCycles(),
+    stalls: instance.getStalls(),
+    activeStages: instance.getActiveStages(),
+    registers: Array.from(instance.getRegisters()),
+  };
+};
+
+const publishLive = () => {
+  if (!sim) return;
+  const state = liveState(sim);
+  if (shared) {
+    writeLiveState(shared, state);
+  } else {
+    post({ type: 'live', state });
+  }
+};
+
+const pauseRequested = () => pauseMessage || (shared !== null && isPauseRequested(shared));
+
+const clearPause = () => {
+  pauseMessage = false;
+  if (shared) setPauseRequested(shared, false);
+};
+
+// The batched entry point is used when the loaded module has it; older builds only step.
+const advance = (instance: Simulator, cycles: number) => {
+  if (typeof (instance as Partial<Simulator>).runCycles === 'function') {
+    instance.runCycles(cycles);
+    return;
+  }
+  for (let i = 0; i < cycles && instance.isRunning(); i++) {
+    instance.step();
+  }
+};
+
+const yieldToEvents = () => new Promise<void>((resolve) => setTimeout(resolve, 0));
+
+const run = async (maxCycles: number) => {
+  if (!sim) return;
+  const token = ++runToken;
+  clearPause();
+  const limit = sim.getCycles() + maxCycles;
+  let reason: StopReason = 'finished';
+
+  while (sim.isRunning()) {
+    const sliceEnd = performance.now() + SLICE_MS;
+    while (sim.isRunning() && sim.getCycles() < limit && performance.now() < sliceEnd) {
+      advance(sim, Math.min(CYCLES_PER_CALL, limit - sim.getCycles()));
+    }
+    if (sim.isRunning() && sim.getCycles() >= limit) {
+      reason = 'limit';
+      break;
+    }
+    publishLive();
+    await yieldToEvents();
+    if (token !== runToken || pauseRequested()) {
+      reason = 'paused';
+      break;
+    }
+  }
+  clearPause();
+  if (token === runToken) {
+    post({ type: 'stopped', reason, snapshot: takeSnapshot(sim) });
+  }
+};
+
+const handle = async (request: WorkerRequest) => {
+  if (request.type === 'init') {
+    shared = request.shared ? new Int32Array(request.shared) : null;
+    importScripts('/wasm/simulator.js');
+    if (!scope.createSimulator) {
+      throw new Error('createSimulator function not found in worker scope');
+    }
+    const module = await scope.createSimulator({ locateFile: (path) => '/wasm/' + path });
+    sim = new module.Simulator();
+    post({ type: 'ready', shared: shared !== null });
+    post({ type: 'state', snapshot: takeSnapshot(sim) });
+    return;
+  }
+  if (!sim) {
+    throw new Error('Simulator is not initialized');
+  }
+
+  switch (request.type) {
+    case 'load': {
+      const success = sim.loadProgram(request.source);
+      post({ type: 'loaded', success, snapshot: takeSnapshot(sim) });
+      break;
+    }
+    case 'step':
+      sim.step();
+      post({ type: 'state', snapshot: takeSnapshot(sim) });
+      break;
+    case 'stepBack':
+      sim.stepBack();
+      post({ type: 'state', snapshot: takeSnapshot(sim) });
+      break;
+    case 'seek':
+      sim.seekCycle(request.cycle);
+      post({ type: 'state', snapshot: takeSnapshot(sim) });
+      break;
+    case 'run':
+      await run(request.maxCycles ?? DEFAULT_MAX_CYCLES);
+      break;
+    case 'reset':
+      sim.reset();
+      if (!request.silent) {
+        post({ type: 'state', snapshot: takeSnapshot(sim) });
+      }
+      break;
+    case 'setEnvironment':
+      sim.setEnvironment(request.pipeline, request.dataForwarding);
+      post({ type: 'state', snapshot: takeSnapshot(sim) });
+      break;
+  }
+};
+
+// Requests are handled in arrival order, except pause and snapshot: those have to reach a run
+// that is still in progress, so they are answered between slices. Any other request ends a run
+// in progress; its own reply carries the new state.
+scope.onmessage = (event) => {
+  const request = event.data;
+  if (request.type === 'pause') {
+    pauseMessage = true;
+    return;
+  }
+  if (request.type === 'snapshot') {
+    if (sim) post({ type: 'state', snapshot: takeSnapshot(sim) });
+    return;
+  }
+  if (request.type !== 'run' && request.type !== 'init') {
+    runToken++;
+  }
+  queue = queue.then(() => handle(request)).catch((err: unknown) => {
+    post({ type: 'error', message: err instanceof Error ? err.message : String(err) });
+  });
+};
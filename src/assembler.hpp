@@ -9,304 +9,296 @@
 #include <utility>
 #include <vector>
 #include "types.hpp"
+#include "encoding.hpp"
+#include "parallel.hpp"
+#include "diagnostics.hpp"
 
 using namespace riscv;
 
+// Like the parser, errors are collected in getDiagnostics() rather than thrown; an instruction
+// that cannot be encoded is reported and left out of the machine code.
 class Assembler {
 public:
     explicit Assembler(std::unordered_map<std::string, SymbolEntry> symbolTable, 
         std::vector<ParsedInstruction> parsedInstructions) 
-        : errorCount(0), 
-        symTable(std::move(symbolTable)), 
+        : symTable(std::move(symbolTable)), 
         parseInstructions(std::move(parsedInstructions)) {}
 
-    inline bool assemble();
+    inline bool assemble(size_t threads = 1);
+    inline uint32_t encodeInstruction(const ParsedInstruction& inst, Diagnostics& into) const;
 
     inline const std::vector<std::pair<uint32_t, uint32_t>>& getMachineCode() const { return machineCode; }
     
-    inline size_t getErrorCount() const { return errorCount; }
+    inline size_t getErrorCount() const { return diagnostics.size(); }
+    inline const Diagnostics& getDiagnostics() const { return diagnostics; }
 
 private:
-    mutable size_t errorCount;
+    Diagnostics diagnostics;
 
     std::unordered_map<std::string, SymbolEntry> symTable;
 
     std::vector<std::pair<uint32_t, uint32_t>> machineCode;
     std::vector<ParsedInstruction> parseInstructions;
 
-    inline bool generateIType(const std::string& opcode, const std::vector<std::string>& operands, uint32_t currentAddress);
-    inline bool generateUType(const std::string& opcode, const std::vector<std::string>& operands, uint32_t currentAddress);
+    inline uint32_t generateRType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const;
+    inline uint32_t generateIType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const;
+    inline uint32_t generateSType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const;
+    inline uint32_t generateSBType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const;
+    inline uint32_t generateUType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const;
+    inline uint32_t generateUJType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const;
 
-    inline uint32_t generateRType(const std::string& opcode, const std::vector<std::string>& operands);
-    inline uint32_t generateSType(const std::string& opcode, const std::vector<std::string>& operands);
-    inline uint32_t generateSBType(const std::string& opcode, const std::vector<std::string>& operands, uint32_t currentAddress);
-    inline uint32_t generateUJType(const std::string& opcode, const std::vector<std::string>& operands, uint32_t currentAddress);
-    inline uint32_t calculateRelativeOffset(uint32_t currentAddress, uint32_t targetAddress) const;
+    inline int32_t registerOperand(const ParsedInstruction& inst, size_t slot) const;
+    inline int32_t immediateOperand(const ParsedInstruction& inst, size_t slot, const char* type, Diagnostics& into) const;
     
-    inline void reportError(const std::string& message) const;
-    inline void processTextSegment();
-    inline void processDataSegment();
+    static inline void reportError(Diagnostics& into, const std::string& message, int lineNumber = 0);
+    inline void processTextSegment(size_t threads);
+    inline void processDataSegment(size_t threads);
+
+    static constexpr size_t MIN_CHUNK_ITEMS = 4096;
+
+    static inline size_t dataSize(const SymbolEntry& entry);
+    static inline void emitData(const SymbolEntry& entry, std::pair<uint32_t, uint32_t>* out);
 };
 
-inline bool Assembler::assemble() {
+// Text words come first in address order, followed by the data bytes in address order. Both are
+// written into place by chunk, so no sort over the output is needed.
+inline bool Assembler::assemble(size_t threads) {
     machineCode.clear();
-    processTextSegment();
-    processDataSegment();
-    return errorCount == 0;
+    diagnostics.clear();
+    processTextSegment(threads);
+    processDataSegment(threads);
+    return diagnostics.empty();
 }
 
-inline void Assembler::processTextSegment() {
-    uint32_t currentAddress = TEXT_SEGMENT_START;
-
-    for (const auto &inst : parseInstructions) {
-        if (RTypeInstructions::getEncoding().opcodeMap.count(inst.opcode)) {
-            machineCode.push_back({currentAddress, generateRType(inst.opcode, inst.operands)});
-        }
-        else if (ITypeInstructions::getEncoding().opcodeMap.count(inst.opcode)) {
-            generateIType(inst.opcode, inst.operands, currentAddress);
-        }
-        else if (STypeInstructions::getEncoding().opcodeMap.count(inst.opcode)) {
-            machineCode.push_back({currentAddress, generateSType(inst.opcode, inst.operands)});
+// The parser hands the instructions over in address order, so the words come out sorted. Slots
+// of instructions that failed to encode are squeezed out afterwards.
+inline void Assembler::processTextSegment(size_t threads) {
+    machineCode.resize(parseInstructions.size());
+    std::vector<uint8_t> encoded(parseInstructions.size(), 0);
+    auto ranges = splitRange(parseInstructions.size(), chunkCount(parseInstructions.size(), threads, MIN_CHUNK_ITEMS));
+    std::vector<Diagnostics> partDiagnostics(ranges.size());
+    parallelRun(ranges.size(), threads, [&](size_t r) {
+        for (size_t i = ranges[r].first; i < ranges[r].second; i++) {
+            const ParsedInstruction& inst = parseInstructions[i];
+            if (inst.instruction == Instructions::INVALID) {
+                reportError(partDiagnostics[r], "Invalid instruction at address " + std::to_string(inst.address), inst.lineNumber);
+                continue;
+            }
+            size_t errors = partDiagnostics[r].size();
+            uint32_t word = encodeInstruction(inst, partDiagnostics[r]);
+            if (partDiagnostics[r].size() != errors) continue;
+            machineCode[i] = {inst.address, word};
+            encoded[i] = 1;
         }
-        else if (SBTypeInstructions::getEncoding().opcodeMap.count(inst.opcode)) {
-            machineCode.push_back({currentAddress, generateSBType(inst.opcode, inst.operands, currentAddress)});
+    });
+    bool failed = false;
+    for (Diagnostics& part : partDiagnostics) {
+        failed = failed || !part.empty();
+        diagnostics.append(std::move(part));
+    }
+    if (failed) {
+        size_t kept = 0;
+        for (size_t i = 0; i < machineCode.size(); i++) {
+            if (encoded[i]) machineCode[kept++] = machineCode[i];
         }
-        else if (UTypeInstructions::getEncoding().opcodeMap.count(inst.opcode)) {
-            generateUType(inst.opcode, inst.operands, currentAddress);
+        machineCode.resize(kept);
+    }
+}
+
+inline uint32_t Assembler::encodeInstruction(const ParsedInstruction& inst, Diagnostics& into) const {
+    const InstructionFormat& format = getInstructionFormat(inst.instruction);
+    switch (format.type) {
+        case InstructionType::R: return generateRType(format, inst, into);
+        case InstructionType::I: return generateIType(format, inst, into);
+        case InstructionType::S: return generateSType(format, inst, into);
+        case InstructionType::SB: return generateSBType(format, inst, into);
+        case InstructionType::U: return generateUType(format, inst, into);
+        case InstructionType::UJ: return generateUJType(format, inst, into);
+    }
+    return 0;
+}
+
+inline size_t Assembler::dataSize(const SymbolEntry& entry) {
+    if (entry.isString) {
+        bool terminate = entry.stringValue.empty() || entry.stringValue.back() != '\0';
+        return entry.stringValue.length() + (terminate ? 1 : 0);
+    }
+    uint32_t size = getDirectiveSize(entry.directive);
+    bool supported = size == 1 || size == 2 || size == 4 || size == 8;
+    return supported ? size * entry.numericValues.size() : 0;
+}
+
+inline void Assembler::emitData(const SymbolEntry& entry, std::pair<uint32_t, uint32_t>* out) {
+    uint32_t addr = entry.address;
+    if (entry.isString) {
+        for (size_t i = 0; i < entry.stringValue.length(); i++) {
+            *out++ = {addr + i, static_cast<uint8_t>(entry.stringValue[i])};
         }
-        else if (UJTypeInstructions::getEncoding().opcodeMap.count(inst.opcode)) {
-            machineCode.push_back({currentAddress, generateUJType(inst.opcode, inst.operands, currentAddress)});
+        if (entry.stringValue.empty() || entry.stringValue.back() != '\0') {
+            *out++ = {addr + entry.stringValue.length(), 0};
         }
-        else {
-            reportError("Unknown instruction type for opcode: " + inst.opcode);
-            continue;
+        return;
+    }
+    if (dataSize(entry) == 0) return;
+    uint32_t size = getDirectiveSize(entry.directive);
+    for (uint64_t value : entry.numericValues) {
+        for (uint32_t byte = 0; byte < size; byte++) {
+            *out++ = {addr + byte, static_cast<uint32_t>((value >> (8 * byte)) & 0xFF)};
         }
-        currentAddress += 4;
+        addr += size;
     }
 }
 
-inline void Assembler::processDataSegment() {
+// Data symbols never overlap, so ordering the symbols (not the bytes) by address and writing each
+// one at its offset yields the bytes in address order.
+inline void Assembler::processDataSegment(size_t threads) {
+    std::vector<const std::pair<const std::string, SymbolEntry>*> symbols;
     for (const auto &pair : symTable) {
-        const auto &entry = pair.second;
-        if (entry.address >= DATA_SEGMENT_START) {
-            uint32_t addr = entry.address;
+        if (pair.second.address >= DATA_SEGMENT_START) {
+            symbols.push_back(&pair);
+        }
+    }
+    std::sort(symbols.begin(), symbols.end(), [](const auto* a, const auto* b) {
+        return a->second.address != b->second.address ? a->second.address < b->second.address : a->first < b->first;
+    });
 
-            if (entry.isString) {
-                for (size_t i = 0; i < entry.stringValue.length(); i++) {
-                    machineCode.push_back({addr + i, static_cast<uint8_t>(entry.stringValue[i])});
-                }
-                if (entry.stringValue.empty() || entry.stringValue.back() != '\0') {
-                    machineCode.push_back({addr + entry.stringValue.length(), 0});
-                }
-            }
-            else {
-                for (const auto &value : entry.numericValues) {
-                    const auto directiveSize = getDirectiveSize(entry.directive);
-                    if (directiveSize == 1) {
-                        machineCode.push_back({addr, value & 0xFF});
-                        addr += 1;
-                    } else if (directiveSize == 2) {
-                        machineCode.push_back({addr, value & 0xFF});
-                        machineCode.push_back({addr + 1, (value >> 8) & 0xFF});
-                        addr += 2;
-                    } else if (directiveSize == 4) {
-                        machineCode.push_back({addr, value & 0xFF});
-                        machineCode.push_back({addr + 1, (value >> 8) & 0xFF});
-                        machineCode.push_back({addr + 2, (value >> 16) & 0xFF});
-                        machineCode.push_back({addr + 3, (value >> 24) & 0xFF});
-                        addr += 4;
-                    } else if (directiveSize == 8) {
-                        machineCode.push_back({addr, value & 0xFF});
-                        machineCode.push_back({addr + 1, (value >> 8) & 0xFF});
-                        machineCode.push_back({addr + 2, (value >> 16) & 0xFF});
-                        machineCode.push_back({addr + 3, (value >> 24) & 0xFF});
-                        machineCode.push_back({addr + 4, (value >> 32) & 0xFF});
-                        machineCode.push_back({addr + 5, (value >> 40) & 0xFF});
-                        machineCode.push_back({addr + 6, (value >> 48) & 0xFF});
-                        machineCode.push_back({addr + 7, (value >> 56) & 0xFF});
-                        addr += 8;
-                    }
-                }
-            }
+    std::vector<size_t> offsets(symbols.size() + 1, machineCode.size());
+    for (size_t i = 0; i < symbols.size(); i++) {
+        offsets[i + 1] = offsets[i] + dataSize(symbols[i]->second);
+    }
+    machineCode.resize(offsets.back());
+
+    auto ranges = splitRange(symbols.size(), chunkCount(offsets.back() - offsets.front(), threads, MIN_CHUNK_ITEMS));
+    parallelRun(ranges.size(), threads, [&](size_t r) {
+        for (size_t i = ranges[r].first; i < ranges[r].second; i++) {
+            emitData(symbols[i]->second, machineCode.data() + offsets[i]);
         }
+    });
+}
+
+inline int32_t Assembler::registerOperand(const ParsedInstruction& inst, size_t slot) const {
+    return inst.isRegister(slot) ? inst.operands[slot] : -1;
+}
+
+inline int32_t Assembler::immediateOperand(const ParsedInstruction& inst, size_t slot, const char* type, Diagnostics& into) const {
+    if (inst.isRegister(slot)) {
+        reportError(into, std::string("Expected an immediate operand in ") + type + "-type instruction", inst.lineNumber);
+        return 0;
     }
-    std::sort(machineCode.begin(), machineCode.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    const Relocation& reloc = inst.relocation;
+    if (reloc.kind != Relocation::Kind::NONE && reloc.slot == slot) {
+        return static_cast<int32_t>(reloc.kind == Relocation::Kind::PC_RELATIVE ? reloc.target - inst.address : reloc.target);
+    }
+    return inst.operands[slot];
 }
 
-inline uint32_t Assembler::generateRType(const std::string &opcode, const std::vector<std::string> &operands) {
-    const auto& encoding = RTypeInstructions::getEncoding();
-    uint32_t opcodeVal = encoding.opcodeMap.at(opcode);
-    uint32_t funct3 = encoding.func3Map.at(opcode);
-    uint32_t funct7 = encoding.func7Map.at(opcode);
-    
-    int32_t rd = getRegisterNumber(operands[0]);
-    int32_t rs1 = getRegisterNumber(operands[1]);
-    int32_t rs2 = getRegisterNumber(operands[2]);
+inline uint32_t Assembler::generateRType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const {
+    int32_t rd = registerOperand(inst, 0);
+    int32_t rs1 = registerOperand(inst, 1);
+    int32_t rs2 = registerOperand(inst, 2);
     
     if (rd < 0 || rs1 < 0 || rs2 < 0 || rd > 31 || rs1 > 31 || rs2 > 31) {
-        throw std::runtime_error(std::string(RED) + "Invalid register in R-type instruction" + RESET);
+        reportError(into, "Invalid register in R-type instruction", inst.lineNumber);
+        return 0;
     }
     
-    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcodeVal;
+    return encodeRType(format, rd, rs1, rs2);
 }
 
-inline bool Assembler::generateIType(const std::string &opcode, const std::vector<std::string> &operands, uint32_t currentAddress) {
-    if (operands.size() != 3) {
-        throw std::runtime_error(std::string(RED) + "I-type instruction requires 3 operands" + RESET);
+inline uint32_t Assembler::generateIType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const {
+    if (inst.operandCount != 3) {
+        reportError(into, "I-type instruction requires 3 operands", inst.lineNumber);
+        return 0;
     }
     
-    const auto& encoding = ITypeInstructions::getEncoding();
-    uint32_t opcodeVal = encoding.opcodeMap.at(opcode);
-    uint32_t funct3 = encoding.func3Map.at(opcode);
-    
-    int32_t rd = getRegisterNumber(operands[0]);
+    int32_t rd = registerOperand(inst, 0);
     int32_t rs1;
     int32_t imm;
     
-    if (opcode == "lb" || opcode == "lh" || opcode == "lw" || opcode == "lbu" || opcode == "lhu" || opcode == "ld") {
-        std::string offset, baseReg;
-        if (isMemory(operands[1], offset, baseReg)) {
-            rs1 = getRegisterNumber(baseReg);
-            imm = parseImmediate(offset);
-        }
-        else {
-            imm = parseImmediate(operands[1]);
-            rs1 = getRegisterNumber(operands[2]);
-        }
+    if (isLoadFormat(format)) {
+        imm = immediateOperand(inst, 1, "I", into);
+        rs1 = registerOperand(inst, 2);
     }
     else {
-        rs1 = getRegisterNumber(operands[1]);
-        imm = parseImmediate(operands[2]);
+        rs1 = registerOperand(inst, 1);
+        imm = immediateOperand(inst, 2, "I", into);
     }
     
     if (rd < 0 || rs1 < 0) {
-        throw std::runtime_error(std::string(RED) + "Invalid register in I-type instruction" + RESET);
-    }
-    
-    if ((opcode == "slli" || opcode == "srli" || opcode == "srai") && (imm < 0 || imm > 31)) {
-        throw std::runtime_error(std::string(RED) + "Shift amount must be between 0 and 31" + RESET);
+        reportError(into, "Invalid register in I-type instruction", inst.lineNumber);
+        return 0;
     }
     
     if (imm < -2048 || imm > 2047) {
-        throw std::runtime_error(std::string(RED) + "Immediate value out of range for I-type instruction (-2048 to 2047)" + RESET);
-    }
-    
-    uint32_t funct7 = (opcode == "srai") ? 0b0100000 : 0;
-    if (encoding.func7Map.count(opcode)) {
-        funct7 = encoding.func7Map.at(opcode);
+        reportError(into, "Immediate value out of range for I-type instruction (-2048 to 2047)", inst.lineNumber);
+        return 0;
     }
     
-    uint32_t instruction = (funct7 << 25) | ((imm & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcodeVal;
-    machineCode.push_back({currentAddress, instruction});
-    return true;
+    return encodeIType(format, rd, rs1, imm);
 }
 
-inline uint32_t Assembler::generateSType(const std::string &opcode, const std::vector<std::string> &operands) {
-    const auto& encoding = STypeInstructions::getEncoding();
-    uint32_t opcodeVal = encoding.opcodeMap.at(opcode);
-    uint32_t funct3 = encoding.func3Map.at(opcode);
-    
-    int32_t rs2 = getRegisterNumber(operands[0]);
-    int32_t rs1, imm;
-    
-    if (operands.size() == 2) {
-        std::string offset, reg;
-        if (!isMemory(operands[1], offset, reg)) {
-            throw std::runtime_error(std::string(RED) + "Invalid memory operand format" + RESET);
-        }
-        imm = parseImmediate(offset);
-        rs1 = getRegisterNumber(reg);
-    }
-    else if (operands.size() == 3) {
-        imm = parseImmediate(operands[1]);
-        rs1 = getRegisterNumber(operands[2]);
-    }
-    else {
-        throw std::runtime_error(std::string(RED) + "Invalid number of operands for S-type instruction" + RESET);
+inline uint32_t Assembler::generateSType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const {
+    if (inst.operandCount != 3) {
+        reportError(into, "Invalid number of operands for S-type instruction", inst.lineNumber);
+        return 0;
     }
+
+    int32_t rs2 = registerOperand(inst, 0);
+    int32_t imm = immediateOperand(inst, 1, "S", into);
+    int32_t rs1 = registerOperand(inst, 2);
     
     if (rs1 < 0 || rs2 < 0 || rs1 > 31 || rs2 > 31 || imm < -2048 || imm > 2047) {
-        throw std::runtime_error(std::string(RED) + "Invalid parameter in S-type instruction" + RESET);
+        reportError(into, "Invalid parameter in S-type instruction", inst.lineNumber);
+        return 0;
     }
     
-    uint32_t imm_11_5 = ((imm >> 5) & 0x7F) << 25;
-    uint32_t imm_4_0 = (imm & 0x1F) << 7;
-    
-    return imm_11_5 | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | imm_4_0 | opcodeVal;
+    return encodeSType(format, rs1, rs2, imm);
 }
 
-inline uint32_t Assembler::generateSBType(const std::string &opcode, const std::vector<std::string> &operands, uint32_t currentAddress) {
-    const auto& encoding = SBTypeInstructions::getEncoding();
-    uint32_t opcodeVal = encoding.opcodeMap.at(opcode);
-    uint32_t funct3 = encoding.func3Map.at(opcode);
-    
-    int32_t rs1 = getRegisterNumber(operands[0]);
-    int32_t rs2 = getRegisterNumber(operands[1]);
-    int32_t offset = (operands[2].find("0x") == 0 || operands[2].find("0b") == 0 ||
-                    std::all_of(operands[2].begin(), operands[2].end(), ::isdigit) ||
-                    operands[2][0] == '-')
-                        ? parseImmediate(operands[2])
-                        : calculateRelativeOffset(currentAddress, std::stoul(operands[2], nullptr, 0));
+inline uint32_t Assembler::generateSBType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const {
+    int32_t rs1 = registerOperand(inst, 0);
+    int32_t rs2 = registerOperand(inst, 1);
+    int32_t offset = immediateOperand(inst, 2, "SB", into);
     
     if (rs1 < 0 || rs2 < 0 || rs1 > 31 || rs2 > 31 || offset < -4096 || offset > 4095 || offset & 1) {
-        throw std::runtime_error(std::string(RED) + "Invalid parameter in SB-type instruction" + RESET);
+        reportError(into, "Invalid parameter in SB-type instruction", inst.lineNumber);
+        return 0;
     }
     
-    return ((offset < 0 ? 1 : (offset >> 12) & 0x1) << 31) | ((offset >> 11 & 0x1) << 7) | 
-           ((offset >> 5 & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | 
-           ((offset >> 1 & 0xF) << 8) | opcodeVal;
+    return encodeSBType(format, rs1, rs2, offset);
 }
 
-inline bool Assembler::generateUType(const std::string &opcode, const std::vector<std::string> &operands, uint32_t currentAddress) {
-    if (operands.size() != 2) {
-        throw std::runtime_error(std::string(RED) + "U-type instruction requires 2 operands" + RESET);
+inline uint32_t Assembler::generateUType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const {
+    if (inst.operandCount != 2) {
+        reportError(into, "U-type instruction requires 2 operands", inst.lineNumber);
+        return 0;
     }
     
-    const auto& encoding = UTypeInstructions::getEncoding();
-    uint32_t opcodeVal = encoding.opcodeMap.at(opcode);
-    
-    int32_t rd = getRegisterNumber(operands[0]);
-    int32_t imm = parseImmediate(operands[1]);
+    int32_t rd = registerOperand(inst, 0);
+    int32_t imm = immediateOperand(inst, 1, "U", into);
     
     if (rd < 0 || imm < 0 || imm > 0xFFFFF) {
-        throw std::runtime_error(std::string(RED) + "Invalid parameter in U-type instruction" + RESET);
+        reportError(into, "Invalid parameter in U-type instruction", inst.lineNumber);
+        return 0;
     }
     
-    uint32_t instruction = ((imm & 0xFFFFF) << 12) | (rd << 7) | opcodeVal;
-    machineCode.push_back({currentAddress, instruction});
-    return true;
+    return encodeUType(format, rd, imm);
 }
 
-inline uint32_t Assembler::generateUJType(const std::string &opcode, const std::vector<std::string> &operands, uint32_t currentAddress) {
-    const auto& encoding = UJTypeInstructions::getEncoding();
-    uint32_t opcodeVal = encoding.opcodeMap.at(opcode);
-    
-    int32_t rd = getRegisterNumber(operands[0]);
-    int32_t offset = (operands[1].find("0x") == 0 || operands[1].find("0b") == 0 ||
-                    std::all_of(operands[1].begin(), operands[1].end(), ::isdigit) ||
-                    operands[1][0] == '-')
-                        ? parseImmediate(operands[1])
-                        : calculateRelativeOffset(currentAddress, std::stoul(operands[1], nullptr, 0));
+inline uint32_t Assembler::generateUJType(const InstructionFormat& format, const ParsedInstruction& inst, Diagnostics& into) const {
+    int32_t rd = registerOperand(inst, 0);
+    int32_t offset = immediateOperand(inst, 1, "UJ", into);
     
     if (rd < 0 || rd > 31 || offset < -1048576 || offset > 1048575 || offset & 1) {
-        throw std::runtime_error(std::string(RED) + "Invalid parameter in UJ-type instruction" + RESET);
+        reportError(into, "Invalid parameter in UJ-type instruction", inst.lineNumber);
+        return 0;
     }
     
-    return (((offset >> 20) & 0x1) << 31) | (((offset >> 1) & 0x3FF) << 21) | (((offset >> 11) & 0x1) << 20) |
-           (((offset >> 12) & 0xFF) << 12) | (rd << 7) | opcodeVal;
+    return encodeUJType(format, rd, offset);
 }
 
-inline void Assembler::reportError(const std::string &message) const {
-    throw std::runtime_error(std::string(RED) + "Assembler Error: " + message + RESET);
-    ++errorCount;
-}
-
-inline uint32_t Assembler::calculateRelativeOffset(uint32_t currentAddress, uint32_t targetAddress) const {
-    int32_t offset = static_cast<int32_t>(targetAddress - currentAddress);
-    if (currentAddress == 0 || targetAddress == 0 || offset < -4096 || offset > 4095) {
-        throw std::runtime_error(std::string(RED) + "Invalid offset calculation" + RESET);
-    }
-    return offset;
+inline void Assembler::reportError(Diagnostics& into, const std::string &message, int lineNumber) {
+    into.error(DiagnosticSource::ASSEMBLER, message, lineNumber);
 }
 
 #endif
\ No newline at end of file
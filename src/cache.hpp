@@ -0,0 +1,287 @@
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "types.hpp"
+
+using namespace riscv;
+
+enum class ReplacementPolicy { LRU, PLRU, RANDOM };
+enum class WritePolicy { WRITE_BACK, WRITE_THROUGH };
+
+inline constexpr uint32_t MAX_CACHE_WAYS = 16;
+
+inline std::string replacementPolicyToString(ReplacementPolicy policy) {
+    switch (policy) {
+        case ReplacementPolicy::LRU: return "lru";
+        case ReplacementPolicy::PLRU: return "plru";
+        case ReplacementPolicy::RANDOM: return "random";
+        default: return "UNKNOWN";
+    }
+}
+
+inline std::string writePolicyToString(WritePolicy policy) {
+    return policy == WritePolicy::WRITE_BACK ? "wb" : "wt";
+}
+
+// A size of 0 disables the cache: every access then completes in the stage that issues it, as
+// the simulator has always modelled memory.
+struct CacheConfig {
+    uint32_t sizeBytes;
+    uint32_t lineBytes;
+    uint32_t ways;
+    ReplacementPolicy replacement;
+    WritePolicy write;
+    uint32_t missPenalty;
+
+    CacheConfig() : sizeBytes(0), lineBytes(32), ways(1), replacement(ReplacementPolicy::LRU), write(WritePolicy::WRITE_BACK), missPenalty(10) {}
+
+    inline bool enabled() const { return sizeBytes != 0; }
+};
+
+struct CacheStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t writebacks;
+
+    CacheStats() : hits(0), misses(0), evictions(0), writebacks(0) {}
+};
+
+inline bool isPowerOfTwo(uint32_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+inline uint32_t log2Exact(uint32_t value) {
+    uint32_t bits = 0;
+    while ((1u << bits) < value) bits++;
+    return bits;
+}
+
+inline void validateCacheConfig(const CacheConfig& config, const std::string& name) {
+    if (!config.enabled()) return;
+    auto fail = [&name](const std::string& message) {
+        throw std::runtime_error(std::string(RED) + "Invalid " + name + " configuration: " + message + RESET);
+    };
+    if (!isPowerOfTwo(config.sizeBytes) || !isPowerOfTwo(config.lineBytes) || !isPowerOfTwo(config.ways)) {
+        fail("size, line size and associativity must be powers of two");
+    }
+    if (config.lineBytes < INSTRUCTION_SIZE) {
+        fail("line size must be at least " + std::to_string(INSTRUCTION_SIZE) + " bytes");
+    }
+    if (config.ways > MAX_CACHE_WAYS) {
+        fail("at most " + std::to_string(MAX_CACHE_WAYS) + " ways are supported");
+    }
+    if (config.sizeBytes < config.lineBytes * config.ways) {
+        fail("size must hold at least one set of " + std::to_string(config.ways) + " lines");
+    }
+}
+
+// Applies one key=value pair of a cache spec (size, line, ways, replacement, write, penalty).
+inline void applyCacheValue(CacheConfig& config, const std::string& key, const std::string& value) {
+    auto number = [&]() {
+        uint32_t parsed = 0;
+        if (parseUnsigned(value, parsed) != NumberError::NONE) {
+            throw std::runtime_error(std::string(RED) + "Invalid cache value '" + value + "' for " + key + RESET);
+        }
+        return parsed;
+    };
+    if (key == "size") {
+        config.sizeBytes = number();
+    } else if (key == "line") {
+        config.lineBytes = number();
+    } else if (key == "ways") {
+        config.ways = number();
+    } else if (key == "penalty") {
+        config.missPenalty = number();
+    } else if (key == "replacement") {
+        if (value == "lru") config.replacement = ReplacementPolicy::LRU;
+        else if (value == "plru") config.replacement = ReplacementPolicy::PLRU;
+        else if (value == "random") config.replacement = ReplacementPolicy::RANDOM;
+        else throw std::runtime_error(std::string(RED) + "Invalid cache replacement '" + value + "' (expected lru, plru, random)" + RESET);
+    } else if (key == "write") {
+        if (value == "wb") config.write = WritePolicy::WRITE_BACK;
+        else if (value == "wt") config.write = WritePolicy::WRITE_THROUGH;
+        else throw std::runtime_error(std::string(RED) + "Invalid cache write policy '" + value + "' (expected wb, wt)" + RESET);
+    } else {
+        throw std::runtime_error(std::string(RED) + "Unknown cache parameter '" + key + "'" + RESET);
+    }
+}
+
+// Parses "size=4096,line=32,ways=2,...". Keys that are not listed keep their value from base.
+inline CacheConfig parseCacheSpec(const std::string& spec, CacheConfig base = CacheConfig()) {
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(start, end - start);
+        if (!item.empty()) {
+            size_t equalPos = item.find('=');
+            if (equalPos == std::string::npos) {
+                throw std::runtime_error(std::string(RED) + "Invalid cache parameter '" + item + "' (expected key=value)" + RESET);
+            }
+            applyCacheValue(base, item.substr(0, equalPos), item.substr(equalPos + 1));
+        }
+        start = end + 1;
+    }
+    return base;
+}
+
+// Set-associative timing model: it tracks which lines are resident, not their contents, which
+// stay in Memory. Each way is one packed word, tag << 2 | dirty << 1 | valid, and the per-set
+// replacement state is one 64-bit word: an LRU stack of 4-bit way numbers (most recent in the
+// low nibble) or the ways - 1 bits of a PLRU tree.
+//
+// Write-back caches allocate on a write miss and pay a second miss penalty when the victim is
+// dirty. Write-through caches never hold dirty lines, do not allocate on a write miss, and
+// writes are assumed to drain through a write buffer without stalling.
+class Cache {
+public:
+    Cache() : offsetBits(0), indexBits(0), setMask(0), randomState(0x9E3779B9u) {}
+
+    inline void configure(const CacheConfig& newConfig, const std::string& name);
+    inline void reset();
+    inline bool enabled() const { return config.enabled(); }
+
+    // Extra cycles the access takes: 0 on a hit, missPenalty per line moved to or from memory.
+    inline uint32_t access(uint32_t address, bool write);
+
+    inline const CacheStats& getStats() const { return stats; }
+    inline const CacheConfig& getConfig() const { return config; }
+
+private:
+    static constexpr uint32_t VALID = 1;
+    static constexpr uint32_t DIRTY = 2;
+
+    CacheConfig config;
+    CacheStats stats;
+    uint32_t offsetBits;
+    uint32_t indexBits;
+    uint32_t setMask;
+    uint32_t randomState;
+    std::vector<uint32_t> tags;
+    std::vector<uint64_t> replacement;
+
+    inline void touch(uint32_t set, uint32_t way);
+    inline uint32_t victim(uint32_t set);
+    inline uint64_t initialState() const;
+};
+
+inline void Cache::configure(const CacheConfig& newConfig, const std::string& name) {
+    validateCacheConfig(newConfig, name);
+    config = newConfig;
+    if (!config.enabled()) {
+        tags.clear();
+        replacement.clear();
+        stats = CacheStats();
+        return;
+    }
+    uint32_t sets = config.sizeBytes / (config.lineBytes * config.ways);
+    offsetBits = log2Exact(config.lineBytes);
+    indexBits = log2Exact(sets);
+    setMask = sets - 1;
+    reset();
+}
+
+inline uint64_t Cache::initialState() const {
+    if (config.replacement != ReplacementPolicy::LRU) return 0;
+    uint64_t stack = 0;
+    for (uint32_t way = 0; way < config.ways; way++) {
+        stack |= static_cast<uint64_t>(way) << (4 * way);
+    }
+    return stack;
+}
+
+inline void Cache::reset() {
+    stats = CacheStats();
+    randomState = 0x9E3779B9u;
+    if (!config.enabled()) return;
+    size_t sets = static_cast<size_t>(setMask) + 1;
+    tags.assign(sets * config.ways, 0);
+    replacement.assign(sets, initialState());
+}
+
+inline void Cache::touch(uint32_t set, uint32_t way) {
+    uint64_t& state = replacement[set];
+    if (config.replacement == ReplacementPolicy::LRU) {
+        uint32_t position = 0;
+        while (((state >> (4 * position)) & 0xF) != way) position++;
+        uint64_t below = state & ((uint64_t(1) << (4 * position)) - 1);
+        uint64_t above = position + 1 < 16 ? state >> (4 * (position + 1)) << (4 * (position + 1)) : 0;
+        state = above | (below << 4) | way;
+    } else if (config.replacement == ReplacementPolicy::PLRU) {
+        // Each tree node on the path is set to point away from the way just used.
+        uint32_t node = 0;
+        for (uint32_t level = config.ways >> 1; level > 0; level >>= 1) {
+            bool right = (way & level) != 0;
+            state = right ? state & ~(uint64_t(1) << node) : state | (uint64_t(1) << node);
+            node = 2 * node + 1 + (right ? 1 : 0);
+        }
+    }
+}
+
+inline uint32_t Cache::victim(uint32_t set) {
+    const uint32_t* line = &tags[static_cast<size_t>(set) * config.ways];
+    for (uint32_t way = 0; way < config.ways; way++) {
+        if ((line[way] & VALID) == 0) return way;
+    }
+    switch (config.replacement) {
+        case ReplacementPolicy::LRU:
+            return static_cast<uint32_t>((replacement[set] >> (4 * (config.ways - 1))) & 0xF);
+        case ReplacementPolicy::PLRU: {
+            uint32_t node = 0;
+            uint32_t way = 0;
+            for (uint32_t level = config.ways >> 1; level > 0; level >>= 1) {
+                bool right = (replacement[set] >> node) & 1;
+                way |= right ? level : 0;
+                node = 2 * node + 1 + (right ? 1 : 0);
+            }
+            return way;
+        }
+        case ReplacementPolicy::RANDOM:
+        default:
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 17;
+            randomState ^= randomState << 5;
+            return randomState & (config.ways - 1);
+    }
+}
+
+inline uint32_t Cache::access(uint32_t address, bool write) {
+    uint32_t set = (address >> offsetBits) & setMask;
+    uint32_t tag = address >> (offsetBits + indexBits);
+    uint32_t* line = &tags[static_cast<size_t>(set) * config.ways];
+    uint32_t packed = (tag << 2) | VALID;
+    bool writeBack = config.write == WritePolicy::WRITE_BACK;
+
+    for (uint32_t way = 0; way < config.ways; way++) {
+        if ((line[way] & ~DIRTY) == packed) {
+            stats.hits++;
+            if (write && writeBack) line[way] |= DIRTY;
+            touch(set, way);
+            return 0;
+        }
+    }
+
+    stats.misses++;
+    if (write && !writeBack) {
+        return 0;
+    }
+    uint32_t way = victim(set);
+    uint32_t penalty = config.missPenalty;
+    if (line[way] & VALID) {
+        stats.evictions++;
+        if (line[way] & DIRTY) {
+            stats.writebacks++;
+            penalty += config.missPenalty;
+        }
+    }
+    line[way] = packed | (write && writeBack ? DIRTY : 0);
+    touch(set, way);
+    return penalty;
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef DIAGNOSTICS_HPP
+#define DIAGNOSTICS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "types.hpp"
+
+using namespace riscv;
+
+enum class DiagnosticSource : uint8_t { LEXER, PARSER, ASSEMBLER };
+
+struct Diagnostic {
+    DiagnosticSource source;
+    // Source line, or 0 when the error is not tied to one.
+    int lineNumber;
+    std::string message;
+};
+
+inline const char* getDiagnosticSourceName(DiagnosticSource source) {
+    switch (source) {
+        case DiagnosticSource::LEXER: return "Lexer";
+        case DiagnosticSource::PARSER: return "Parser";
+        case DiagnosticSource::ASSEMBLER: return "Assembler";
+    }
+    return "Unknown";
+}
+
+// "Parser Error on Line 12: ..." or "Assembler Error: ...", without colour codes.
+inline std::string formatDiagnostic(const Diagnostic& diagnostic) {
+    std::string text = getDiagnosticSourceName(diagnostic.source);
+    text += " Error";
+    if (diagnostic.lineNumber > 0) text += " on Line " + std::to_string(diagnostic.lineNumber);
+    return text + ": " + diagnostic.message;
+}
+
+// Errors collected over one lexer, parser or assembler run. Reporting an error only appends to
+// the buffer, so a pass carries on and every problem in the input is found in one run. Parallel
+// passes fill one buffer per chunk and append them in chunk order, which keeps the result in
+// source order and independent of the thread count.
+class Diagnostics {
+public:
+    inline void error(DiagnosticSource source, std::string message, int lineNumber = 0) {
+        entries.push_back({source, lineNumber, std::move(message)});
+    }
+
+    inline void append(Diagnostics&& other) {
+        if (entries.empty()) {
+            entries = std::move(other.entries);
+        } else {
+            entries.insert(entries.end(), std::make_move_iterator(other.entries.begin()), std::make_move_iterator(other.entries.end()));
+        }
+        other.entries.clear();
+    }
+
+    inline void append(const Diagnostics& other) {
+        entries.insert(entries.end(), other.entries.begin(), other.entries.end());
+    }
+
+    // Orders the errors of different passes by line; errors on one line keep their order, and
+    // errors without a line come first.
+    inline void sortByLine() {
+        std::stable_sort(entries.begin(), entries.end(), [](const Diagnostic& a, const Diagnostic& b) { return a.lineNumber < b.lineNumber; });
+    }
+
+    inline void clear() { entries.clear(); }
+    inline bool empty() const { return entries.empty(); }
+    inline size_t size() const { return entries.size(); }
+    inline const std::vector<Diagnostic>& getEntries() const { return entries; }
+
+    // One diagnostic per line.
+    inline std::string format() const {
+        std::string text;
+        for (const Diagnostic& diagnostic : entries) {
+            if (!text.empty()) text += '\n';
+            text += formatDiagnostic(diagnostic);
+        }
+        return text;
+    }
+
+    inline void print(std::ostream& out) const {
+        for (const Diagnostic& diagnostic : entries) {
+            out << RED << formatDiagnostic(diagnostic) << RESET << "\n";
+        }
+    }
+
+    // For callers that still report failures as exceptions: a single throw carrying every error.
+    inline void throwIfAny() const {
+        if (!entries.empty()) throw std::runtime_error(std::string(RED) + format() + RESET);
+    }
+
+private:
+    std::vector<Diagnostic> entries;
+};
+
+#endif
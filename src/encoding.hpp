@@ -0,0 +1,219 @@
+#ifndef ENCODING_HPP
+#define ENCODING_HPP
+
+#include <array>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "types.hpp"
+
+using namespace riscv;
+
+// Encoder, decoder and disassembler generated from INSTRUCTION_FORMATS.
+//
+// Decoding is a direct lookup: the 2^10 primary table is indexed by funct3:opcode and holds the
+// instruction, INVALID, or FUNCT7_ENTRY when the slot is shared by R-type instructions that only
+// differ in funct7; those are resolved by a second table indexed by funct3:funct7. U and UJ
+// formats have no funct3, so they fill all eight slots of their opcode.
+namespace encoding {
+    inline constexpr size_t DECODE_TABLE_SIZE = 1 << 10;
+    inline constexpr uint8_t INVALID_ENTRY = static_cast<uint8_t>(Instructions::INVALID);
+    inline constexpr uint8_t FUNCT7_ENTRY = 0xFF;
+
+    struct DecodeTables {
+        std::array<uint8_t, DECODE_TABLE_SIZE> primary;
+        std::array<uint8_t, DECODE_TABLE_SIZE> funct7;
+    };
+
+    inline constexpr size_t primaryIndex(uint32_t opcode, uint32_t func3) { return (func3 << 7) | opcode; }
+    inline constexpr size_t funct7Index(uint32_t func3, uint32_t func7) { return (func3 << 7) | func7; }
+
+    inline constexpr void claim(uint8_t& slot, uint8_t value) {
+        if (slot != INVALID_ENTRY && slot != value) throw std::logic_error("Instruction formats overlap");
+        slot = value;
+    }
+
+    // Overlapping formats throw, which turns into a compile error in the constexpr table below.
+    inline constexpr DecodeTables buildDecodeTables() {
+        DecodeTables tables{};
+        for (size_t i = 0; i < DECODE_TABLE_SIZE; i++) {
+            tables.primary[i] = INVALID_ENTRY;
+            tables.funct7[i] = INVALID_ENTRY;
+        }
+        for (size_t i = 0; i < INSTRUCTION_COUNT; i++) {
+            const InstructionFormat& format = INSTRUCTION_FORMATS[i];
+            uint8_t entry = static_cast<uint8_t>(i);
+            if (format.type == InstructionType::R) {
+                claim(tables.primary[primaryIndex(format.opcode, format.func3)], FUNCT7_ENTRY);
+                claim(tables.funct7[funct7Index(format.func3, format.func7)], entry);
+            } else if (format.type == InstructionType::U || format.type == InstructionType::UJ) {
+                for (uint32_t func3 = 0; func3 < 8; func3++) {
+                    claim(tables.primary[primaryIndex(format.opcode, func3)], entry);
+                }
+            } else {
+                claim(tables.primary[primaryIndex(format.opcode, format.func3)], entry);
+            }
+        }
+        return tables;
+    }
+
+    inline constexpr DecodeTables DECODE_TABLES = buildDecodeTables();
+}
+
+inline constexpr Instructions decodeInstructionName(uint32_t word) {
+    uint32_t func3 = (word >> 12) & 0x7;
+    uint8_t entry = encoding::DECODE_TABLES.primary[encoding::primaryIndex(word & 0x7F, func3)];
+    if (entry == encoding::FUNCT7_ENTRY) {
+        entry = encoding::DECODE_TABLES.funct7[encoding::funct7Index(func3, (word >> 25) & 0x7F)];
+    }
+    return static_cast<Instructions>(entry);
+}
+
+// Sign-extended immediate of word in the given format; 0 for R-type. U-type keeps the upper
+// 20 bits in place.
+inline constexpr int32_t decodeImmediate(InstructionType type, uint32_t word) {
+    switch (type) {
+        case InstructionType::I: {
+            int32_t imm = (word >> 20) & 0xFFF;
+            if (imm & 0x800) imm |= 0xFFFFF000;
+            return imm;
+        }
+        case InstructionType::S: {
+            int32_t imm = ((word >> 25) & 0x7F) << 5 | ((word >> 7) & 0x1F);
+            if (imm & 0x800) imm |= 0xFFFFF000;
+            return imm;
+        }
+        case InstructionType::SB: {
+            int32_t imm = ((word >> 31) & 0x1) << 12 |
+                          ((word >> 7) & 0x1) << 11 |
+                          ((word >> 25) & 0x3F) << 5 |
+                          ((word >> 8) & 0xF) << 1;
+            if (imm & 0x1000) imm |= 0xFFFFE000;
+            return imm;
+        }
+        case InstructionType::U:
+            return static_cast<int32_t>(word & 0xFFFFF000);
+        case InstructionType::UJ: {
+            int32_t imm = ((word >> 31) & 0x1) << 20 |
+                          ((word >> 12) & 0xFF) << 12 |
+                          ((word >> 20) & 0x1) << 11 |
+                          ((word >> 21) & 0x3FF) << 1;
+            if (imm & 0x100000) imm |= 0xFFE00000;
+            return imm;
+        }
+        default:
+            return 0;
+    }
+}
+
+// Field encoders. Operands are assumed to be in range; the assembler checks them first.
+inline constexpr uint32_t encodeRType(const InstructionFormat& format, uint32_t rd, uint32_t rs1, uint32_t rs2) {
+    return (static_cast<uint32_t>(format.func7) << 25) | (rs2 << 20) | (rs1 << 15) | (format.func3 << 12) | (rd << 7) | format.opcode;
+}
+
+inline constexpr uint32_t encodeIType(const InstructionFormat& format, uint32_t rd, uint32_t rs1, int32_t imm) {
+    return ((static_cast<uint32_t>(imm) & 0xFFF) << 20) | (rs1 << 15) | (format.func3 << 12) | (rd << 7) | format.opcode;
+}
+
+inline constexpr uint32_t encodeSType(const InstructionFormat& format, uint32_t rs1, uint32_t rs2, int32_t imm) {
+    uint32_t bits = static_cast<uint32_t>(imm);
+    return (((bits >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (format.func3 << 12) | ((bits & 0x1F) << 7) | format.opcode;
+}
+
+inline constexpr uint32_t encodeSBType(const InstructionFormat& format, uint32_t rs1, uint32_t rs2, int32_t offset) {
+    uint32_t bits = static_cast<uint32_t>(offset);
+    return (((bits >> 12) & 0x1) << 31) | (((bits >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) | (format.func3 << 12) |
+           (((bits >> 1) & 0xF) << 8) | (((bits >> 11) & 0x1) << 7) | format.opcode;
+}
+
+inline constexpr uint32_t encodeUType(const InstructionFormat& format, uint32_t rd, int32_t imm) {
+    return ((static_cast<uint32_t>(imm) & 0xFFFFF) << 12) | (rd << 7) | format.opcode;
+}
+
+inline constexpr uint32_t encodeUJType(const InstructionFormat& format, uint32_t rd, int32_t offset) {
+    uint32_t bits = static_cast<uint32_t>(offset);
+    return (((bits >> 20) & 0x1) << 31) | (((bits >> 1) & 0x3FF) << 21) | (((bits >> 11) & 0x1) << 20) |
+           (((bits >> 12) & 0xFF) << 12) | (rd << 7) | format.opcode;
+}
+
+// imm is the value the format stores: the upper 20 bits for U-type, a byte offset otherwise.
+inline constexpr uint32_t encodeFields(Instructions inst, uint32_t rd, uint32_t rs1, uint32_t rs2, int32_t imm) {
+    const InstructionFormat& format = getInstructionFormat(inst);
+    switch (format.type) {
+        case InstructionType::R: return encodeRType(format, rd, rs1, rs2);
+        case InstructionType::I: return encodeIType(format, rd, rs1, imm);
+        case InstructionType::S: return encodeSType(format, rs1, rs2, imm);
+        case InstructionType::SB: return encodeSBType(format, rs1, rs2, imm);
+        case InstructionType::U: return encodeUType(format, rd, imm);
+        case InstructionType::UJ: return encodeUJType(format, rd, imm);
+    }
+    return 0;
+}
+
+namespace encoding {
+    inline constexpr bool roundTrips() {
+        for (size_t i = 0; i < INSTRUCTION_COUNT; i++) {
+            Instructions inst = static_cast<Instructions>(i);
+            InstructionType type = getInstructionFormat(inst).type;
+            int32_t imm = type == InstructionType::U ? 0xFFFFF : -2048;
+            uint32_t word = encodeFields(inst, 31, 17, 9, imm);
+            if (decodeInstructionName(word) != inst) return false;
+            if (type == InstructionType::U ? decodeImmediate(type, word) != static_cast<int32_t>(0xFFFFF000)
+                                           : type != InstructionType::R && decodeImmediate(type, word) != imm) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(roundTrips(), "every format must decode back to itself");
+    static_assert(decodeInstructionName(0x00000013) == Instructions::ADDI, "decode table");
+    static_assert(decodeInstructionName(0x0000B033) == Instructions::INVALID, "decode table");
+}
+
+// separator goes between operands: ", " for listings and logs, "," in .mc files.
+inline std::string disassembleInstruction(uint32_t word, std::string_view separator = ", ") {
+    Instructions inst = decodeInstructionName(word);
+    if (inst == Instructions::INVALID) {
+        std::stringstream ss;
+        ss << "Invalid instruction: 0x" << std::hex << word;
+        throw std::runtime_error(std::string(RED) + ss.str() + RESET);
+    }
+    const InstructionFormat& format = getInstructionFormat(inst);
+    int32_t imm = decodeImmediate(format.type, word);
+    std::string rd = "x" + std::to_string((word >> 7) & 0x1F);
+    std::string rs1 = "x" + std::to_string((word >> 15) & 0x1F);
+    std::string rs2 = "x" + std::to_string((word >> 20) & 0x1F);
+
+    std::string text(format.name);
+    text += ' ';
+    switch (format.type) {
+        case InstructionType::R:
+            text.append(rd).append(separator).append(rs1).append(separator).append(rs2);
+            break;
+        case InstructionType::I:
+            if (isLoadFormat(format)) {
+                text.append(rd).append(separator).append(std::to_string(imm)).append("(").append(rs1).append(")");
+            } else {
+                text.append(rd).append(separator).append(rs1).append(separator).append(std::to_string(imm));
+            }
+            break;
+        case InstructionType::S:
+            text.append(rs2).append(separator).append(std::to_string(imm)).append("(").append(rs1).append(")");
+            break;
+        case InstructionType::SB:
+            text.append(rs1).append(separator).append(rs2).append(separator).append(std::to_string(imm));
+            break;
+        case InstructionType::U:
+            text.append(rd).append(separator).append(std::to_string(static_cast<uint32_t>(imm) >> 12));
+            break;
+        case InstructionType::UJ:
+            text.append(rd).append(separator).append(std::to_string(imm));
+            break;
+    }
+    return text;
+}
+
+#endif
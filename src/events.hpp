@@ -0,0 +1,257 @@
+#ifndef EVENTS_HPP
+#define EVENTS_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include "types.hpp"
+#include "execution.hpp"
+
+using namespace riscv;
+
+// Highest event level that is compiled in at all. Build with -DEVENT_LEVEL=0 to strip every
+// emission site, or -DEVENT_LEVEL=1 to keep only the per-run messages.
+#ifndef EVENT_LEVEL
+#define EVENT_LEVEL 2
+#endif
+
+enum class EventLevel : uint8_t {
+    NONE = 0,
+    INFO = 1,
+    TRACE = 2
+};
+
+inline constexpr EventLevel COMPILED_EVENT_LEVEL = static_cast<EventLevel>(EVENT_LEVEL);
+
+enum class EventKind : uint8_t {
+    PROGRAM_LOADED,
+    PROGRAM_COMPLETED,
+    STEP_LIMIT,
+    INSTRUCTION_LIMIT,
+    FOLLOWED_STAGE,
+    FORWARD_EX_EX,
+    FORWARD_MEM_EX,
+    FORWARD_MEM_MEM,
+    DATA_HAZARD,
+    LOAD_USE_HAZARD,
+    STALL_DECODE,
+    STALL_DECODE_RESUME,
+    STALL_EXECUTE,
+    BRANCH_PREDICTED,
+    BRANCH_MISPREDICTED,
+    BRANCH_CORRECT,
+    PIPELINE_FLUSH
+};
+
+// Plain record handed to sinks. Instruction words are carried raw; disassembly only happens
+// when a sink formats the event.
+struct Event {
+    uint32_t cycle;
+    uint32_t pc;
+    uint32_t instruction;
+    uint32_t sourcePc;
+    uint32_t sourceInstruction;
+    uint32_t target;
+    uint32_t actual;
+    EventKind kind;
+    Stage stage;
+    uint8_t reg;
+    uint8_t operand;
+    bool isLoad;
+    bool toRM;
+    bool isBranch;
+    bool predictedTaken;
+    bool taken;
+};
+
+inline Event makeEvent(EventKind kind, uint32_t cycle, uint32_t pc = 0, uint32_t instruction = 0) {
+    Event event{};
+    event.kind = kind;
+    event.cycle = cycle;
+    event.pc = pc;
+    event.instruction = instruction;
+    return event;
+}
+
+inline EventLevel eventLevel(EventKind kind) {
+    switch (kind) {
+        case EventKind::PROGRAM_LOADED:
+        case EventKind::PROGRAM_COMPLETED:
+        case EventKind::STEP_LIMIT:
+        case EventKind::INSTRUCTION_LIMIT:
+        case EventKind::FOLLOWED_STAGE:
+            return EventLevel::INFO;
+        default:
+            return EventLevel::TRACE;
+    }
+}
+
+class EventSink {
+public:
+    explicit EventSink(EventLevel level = EventLevel::TRACE) : level(level) {}
+    virtual ~EventSink() = default;
+    virtual void emit(const Event& event) = 0;
+
+    inline EventLevel getLevel() const { return level; }
+    inline void setLevel(EventLevel newLevel) { level = newLevel; }
+
+private:
+    EventLevel level;
+};
+
+inline bool isEventEnabled(const EventSink* sink, EventLevel level) {
+    return level <= COMPILED_EVENT_LEVEL && sink != nullptr && level <= sink->getLevel();
+}
+
+inline std::string eventInstructionText(uint32_t instruction) {
+    return instruction != 0 ? disassembleInstruction(instruction) : "";
+}
+
+inline std::string formatEvent(const Event& event) {
+    std::stringstream ss;
+    const char* unit = event.isBranch ? "Branch" : "Jump";
+    switch (event.kind) {
+        case EventKind::PROGRAM_LOADED:
+            ss << "Program loaded successfully";
+            break;
+        case EventKind::PROGRAM_COMPLETED:
+            ss << "Program execution completed";
+            break;
+        case EventKind::STEP_LIMIT:
+            ss << "Program execution terminated - exceeded maximum step count (" << event.target << ")";
+            break;
+        case EventKind::INSTRUCTION_LIMIT:
+            ss << "Program execution terminated - exceeded maximum instruction count (" << event.target << ")";
+            break;
+        case EventKind::FOLLOWED_STAGE:
+            ss << "Cycle " << event.cycle << ": Followed instruction at PC=0x" << std::hex << event.pc << std::dec
+               << " (" << eventInstructionText(event.instruction) << ") completes " << stageToString(event.stage);
+            break;
+        case EventKind::FORWARD_EX_EX:
+        case EventKind::FORWARD_MEM_EX:
+        case EventKind::FORWARD_MEM_MEM:
+            ss << "Data Forwarding: "
+               << (event.kind == EventKind::FORWARD_EX_EX ? "EX->EX" : event.kind == EventKind::FORWARD_MEM_EX ? "MEM->EX" : "MEM->MEM")
+               << " for rs" << static_cast<uint32_t>(event.operand) << " (reg " << static_cast<uint32_t>(event.reg) << ")"
+               << (event.toRM ? " to RM" : "") << " of instruction at PC=" << event.pc
+               << " (" << eventInstructionText(event.instruction) << ")" << (event.isLoad ? " [Load]" : "")
+               << " from instruction (" << eventInstructionText(event.sourceInstruction) << ")";
+            break;
+        case EventKind::DATA_HAZARD:
+            ss << "Data Hazard: Instruction at PC=" << event.pc << " (" << eventInstructionText(event.instruction)
+               << ") depends on reg " << static_cast<uint32_t>(event.reg) << " in " << stageToString(event.stage);
+            break;
+        case EventKind::LOAD_USE_HAZARD:
+            ss << "Load-Use Hazard: Instruction at PC=" << event.pc << " (" << eventInstructionText(event.instruction)
+               << ") depends on load at PC=" << event.sourcePc << " (rd=" << static_cast<uint32_t>(event.reg) << ")";
+            break;
+        case EventKind::STALL_DECODE:
+            ss << "Stalling DECODE at PC=" << event.pc << " due to RAW hazard";
+            break;
+        case EventKind::STALL_DECODE_RESUME:
+            ss << "Stalling DECODE (resume) at PC=" << event.pc << " due to RAW hazard";
+            break;
+        case EventKind::STALL_EXECUTE:
+            ss << "Stalling EXECUTE at PC=" << event.pc << " due to load hazard";
+            break;
+        case EventKind::BRANCH_PREDICTED:
+            ss << unit << " predicted " << (event.predictedTaken ? "taken" : "not taken") << " at PC=" << event.pc
+               << " (" << eventInstructionText(event.instruction) << ")";
+            break;
+        case EventKind::BRANCH_MISPREDICTED:
+            ss << unit << " misprediction (" << (event.predictedTaken != event.taken ? "direction" : "target address")
+               << ") at PC=" << event.pc << " (" << eventInstructionText(event.instruction) << "), predicted: ";
+            if (event.predictedTaken) {
+                ss << "taken to " << event.target;
+            } else {
+                ss << "not taken";
+            }
+            ss << ", actual: ";
+            if (event.taken) {
+                ss << "taken to " << event.actual;
+            } else {
+                ss << "not taken";
+            }
+            break;
+        case EventKind::BRANCH_CORRECT:
+            ss << unit << " correctly predicted at PC=" << event.pc << ", restored PC=" << event.actual;
+            break;
+        case EventKind::PIPELINE_FLUSH:
+            ss << "Pipeline flushed: " << unit << " misprediction";
+            break;
+    }
+    return ss.str();
+}
+
+// Writes one colored line per event, the way the command-line simulator always reported.
+class ConsoleEventSink : public EventSink {
+public:
+    explicit ConsoleEventSink(EventLevel level = EventLevel::TRACE, std::ostream& out = std::cout) : EventSink(level), out(out) {}
+
+    void emit(const Event& event) override {
+        out << colorOf(event.kind) << formatEvent(event) << RESET << std::endl;
+    }
+
+private:
+    std::ostream& out;
+
+    static const char* colorOf(EventKind kind) {
+        switch (kind) {
+            case EventKind::PROGRAM_LOADED:
+            case EventKind::PROGRAM_COMPLETED:
+            case EventKind::FOLLOWED_STAGE:
+            case EventKind::LOAD_USE_HAZARD:
+                return GREEN;
+            case EventKind::STEP_LIMIT:
+            case EventKind::INSTRUCTION_LIMIT:
+                return RED;
+            default:
+                return YELLOW;
+        }
+    }
+};
+
+// Collects events into the status-code keyed log map handed to the web frontend by getLogs().
+// Forwarding events of one cycle are joined into a single entry.
+class LogMapSink : public EventSink {
+public:
+    explicit LogMapSink(std::unordered_map<int, std::string>& logs, EventLevel level = EventLevel::TRACE) : EventSink(level), logs(logs) {}
+
+    void emit(const Event& event) override {
+        int code = codeOf(event.kind);
+        std::string message = formatEvent(event);
+        bool isForwarding = event.kind == EventKind::FORWARD_EX_EX || event.kind == EventKind::FORWARD_MEM_EX || event.kind == EventKind::FORWARD_MEM_MEM;
+        auto it = logs.find(code);
+        if (isForwarding && it != logs.end()) {
+            it->second += "\n" + message;
+        } else {
+            logs[code] = message;
+        }
+    }
+
+private:
+    std::unordered_map<int, std::string>& logs;
+
+    static int codeOf(EventKind kind) {
+        switch (kind) {
+            case EventKind::STEP_LIMIT:
+            case EventKind::INSTRUCTION_LIMIT:
+                return 400;
+            case EventKind::FORWARD_EX_EX:
+            case EventKind::FORWARD_MEM_EX:
+            case EventKind::FORWARD_MEM_MEM:
+            case EventKind::DATA_HAZARD:
+            case EventKind::STALL_DECODE:
+            case EventKind::STALL_DECODE_RESUME:
+            case EventKind::STALL_EXECUTE:
+            case EventKind::PIPELINE_FLUSH:
+                return 300;
+            default:
+                return 200;
+        }
+    }
+};
+
+#endif
@@ -9,7 +9,10 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <iomanip>
+#include <vector>
 #include "types.hpp"
+#include "encoding.hpp"
+#include "memory.hpp"
 
 using namespace riscv;
 
@@ -39,231 +42,134 @@ inline bool isValidAddress(uint32_t addr, uint32_t size) {
 }
 
 inline InstructionType classifyInstructions(uint32_t instHex) {
-    uint32_t opcode = instHex & 0x7F;
-    uint32_t func3 = (instHex >> 12) & 0x7;
-    uint32_t func7 = (instHex >> 25) & 0x7F;
-    
-    auto rTypeEncoding = RTypeInstructions::getEncoding();
-    for (const auto &[name, op] : rTypeEncoding.opcodeMap) {
-        if (op == opcode && rTypeEncoding.func3Map.at(name) == func3 && rTypeEncoding.func7Map.at(name) == func7) {
-            return InstructionType::R;
-        }
-    }
-
-    auto iTypeEncoding = ITypeInstructions::getEncoding();
-    for (const auto &[name, op] : iTypeEncoding.opcodeMap) {
-        if (op == opcode && iTypeEncoding.func3Map.at(name) == func3) {
-            return InstructionType::I;
-        }
-    }
-
-    auto sTypeEncoding = STypeInstructions::getEncoding();
-    for (const auto &[name, op] : sTypeEncoding.opcodeMap) {
-        if (op == opcode && sTypeEncoding.func3Map.at(name) == func3) {
-            return InstructionType::S;
-        }
-    }
-
-    auto uTypeEncoding = UTypeInstructions::getEncoding();
-    for (const auto &[name, op] : uTypeEncoding.opcodeMap) {
-        if (op == opcode) {
-            return InstructionType::U;
-        }
-    }
-
-    auto sbTypeEncoding = SBTypeInstructions::getEncoding();
-    for (const auto &[name, op] : sbTypeEncoding.opcodeMap) {
-        if (op == opcode && sbTypeEncoding.func3Map.at(name) == func3) {
-            return InstructionType::SB;
-        }
-    }
-
-    auto ujTypeEncoding = UJTypeInstructions::getEncoding();
-    for (const auto &[name, op] : ujTypeEncoding.opcodeMap) {
-        if (op == opcode) {
-            return InstructionType::UJ;
-        }
+    Instructions inst = decodeInstructionName(instHex);
+    if (inst != Instructions::INVALID) {
+        return getInstructionFormat(inst).type;
     }
 
     std::stringstream ss;
-    ss << "Instruction 0x" << std::hex << instHex << " could not be classified: Invalid opcode (0x" << opcode << ")";
+    ss << "Instruction 0x" << std::hex << instHex << " could not be classified: Invalid opcode (0x" << (instHex & 0x7F) << ")";
     throw std::runtime_error(std::string(RED) + ss.str() + RESET);
 }
 
-inline void fetchInstruction(InstructionNode* node, uint32_t& PC, bool& running, std::map<uint32_t, std::pair<uint32_t, std::string>>& textMap) {
-    if (!isValidAddress(PC, 4)) {
-        std::ostringstream oss;
-        oss << "Fetch error: Invalid PC address 0x" << std::hex << PC;
-        throw std::runtime_error(std::string(RED) + oss.str() + RESET);
-    }
-    auto it = textMap.find(PC);
-    if (it != textMap.end()) {
-        node->instruction = it->second.first;
-        node->instructionType = classifyInstructions(node->instruction);
-        node->PC = PC;
-        PC += INSTRUCTION_SIZE;
-    } else {
-        node->instruction = 0;
-        running = false;
+// Decodes an instruction word once, at load time, into the record FETCH and DECODE index by PC.
+// Words that do not match any known encoding are kept with isValid == false so that the
+// classification error is still raised when (and only if) they are fetched.
+inline DecodedInstruction predecodeInstruction(uint32_t instHex) {
+    DecodedInstruction decoded;
+    decoded.instruction = instHex;
+    decoded.opcode = instHex & 0x7F;
+
+    decoded.instructionName = decodeInstructionName(instHex);
+    if (decoded.instructionName == Instructions::INVALID) {
+        return decoded;
     }
-}
-
-inline void decodeInstruction(InstructionNode* node, InstructionRegisters& instructionRegisters, uint32_t* registers) {
-    std::stringstream ss;
-    node->opcode = node->instruction & 0x7F;
+    decoded.isValid = true;
+    decoded.instructionType = getInstructionFormat(decoded.instructionName).type;
+    decoded.immediate = decodeImmediate(decoded.instructionType, instHex);
 
-    switch (node->instructionType) {
+    switch (decoded.instructionType) {
         case InstructionType::R:
-            node->rd = (node->instruction >> 7) & 0x1F;
-            node->func3 = (node->instruction >> 12) & 0x7;
-            node->rs1 = (node->instruction >> 15) & 0x1F;
-            node->rs2 = (node->instruction >> 20) & 0x1F;
-            node->func7 = (node->instruction >> 25) & 0x7F;
+            decoded.rd = (instHex >> 7) & 0x1F;
+            decoded.func3 = (instHex >> 12) & 0x7;
+            decoded.rs1 = (instHex >> 15) & 0x1F;
+            decoded.rs2 = (instHex >> 20) & 0x1F;
+            decoded.func7 = (instHex >> 25) & 0x7F;
             break;
-            
         case InstructionType::I:
-            node->rd = (node->instruction >> 7) & 0x1F;
-            node->func3 = (node->instruction >> 12) & 0x7;
-            node->rs1 = (node->instruction >> 15) & 0x1F;
+            decoded.rd = (instHex >> 7) & 0x1F;
+            decoded.func3 = (instHex >> 12) & 0x7;
+            decoded.rs1 = (instHex >> 15) & 0x1F;
             break;
-            
         case InstructionType::S:
-            node->func3 = (node->instruction >> 12) & 0x7;
-            node->rs1 = (node->instruction >> 15) & 0x1F;
-            node->rs2 = (node->instruction >> 20) & 0x1F;
-            break;
-            
         case InstructionType::SB:
-            node->func3 = (node->instruction >> 12) & 0x7;
-            node->rs1 = (node->instruction >> 15) & 0x1F;
-            node->rs2 = (node->instruction >> 20) & 0x1F;
+            decoded.func3 = (instHex >> 12) & 0x7;
+            decoded.rs1 = (instHex >> 15) & 0x1F;
+            decoded.rs2 = (instHex >> 20) & 0x1F;
             break;
-            
         case InstructionType::U:
-            node->rd = (node->instruction >> 7) & 0x1F;
-            break;
-            
         case InstructionType::UJ:
-            node->rd = (node->instruction >> 7) & 0x1F;
+            decoded.rd = (instHex >> 7) & 0x1F;
             break;
-            
-        default:
-            ss << "Invalid instruction type in decodeInstruction";
-            throw std::runtime_error(std::string(RED) + ss.str() + RESET);
     }
 
-    instructionRegisters.RA = (node->rs1 != UINT32_MAX) ? registers[node->rs1] : 0;
-
-    switch (node->instructionType) {
-        case InstructionType::R: {
-            auto rTypeEncoding = RTypeInstructions::getEncoding();
-            for (const auto &[name, op] : rTypeEncoding.opcodeMap) {
-                if (op == node->opcode && rTypeEncoding.func3Map.at(name) == node->func3 && rTypeEncoding.func7Map.at(name) == node->func7) {
-                    node->instructionName = stringToInstruction.at(name);
-                    instructionRegisters.RB = registers[node->rs2];
-                    break;
-                }
-            }
-            break;
-        }
-        case InstructionType::I: {
-            auto iTypeEncoding = ITypeInstructions::getEncoding();
-            for (const auto &[name, op] : iTypeEncoding.opcodeMap) {
-                if (op == node->opcode && iTypeEncoding.func3Map.at(name) == node->func3) {
-                    node->instructionName = stringToInstruction.at(name);
-                    int32_t imm = (node->instruction >> 20) & 0xFFF;
-                    if (imm & 0x800) imm |= 0xFFFFF000;
-                    instructionRegisters.RB = imm;
-                    break;
-                }
-            }
-            break;
-        }
-        case InstructionType::S: {
-            auto sTypeEncoding = STypeInstructions::getEncoding();
-            for (const auto &[name, op] : sTypeEncoding.opcodeMap) {
-                if (op == node->opcode && sTypeEncoding.func3Map.at(name) == node->func3) {
-                    node->instructionName = stringToInstruction.at(name);
-                    int32_t imm = ((node->instruction >> 25) & 0x7F) << 5 | ((node->instruction >> 7) & 0x1F);
-                    if (imm & 0x800) imm |= 0xFFFFF000;
-                    instructionRegisters.RB = imm;
-                    break;
-                }
-            }
-            break;
-        }
-        case InstructionType::SB: {
-            auto sbTypeEncoding = SBTypeInstructions::getEncoding();
-            for (const auto &[name, op] : sbTypeEncoding.opcodeMap) {
-                if (op == node->opcode && sbTypeEncoding.func3Map.at(name) == node->func3) {
-                    node->instructionName = stringToInstruction.at(name);
-                    int32_t imm = ((node->instruction >> 31) & 0x1) << 12 | 
-                                  ((node->instruction >> 7) & 0x1) << 11 | 
-                                  ((node->instruction >> 25) & 0x3F) << 5 | 
-                                  ((node->instruction >> 8) & 0xF) << 1;
-                    if (imm & 0x1000) imm |= 0xFFFFE000;
-                    instructionRegisters.RB = imm;
-                    break;
-                }
-            }
-            break;
-        }
-        case InstructionType::U: {
-            auto uTypeEncoding = UTypeInstructions::getEncoding();
-            for (const auto &[name, op] : uTypeEncoding.opcodeMap) {
-                if (op == node->opcode) {
-                    node->instructionName = stringToInstruction.at(name);
-                    instructionRegisters.RB = node->instruction & 0xFFFFF000;
-                    break;
-                }
-            }
-            break;
-        }
-        case InstructionType::UJ: {
-            auto ujTypeEncoding = UJTypeInstructions::getEncoding();
-            for (const auto &[name, op] : ujTypeEncoding.opcodeMap) {
-                if (op == node->opcode) {
-                    node->instructionName = stringToInstruction.at(name);
-                    int32_t imm = ((node->instruction >> 31) & 0x1) << 20 | 
-                                  ((node->instruction >> 12) & 0xFF) << 12 | 
-                                  ((node->instruction >> 20) & 0x1) << 11 | 
-                                  ((node->instruction >> 21) & 0x3FF) << 1;
-                    if (imm & 0x100000) imm |= 0xFFE00000;
-                    instructionRegisters.RB = imm;
-                    break;
-                }
-            }
-            break;
-        }
-        default:
-            ss << "Invalid instruction type in decodeInstruction register setup";
-            throw std::runtime_error(std::string(RED) + ss.str() + RESET);
-    }
-
-    switch (node->instructionName) {
+    switch (decoded.instructionName) {
         case Instructions::JAL:
         case Instructions::JALR:
-            node->isJump = true;
+            decoded.isJump = true;
             break;
         case Instructions::BNE:
         case Instructions::BEQ:
         case Instructions::BLT:
         case Instructions::BGE:
-            node->isBranch = true;
+            decoded.isBranch = true;
             break;
         case Instructions::LB:
         case Instructions::LH:
         case Instructions::LW:
-            node->isLoad = true;
+            decoded.isLoad = true;
             break;
         case Instructions::SB:
         case Instructions::SH:
         case Instructions::SW:
-            node->isStore = true;
+            decoded.isStore = true;
             break;
         default:
             break;
     }
+    return decoded;
+}
+
+inline const DecodedInstruction* findDecodedInstruction(uint32_t PC, const std::vector<DecodedInstruction>& decodedText) {
+    if (PC < TEXT_SEGMENT_START || (PC - TEXT_SEGMENT_START) % INSTRUCTION_SIZE != 0) {
+        return nullptr;
+    }
+    uint32_t index = (PC - TEXT_SEGMENT_START) / INSTRUCTION_SIZE;
+    return index < decodedText.size() ? &decodedText[index] : nullptr;
+}
+
+inline void fetchInstruction(InstructionNode* node, uint32_t& PC, bool& running, const std::vector<DecodedInstruction>& decodedText) {
+    if (!isValidAddress(PC, 4)) {
+        std::ostringstream oss;
+        oss << "Fetch error: Invalid PC address 0x" << std::hex << PC;
+        throw std::runtime_error(std::string(RED) + oss.str() + RESET);
+    }
+    const DecodedInstruction* decoded = findDecodedInstruction(PC, decodedText);
+    if (decoded != nullptr) {
+        if (!decoded->isValid) {
+            classifyInstructions(decoded->instruction);
+        }
+        node->instruction = decoded->instruction;
+        node->instructionType = decoded->instructionType;
+        node->decoded = decoded;
+        node->PC = PC;
+        PC += INSTRUCTION_SIZE;
+    } else {
+        node->instruction = 0;
+        running = false;
+    }
+}
+
+inline void decodeInstruction(InstructionNode* node, InstructionRegisters& instructionRegisters, uint32_t* registers) {
+    const DecodedInstruction* decoded = node->decoded;
+    if (decoded == nullptr || !decoded->isValid) {
+        throw std::runtime_error(std::string(RED) + "Invalid instruction type in decodeInstruction" + RESET);
+    }
+
+    node->opcode = decoded->opcode;
+    node->rd = decoded->rd;
+    node->func3 = decoded->func3;
+    node->rs1 = decoded->rs1;
+    node->rs2 = decoded->rs2;
+    node->func7 = decoded->func7;
+    node->instructionName = decoded->instructionName;
+    node->isJump = decoded->isJump;
+    node->isBranch = decoded->isBranch;
+    node->isLoad = decoded->isLoad;
+    node->isStore = decoded->isStore;
+
+    instructionRegisters.RA = registers[node->rs1];
+    instructionRegisters.RB = (decoded->instructionType == InstructionType::R) ? registers[node->rs2] : static_cast<uint32_t>(decoded->immediate);
 }
 
 inline void executeInstruction(InstructionNode* node, InstructionRegisters& instructionRegisters, uint32_t* registers, uint32_t& PC, bool& taken, ForwardingStatus& forwardingStatus) {
@@ -414,7 +320,29 @@ inline void executeInstruction(InstructionNode* node, InstructionRegisters& inst
     }
 }
 
-inline void memoryAccess(InstructionNode* node, InstructionRegisters& instructionRegisters, uint32_t* registers, std::unordered_map<uint32_t, uint8_t>& dataMap) {
+inline uint32_t loadData(Memory& memory, uint32_t address, uint32_t size) {
+    if (Memory::withinPage(address, size)) {
+        if (const uint8_t* page = memory.findPage(address)) {
+            return Memory::readFromPage(page + Memory::pageOffset(address), size);
+        }
+    }
+    isValidAddress(address, size);
+    return memory.read(address, size);
+}
+
+inline void storeData(Memory& memory, uint32_t address, uint32_t value, uint32_t size) {
+    if (address >= DATA_SEGMENT_START && Memory::withinPage(address, size)) {
+        if (uint8_t* page = memory.findWritablePage(address)) {
+            Memory::writeToPage(page + Memory::pageOffset(address), value, size);
+            return;
+        }
+    }
+    isValidMemory(address);
+    isValidAddress(address, size);
+    memory.write(address, value, size);
+}
+
+inline void memoryAccess(InstructionNode* node, InstructionRegisters& instructionRegisters, uint32_t* registers, Memory& memory) {
     uint32_t address = instructionRegisters.RY;
     instructionRegisters.RZ = instructionRegisters.RY;
     
@@ -422,51 +350,22 @@ inline void memoryAccess(InstructionNode* node, InstructionRegisters& instructio
 
     switch (instr) {
         case Instructions::LB:
-            isValidAddress(address, 1);
-            instructionRegisters.RZ = dataMap.count(address) ? static_cast<int8_t>(dataMap[address]) : 0;
+            instructionRegisters.RZ = static_cast<int8_t>(loadData(memory, address, 1));
             break;
         case Instructions::LH:
-            isValidAddress(address, 2);
-            instructionRegisters.RZ = static_cast<int16_t>(
-                (dataMap.count(address + 1) ? dataMap[address + 1] : 0) << 8 |
-                (dataMap.count(address) ? dataMap[address] : 0)
-            );
+            instructionRegisters.RZ = static_cast<int16_t>(loadData(memory, address, 2));
             break;
         case Instructions::LW:
-            isValidAddress(address, 4);
-            instructionRegisters.RZ = 
-                ((dataMap.count(address + 3) ? dataMap[address + 3] : 0) << 24) |
-                ((dataMap.count(address + 2) ? dataMap[address + 2] : 0) << 16) |
-                ((dataMap.count(address + 1) ? dataMap[address + 1] : 0) << 8)  |
-                (dataMap.count(address) ? dataMap[address] : 0);
+            instructionRegisters.RZ = loadData(memory, address, 4);
             break;
         case Instructions::SB:
-            {
-                isValidMemory(address);
-                uint32_t valueToStore = instructionRegisters.RM;
-                isValidAddress(address, 1);
-                dataMap[address] = valueToStore & 0xFF;
-            }
+            storeData(memory, address, instructionRegisters.RM, 1);
             break;
         case Instructions::SH:
-            {
-                isValidMemory(address);
-                uint32_t valueToStore = instructionRegisters.RM;
-                isValidAddress(address, 2);
-                dataMap[address] = valueToStore & 0xFF;
-                dataMap[address + 1] = (valueToStore >> 8) & 0xFF;
-            }
+            storeData(memory, address, instructionRegisters.RM, 2);
             break;
         case Instructions::SW:
-            {
-                isValidMemory(address);
-                uint32_t valueToStore = instructionRegisters.RM;
-                isValidAddress(address, 4);
-                dataMap[address] = valueToStore & 0xFF;
-                dataMap[address + 1] = (valueToStore >> 8) & 0xFF;
-                dataMap[address + 2] = (valueToStore >> 16) & 0xFF;
-                dataMap[address + 3] = (valueToStore >> 24) & 0xFF;
-            }
+            storeData(memory, address, instructionRegisters.RM, 4);
             break;
         default:
             break;
@@ -492,83 +391,4 @@ inline void writeback(InstructionNode* node, InstructionRegisters& instructionRe
     registers[0] = 0;
 }
 
-inline std::string parseInstructions(uint32_t instHex) {
-    uint32_t opcode = instHex & 0x7F;
-    uint32_t rd = (instHex >> 7) & 0x1F;
-    uint32_t func3 = (instHex >> 12) & 0x7;
-    uint32_t rs1 = (instHex >> 15) & 0x1F;
-    uint32_t rs2 = (instHex >> 20) & 0x1F;
-    uint32_t func7 = (instHex >> 25) & 0x7F;
-
-    auto rTypeEncoding = RTypeInstructions::getEncoding();
-    for (const auto &[name, op] : rTypeEncoding.opcodeMap) {
-        if (op == opcode && rTypeEncoding.func3Map.at(name) == func3 && rTypeEncoding.func7Map.at(name) == func7) {
-            std::stringstream ss;
-            ss << name << " x" << rd << ", x" << rs1 << ", x" << rs2;
-            return ss.str();
-        }
-    }
-
-    auto iTypeEncoding = ITypeInstructions::getEncoding();
-    for (const auto &[name, op] : iTypeEncoding.opcodeMap) {
-        if (op == opcode && iTypeEncoding.func3Map.at(name) == func3) {
-            int32_t imm = (instHex >> 20);
-            if (imm & 0x800) imm |= 0xFFFFF000;
-            std::stringstream ss;
-            if (name == "lb" || name == "lh" || name == "lw") {
-                ss << name << " x" << rd << ", " << imm << "(x" << rs1 << ")";
-            } else {
-                ss << name << " x" << rd << ", x" << rs1 << ", " << imm;
-            }
-            return ss.str();
-        }
-    }
-
-    auto sTypeEncoding = STypeInstructions::getEncoding();
-    for (const auto &[name, op] : sTypeEncoding.opcodeMap) {
-        if (op == opcode && sTypeEncoding.func3Map.at(name) == func3) {
-            int32_t imm = ((instHex >> 25) << 5) | ((instHex >> 7) & 0x1F);
-            if (imm & 0x800) imm |= 0xFFFFF000;
-            std::stringstream ss;
-            ss << name << " x" << rs2 << ", " << imm << "(x" << rs1 << ")";
-            return ss.str();
-        }
-    }
-
-    auto sbTypeEncoding = SBTypeInstructions::getEncoding();
-    for (const auto &[name, op] : sbTypeEncoding.opcodeMap) {
-        if (op == opcode && sbTypeEncoding.func3Map.at(name) == func3) {
-            int32_t imm = ((instHex >> 31) << 12) | (((instHex >> 7) & 1) << 11) | (((instHex >> 25) & 0x3F) << 5) | (((instHex >> 8) & 0xF) << 1);
-            if (imm & 0x1000) imm |= 0xFFFFE000;
-            std::stringstream ss;
-            ss << name << " x" << rs1 << ", x" << rs2 << ", " << imm;
-            return ss.str();
-        }
-    }
-
-    auto uTypeEncoding = UTypeInstructions::getEncoding();
-    for (const auto &[name, op] : uTypeEncoding.opcodeMap) {
-        if (op == opcode) {
-            uint32_t imm = instHex & 0xFFFFF000;
-            std::stringstream ss;
-            ss << name << " x" << rd << ", " << (imm >> 12);
-            return ss.str();
-        }
-    }
-
-    auto ujTypeEncoding = UJTypeInstructions::getEncoding();
-    for (const auto &[name, op] : ujTypeEncoding.opcodeMap) {
-        if (op == opcode) {
-            int32_t imm = ((instHex >> 31) << 20) | (((instHex >> 12) & 0xFF) << 12) | (((instHex >> 20) & 1) << 11) | (((instHex >> 21) & 0x3FF) << 1);
-            if (imm & 0x100000) imm |= 0xFFE00000;
-            std::stringstream ss;
-            ss << name << " x" << rd << ", " << imm;
-            return ss.str();
-        }
-    }
-    std::stringstream ss;
-    ss << "Invalid instruction: 0x" << std::hex << instHex;
-    throw std::runtime_error(std::string(RED) + ss.str() + RESET);
-}
-
 #endif
\ No newline at end of file
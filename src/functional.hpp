@@ -0,0 +1,181 @@
+#ifndef FUNCTIONAL_HPP
+#define FUNCTIONAL_HPP
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "types.hpp"
+#include "memory.hpp"
+#include "execution.hpp"
+#include "profile.hpp"
+
+using namespace riscv;
+
+// ISA-level execution engine. Runs straight from the predecoded text segment with one switch
+// per instruction and no pipeline bookkeeping. The architectural results (registers, data
+// memory, retired instruction count and instruction mix) match the non-pipelined 5-stage model.
+// A profiler, when given, only sees executions, branches and memory accesses: there are no stalls.
+inline uint32_t runFunctional(const std::vector<DecodedInstruction>& decodedText, uint32_t* registers, uint32_t& PC,
+                              Memory& memory, SimulationStats& stats,
+                              uint32_t maxInstructions, bool& running, Profiler* profiler = nullptr) {
+    const DecodedInstruction* text = decodedText.data();
+    const uint32_t textSize = static_cast<uint32_t>(decodedText.size());
+    uint32_t executed = 0;
+
+    while (running && executed < maxInstructions) {
+        uint32_t offset = PC - TEXT_SEGMENT_START;
+        if (PC < TEXT_SEGMENT_START || (offset % INSTRUCTION_SIZE) != 0 || offset / INSTRUCTION_SIZE >= textSize) {
+            running = false;
+            break;
+        }
+
+        const DecodedInstruction& inst = text[offset / INSTRUCTION_SIZE];
+        if (!inst.isValid) {
+            classifyInstructions(inst.instruction);
+        }
+
+        const uint32_t a = registers[inst.rs1];
+        const uint32_t b = (inst.instructionType == InstructionType::R) ? registers[inst.rs2] : static_cast<uint32_t>(inst.immediate);
+        uint32_t nextPC = PC + INSTRUCTION_SIZE;
+        uint32_t result = 0;
+
+        switch (inst.instructionName) {
+            case Instructions::ADD:
+            case Instructions::ADDI:
+                result = a + b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::SUB:
+                result = a - b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::MUL:
+                result = a * b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::DIV:
+                if (b == 0) {
+                    std::stringstream ss;
+                    ss << "Division by zero at PC 0x" << std::hex << PC << "\n";
+                    throw std::runtime_error(std::string(RED) + ss.str() + RESET);
+                }
+                result = static_cast<uint32_t>(static_cast<int32_t>(a) / static_cast<int32_t>(b));
+                stats.aluInstructions++;
+                break;
+            case Instructions::REM:
+                if (b == 0) {
+                    std::stringstream ss;
+                    ss << "Remainder by zero at PC 0x" << std::hex << PC << "\n";
+                    throw std::runtime_error(std::string(RED) + ss.str() + RESET);
+                }
+                result = static_cast<uint32_t>(static_cast<int32_t>(a) % static_cast<int32_t>(b));
+                stats.aluInstructions++;
+                break;
+            case Instructions::AND:
+            case Instructions::ANDI:
+                result = a & b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::OR:
+            case Instructions::ORI:
+                result = a | b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::XOR:
+                result = a ^ b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::SLL:
+                result = a << (b & 0x1F);
+                stats.aluInstructions++;
+                break;
+            case Instructions::SRL:
+                result = a >> (b & 0x1F);
+                stats.aluInstructions++;
+                break;
+            case Instructions::SRA:
+                result = static_cast<uint32_t>(static_cast<int32_t>(a) >> (b & 0x1F));
+                stats.aluInstructions++;
+                break;
+            case Instructions::SLT:
+                result = (static_cast<int32_t>(a) < static_cast<int32_t>(b)) ? 1 : 0;
+                stats.aluInstructions++;
+                break;
+            case Instructions::LUI:
+                result = b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::AUIPC:
+                result = PC + b;
+                stats.aluInstructions++;
+                break;
+            case Instructions::LB:
+                result = static_cast<int8_t>(loadData(memory, a + b, 1));
+                stats.dataTransferInstructions++;
+                break;
+            case Instructions::LH:
+                result = static_cast<int16_t>(loadData(memory, a + b, 2));
+                stats.dataTransferInstructions++;
+                break;
+            case Instructions::LW:
+                result = loadData(memory, a + b, 4);
+                stats.dataTransferInstructions++;
+                break;
+            case Instructions::SB:
+                storeData(memory, a + b, registers[inst.rs2], 1);
+                stats.dataTransferInstructions++;
+                break;
+            case Instructions::SH:
+                storeData(memory, a + b, registers[inst.rs2], 2);
+                stats.dataTransferInstructions++;
+                break;
+            case Instructions::SW:
+                storeData(memory, a + b, registers[inst.rs2], 4);
+                stats.dataTransferInstructions++;
+                break;
+            case Instructions::BEQ:
+                if (a == registers[inst.rs2]) nextPC = PC + b;
+                stats.controlInstructions++;
+                break;
+            case Instructions::BNE:
+                if (a != registers[inst.rs2]) nextPC = PC + b;
+                stats.controlInstructions++;
+                break;
+            case Instructions::BLT:
+                if (static_cast<int32_t>(a) < static_cast<int32_t>(registers[inst.rs2])) nextPC = PC + b;
+                stats.controlInstructions++;
+                break;
+            case Instructions::BGE:
+                if (static_cast<int32_t>(a) >= static_cast<int32_t>(registers[inst.rs2])) nextPC = PC + b;
+                stats.controlInstructions++;
+                break;
+            case Instructions::JAL:
+                result = PC + INSTRUCTION_SIZE;
+                nextPC = PC + b;
+                stats.controlInstructions++;
+                break;
+            case Instructions::JALR:
+                result = PC + INSTRUCTION_SIZE;
+                nextPC = (a + b) & ~1u;
+                stats.controlInstructions++;
+                break;
+            default:
+                break;
+        }
+
+        if (profiler != nullptr) {
+            profiler->recordExecution(PC);
+            if (inst.isBranch || inst.isJump) profiler->recordBranch(PC, false);
+            if (inst.isLoad || inst.isStore) profiler->recordMemoryAccess(PC);
+        }
+        if (inst.rd != 0) {
+            registers[inst.rd] = result;
+        }
+        PC = nextPC;
+        executed++;
+    }
+    return executed;
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef HOOKS_HPP
+#define HOOKS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "types.hpp"
+#include "events.hpp"
+
+using namespace riscv;
+
+// Compile-time policies of BasicSimulator. The Hooks policy is called at the points a front end
+// redraws from (stalls, flushes, forwarding paths, branch redirects, stores). The Log policy
+// receives load and runtime errors. Every NoHooks member is an empty inline function, so the
+// command-line engine pays nothing for the hook calls.
+struct NoHooks {
+    inline void onCycleBegin() {}
+    inline void onStall() {}
+    inline void onFlush() {}
+    inline void onForward(EventKind) {}
+    inline void onBranchToFetch() {}
+    inline void onBranchResolved() {}
+    inline void onStore(uint32_t, uint32_t) {}
+    inline void onTerminated() {}
+    inline void onReset() {}
+};
+
+struct ConsoleLog {
+    inline void error(const std::string& message) const {
+        std::cerr << RED << message << RESET << std::endl;
+    }
+};
+
+// Writes errors into the status-code keyed log map the web front end reads, under code 404.
+class LogMapLog {
+public:
+    explicit LogMapLog(std::unordered_map<int, std::string>& logs) : logs(&logs) {}
+
+    inline void error(const std::string& message) const { (*logs)[404] = stripColor(message); }
+
+    static inline std::string stripColor(const std::string& text) {
+        std::string plain;
+        plain.reserve(text.size());
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '\033' && i + 1 < text.size() && text[i + 1] == '[') {
+                size_t end = text.find('m', i);
+                if (end != std::string::npos) {
+                    i = end;
+                    continue;
+                }
+            }
+            plain.push_back(text[i]);
+        }
+        return plain;
+    }
+
+private:
+    std::unordered_map<int, std::string>* logs;
+};
+
+struct UIResponse {
+    bool isFlushed;
+    bool isStalled;
+    bool isDataForwarded;
+    bool isProgramTerminated;
+
+    UIResponse() : isFlushed(false), isStalled(false), isDataForwarded(false), isProgramTerminated(false) {}
+};
+
+struct PipelineDiagramInfo {
+    bool ExExForwarding;
+    bool MemMemForwarding;
+    bool MemExForwarding;
+    bool BranchToFetch;
+    bool ExToBranch;
+
+    PipelineDiagramInfo() : ExExForwarding(false), MemMemForwarding(false), MemExForwarding(false), BranchToFetch(false), ExToBranch(false) {}
+};
+
+// Hooks for the browser view: what happened in the last cycle, plus the data bytes stored to
+// since takeDirtyRanges() was last called, merged into [begin, end) ranges.
+class UIHooks {
+public:
+    static constexpr size_t DIRTY_LIMIT = 4096;
+
+    inline void onCycleBegin() {
+        uiResponse = UIResponse();
+        diagram = PipelineDiagramInfo();
+    }
+    inline void onStall() { uiResponse.isStalled = true; }
+    inline void onFlush() { uiResponse.isFlushed = true; }
+    inline void onForward(EventKind kind) {
+        uiResponse.isDataForwarded = true;
+        switch (kind) {
+            case EventKind::FORWARD_EX_EX: diagram.ExExForwarding = true; break;
+            case EventKind::FORWARD_MEM_EX: diagram.MemExForwarding = true; break;
+            case EventKind::FORWARD_MEM_MEM: diagram.MemMemForwarding = true; break;
+            default: break;
+        }
+    }
+    inline void onBranchToFetch() { diagram.BranchToFetch = true; }
+    inline void onBranchResolved() { diagram.ExToBranch = true; }
+    inline void onStore(uint32_t address, uint32_t size);
+    inline void onTerminated() { uiResponse.isProgramTerminated = true; }
+    inline void onReset() {
+        uiResponse = UIResponse();
+        diagram = PipelineDiagramInfo();
+        dirty.clear();
+    }
+
+    inline const UIResponse& getUIResponse() const { return uiResponse; }
+    inline const PipelineDiagramInfo& getPipelineDiagramInfo() const { return diagram; }
+    inline std::vector<std::pair<uint32_t, uint32_t>> takeDirtyRanges();
+
+private:
+    UIResponse uiResponse;
+    PipelineDiagramInfo diagram;
+    std::vector<std::pair<uint32_t, uint32_t>> dirty;
+
+    inline void mergeDirty();
+};
+
+inline void UIHooks::onStore(uint32_t address, uint32_t size) {
+    uint32_t end = address + size;
+    if (!dirty.empty() && dirty.back().first <= address && address <= dirty.back().second) {
+        dirty.back().second = std::max(dirty.back().second, end);
+    } else {
+        dirty.emplace_back(address, end);
+        if (dirty.size() >= DIRTY_LIMIT) mergeDirty();
+    }
+}
+
+// Past DIRTY_LIMIT / 2 disjoint ranges the hull is reported instead.
+inline void UIHooks::mergeDirty() {
+    std::sort(dirty.begin(), dirty.end());
+    size_t last = 0;
+    for (size_t i = 1; i < dirty.size(); i++) {
+        if (dirty[i].first <= dirty[last].second) {
+            dirty[last].second = std::max(dirty[last].second, dirty[i].second);
+        } else {
+            dirty[++last] = dirty[i];
+        }
+    }
+    dirty.resize(dirty.empty() ? 0 : last + 1);
+    if (dirty.size() >= DIRTY_LIMIT / 2) {
+        dirty = {{dirty.front().first, dirty.back().second}};
+    }
+}
+
+inline std::vector<std::pair<uint32_t, uint32_t>> UIHooks::takeDirtyRanges() {
+    mergeDirty();
+    std::vector<std::pair<uint32_t, uint32_t>> ranges = std::move(dirty);
+    dirty.clear();
+    return ranges;
+}
+
+#endif
@@ -0,0 +1,397 @@
+#ifndef INCREMENTAL_HPP
+#define INCREMENTAL_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "types.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "assembler.hpp"
+#include "memory.hpp"
+#include "program.hpp"
+
+using namespace riscv;
+
+// Difference between two successive assemblies of the editor buffer, keyed by address. error
+// holds every lexer, parser or assembler error, one per line; empty is set when no line has any
+// tokens.
+struct ProgramDiff {
+    bool success;
+    bool empty;
+    size_t reencoded;
+    std::string error;
+    std::vector<std::pair<uint32_t, uint32_t>> textChanged;
+    std::vector<uint32_t> textRemoved;
+    std::vector<std::pair<uint32_t, uint8_t>> dataChanged;
+    std::vector<uint32_t> dataRemoved;
+
+    ProgramDiff() : success(false), empty(false), reencoded(0) {}
+};
+
+// Keeps the tokens and machine code of every source line so that an edit only re-lexes the
+// edited lines and only re-encodes the .text lines whose encoding can have changed: the edited
+// ones and those referring to a label that moved. Label addresses still come from a full first
+// pass, which is cheap next to encoding. Anything the incremental path cannot reproduce exactly
+// (section directives, failed assemblies) falls back to a full Parser/Assembler run over the
+// cached tokens, so the result always matches assembleProgram() over the same text.
+class IncrementalAssembler {
+public:
+    // Replaces removedLines source lines starting at firstLine (0-based) with newLines.
+    inline ProgramDiff update(size_t firstLine, size_t removedLines, const std::vector<std::string>& newLines);
+
+    inline size_t lineCount() const { return lines.size(); }
+    inline const std::vector<std::pair<uint32_t, uint32_t>>& getText() const { return text; }
+    inline const std::vector<std::pair<uint32_t, uint8_t>>& getData() const { return data; }
+
+    // Image of the last successful assembly, with 1-based source lines.
+    inline std::shared_ptr<const ProgramImage> buildImage() const;
+
+private:
+    // The source is kept on the heap so the token views into it survive the line moving when
+    // lines are inserted or erased.
+    struct SourceLine {
+        std::unique_ptr<const std::string> source;
+        std::vector<std::string> references;
+        std::string lexError;
+        bool edited;
+        bool inText;
+        uint32_t address;
+        size_t instructionCount;
+        std::vector<std::pair<uint32_t, uint32_t>> code;
+
+        explicit SourceLine(std::string text)
+            : source(std::make_unique<const std::string>(std::move(text))), edited(true), inText(false), address(0), instructionCount(0) {}
+    };
+
+    std::vector<SourceLine> lines;
+    std::vector<std::vector<TokenView>> tokens;
+    std::unordered_map<std::string, SymbolEntry> symbolTable;
+    std::vector<std::pair<uint32_t, uint32_t>> text;
+    std::vector<std::pair<uint32_t, uint8_t>> data;
+    std::vector<std::pair<uint32_t, uint8_t>> rebuiltData;
+    bool dataRebuilt = false;
+    size_t reencoded = 0;
+    bool valid = false;
+
+    inline void lexLine(size_t index);
+    inline bool prepare(ProgramDiff& diff);
+    inline void layoutLines();
+    inline bool assembleFull(ProgramDiff& diff);
+    inline bool assembleIncremental(bool dataTouched, ProgramDiff& diff);
+
+    static inline bool isSectionLine(const std::vector<TokenView>& line);
+    static inline std::vector<std::pair<uint32_t, uint8_t>> collectData(const std::vector<std::pair<uint32_t, uint32_t>>& machineCode);
+};
+
+inline bool IncrementalAssembler::isSectionLine(const std::vector<TokenView>& line) {
+    return !line.empty() && line[0].type == TokenType::DIRECTIVE;
+}
+
+// Byte per address, the later write winning as it does when ProgramImage fills its Memory.
+inline std::vector<std::pair<uint32_t, uint8_t>> IncrementalAssembler::collectData(const std::vector<std::pair<uint32_t, uint32_t>>& machineCode) {
+    std::vector<std::pair<uint32_t, uint8_t>> bytes;
+    for (const auto& [address, value] : machineCode) {
+        if (address >= DATA_SEGMENT_START) {
+            bytes.emplace_back(address, static_cast<uint8_t>(value));
+        }
+    }
+    std::stable_sort(bytes.begin(), bytes.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<std::pair<uint32_t, uint8_t>> unique;
+    unique.reserve(bytes.size());
+    for (const auto& entry : bytes) {
+        if (!unique.empty() && unique.back().first == entry.first) {
+            unique.back().second = entry.second;
+        } else {
+            unique.push_back(entry);
+        }
+    }
+    return unique;
+}
+
+// Lexer errors are kept per line and reported in source order by prepare().
+inline void IncrementalAssembler::lexLine(size_t index) {
+    SourceLine& line = lines[index];
+    line.lexError.clear();
+    line.references.clear();
+    Diagnostics diagnostics;
+    tokens[index] = Lexer::tokenizeLine(*line.source, static_cast<int>(index + 1), diagnostics);
+    line.lexError = diagnostics.format();
+    for (const TokenView& token : tokens[index]) {
+        if (token.type == TokenType::LABEL || token.type == TokenType::UNKNOWN) {
+            line.references.emplace_back(token.value);
+        }
+    }
+}
+
+// Returns false when the program cannot be assembled at all.
+inline bool IncrementalAssembler::prepare(ProgramDiff& diff) {
+    for (const SourceLine& line : lines) {
+        if (!line.lexError.empty()) {
+            diff.error += (diff.error.empty() ? "" : "\n") + line.lexError;
+        }
+    }
+    if (!diff.error.empty()) return false;
+    bool anyTokens = std::any_of(tokens.begin(), tokens.end(), [](const std::vector<TokenView>& line) { return !line.empty(); });
+    diff.empty = !anyTokens;
+    return anyTokens;
+}
+
+// Section of every line and the address its words end up at; a repeated .text carries on after
+// the previous one, as in the parser.
+inline void IncrementalAssembler::layoutLines() {
+    bool inText = true;
+    uint32_t address = TEXT_SEGMENT_START;
+    for (size_t i = 0; i < lines.size(); i++) {
+        SourceLine& line = lines[i];
+        const std::vector<TokenView>& lineTokens = tokens[i];
+        if (isSectionLine(lineTokens)) {
+            if (lineTokens[0].value == ".data") {
+                inText = false;
+            } else if (lineTokens[0].value == ".text") {
+                inText = true;
+            }
+            line.inText = false;
+            line.instructionCount = 0;
+            continue;
+        }
+        line.inText = inText;
+        line.address = address;
+        line.instructionCount = inText ? Parser::countInstructions(tokenLine(lineTokens)) : 0;
+        address += static_cast<uint32_t>(line.instructionCount) * INSTRUCTION_SIZE;
+    }
+}
+
+inline bool IncrementalAssembler::assembleFull(ProgramDiff& diff) {
+    Parser parser(tokens);
+    if (!parser.parse()) {
+        diff.error = parser.getDiagnostics().format();
+        return false;
+    }
+    Assembler assembler(parser.getSymbolTable(), parser.getParsedInstructions());
+    if (!assembler.assemble()) {
+        diff.error = assembler.getDiagnostics().format();
+        return false;
+    }
+
+    layoutLines();
+    const auto& machineCode = assembler.getMachineCode();
+    size_t next = 0;
+    for (SourceLine& line : lines) {
+        line.code.clear();
+        if (!line.inText || line.instructionCount == 0) continue;
+        uint32_t end = line.address + static_cast<uint32_t>(line.instructionCount) * INSTRUCTION_SIZE;
+        while (next < machineCode.size() && machineCode[next].first < end) {
+            line.code.push_back(machineCode[next++]);
+        }
+    }
+    symbolTable = parser.getSymbolTable();
+    rebuiltData = collectData(machineCode);
+    dataRebuilt = true;
+    reencoded = lines.size();
+    return true;
+}
+
+inline bool IncrementalAssembler::assembleIncremental(bool dataTouched, ProgramDiff& diff) {
+    std::vector<uint32_t> previous(lines.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        previous[i] = lines[i].address;
+    }
+
+    Parser parser(tokens);
+    if (!parser.layout()) {
+        diff.error = parser.getDiagnostics().format();
+        return false;
+    }
+    layoutLines();
+    for (const SourceLine& line : lines) {
+        dataTouched = dataTouched || (line.edited && !line.inText);
+    }
+
+    const std::unordered_map<std::string, SymbolEntry>& newSymbols = parser.getSymbolTable();
+    std::unordered_set<std::string> moved;
+    for (const auto& [name, entry] : newSymbols) {
+        auto it = symbolTable.find(name);
+        if (it == symbolTable.end() || it->second.address != entry.address) moved.insert(name);
+    }
+    for (const auto& entry : symbolTable) {
+        if (!newSymbols.count(entry.first)) moved.insert(entry.first);
+    }
+
+    // Parse every stale line before encoding any of them, as a full assembly would.
+    std::vector<std::pair<size_t, std::vector<ParsedInstruction>>> stale;
+    for (size_t i = 0; i < lines.size(); i++) {
+        SourceLine& line = lines[i];
+        if (!line.inText) {
+            if (line.edited && std::any_of(tokens[i].begin(), tokens[i].end(), [](const TokenView& t) { return t.type == TokenType::OPCODE; })) {
+                return assembleFull(diff);
+            }
+            line.code.clear();
+            continue;
+        }
+        if (line.instructionCount == 0) {
+            line.code.clear();
+            continue;
+        }
+        bool referencesMoved = std::any_of(line.references.begin(), line.references.end(),
+                                           [&moved](const std::string& name) { return moved.count(name) > 0; });
+        bool relocated = previous[i] != line.address;
+        if (line.edited || line.code.size() != line.instructionCount || referencesMoved || (relocated && !line.references.empty())) {
+            std::vector<ParsedInstruction> parsed = parser.parseTextLine(tokenLine(tokens[i]), line.address);
+            bool invalid = std::any_of(parsed.begin(), parsed.end(), [](const ParsedInstruction& inst) { return inst.instruction == Instructions::INVALID; });
+            if (parsed.size() != line.instructionCount || invalid) {
+                return assembleFull(diff);
+            }
+            stale.emplace_back(i, std::move(parsed));
+        } else if (relocated) {
+            uint32_t shift = line.address - previous[i];
+            for (auto& entry : line.code) entry.first += shift;
+        }
+    }
+
+    Assembler encoder({}, {});
+    Diagnostics encodeDiagnostics;
+    for (auto& [index, parsed] : stale) {
+        SourceLine& line = lines[index];
+        line.code.clear();
+        for (const ParsedInstruction& inst : parsed) {
+            line.code.emplace_back(inst.address, encoder.encodeInstruction(inst, encodeDiagnostics));
+        }
+    }
+    if (!encodeDiagnostics.empty()) {
+        diff.error = encodeDiagnostics.format();
+        return false;
+    }
+    reencoded = stale.size();
+
+    if (dataTouched) {
+        Assembler dataAssembler(newSymbols, {});
+        if (!dataAssembler.assemble()) {
+            diff.error = dataAssembler.getDiagnostics().format();
+            return false;
+        }
+        rebuiltData = collectData(dataAssembler.getMachineCode());
+        dataRebuilt = true;
+    }
+    symbolTable = newSymbols;
+    return true;
+}
+
+template <typename T>
+inline void diffEntries(const std::vector<std::pair<uint32_t, T>>& before, const std::vector<std::pair<uint32_t, T>>& after,
+                        std::vector<std::pair<uint32_t, T>>& changed, std::vector<uint32_t>& removed) {
+    size_t i = 0, j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && before[i].first < after[j].first)) {
+            removed.push_back(before[i++].first);
+        } else if (i == before.size() || after[j].first < before[i].first) {
+            changed.push_back(after[j++]);
+        } else {
+            if (before[i].second != after[j].second) changed.push_back(after[j]);
+            i++;
+            j++;
+        }
+    }
+}
+
+inline ProgramDiff IncrementalAssembler::update(size_t firstLine, size_t removedLines, const std::vector<std::string>& newLines) {
+    ProgramDiff diff;
+    firstLine = std::min(firstLine, lines.size());
+    removedLines = std::min(removedLines, lines.size() - firstLine);
+
+    bool full = !valid || removedLines == lines.size();
+    bool dataTouched = false;
+    for (size_t i = firstLine; i < firstLine + removedLines; i++) {
+        full = full || isSectionLine(tokens[i]);
+        dataTouched = dataTouched || !lines[i].inText;
+    }
+
+    lines.erase(lines.begin() + firstLine, lines.begin() + firstLine + removedLines);
+    tokens.erase(tokens.begin() + firstLine, tokens.begin() + firstLine + removedLines);
+    std::vector<SourceLine> inserted;
+    inserted.reserve(newLines.size());
+    for (const std::string& source : newLines) {
+        inserted.emplace_back(source);
+    }
+    lines.insert(lines.begin() + firstLine, std::make_move_iterator(inserted.begin()), std::make_move_iterator(inserted.end()));
+    tokens.insert(tokens.begin() + firstLine, newLines.size(), std::vector<TokenView>());
+    if (lines.empty()) {
+        lines.emplace_back(std::string());
+        tokens.emplace_back();
+    }
+
+    // Later lines only need their line numbers fixed, unless a stored error quotes one.
+    if (newLines.size() != removedLines) {
+        for (size_t i = firstLine + newLines.size(); i < lines.size(); i++) {
+            if (!lines[i].lexError.empty()) {
+                lexLine(i);
+                continue;
+            }
+            for (TokenView& token : tokens[i]) token.lineNumber = static_cast<int>(i + 1);
+        }
+    }
+    for (size_t i = firstLine; i < firstLine + newLines.size(); i++) {
+        lexLine(i);
+        full = full || isSectionLine(tokens[i]);
+    }
+
+    bool success = false;
+    dataRebuilt = false;
+    reencoded = 0;
+    try {
+        if (prepare(diff)) {
+            success = full ? assembleFull(diff) : assembleIncremental(dataTouched, diff);
+        }
+    } catch (const std::exception& e) {
+        diff.error = e.what();
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> newText;
+    if (success) {
+        for (const SourceLine& line : lines) {
+            newText.insert(newText.end(), line.code.begin(), line.code.end());
+        }
+    }
+    diffEntries(text, newText, diff.textChanged, diff.textRemoved);
+    text = std::move(newText);
+    if (!success || dataRebuilt) {
+        if (!success) rebuiltData.clear();
+        diffEntries(data, rebuiltData, diff.dataChanged, diff.dataRemoved);
+        data = std::move(rebuiltData);
+        rebuiltData.clear();
+    }
+
+    for (SourceLine& line : lines) {
+        line.edited = !success;
+    }
+    valid = success;
+    diff.success = success;
+    diff.reencoded = success ? reencoded : 0;
+    return diff;
+}
+
+inline std::shared_ptr<const ProgramImage> IncrementalAssembler::buildImage() const {
+    std::vector<uint32_t> words;
+    std::vector<uint32_t> sourceLines;
+    words.reserve(text.size());
+    sourceLines.reserve(text.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        for (const auto& entry : lines[i].code) {
+            words.push_back(entry.second);
+            sourceLines.push_back(static_cast<uint32_t>(i + 1));
+        }
+    }
+    Memory memory;
+    for (const auto& [address, value] : data) {
+        memory.writeByte(address, value);
+    }
+    return std::make_shared<const ProgramImage>(std::move(words), std::move(memory), symbolTable, std::move(sourceLines));
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef IO_HPP
+#define IO_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Path that stands for standard input or standard output.
+inline constexpr const char* STANDARD_STREAM_PATH = "-";
+inline constexpr size_t SOURCE_READ_CHUNK = 1 << 16;
+inline constexpr size_t WRITER_BUFFER_SIZE = 1 << 16;
+
+inline bool isStandardStream(const std::string& path) {
+    return path == STANDARD_STREAM_PATH;
+}
+
+// Read-only view of a whole input. A regular file is mapped, so the lexer scans the page cache in
+// place with no copy; standard input, pipes and anything else that cannot be mapped are read in
+// chunks into one growing buffer.
+class SourceBuffer {
+public:
+    inline explicit SourceBuffer(const std::string& path);
+    inline ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    inline std::string_view view() const { return {data, length}; }
+    inline const uint8_t* bytes() const { return reinterpret_cast<const uint8_t*>(data); }
+    inline size_t size() const { return length; }
+    inline bool isMapped() const { return mapping != nullptr; }
+
+private:
+    const char* data;
+    size_t length;
+    void* mapping;
+    std::vector<char> buffer;
+
+    inline void readAll(int fd, const std::string& path);
+};
+
+inline SourceBuffer::SourceBuffer(const std::string& path) : data(""), length(0), mapping(nullptr) {
+    bool standardInput = isStandardStream(path);
+    int fd = standardInput ? STDIN_FILENO : open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            mapping = mapped;
+            data = static_cast<const char*>(mapped);
+            length = static_cast<size_t>(info.st_size);
+        }
+    }
+    if (mapping == nullptr) {
+        try {
+            readAll(fd, path);
+        } catch (...) {
+            if (!standardInput) close(fd);
+            throw;
+        }
+    }
+    if (!standardInput) close(fd);
+}
+
+inline SourceBuffer::~SourceBuffer() {
+    if (mapping != nullptr) munmap(mapping, length);
+}
+
+inline void SourceBuffer::readAll(int fd, const std::string& path) {
+    size_t used = 0;
+    while (true) {
+        if (buffer.size() - used < SOURCE_READ_CHUNK) buffer.resize(std::max(buffer.size() * 2, used + SOURCE_READ_CHUNK));
+        ssize_t count = read(fd, buffer.data() + used, buffer.size() - used);
+        if (count == 0) break;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Could not read file: " + path + " (" + std::strerror(errno) + ")");
+        }
+        used += static_cast<size_t>(count);
+    }
+    buffer.resize(used);
+    data = buffer.empty() ? "" : buffer.data();
+    length = used;
+}
+
+// Output file, or standard output for "-", written through one fixed buffer with plain write(2)
+// calls: no stream formatting state and no per-field virtual calls. close() reports write errors;
+// the destructor only makes a best effort to flush.
+class BufferedWriter {
+public:
+    inline explicit BufferedWriter(const std::string& path);
+    inline ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    inline void write(std::string_view text);
+    inline void put(char c) {
+        if (used == WRITER_BUFFER_SIZE) flush();
+        buffer[used++] = c;
+    }
+    // Zero-padded lower-case hex, without a prefix.
+    inline void writeHex(uint32_t value, int digits);
+    inline void flush();
+    inline void close();
+
+private:
+    std::string path;
+    int fd;
+    bool ownsDescriptor;
+    std::unique_ptr<char[]> buffer;
+    size_t used;
+};
+
+inline BufferedWriter::BufferedWriter(const std::string& path)
+    : path(path), fd(-1), ownsDescriptor(!isStandardStream(path)), buffer(new char[WRITER_BUFFER_SIZE]), used(0) {
+    fd = ownsDescriptor ? open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+    if (fd < 0) {
+        throw std::runtime_error("Could not open output file for writing: " + path);
+    }
+}
+
+inline BufferedWriter::~BufferedWriter() {
+    if (fd < 0) return;
+    try {
+        flush();
+    } catch (const std::exception&) {
+    }
+    if (ownsDescriptor) ::close(fd);
+}
+
+inline void BufferedWriter::write(std::string_view text) {
+    while (!text.empty()) {
+        if (used == WRITER_BUFFER_SIZE) flush();
+        size_t count = std::min(text.size(), WRITER_BUFFER_SIZE - used);
+        std::memcpy(buffer.get() + used, text.data(), count);
+        used += count;
+        text.remove_prefix(count);
+    }
+}
+
+inline void BufferedWriter::writeHex(uint32_t value, int digits) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    char text[8];
+    for (int i = digits - 1; i >= 0; i--) {
+        text[i] = HEX_DIGITS[value & 0xF];
+        value >>= 4;
+    }
+    write(std::string_view(text, static_cast<size_t>(digits)));
+}
+
+inline void BufferedWriter::flush() {
+    size_t written = 0;
+    while (written < used) {
+        ssize_t count = ::write(fd, buffer.get() + written, used - written);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            used = 0;
+            throw std::runtime_error("Could not write output file: " + path + " (" + std::strerror(errno) + ")");
+        }
+        written += static_cast<size_t>(count);
+    }
+    used = 0;
+}
+
+inline void BufferedWriter::close() {
+    if (fd < 0) return;
+    flush();
+    if (ownsDescriptor && ::close(fd) != 0) {
+        fd = -1;
+        throw std::runtime_error("Could not write output file: " + path);
+    }
+    fd = -1;
+}
+
+#endif
@@ -1,49 +1,95 @@
 #ifndef LEXER_HPP
 #define LEXER_HPP
 
-#include <sstream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cctype>
 #include <algorithm>
 #include <stdexcept>
 #include "types.hpp"
+#include "parallel.hpp"
+#include "diagnostics.hpp"
 
 using namespace riscv;
 
+// Token whose text points into the scanned source buffer (or, for an omitted memory offset, at a
+// static "0"). The buffer has to outlive the token.
+struct TokenView {
+    TokenType type;
+    std::string_view value;
+    int lineNumber;
+};
+
+// Tokens of one source line, as a range of some longer-lived token array.
+struct TokenLine {
+    const TokenView* first;
+    const TokenView* last;
+
+    inline size_t size() const { return static_cast<size_t>(last - first); }
+    inline bool empty() const { return first == last; }
+    inline const TokenView& operator[](size_t i) const { return first[i]; }
+    inline const TokenView* begin() const { return first; }
+    inline const TokenView* end() const { return last; }
+    // Tokens [from, to) of this line.
+    inline TokenLine slice(size_t from, size_t to) const { return {first + from, first + to}; }
+};
+
+inline TokenLine tokenLine(const std::vector<TokenView>& tokens) {
+    return {tokens.data(), tokens.data() + tokens.size()};
+}
+
+// Flat token array for a whole source buffer. Line i (counting only lines that produced tokens)
+// is tokens[lineStarts[i], lineStarts[i + 1]).
+struct TokenStream {
+    std::vector<TokenView> tokens;
+    std::vector<size_t> lineStarts;
+
+    inline size_t lineCount() const { return lineStarts.empty() ? 0 : lineStarts.size() - 1; }
+    inline const TokenView* lineBegin(size_t line) const { return tokens.data() + lineStarts[line]; }
+    inline const TokenView* lineEnd(size_t line) const { return tokens.data() + lineStarts[line + 1]; }
+    inline TokenLine line(size_t line) const { return {lineBegin(line), lineEnd(line)}; }
+};
+
+// The overloads taking a Diagnostics buffer never throw: malformed lines are reported there and
+// skipped, and scanning goes on. The others throw once, with every error, when any were found.
 class Lexer {
 public:
-    static std::vector<std::vector<Token>> tokenize(const std::string& input);
+    static TokenStream scan(std::string_view input, size_t threads = 1);
+    static TokenStream scan(std::string_view input, Diagnostics& diagnostics, size_t threads = 1);
+    static std::vector<TokenView> tokenizeLine(std::string_view line, int lineNumber);
+    static std::vector<TokenView> tokenizeLine(std::string_view line, int lineNumber, Diagnostics& diagnostics);
 
 private:
-    static std::vector<Token> tokenizeLine(const std::string& line, int lineNumber);
+    static constexpr size_t MIN_CHUNK_BYTES = 1 << 16;
+
+    static void scanLines(std::string_view input, int lineNumber, TokenStream& stream, Diagnostics& diagnostics);
+    static void scanLine(std::string_view line, int lineNumber, std::vector<TokenView>& tokens, Diagnostics& diagnostics);
 
-    static Token classifyToken(const std::string& token, int lineNumber);
+    static TokenView classifyToken(std::string_view token, int lineNumber);
+    static bool splitMemory(std::string_view token, std::string_view& offset, std::string_view& reg);
 
-    static bool isDirective(const std::string& token);
-    static bool isLabel(const std::string& token);
+    static bool isDirective(std::string_view token);
+    static bool isLabel(std::string_view token);
 
-    static void reportError(const std::string& message, int lineNumber);
+    static void reportError(Diagnostics& diagnostics, const std::string& message, int lineNumber);
 };
 
-inline bool Lexer::isDirective(const std::string& token) {
-    return directives.count(token) > 0;
+inline bool Lexer::isDirective(std::string_view token) {
+    return DIRECTIVE_TABLE.contains(token);
 }
 
-inline bool Lexer::isLabel(const std::string& token) {
+inline bool Lexer::isLabel(std::string_view token) {
     return !token.empty() && token.back() == ':' && std::all_of(token.begin(), token.end() - 1, [](char c) { return std::isalnum(c) || c == '_' || c == '.'; });
 }
 
-inline Token Lexer::classifyToken(const std::string& token, int lineNumber) {
-    std::string trimmed = trim(token);
-    if (trimmed.empty()) {
-        throw std::runtime_error(std::string(RED) + "Empty token found on line " + std::to_string(lineNumber) + RESET);
-        return {TokenType::UNKNOWN, "", lineNumber};
-    }
+// Tokens are cut at whitespace, so they are never empty.
+inline TokenView Lexer::classifyToken(std::string_view token, int lineNumber) {
+    std::string_view trimmed = trimView(token);
     if (isRegister(trimmed)) {
         return {TokenType::REGISTER, trimmed, lineNumber};
     }
-    if (opcodes.count(trimmed)) {
+    if (OPCODE_TABLE.contains(trimmed)) {
         return {TokenType::OPCODE, trimmed, lineNumber};
     }
     if (isDirective(trimmed)) {
@@ -58,108 +104,205 @@ inline Token Lexer::classifyToken(const std::string& token, int lineNumber) {
     return {TokenType::UNKNOWN, trimmed, lineNumber};
 }
 
-inline void Lexer::reportError(const std::string& message, int lineNumber) {
-    throw std::runtime_error(std::string(RED) + "Lexer Error on Line " + std::to_string(lineNumber) + ": " + message + RESET);
+// Splits "offset(reg)" into its parts; an empty offset becomes "0".
+inline bool Lexer::splitMemory(std::string_view token, std::string_view& offset, std::string_view& reg) {
+    size_t open = token.find('(');
+    size_t close = token.find(')', open);
+    if (open == std::string_view::npos || close == std::string_view::npos || close <= open) return false;
+    offset = trimView(token.substr(0, open));
+    reg = trimView(token.substr(open + 1, close - open - 1));
+    if (offset.empty()) offset = "0";
+    if (!isRegister(reg) || !isImmediate(offset)) return false;
+    if (close + 1 < token.length() && !trimView(token.substr(close + 1)).empty()) return false;
+    return true;
+}
+
+inline void Lexer::reportError(Diagnostics& diagnostics, const std::string& message, int lineNumber) {
+    diagnostics.error(DiagnosticSource::LEXER, message, lineNumber);
 }
 
-inline std::vector<Token> Lexer::tokenizeLine(const std::string& line, int lineNumber) {
-    std::vector<Token> tokens;
-    std::string currentToken;
+// A line with an error is reported and contributes no tokens.
+inline void Lexer::scanLine(std::string_view rawLine, int lineNumber, std::vector<TokenView>& tokens, Diagnostics& diagnostics) {
+    std::string_view line = trimView(rawLine);
+    size_t lineTokens = tokens.size();
+    size_t lineErrors = diagnostics.size();
+    size_t tokenStart = std::string_view::npos;
     bool inString = false;
     bool inMemory = false;
     int parenthesesCount = 0;
 
-    const std::string& trimmedLine = trim(line);
-    if (trimmedLine.empty()) return tokens;
+    auto flush = [&](size_t end) {
+        if (tokenStart != std::string_view::npos) {
+            tokens.push_back(classifyToken(line.substr(tokenStart, end - tokenStart), lineNumber));
+            tokenStart = std::string_view::npos;
+        }
+    };
 
-    for (size_t i = 0; i < trimmedLine.length(); ++i) {
-        char c = trimmedLine[i];
-        if (!inString && !inMemory && (c == '#' || (c == '/' && i + 1 < trimmedLine.length() && trimmedLine[i + 1] == '/'))) {
+    size_t i = 0;
+    for (; i < line.length(); ++i) {
+        char c = line[i];
+        if (!inString && !inMemory && (c == '#' || (c == '/' && i + 1 < line.length() && line[i + 1] == '/'))) {
             break;
         }
         if (c == '"' && !inMemory) {
             if (inString) {
-                tokens.push_back({TokenType::STRING, currentToken, lineNumber});
-                currentToken.clear();
+                tokens.push_back({TokenType::STRING, line.substr(tokenStart, i - tokenStart), lineNumber});
+                tokenStart = std::string_view::npos;
                 inString = false;
             } else {
-                if (!currentToken.empty()) {
-                    tokens.push_back(classifyToken(currentToken, lineNumber));
-                    currentToken.clear();
-                }
+                flush(i);
                 inString = true;
+                tokenStart = i + 1;
             }
             continue;
         }
         if (inString) {
-            currentToken += c;
             continue;
         }
         if (c == '(' && !inMemory) {
             inMemory = true;
             parenthesesCount = 1;
-            currentToken += c;
+            if (tokenStart == std::string_view::npos) tokenStart = i;
             continue;
         }
         if (inMemory) {
-            currentToken += c;
             if (c == '(') ++parenthesesCount;
             if (c == ')') --parenthesesCount;
             if (parenthesesCount == 0) {
                 inMemory = false;
-                std::string offset, reg;
-                if (isMemory(currentToken, offset, reg)) {
+                std::string_view memory = line.substr(tokenStart, i + 1 - tokenStart);
+                std::string_view offset, reg;
+                if (splitMemory(memory, offset, reg)) {
                     tokens.push_back({TokenType::IMMEDIATE, offset, lineNumber});
                     tokens.push_back({TokenType::REGISTER, reg, lineNumber});
                 } else {
-                    throw std::runtime_error(std::string(RED) + "Invalid memory reference: " + currentToken + RESET);
+                    reportError(diagnostics, "Invalid memory reference: " + std::string(memory), lineNumber);
                 }
-                currentToken.clear();
+                tokenStart = std::string_view::npos;
             }
             continue;
         }
-        if (std::isspace(c) || c == ',') {
-            if (!currentToken.empty()) {
-                tokens.push_back(classifyToken(currentToken, lineNumber));
-                currentToken.clear();
-            }
+        if (std::isspace(static_cast<unsigned char>(c)) || c == ',') {
+            flush(i);
             continue;
         }
-        currentToken += c;
+        if (tokenStart == std::string_view::npos) tokenStart = i;
     }
-    if (!currentToken.empty()) {
-        tokens.push_back(classifyToken(currentToken, lineNumber));
+    if (!inString && !inMemory) {
+        flush(i);
     }
     if (inString) {
-        reportError("Unterminated string", lineNumber);
+        reportError(diagnostics, "Unterminated string", lineNumber);
     }
     if (inMemory) {
-        reportError("Unterminated memory reference", lineNumber);
+        reportError(diagnostics, "Unterminated memory reference", lineNumber);
+    }
+    if (diagnostics.size() != lineErrors) {
+        tokens.resize(lineTokens);
     }
-    return tokens;
 }
 
-inline std::vector<std::vector<Token>> Lexer::tokenize(const std::string& input) {
-    std::vector<std::vector<Token>> tokenizedLines;
+inline void Lexer::scanLines(std::string_view input, int lineNumber, TokenStream& stream, Diagnostics& diagnostics) {
+    size_t lineStart = 0;
+    while (lineStart < input.size()) {
+        size_t lineEnd = input.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = input.size();
+        ++lineNumber;
+        scanLine(input.substr(lineStart, lineEnd - lineStart), lineNumber, stream.tokens, diagnostics);
+        if (stream.tokens.size() != stream.lineStarts.back()) {
+            stream.lineStarts.push_back(stream.tokens.size());
+        }
+        lineStart = lineEnd + 1;
+    }
+}
 
+// Single pass over the whole buffer: no per-line copies and no per-token strings. With threads > 1
+// a large buffer is cut into chunks on line boundaries that are scanned concurrently and then
+// concatenated in order, and so are their diagnostics.
+inline TokenStream Lexer::scan(std::string_view input, Diagnostics& diagnostics, size_t threads) {
+    TokenStream stream;
     if (input.empty()) {
-        reportError("Empty input provided", 0);
-        return tokenizedLines;
+        reportError(diagnostics, "Empty input provided", 0);
+        return stream;
     }
 
-    std::string inputStr(input);
-    std::istringstream inputStream(inputStr);
-    std::string line;
-    int lineNumber = 0;
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+    for (const auto& range : splitRange(input.size(), chunkCount(input.size(), threads, MIN_CHUNK_BYTES))) {
+        if (range.second <= begin) continue;
+        size_t end = input.find('\n', range.second - 1);
+        end = end == std::string_view::npos ? input.size() : end + 1;
+        chunks.push_back(input.substr(begin, end - begin));
+        begin = end;
+    }
 
-    while (std::getline(inputStream, line)) {
-        ++lineNumber;
-        std::vector<Token> tokens = tokenizeLine(line, lineNumber);
-        if (!tokens.empty()) {
-            tokenizedLines.push_back(std::move(tokens));
-        }
+    if (chunks.size() == 1) {
+        stream.tokens.reserve(input.size() / 4);
+        stream.lineStarts.push_back(0);
+        scanLines(input, 0, stream, diagnostics);
+        return stream;
+    }
+
+    // Counting newlines first gives every chunk its starting line number, so diagnostics match
+    // a serial scan.
+    std::vector<int> firstLine(chunks.size(), 0);
+    parallelRun(chunks.size(), threads, [&](size_t i) {
+        firstLine[i] = static_cast<int>(std::count(chunks[i].begin(), chunks[i].end(), '\n'));
+    });
+    for (size_t i = 0, line = 0; i < chunks.size(); i++) {
+        int newlines = firstLine[i];
+        firstLine[i] = static_cast<int>(line);
+        line += newlines;
+    }
+
+    std::vector<TokenStream> parts(chunks.size());
+    std::vector<Diagnostics> partDiagnostics(chunks.size());
+    parallelRun(chunks.size(), threads, [&](size_t i) {
+        parts[i].tokens.reserve(chunks[i].size() / 4);
+        parts[i].lineStarts.push_back(0);
+        scanLines(chunks[i], firstLine[i], parts[i], partDiagnostics[i]);
+    });
+    for (Diagnostics& part : partDiagnostics) {
+        diagnostics.append(std::move(part));
+    }
+
+    std::vector<size_t> tokenOffset(parts.size() + 1, 0);
+    std::vector<size_t> lineOffset(parts.size() + 1, 0);
+    for (size_t i = 0; i < parts.size(); i++) {
+        tokenOffset[i + 1] = tokenOffset[i] + parts[i].tokens.size();
+        lineOffset[i + 1] = lineOffset[i] + parts[i].lineStarts.size() - 1;
     }
-    return tokenizedLines;
+    stream.tokens.resize(tokenOffset.back());
+    stream.lineStarts.assign(lineOffset.back() + 1, 0);
+    parallelRun(parts.size(), threads, [&](size_t i) {
+        std::copy(parts[i].tokens.begin(), parts[i].tokens.end(), stream.tokens.begin() + tokenOffset[i]);
+        for (size_t line = 1; line < parts[i].lineStarts.size(); line++) {
+            stream.lineStarts[lineOffset[i] + line] = parts[i].lineStarts[line] + tokenOffset[i];
+        }
+    });
+    return stream;
+}
+
+inline TokenStream Lexer::scan(std::string_view input, size_t threads) {
+    Diagnostics diagnostics;
+    TokenStream stream = scan(input, diagnostics, threads);
+    diagnostics.throwIfAny();
+    return stream;
+}
+
+// One source line on its own, for callers that keep tokens per line (the incremental assembler).
+// The views point into line.
+inline std::vector<TokenView> Lexer::tokenizeLine(std::string_view line, int lineNumber, Diagnostics& diagnostics) {
+    std::vector<TokenView> tokens;
+    scanLine(line, lineNumber, tokens, diagnostics);
+    return tokens;
+}
+
+inline std::vector<TokenView> Lexer::tokenizeLine(std::string_view line, int lineNumber) {
+    Diagnostics diagnostics;
+    std::vector<TokenView> tokens = tokenizeLine(line, lineNumber, diagnostics);
+    diagnostics.throwIfAny();
+    return tokens;
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,229 @@
+#ifndef MEMORY_HPP
+#define MEMORY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include "types.hpp"
+
+using namespace riscv;
+
+// Sparse byte-addressable memory backed by 4 KiB pages behind a two-level page table.
+// Pages are allocated on first write; reads of unmapped bytes return zero. Range checks are
+// left to the callers so they can be done once per page instead of once per byte.
+// Copies share page tables and pages; whichever copy writes first gets a private duplicate.
+// generation() names the current set of page buffers: it changes whenever a page is mapped,
+// duplicated or dropped, so a caller holding pointers into the pages knows to fetch them again.
+class Memory {
+public:
+    static constexpr uint32_t PAGE_BITS = 12;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+    static constexpr uint32_t TABLE_BITS = 10;
+    static constexpr uint32_t TABLE_SIZE = 1u << TABLE_BITS;
+    static constexpr uint32_t DIRECTORY_SIZE = 1u << (32 - PAGE_BITS - TABLE_BITS);
+
+    Memory() : mappedPages(0), pageGeneration(nextGeneration()) {}
+    Memory(const Memory&) = default;
+    Memory& operator=(const Memory&) = default;
+    Memory(Memory&&) = default;
+    Memory& operator=(Memory&&) = default;
+
+    static inline uint32_t pageOffset(uint32_t address) { return address & (PAGE_SIZE - 1); }
+    static inline uint32_t pageBase(uint32_t address) { return address & ~(PAGE_SIZE - 1); }
+    static inline bool withinPage(uint32_t address, uint32_t size) { return pageOffset(address) + size <= PAGE_SIZE; }
+
+    inline const uint8_t* findPage(uint32_t address) const;
+    inline uint8_t* findWritablePage(uint32_t address);
+    inline uint8_t* touchPage(uint32_t address);
+
+    inline uint8_t readByte(uint32_t address) const;
+    inline void writeByte(uint32_t address, uint8_t value);
+    inline uint32_t read(uint32_t address, uint32_t size) const;
+    inline void write(uint32_t address, uint32_t value, uint32_t size);
+
+    static inline uint32_t readFromPage(const uint8_t* data, uint32_t size);
+    static inline void writeToPage(uint8_t* data, uint32_t value, uint32_t size);
+
+    template <typename Visitor>
+    void forEachPage(Visitor&& visit) const;
+    template <typename Visitor>
+    void forEachPageChangedSince(const Memory& base, Visitor&& visit) const;
+
+    inline size_t pageCount() const { return mappedPages; }
+    inline uint64_t generation() const { return pageGeneration; }
+    inline void clear();
+
+private:
+    struct Page {
+        uint8_t data[PAGE_SIZE];
+    };
+
+    struct PageTable {
+        std::array<std::shared_ptr<Page>, TABLE_SIZE> pages;
+    };
+
+    std::array<std::shared_ptr<PageTable>, DIRECTORY_SIZE> directory;
+    size_t mappedPages;
+    uint64_t pageGeneration;
+
+    static inline uint64_t nextGeneration() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    inline PageTable* writableTable(uint32_t address);
+
+    static inline uint32_t directoryIndex(uint32_t address) { return address >> (PAGE_BITS + TABLE_BITS); }
+    static inline uint32_t tableIndex(uint32_t address) { return (address >> PAGE_BITS) & (TABLE_SIZE - 1); }
+};
+
+inline const uint8_t* Memory::findPage(uint32_t address) const {
+    const auto& table = directory[directoryIndex(address)];
+    if (!table) return nullptr;
+    const auto& page = table->pages[tableIndex(address)];
+    return page ? page->data : nullptr;
+}
+
+inline Memory::PageTable* Memory::writableTable(uint32_t address) {
+    auto& table = directory[directoryIndex(address)];
+    if (table && table.use_count() > 1) {
+        table = std::make_shared<PageTable>(*table);
+    }
+    return table.get();
+}
+
+// Mapped page at address, made private to this Memory first if it is shared; nullptr if unmapped.
+inline uint8_t* Memory::findWritablePage(uint32_t address) {
+    if (!directory[directoryIndex(address)] || !directory[directoryIndex(address)]->pages[tableIndex(address)]) {
+        return nullptr;
+    }
+    auto& page = writableTable(address)->pages[tableIndex(address)];
+    if (page.use_count() > 1) {
+        page = std::make_shared<Page>(*page);
+        pageGeneration = nextGeneration();
+    }
+    return page->data;
+}
+
+inline uint8_t* Memory::touchPage(uint32_t address) {
+    if (uint8_t* data = findWritablePage(address)) {
+        return data;
+    }
+    auto& table = directory[directoryIndex(address)];
+    if (!table) {
+        table = std::make_shared<PageTable>();
+    }
+    auto& page = writableTable(address)->pages[tableIndex(address)];
+    page = std::make_shared<Page>();
+    std::memset(page->data, 0, PAGE_SIZE);
+    mappedPages++;
+    pageGeneration = nextGeneration();
+    return page->data;
+}
+
+inline uint8_t Memory::readByte(uint32_t address) const {
+    const uint8_t* page = findPage(address);
+    return page ? page[pageOffset(address)] : 0;
+}
+
+inline void Memory::writeByte(uint32_t address, uint8_t value) {
+    touchPage(address)[pageOffset(address)] = value;
+}
+
+inline uint32_t Memory::readFromPage(const uint8_t* data, uint32_t size) {
+    switch (size) {
+        case 1:
+            return data[0];
+        case 2: {
+            uint16_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+        default: {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+    }
+}
+
+inline void Memory::writeToPage(uint8_t* data, uint32_t value, uint32_t size) {
+    switch (size) {
+        case 1:
+            data[0] = static_cast<uint8_t>(value);
+            break;
+        case 2: {
+            uint16_t half = static_cast<uint16_t>(value);
+            std::memcpy(data, &half, sizeof(half));
+            break;
+        }
+        default:
+            std::memcpy(data, &value, sizeof(value));
+            break;
+    }
+}
+
+inline uint32_t Memory::read(uint32_t address, uint32_t size) const {
+    if (withinPage(address, size)) {
+        const uint8_t* page = findPage(address);
+        return page ? readFromPage(page + pageOffset(address), size) : 0;
+    }
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        value |= static_cast<uint32_t>(readByte(address + i)) << (8 * i);
+    }
+    return value;
+}
+
+inline void Memory::write(uint32_t address, uint32_t value, uint32_t size) {
+    if (withinPage(address, size)) {
+        writeToPage(touchPage(address) + pageOffset(address), value, size);
+        return;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        writeByte(address + i, (value >> (8 * i)) & 0xFF);
+    }
+}
+
+template <typename Visitor>
+void Memory::forEachPage(Visitor&& visit) const {
+    for (uint32_t d = 0; d < DIRECTORY_SIZE; d++) {
+        if (!directory[d]) continue;
+        for (uint32_t t = 0; t < TABLE_SIZE; t++) {
+            const auto& page = directory[d]->pages[t];
+            if (page) {
+                visit((d << (PAGE_BITS + TABLE_BITS)) | (t << PAGE_BITS), static_cast<const uint8_t*>(page->data));
+            }
+        }
+    }
+}
+
+// Visits (address, data, baseData) for every page whose buffer is no longer shared with base, which
+// is every page written since this Memory was copied from base. baseData is nullptr for pages
+// base does not map. Tables still shared with base are skipped without looking at their pages.
+template <typename Visitor>
+void Memory::forEachPageChangedSince(const Memory& base, Visitor&& visit) const {
+    for (uint32_t d = 0; d < DIRECTORY_SIZE; d++) {
+        if (!directory[d] || directory[d] == base.directory[d]) continue;
+        for (uint32_t t = 0; t < TABLE_SIZE; t++) {
+            const auto& page = directory[d]->pages[t];
+            const Page* basePage = base.directory[d] ? base.directory[d]->pages[t].get() : nullptr;
+            if (page && page.get() != basePage) {
+                visit((d << (PAGE_BITS + TABLE_BITS)) | (t << PAGE_BITS), static_cast<const uint8_t*>(page->data),
+                      basePage != nullptr ? static_cast<const uint8_t*>(basePage->data) : nullptr);
+            }
+        }
+    }
+}
+
+inline void Memory::clear() {
+    for (auto& table : directory) {
+        table.reset();
+    }
+    mappedPages = 0;
+    pageGeneration = nextGeneration();
+}
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef MULTIHART_HPP
+#define MULTIHART_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "types.hpp"
+#include "memory.hpp"
+#include "program.hpp"
+#include "parallel.hpp"
+#include "simulator.hpp"
+
+using namespace riscv;
+
+inline constexpr uint32_t DEFAULT_HART_QUANTUM = 1000;
+inline constexpr uint32_t MAX_HARTS = 64;
+// Each hart gets its own stack below the previous hart's.
+inline constexpr uint32_t HART_STACK_SIZE = 0x10000;
+inline constexpr uint32_t HART_ID_REGISTER = 4;
+
+// N harts running the same program over one shared data memory, each with its own registers,
+// pipeline, predictor and caches. Hart i starts with its id in tp (x4) and its stack pointer
+// HART_STACK_SIZE * i below the usual one, so hart 0 starts exactly like a single-core run.
+//
+// Harts advance in quanta of `quantum` cycles, in parallel on host threads, and meet at a barrier
+// after every quantum. During a quantum each hart works on a copy-on-write copy of the shared
+// memory, so it sees its own stores at once and nobody else's; at the barrier the bytes every
+// hart changed are merged into the shared memory in hart order and the result is handed back to
+// all of them. Stores therefore become visible to the other harts within one quantum, a byte
+// written by two harts in the same quantum keeps the value of the higher-numbered hart, and a run
+// is deterministic whatever the number of host threads.
+template <typename Sim = Simulator>
+class MultiHartSimulator {
+public:
+    explicit MultiHartSimulator(size_t harts, uint32_t quantum = DEFAULT_HART_QUANTUM);
+
+    inline size_t size() const { return harts.size(); }
+    inline Sim& hart(size_t index) { return *harts[index]; }
+    inline const Sim& hart(size_t index) const { return *harts[index]; }
+    inline uint32_t getQuantum() const { return quantum; }
+    inline const Memory& getMemory() const { return memory; }
+
+    bool loadProgram(const std::shared_ptr<const ProgramImage>& image);
+    void setEnvironment(bool pipeline, bool dataForwarding, bool branchPrediction, bool functional = false);
+    void setPredictorConfig(const PredictorConfig& config);
+    void setCacheConfig(const CacheConfig& icache, const CacheConfig& dcache);
+
+    // Runs until every hart has terminated or the harts have run maxCycles. Returns false
+    // when the cycle limit stopped the run.
+    bool run(size_t threads, uint64_t maxCycles);
+    bool isRunning() const;
+    uint32_t getCycles() const;
+    // Sums of the per-hart counters; totalCycles is the longest hart's, so CPI is machine cycles
+    // per instruction retired by any hart.
+    SimulationStats getAggregateStats();
+
+private:
+    std::vector<std::unique_ptr<Sim>> harts;
+    // One byte per hart rather than vector<bool>, so harts on different threads never share a word.
+    std::vector<uint8_t> active;
+    Memory memory;
+    uint32_t quantum;
+
+    void mergeQuantum();
+};
+
+template <typename Sim>
+MultiHartSimulator<Sim>::MultiHartSimulator(size_t count, uint32_t quantum) : quantum(std::max<uint32_t>(quantum, 1)) {
+    if (count == 0 || count > MAX_HARTS) {
+        throw std::runtime_error(std::string(RED) + "Hart count must be between 1 and " + std::to_string(MAX_HARTS) + RESET);
+    }
+    for (size_t i = 0; i < count; i++) {
+        harts.push_back(std::make_unique<Sim>());
+    }
+    active.assign(count, 0);
+}
+
+template <typename Sim>
+bool MultiHartSimulator<Sim>::loadProgram(const std::shared_ptr<const ProgramImage>& image) {
+    memory = image ? image->getData() : Memory();
+    for (size_t i = 0; i < harts.size(); i++) {
+        Sim& sim = *harts[i];
+        if (!sim.loadProgram(image)) return false;
+        uint32_t stack = sim.getRegisters()[2] - static_cast<uint32_t>(i) * HART_STACK_SIZE;
+        sim.setRegister(2, stack);
+        sim.setRegister(11, stack);
+        sim.setRegister(HART_ID_REGISTER, static_cast<uint32_t>(i));
+        sim.setMemory(memory);
+        active[i] = sim.isRunning() ? 1 : 0;
+    }
+    return true;
+}
+
+template <typename Sim>
+void MultiHartSimulator<Sim>::setEnvironment(bool pipeline, bool dataForwarding, bool branchPrediction, bool functional) {
+    for (std::unique_ptr<Sim>& sim : harts) {
+        sim->setEnvironment(pipeline, dataForwarding, branchPrediction, UINT32_MAX, functional);
+    }
+}
+
+template <typename Sim>
+void MultiHartSimulator<Sim>::setPredictorConfig(const PredictorConfig& config) {
+    for (std::unique_ptr<Sim>& sim : harts) sim->setPredictorConfig(config);
+}
+
+template <typename Sim>
+void MultiHartSimulator<Sim>::setCacheConfig(const CacheConfig& icache, const CacheConfig& dcache) {
+    for (std::unique_ptr<Sim>& sim : harts) sim->setCacheConfig(icache, dcache);
+}
+
+// Runs on the last thread to reach the barrier, while every hart is stopped.
+template <typename Sim>
+void MultiHartSimulator<Sim>::mergeQuantum() {
+    Memory base = memory;
+    for (std::unique_ptr<Sim>& sim : harts) {
+        sim->getMemory().forEachPageChangedSince(base, [this](uint32_t address, const uint8_t* data, const uint8_t* baseData) {
+            uint8_t* target = nullptr;
+            for (uint32_t offset = 0; offset < Memory::PAGE_SIZE; offset++) {
+                if (data[offset] == (baseData != nullptr ? baseData[offset] : 0)) continue;
+                if (target == nullptr) target = memory.touchPage(address);
+                target[offset] = data[offset];
+            }
+        });
+    }
+    for (std::unique_ptr<Sim>& sim : harts) {
+        sim->setMemory(memory);
+    }
+}
+
+template <typename Sim>
+bool MultiHartSimulator<Sim>::run(size_t threads, uint64_t maxCycles) {
+    threads = std::max<size_t>(1, std::min(threads, harts.size()));
+    std::vector<std::pair<size_t, size_t>> ranges = splitRange(harts.size(), threads);
+    PhaseBarrier barrier(ranges.size());
+    bool finished = !isRunning();
+    bool limited = false;
+
+    auto worker = [&](size_t team) {
+        while (!finished) {
+            for (size_t i = ranges[team].first; i < ranges[team].second; i++) {
+                if (!active[i]) continue;
+                uint32_t budget = static_cast<uint32_t>(std::min<uint64_t>(quantum, maxCycles - std::min<uint64_t>(maxCycles, harts[i]->getCycles())));
+                if (budget == 0) continue;
+                RunSummary summary = harts[i]->runCycles(budget);
+                if (summary.reason == StopReason::TERMINATED) active[i] = 0;
+            }
+            barrier.arriveAndWait([&]() {
+                mergeQuantum();
+                finished = !isRunning();
+                if (!finished && getCycles() >= maxCycles) {
+                    limited = true;
+                    finished = true;
+                }
+            });
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t team = 1; team < ranges.size(); team++) {
+        workers.emplace_back(worker, team);
+    }
+    worker(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    return !limited;
+}
+
+template <typename Sim>
+bool MultiHartSimulator<Sim>::isRunning() const {
+    return std::find(active.begin(), active.end(), 1) != active.end();
+}
+
+template <typename Sim>
+uint32_t MultiHartSimulator<Sim>::getCycles() const {
+    uint32_t cycles = 0;
+    for (const std::unique_ptr<Sim>& sim : harts) cycles = std::max(cycles, sim->getCycles());
+    return cycles;
+}
+
+template <typename Sim>
+SimulationStats MultiHartSimulator<Sim>::getAggregateStats() {
+    SimulationStats total;
+    for (std::unique_ptr<Sim>& sim : harts) {
+        SimulationStats s = sim->getStats();
+        total.instructionsExecuted += s.instructionsExecuted;
+        total.dataTransferInstructions += s.dataTransferInstructions;
+        total.aluInstructions += s.aluInstructions;
+        total.controlInstructions += s.controlInstructions;
+        total.stallBubbles += s.stallBubbles;
+        total.dataHazards += s.dataHazards;
+        total.controlHazards += s.controlHazards;
+        total.dataHazardStalls += s.dataHazardStalls;
+        total.controlHazardStalls += s.controlHazardStalls;
+        total.pipelineFlushes += s.pipelineFlushes;
+        total.branchPredictions += s.branchPredictions;
+        total.branchMispredictions += s.branchMispredictions;
+        total.icacheHits += s.icacheHits;
+        total.icacheMisses += s.icacheMisses;
+        total.dcacheHits += s.dcacheHits;
+        total.dcacheMisses += s.dcacheMisses;
+        total.cacheStallCycles += s.cacheStallCycles;
+    }
+    total.totalCycles = getCycles();
+    if (total.instructionsExecuted > 0) {
+        total.cyclesPerInstruction = static_cast<double>(total.totalCycles) / total.instructionsExecuted;
+    }
+    return total;
+}
+
+inline void writeHartStats(std::ostream& out, const std::string& name, const SimulationStats& s) {
+    out << name << ": Cycles " << s.totalCycles << ", Instructions " << s.instructionsExecuted
+        << ", CPI " << s.cyclesPerInstruction << ", Stall Bubbles " << s.stallBubbles
+        << ", Pipeline Flushes " << s.pipelineFlushes << ", Branch Mispredictions " << s.branchMispredictions
+        << ", D-Cache Misses " << s.dcacheMisses << ", Cache Stall Cycles " << s.cacheStallCycles << "\n";
+}
+
+template <typename Sim>
+inline void writeMultiHartReport(std::ostream& out, MultiHartSimulator<Sim>& machine) {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::dec << "Multi-hart Simulation: " << machine.size() << " harts, quantum " << machine.getQuantum() << " cycles\n";
+    for (size_t i = 0; i < machine.size(); i++) {
+        writeHartStats(out, "Hart " + std::to_string(i), machine.hart(i).getStats());
+    }
+    writeHartStats(out, "Aggregate", machine.getAggregateStats());
+    out.flags(flags);
+}
+
+#endif
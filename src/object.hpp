@@ -0,0 +1,212 @@
+#ifndef OBJECT_HPP
+#define OBJECT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "types.hpp"
+#include "io.hpp"
+#include "memory.hpp"
+#include "program.hpp"
+
+using namespace riscv;
+
+// Binary object file (.rvo). All fields are little-endian uint32 and every section is 4-byte
+// aligned, so a mapped file can be read in place:
+//   header
+//   text:    textWords instruction words starting at textStart
+//   data:    dataRuns x { address, length, bytes[length] padded to 4 }
+//   symbols: symbolCount x { address, nameLength, name[nameLength] padded to 4 }
+//   lines:   lineCount source line numbers, one per text word (0 = unknown), or none
+inline constexpr uint32_t OBJECT_MAGIC = 0x424F5652; // "RVOB"
+inline constexpr uint32_t OBJECT_VERSION = 1;
+
+struct ObjectHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t textStart;
+    uint32_t textWords;
+    uint32_t dataRuns;
+    uint32_t symbolCount;
+    uint32_t lineCount;
+    uint32_t reserved;
+};
+
+inline uint32_t alignObjectSize(uint32_t size) {
+    return (size + 3u) & ~3u;
+}
+
+class ObjectWriter {
+public:
+    inline void word(uint32_t value) { bytes(&value, sizeof(value)); }
+
+    inline void bytes(const void* data, size_t size) {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), begin, begin + size);
+        buffer.resize(buffer.size() + (alignObjectSize(static_cast<uint32_t>(size)) - size), 0);
+    }
+
+    inline const std::vector<uint8_t>& data() const { return buffer; }
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+inline std::vector<uint8_t> serializeObject(const ProgramImage& image) {
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> runs;
+    image.getData().forEachPage([&runs](uint32_t base, const uint8_t* page) {
+        uint32_t first = 0;
+        while (first < Memory::PAGE_SIZE && page[first] == 0) first++;
+        if (first == Memory::PAGE_SIZE) return;
+        uint32_t last = Memory::PAGE_SIZE;
+        while (page[last - 1] == 0) last--;
+        runs.emplace_back(base + first, std::vector<uint8_t>(page + first, page + last));
+    });
+
+    ObjectHeader header{};
+    header.magic = OBJECT_MAGIC;
+    header.version = OBJECT_VERSION;
+    header.textStart = TEXT_SEGMENT_START;
+    header.textWords = static_cast<uint32_t>(image.size());
+    header.dataRuns = static_cast<uint32_t>(runs.size());
+    header.symbolCount = static_cast<uint32_t>(image.getSymbols().size());
+    header.lineCount = image.getSourceLines().size() == image.size() ? header.textWords : 0;
+
+    ObjectWriter writer;
+    writer.bytes(&header, sizeof(header));
+    writer.bytes(image.getText().data(), image.size() * sizeof(uint32_t));
+    for (const auto& [address, run] : runs) {
+        writer.word(address);
+        writer.word(static_cast<uint32_t>(run.size()));
+        writer.bytes(run.data(), run.size());
+    }
+    for (const auto& [name, entry] : image.getSymbols()) {
+        writer.word(entry.address);
+        writer.word(static_cast<uint32_t>(name.size()));
+        writer.bytes(name.data(), name.size());
+    }
+    if (header.lineCount > 0) {
+        writer.bytes(image.getSourceLines().data(), header.lineCount * sizeof(uint32_t));
+    }
+    return writer.data();
+}
+
+inline void writeObjectFile(const std::string& filename, const ProgramImage& image) {
+    std::vector<uint8_t> object = serializeObject(image);
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open output file for writing: " + filename);
+    }
+    file.write(reinterpret_cast<const char*>(object.data()), static_cast<std::streamsize>(object.size()));
+    if (!file) {
+        throw std::runtime_error("Failed writing object file: " + filename);
+    }
+}
+
+// Bounds-checked reader over a mapped object.
+class ObjectReader {
+public:
+    ObjectReader(const uint8_t* data, size_t size) : data(data), size(size), offset(0) {}
+
+    inline const uint8_t* take(size_t length) {
+        size_t padded = alignObjectSize(static_cast<uint32_t>(length));
+        if (length > size || padded > size - offset) {
+            throw std::runtime_error(std::string(RED) + "Truncated object file" + RESET);
+        }
+        const uint8_t* at = data + offset;
+        offset += padded;
+        return at;
+    }
+
+    inline uint32_t word() {
+        uint32_t value;
+        std::memcpy(&value, take(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+};
+
+inline std::shared_ptr<const ProgramImage> parseObject(const uint8_t* data, size_t size) {
+    ObjectReader reader(data, size);
+    ObjectHeader header;
+    std::memcpy(&header, reader.take(sizeof(header)), sizeof(header));
+    if (header.magic != OBJECT_MAGIC) {
+        throw std::runtime_error(std::string(RED) + "Not a RISC-V object file" + RESET);
+    }
+    if (header.version != OBJECT_VERSION) {
+        throw std::runtime_error(std::string(RED) + "Unsupported object file version " + std::to_string(header.version) + RESET);
+    }
+    if (header.textStart != TEXT_SEGMENT_START) {
+        throw std::runtime_error(std::string(RED) + "Object text section must start at 0x0" + RESET);
+    }
+    if (header.textWords > size / sizeof(uint32_t) || (header.lineCount != 0 && header.lineCount != header.textWords)) {
+        throw std::runtime_error(std::string(RED) + "Corrupt object file header" + RESET);
+    }
+
+    std::vector<uint32_t> text(header.textWords);
+    std::memcpy(text.data(), reader.take(text.size() * sizeof(uint32_t)), text.size() * sizeof(uint32_t));
+
+    Memory memory;
+    for (uint32_t i = 0; i < header.dataRuns; i++) {
+        uint32_t address = reader.word();
+        uint32_t length = reader.word();
+        const uint8_t* bytes = reader.take(length);
+        if (address < DATA_SEGMENT_START || address >= MEMORY_SIZE || length > MEMORY_SIZE - address) {
+            throw std::runtime_error(std::string(RED) + "Object data run outside the data segment" + RESET);
+        }
+        for (uint32_t j = 0; j < length;) {
+            uint32_t chunk = std::min(length - j, Memory::PAGE_SIZE - Memory::pageOffset(address + j));
+            std::memcpy(memory.touchPage(address + j) + Memory::pageOffset(address + j), bytes + j, chunk);
+            j += chunk;
+        }
+    }
+
+    std::unordered_map<std::string, SymbolEntry> symbols;
+    for (uint32_t i = 0; i < header.symbolCount; i++) {
+        uint32_t address = reader.word();
+        uint32_t length = reader.word();
+        const char* name = reinterpret_cast<const char*>(reader.take(length));
+        symbols.emplace(std::string(name, length), SymbolEntry{address, false, {}, "", ""});
+    }
+
+    std::vector<uint32_t> lines(header.lineCount);
+    if (!lines.empty()) {
+        std::memcpy(lines.data(), reader.take(lines.size() * sizeof(uint32_t)), lines.size() * sizeof(uint32_t));
+    }
+    return std::make_shared<const ProgramImage>(std::move(text), std::move(memory), std::move(symbols), std::move(lines));
+}
+
+inline bool isObjectImage(std::string_view bytes) {
+    uint32_t magic = 0;
+    if (bytes.size() < sizeof(magic)) return false;
+    std::memcpy(&magic, bytes.data(), sizeof(magic));
+    return magic == OBJECT_MAGIC;
+}
+
+inline bool isObjectFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    return file.gcount() == sizeof(magic) && magic == OBJECT_MAGIC;
+}
+
+inline std::shared_ptr<const ProgramImage> loadObjectFile(const std::string& filename) {
+    SourceBuffer object(filename);
+    if (object.size() == 0) {
+        throw std::runtime_error("Could not read object file: " + filename);
+    }
+    return parseObject(object.bytes(), object.size());
+}
+
+#endif
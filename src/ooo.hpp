@@ -0,0 +1,557 @@
+#ifndef OOO_HPP
+#define OOO_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "types.hpp"
+#include "memory.hpp"
+#include "program.hpp"
+#include "execution.hpp"
+#include "functional.hpp"
+#include "predictor.hpp"
+#include "cache.hpp"
+#include "hooks.hpp"
+#include "simulator.hpp"
+
+using namespace riscv;
+
+inline constexpr uint32_t MAX_OOO_WIDTH = 16;
+inline constexpr uint32_t MAX_ROB_ENTRIES = 1024;
+inline constexpr uint32_t MAX_UNIT_LATENCY = 256;
+// Cycles of future issue slots the reservation tables track; bookings further apart than this
+// are treated conservatively as conflicts.
+inline constexpr uint32_t OOO_SCHEDULE_WINDOW = 1 << 12;
+// Words of recent stores kept for memory disambiguation, direct-mapped by address.
+inline constexpr uint32_t OOO_STORE_TABLE_SIZE = 1 << 10;
+
+// Superscalar out-of-order core: `width` instructions are fetched, dispatched, issued and
+// committed per cycle; dispatch needs a free ROB entry and reservation station, and an
+// instruction issues once its renamed operands are ready and a unit of its class is free.
+struct OutOfOrderConfig {
+    uint32_t width;
+    uint32_t robEntries;
+    uint32_t rsEntries;
+    // Cycles from fetch to dispatch (fetch, decode, rename).
+    uint32_t frontEndDepth;
+    uint32_t aluUnits;
+    uint32_t mulUnits;
+    uint32_t divUnits;
+    uint32_t memoryPorts;
+    uint32_t aluLatency;
+    uint32_t mulLatency;
+    // Dividers are not pipelined: a div or rem holds its unit for divLatency cycles.
+    uint32_t divLatency;
+    // Load-to-use latency on a hit; a D-cache miss adds its penalty.
+    uint32_t loadLatency;
+    // Cycles between a mispredicted branch executing and fetch restarting on the right path.
+    uint32_t redirectPenalty;
+
+    OutOfOrderConfig() : width(4), robEntries(64), rsEntries(32), frontEndDepth(3), aluUnits(4), mulUnits(1), divUnits(1),
+                         memoryPorts(2), aluLatency(1), mulLatency(3), divLatency(20), loadLatency(2), redirectPenalty(1) {}
+};
+
+struct OutOfOrderStats {
+    uint64_t robFullCycles;
+    uint64_t rsFullCycles;
+    uint64_t operandWaitCycles;
+    uint64_t unitWaitCycles;
+
+    OutOfOrderStats() : robFullCycles(0), rsFullCycles(0), operandWaitCycles(0), unitWaitCycles(0) {}
+};
+
+inline void validateOutOfOrderConfig(const OutOfOrderConfig& config) {
+    auto fail = [](const std::string& message) {
+        throw std::runtime_error(std::string(RED) + "Invalid out-of-order configuration: " + message + RESET);
+    };
+    if (config.width == 0 || config.width > MAX_OOO_WIDTH) fail("width must be between 1 and " + std::to_string(MAX_OOO_WIDTH));
+    if (config.robEntries == 0 || config.robEntries > MAX_ROB_ENTRIES) fail("ROB size must be between 1 and " + std::to_string(MAX_ROB_ENTRIES));
+    if (config.rsEntries == 0 || config.rsEntries > config.robEntries) fail("reservation stations must be between 1 and the ROB size");
+    if (config.frontEndDepth == 0) fail("front-end depth must be at least 1");
+    if (config.aluUnits == 0 || config.mulUnits == 0 || config.divUnits == 0 || config.memoryPorts == 0) {
+        fail("every unit class needs at least one unit");
+    }
+    for (uint32_t latency : {config.aluLatency, config.mulLatency, config.divLatency, config.loadLatency}) {
+        if (latency == 0 || latency > MAX_UNIT_LATENCY) fail("latencies must be between 1 and " + std::to_string(MAX_UNIT_LATENCY));
+    }
+}
+
+// Applies one key=value pair of an out-of-order spec.
+inline void applyOutOfOrderValue(OutOfOrderConfig& config, const std::string& key, const std::string& value) {
+    uint32_t parsed = 0;
+    if (parseUnsigned(value, parsed) != NumberError::NONE) {
+        throw std::runtime_error(std::string(RED) + "Invalid out-of-order value '" + value + "' for " + key + RESET);
+    }
+    static const std::pair<const char*, uint32_t OutOfOrderConfig::*> KEYS[] = {
+        {"width", &OutOfOrderConfig::width}, {"rob", &OutOfOrderConfig::robEntries}, {"rs", &OutOfOrderConfig::rsEntries},
+        {"depth", &OutOfOrderConfig::frontEndDepth}, {"alu-units", &OutOfOrderConfig::aluUnits},
+        {"mul-units", &OutOfOrderConfig::mulUnits}, {"div-units", &OutOfOrderConfig::divUnits},
+        {"ports", &OutOfOrderConfig::memoryPorts}, {"alu", &OutOfOrderConfig::aluLatency}, {"mul", &OutOfOrderConfig::mulLatency},
+        {"div", &OutOfOrderConfig::divLatency}, {"load", &OutOfOrderConfig::loadLatency}, {"redirect", &OutOfOrderConfig::redirectPenalty},
+    };
+    for (const auto& [name, field] : KEYS) {
+        if (key == name) {
+            config.*field = parsed;
+            return;
+        }
+    }
+    throw std::runtime_error(std::string(RED) + "Unknown out-of-order parameter '" + key + "'" + RESET);
+}
+
+// Parses "width=4,rob=64,rs=32,mul=3,div=20,...". Keys that are not listed keep their value from
+// base; "default" is the default configuration.
+inline OutOfOrderConfig parseOutOfOrderSpec(const std::string& spec, OutOfOrderConfig base = OutOfOrderConfig()) {
+    if (spec == "default") return base;
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(start, end - start);
+        if (!item.empty()) {
+            size_t equalPos = item.find('=');
+            if (equalPos == std::string::npos) {
+                throw std::runtime_error(std::string(RED) + "Invalid out-of-order parameter '" + item + "' (expected key=value)" + RESET);
+            }
+            applyOutOfOrderValue(base, item.substr(0, equalPos), item.substr(equalPos + 1));
+        }
+        start = end + 1;
+    }
+    validateOutOfOrderConfig(base);
+    return base;
+}
+
+namespace ooo {
+    enum class UnitClass : uint8_t { ALU, MUL, DIV, MEMORY };
+
+    inline UnitClass unitClass(const DecodedInstruction& inst) {
+        switch (inst.instructionName) {
+            case Instructions::MUL: return UnitClass::MUL;
+            case Instructions::DIV:
+            case Instructions::REM: return UnitClass::DIV;
+            default: return inst.isLoad || inst.isStore ? UnitClass::MEMORY : UnitClass::ALU;
+        }
+    }
+
+    // Per-cycle use counts of a pool of identical pipelined resources, over a sliding window of
+    // cycles. A slot whose tag is an older cycle is free; one tagged with a later cycle (a
+    // booking a whole window ahead) counts as taken. A full cycle points past the run of full
+    // cycles after it, with path compression, so finding a free cycle behind a long backlog of
+    // bookings is amortised constant time.
+    class ReservationTable {
+    public:
+        void configure(uint32_t newUnits) {
+            units = newUnits;
+            tags.assign(OOO_SCHEDULE_WINDOW, 0);
+            used.assign(OOO_SCHEDULE_WINDOW, 0);
+            skip.assign(OOO_SCHEDULE_WINDOW, 1);
+        }
+
+        inline uint64_t nextAvailable(uint64_t cycle) {
+            uint64_t found = cycle;
+            while (!available(found)) found = follow(found);
+            for (uint64_t visit = cycle; visit < found;) {
+                uint64_t next = follow(visit);
+                size_t slot = visit & (OOO_SCHEDULE_WINDOW - 1);
+                if (tags[slot] == visit) skip[slot] = found;
+                visit = next;
+            }
+            return found;
+        }
+
+        inline bool available(uint64_t cycle) const {
+            size_t slot = cycle & (OOO_SCHEDULE_WINDOW - 1);
+            return tags[slot] < cycle || (tags[slot] == cycle && used[slot] < units);
+        }
+
+        inline void take(uint64_t cycle) {
+            size_t slot = cycle & (OOO_SCHEDULE_WINDOW - 1);
+            if (tags[slot] != cycle) {
+                tags[slot] = cycle;
+                used[slot] = 0;
+            }
+            if (++used[slot] == units) skip[slot] = cycle + 1;
+        }
+
+    private:
+        uint32_t units = 1;
+        std::vector<uint64_t> tags;
+        std::vector<uint16_t> used;
+        std::vector<uint64_t> skip;
+
+        inline uint64_t follow(uint64_t cycle) const {
+            size_t slot = cycle & (OOO_SCHEDULE_WINDOW - 1);
+            return tags[slot] == cycle ? skip[slot] : cycle + 1;
+        }
+    };
+}
+
+// Timing-directed out-of-order model. Instructions are executed architecturally in program order
+// by the functional engine at dispatch, which gives every branch outcome and effective address
+// up front; the timing model then schedules each instruction once rather than simulating every
+// stage every cycle. Its fetch, dispatch, issue, complete and commit cycles are derived from
+// events already known:
+//   - fetch: `width` per cycle, a predicted-taken branch ends the group, I-cache misses delay it,
+//     and after a misprediction fetch resumes redirectPenalty cycles after the branch executes;
+//   - dispatch: in order, frontEndDepth cycles after fetch, once the ROB entry freed by the
+//     instruction robEntries older has committed and a reservation station is free;
+//   - issue: once the producers of its operands (found through the rename table, so only true
+//     dependences wait) have completed, older stores to the same word have executed, and a unit
+//     of its class and an issue slot are free in that cycle;
+//   - commit: in order, `width` per cycle, the cycle after completion.
+// Each step costs the same whatever the width, ROB or RS size. Wrong-path instructions are not
+// executed: a misprediction shows up as the fetch bubble until the redirect.
+class OutOfOrderSimulator {
+public:
+    explicit OutOfOrderSimulator(const OutOfOrderConfig& config = OutOfOrderConfig());
+
+    void configure(const OutOfOrderConfig& newConfig);
+    void setPredictorConfig(const PredictorConfig& config) { branchPredictor.configure(config); }
+    void setCacheConfig(const CacheConfig& icache, const CacheConfig& dcache);
+    bool loadProgram(const std::shared_ptr<const ProgramImage>& image);
+    void reset();
+
+    // Moves one instruction through the model. Returns false once the program has ended.
+    bool step();
+    RunSummary runCycles(uint32_t maxCycles);
+
+    bool isRunning() const { return running; }
+    uint32_t getPC() const { return PC; }
+    uint32_t getCycles() const { return stats.totalCycles; }
+    uint32_t getInstructionCount() const { return stats.instructionsExecuted; }
+    const uint32_t* getRegisters() const { return registers; }
+    const Memory& getMemory() const { return memory; }
+    const OutOfOrderConfig& getConfig() const { return config; }
+    const OutOfOrderStats& getOutOfOrderStats() const { return oooStats; }
+    SimulationStats getStats();
+    double getIPC() const { return stats.totalCycles > 0 ? static_cast<double>(stats.instructionsExecuted) / stats.totalCycles : 0.0; }
+
+private:
+    OutOfOrderConfig config;
+    std::shared_ptr<const ProgramImage> program;
+    uint32_t registers[NUM_REGISTERS];
+    uint32_t PC;
+    Memory memory;
+    bool running;
+    SimulationStats stats;
+    OutOfOrderStats oooStats;
+    BranchPredictor branchPredictor;
+    Cache instructionCache;
+    Cache dataCache;
+    ConsoleLog log;
+
+    uint64_t fetchCycle;
+    uint32_t fetchUsed;
+    uint64_t fetchResume;
+    uint64_t dispatchCycle;
+    uint32_t dispatchUsed;
+    uint64_t commitCycle;
+    uint32_t commitUsed;
+    uint64_t sequence;
+    // Cycle each architectural register's latest producer completes.
+    std::array<uint64_t, NUM_REGISTERS> registerReady;
+    // Commit cycle of the instruction occupying each ROB entry.
+    std::vector<uint64_t> robCommit;
+    // Issue cycles of the instructions holding a reservation station.
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> stations;
+    std::array<ooo::ReservationTable, 4> units;
+    ooo::ReservationTable issueSlots;
+    std::vector<uint64_t> dividerFree;
+    std::vector<std::pair<uint32_t, uint64_t>> storeTable;
+
+    uint64_t reserveIssue(ooo::UnitClass unit, uint64_t ready);
+};
+
+inline OutOfOrderSimulator::OutOfOrderSimulator(const OutOfOrderConfig& config) : program(emptyProgramImage()) {
+    configure(config);
+}
+
+inline void OutOfOrderSimulator::configure(const OutOfOrderConfig& newConfig) {
+    validateOutOfOrderConfig(newConfig);
+    config = newConfig;
+    reset();
+}
+
+inline void OutOfOrderSimulator::setCacheConfig(const CacheConfig& icache, const CacheConfig& dcache) {
+    instructionCache.configure(icache, "I-cache");
+    dataCache.configure(dcache, "D-cache");
+}
+
+inline void OutOfOrderSimulator::reset() {
+    initialiseRegisters(registers);
+    PC = TEXT_SEGMENT_START;
+    memory.clear();
+    running = false;
+    stats = SimulationStats();
+    oooStats = OutOfOrderStats();
+    branchPredictor.reset();
+    instructionCache.reset();
+    dataCache.reset();
+    fetchCycle = 0;
+    fetchUsed = 0;
+    fetchResume = 0;
+    dispatchCycle = 0;
+    dispatchUsed = 0;
+    commitCycle = 0;
+    commitUsed = 0;
+    sequence = 0;
+    registerReady.fill(0);
+    robCommit.assign(config.robEntries, 0);
+    stations = decltype(stations)();
+    units[static_cast<size_t>(ooo::UnitClass::ALU)].configure(config.aluUnits);
+    units[static_cast<size_t>(ooo::UnitClass::MUL)].configure(config.mulUnits);
+    units[static_cast<size_t>(ooo::UnitClass::DIV)].configure(config.divUnits);
+    units[static_cast<size_t>(ooo::UnitClass::MEMORY)].configure(config.memoryPorts);
+    issueSlots.configure(config.width);
+    dividerFree.assign(config.divUnits, 0);
+    storeTable.assign(OOO_STORE_TABLE_SIZE, {UINT32_MAX, 0});
+}
+
+inline bool OutOfOrderSimulator::loadProgram(const std::shared_ptr<const ProgramImage>& image) {
+    reset();
+    program = image ? image : emptyProgramImage();
+    memory = program->getData();
+    running = !program->empty();
+    return true;
+}
+
+inline uint64_t OutOfOrderSimulator::reserveIssue(ooo::UnitClass unit, uint64_t ready) {
+    uint64_t issue = ready;
+    if (unit == ooo::UnitClass::DIV) {
+        auto divider = std::min_element(dividerFree.begin(), dividerFree.end());
+        issue = issueSlots.nextAvailable(std::max(issue, *divider));
+        *divider = issue + config.divLatency;
+    } else {
+        ooo::ReservationTable& table = units[static_cast<size_t>(unit)];
+        for (uint64_t both = issue;; issue = both) {
+            both = issueSlots.nextAvailable(table.nextAvailable(issue));
+            if (both == issue) break;
+        }
+        table.take(issue);
+    }
+    issueSlots.take(issue);
+    return issue;
+}
+
+inline bool OutOfOrderSimulator::step() {
+    if (!running) return false;
+    const DecodedInstruction* inst = findDecodedInstruction(PC, program->getDecodedText());
+    if (inst == nullptr) {
+        running = false;
+        return false;
+    }
+
+    uint32_t pc = PC;
+    uint32_t address = registers[inst->rs1] + static_cast<uint32_t>(inst->immediate);
+    try {
+        runFunctional(program->getDecodedText(), registers, PC, memory, stats, 1, running);
+    } catch (const std::runtime_error& e) {
+        log.error("Runtime error during step execution: " + std::string(e.what()));
+        running = false;
+        return false;
+    }
+    uint32_t nextPC = PC;
+    bool taken = nextPC != pc + INSTRUCTION_SIZE;
+
+    // Fetch.
+    if (fetchCycle < fetchResume) {
+        fetchCycle = fetchResume;
+        fetchUsed = 0;
+    }
+    if (fetchUsed == config.width) {
+        fetchCycle++;
+        fetchUsed = 0;
+    }
+    if (instructionCache.enabled()) {
+        uint32_t penalty = instructionCache.access(pc, false);
+        if (penalty > 0) {
+            fetchCycle += penalty;
+            fetchUsed = 0;
+            stats.cacheStallCycles += penalty;
+        }
+    }
+    uint64_t fetched = fetchCycle;
+    fetchUsed++;
+
+    bool redirect = false;
+    bool redirectAtDecode = false;
+    if (inst->isBranch || inst->isJump) {
+        uint32_t predictedTarget = 0;
+        bool returnPredicted = branchPredictor.predictReturn(*inst, pc, predictedTarget);
+        bool predictedTaken = returnPredicted || branchPredictor.predict(pc);
+        bool targetKnown = returnPredicted || (predictedTaken && branchPredictor.predictTarget(pc, predictedTarget));
+        bool targetMismatch = false;
+        if (returnPredicted) {
+            targetMismatch = taken && nextPC != predictedTarget;
+            if (targetMismatch) branchPredictor.recordReturnMisprediction();
+        } else if (predictedTaken && taken && targetKnown) {
+            targetMismatch = nextPC != predictedTarget;
+        }
+        bool mispredicted = predictedTaken != taken || targetMismatch;
+        branchPredictor.update(pc, taken, nextPC, mispredicted);
+        // A taken branch fetched without a target ran on down the fall-through path; a jal
+        // finds out in decode, anything else when it executes.
+        redirect = mispredicted || (taken && !targetKnown);
+        redirectAtDecode = redirect && !mispredicted && inst->instructionName == Instructions::JAL;
+        if (!redirect && taken) fetchUsed = config.width;
+    }
+
+    // Dispatch.
+    uint64_t dispatch = std::max(fetched + config.frontEndDepth, dispatchCycle);
+    uint64_t& robEntry = robCommit[sequence % config.robEntries];
+    if (sequence >= config.robEntries && robEntry + 1 > dispatch) {
+        oooStats.robFullCycles += robEntry + 1 - dispatch;
+        dispatch = robEntry + 1;
+    }
+    while (!stations.empty() && stations.top() < dispatch) stations.pop();
+    if (stations.size() >= config.rsEntries) {
+        uint64_t freed = stations.top() + 1;
+        stations.pop();
+        if (freed > dispatch) {
+            oooStats.rsFullCycles += freed - dispatch;
+            dispatch = freed;
+        }
+    }
+    if (dispatch > dispatchCycle) {
+        dispatchCycle = dispatch;
+        dispatchUsed = 0;
+    } else if (dispatchUsed == config.width) {
+        dispatchCycle = ++dispatch;
+        dispatchUsed = 0;
+    }
+    dispatchUsed++;
+
+    // Issue.
+    uint64_t ready = dispatch + 1;
+    bool usesRs1 = inst->instructionType != InstructionType::U && inst->instructionType != InstructionType::UJ;
+    bool usesRs2 = inst->instructionType == InstructionType::R || inst->instructionType == InstructionType::S || inst->instructionType == InstructionType::SB;
+    if (usesRs1 && inst->rs1 != 0) ready = std::max(ready, registerReady[inst->rs1]);
+    if (usesRs2 && inst->rs2 != 0) ready = std::max(ready, registerReady[inst->rs2]);
+    std::pair<uint32_t, uint64_t>& store = storeTable[(address >> 2) & (OOO_STORE_TABLE_SIZE - 1)];
+    if (inst->isLoad && store.first == (address >> 2)) ready = std::max(ready, store.second);
+    if (ready > dispatch + 1) {
+        stats.dataHazards++;
+        stats.dataHazardStalls += static_cast<uint32_t>(ready - dispatch - 1);
+        oooStats.operandWaitCycles += ready - dispatch - 1;
+    }
+    ooo::UnitClass unit = ooo::unitClass(*inst);
+    uint64_t issue = reserveIssue(unit, ready);
+    oooStats.unitWaitCycles += issue - ready;
+    stations.push(issue);
+
+    // Execute.
+    uint32_t latency = config.aluLatency;
+    if (unit == ooo::UnitClass::MUL) latency = config.mulLatency;
+    else if (unit == ooo::UnitClass::DIV) latency = config.divLatency;
+    else if (inst->isLoad) latency = config.loadLatency;
+    if ((inst->isLoad || inst->isStore) && dataCache.enabled()) {
+        uint32_t penalty = dataCache.access(address, inst->isStore);
+        latency += penalty;
+        stats.cacheStallCycles += penalty;
+    }
+    uint64_t complete = issue + latency;
+    if (inst->rd != 0 && !inst->isStore && !inst->isBranch) registerReady[inst->rd] = complete;
+    if (inst->isStore) store = {address >> 2, complete};
+
+    if (redirect) {
+        uint64_t resume = redirectAtDecode ? fetched + config.frontEndDepth : complete + config.redirectPenalty;
+        fetchResume = std::max(fetchResume, resume);
+        stats.controlHazards++;
+        stats.controlHazardStalls += static_cast<uint32_t>(resume - fetched - 1);
+        if (!redirectAtDecode) stats.pipelineFlushes++;
+    }
+
+    // Commit.
+    uint64_t commit = std::max(complete + 1, commitCycle);
+    if (commit == commitCycle && commitUsed == config.width) commit++;
+    if (commit > commitCycle) {
+        if (sequence > 0 && commit > commitCycle + 1) stats.stallBubbles += static_cast<uint32_t>(commit - commitCycle - 1);
+        commitCycle = commit;
+        commitUsed = 0;
+    }
+    commitUsed++;
+    robEntry = commit;
+    sequence++;
+
+    stats.instructionsExecuted++;
+    stats.totalCycles = static_cast<uint32_t>(commitCycle + 1);
+    stats.cyclesPerInstruction = static_cast<double>(stats.totalCycles) / stats.instructionsExecuted;
+    if (findDecodedInstruction(PC, program->getDecodedText()) == nullptr) running = false;
+    return running;
+}
+
+inline RunSummary OutOfOrderSimulator::runCycles(uint32_t maxCycles) {
+    RunSummary summary;
+    uint32_t start = stats.totalCycles;
+    while (stats.totalCycles - start < maxCycles) {
+        if (!step()) {
+            summary.reason = StopReason::TERMINATED;
+            summary.address = PC;
+            break;
+        }
+    }
+    summary.cycles = stats.totalCycles - start;
+    return summary;
+}
+
+inline SimulationStats OutOfOrderSimulator::getStats() {
+    const PredictorStats& predictorStats = branchPredictor.getStats();
+    stats.branchPredictions = predictorStats.predictions;
+    stats.branchMispredictions = predictorStats.mispredictions;
+    stats.btbHits = predictorStats.btbHits;
+    stats.btbMisses = predictorStats.btbMisses;
+    stats.returnPredictions = predictorStats.returnPredictions;
+    stats.returnMispredictions = predictorStats.returnMispredictions;
+    stats.icacheHits = instructionCache.getStats().hits;
+    stats.icacheMisses = instructionCache.getStats().misses;
+    stats.icacheEvictions = instructionCache.getStats().evictions;
+    stats.dcacheHits = dataCache.getStats().hits;
+    stats.dcacheMisses = dataCache.getStats().misses;
+    stats.dcacheEvictions = dataCache.getStats().evictions;
+    stats.dcacheWritebacks = dataCache.getStats().writebacks;
+    return stats;
+}
+
+inline void writeOutOfOrderReport(std::ostream& out, OutOfOrderSimulator& sim) {
+    std::ios_base::fmtflags flags = out.flags();
+    const OutOfOrderConfig& c = sim.getConfig();
+    const OutOfOrderStats& o = sim.getOutOfOrderStats();
+    SimulationStats s = sim.getStats();
+    out << std::dec << "Out-of-Order Simulation: width " << c.width << ", ROB " << c.robEntries << ", RS " << c.rsEntries
+        << ", front end " << c.frontEndDepth << " cycles\n";
+    out << "Units: " << c.aluUnits << " ALU (" << c.aluLatency << " cycles), " << c.mulUnits << " MUL (" << c.mulLatency
+        << "), " << c.divUnits << " DIV (" << c.divLatency << ", unpipelined), " << c.memoryPorts << " memory ports (load "
+        << c.loadLatency << ")\n";
+    out << "Total Cycles: " << s.totalCycles << "\n";
+    out << "Instructions Executed: " << s.instructionsExecuted << "\n";
+    out << "Instructions Per Cycle: " << sim.getIPC() << "\n";
+    out << "Cycles Per Instruction: " << s.cyclesPerInstruction << "\n";
+    out << "Data Transfer Instructions: " << s.dataTransferInstructions << "\n";
+    out << "ALU Instructions: " << s.aluInstructions << "\n";
+    out << "Control Instructions: " << s.controlInstructions << "\n";
+    out << "Commit Bubbles: " << s.stallBubbles << "\n";
+    out << "Data Hazards: " << s.dataHazards << "\n";
+    out << "Operand Wait Cycles: " << o.operandWaitCycles << "\n";
+    out << "Unit Wait Cycles: " << o.unitWaitCycles << "\n";
+    out << "ROB Full Cycles: " << o.robFullCycles << "\n";
+    out << "RS Full Cycles: " << o.rsFullCycles << "\n";
+    out << "Control Hazards: " << s.controlHazards << "\n";
+    out << "Control Hazard Stalls: " << s.controlHazardStalls << "\n";
+    out << "Pipeline Flushes: " << s.pipelineFlushes << "\n";
+    out << "Branch Predictions: " << s.branchPredictions << "\n";
+    out << "Branch Mispredictions: " << s.branchMispredictions << "\n";
+    out << "I-Cache Hits: " << s.icacheHits << "\n";
+    out << "I-Cache Misses: " << s.icacheMisses << "\n";
+    out << "D-Cache Hits: " << s.dcacheHits << "\n";
+    out << "D-Cache Misses: " << s.dcacheMisses << "\n";
+    out << "Cache Stall Cycles: " << s.cacheStallCycles << "\n";
+    out.flags(flags);
+}
+
+#endif
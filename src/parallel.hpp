@@ -0,0 +1,150 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Fixed set of tasks spread over per-worker deques. A worker drains its own deque from the back
+// and, once empty, steals from the front of the others; it exits when every deque is empty.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t threads) : queues(std::max<size_t>(threads, 1)) {}
+
+    void run(const std::vector<std::function<void()>>& tasks) {
+        for (size_t i = 0; i < tasks.size(); i++) {
+            queues[i % queues.size()].tasks.push_back(i);
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(queues.size());
+        for (size_t id = 0; id < queues.size(); id++) {
+            workers.emplace_back([this, id, &tasks]() { work(id, tasks); });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    inline size_t size() const { return queues.size(); }
+
+private:
+    struct TaskQueue {
+        std::mutex lock;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<TaskQueue> queues;
+
+    bool popLocal(size_t id, size_t& task) {
+        TaskQueue& queue = queues[id];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty()) return false;
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t id, size_t& task) {
+        for (size_t offset = 1; offset < queues.size(); offset++) {
+            TaskQueue& victim = queues[(id + offset) % queues.size()];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t id, const std::vector<std::function<void()>>& tasks) {
+        size_t task;
+        while (popLocal(id, task) || steal(id, task)) {
+            tasks[task]();
+        }
+    }
+};
+
+// Reusable barrier for a fixed team of threads. The last thread to arrive runs completion before
+// any thread is released, so it sees every other thread stopped between two phases.
+class PhaseBarrier {
+public:
+    explicit PhaseBarrier(size_t threads) : threads(std::max<size_t>(threads, 1)), waiting(0), phase(0) {}
+
+    template <typename Completion>
+    void arriveAndWait(Completion&& completion) {
+        std::unique_lock<std::mutex> guard(lock);
+        size_t current = phase;
+        if (++waiting == threads) {
+            completion();
+            waiting = 0;
+            phase++;
+            released.notify_all();
+            return;
+        }
+        released.wait(guard, [this, current]() { return phase != current; });
+    }
+
+private:
+    size_t threads;
+    size_t waiting;
+    size_t phase;
+    std::mutex lock;
+    std::condition_variable released;
+};
+
+// Splits [0, count) into at most parts contiguous, nearly equal ranges.
+inline std::vector<std::pair<size_t, size_t>> splitRange(size_t count, size_t parts) {
+    parts = std::max<size_t>(1, std::min(parts, count));
+    std::vector<std::pair<size_t, size_t>> ranges;
+    ranges.reserve(parts);
+    for (size_t i = 0; i < parts; i++) {
+        ranges.emplace_back(count * i / parts, count * (i + 1) / parts);
+    }
+    return ranges;
+}
+
+// Number of chunks to cut items into: one without extra threads or when there is too little work,
+// otherwise a few per thread so work stealing can even out uneven chunks.
+inline size_t chunkCount(size_t items, size_t threads, size_t minItemsPerChunk) {
+    if (threads <= 1) return 1;
+    return std::max<size_t>(1, std::min(items / std::max<size_t>(minItemsPerChunk, 1), threads * 4));
+}
+
+// Runs task(0) ... task(count - 1) on up to threads workers. With one thread the tasks run in
+// order on the caller. Otherwise every task runs, and the exception of the lowest-numbered failing
+// task is rethrown, so a parallel run reports the same first error as a serial one.
+inline void parallelRun(size_t count, size_t threads, const std::function<void(size_t)>& task) {
+    if (threads <= 1 || count <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        tasks.push_back([&task, &errors, i]() {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    WorkStealingPool pool(std::min(threads, count));
+    pool.run(tasks);
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+#endif
@@ -8,116 +8,158 @@
 #include <optional>
 #include <cstdint>
 #include "types.hpp"
+#include "lexer.hpp"
+#include "parallel.hpp"
+#include "diagnostics.hpp"
 
 using namespace riscv;
 
+// Errors do not throw: they are collected in getDiagnostics() and both passes run to the end, so
+// one parse reports every error in the program. The tokens are read in place, so they and the
+// source text they point into have to outlive the parser.
 class Parser {
 public:
-    explicit Parser(const std::vector<std::vector<Token>>& tokenizedLines) 
-        : tokens(tokenizedLines), errorCount(0), currentAddress(0), 
-        inTextSection(false), inDataSection(false) {}
+    explicit Parser(const TokenStream& stream) : currentAddress(0), textAddress(0), inTextSection(false), inDataSection(false) {
+        lines.reserve(stream.lineCount());
+        for (size_t i = 0; i < stream.lineCount(); i++) lines.push_back(stream.line(i));
+    }
+
+    explicit Parser(const std::vector<std::vector<TokenView>>& tokenizedLines) : currentAddress(0), textAddress(0), inTextSection(false), inDataSection(false) {
+        lines.reserve(tokenizedLines.size());
+        for (const auto& line : tokenizedLines) lines.push_back(tokenLine(line));
+    }
     
-    inline bool parse();
+    inline bool parse(size_t threads = 1);
+    inline bool layout();
+    inline std::vector<ParsedInstruction> parseTextLine(TokenLine line, uint32_t address) const;
+
+    static inline size_t countInstructions(TokenLine line);
 
     inline const std::unordered_map<std::string, SymbolEntry>& getSymbolTable() const { return symbolTable; }
     inline const std::vector<ParsedInstruction>& getParsedInstructions() const { return parsedInstructions; }
 
-    inline size_t getErrorCount() const { return errorCount; }
+    inline size_t getErrorCount() const { return diagnostics.size(); }
+    inline const Diagnostics& getDiagnostics() const { return diagnostics; }
 
 private:
-    const std::vector<std::vector<Token>> &tokens;
+    std::vector<TokenLine> lines;
 
     std::unordered_map<std::string, SymbolEntry> symbolTable;
 
     std::vector<ParsedInstruction> parsedInstructions;
 
-    mutable size_t errorCount;
+    Diagnostics diagnostics;
 
     uint32_t currentAddress;
+    // Where the next .text stretch starts: the end of the previous one.
+    uint32_t textAddress;
 
     bool inTextSection;
     bool inDataSection;
 
-    inline bool processFirstPass();
-    inline bool processSecondPass();
-    inline bool handleInstruction(const std::vector<Token>& line);
-
-    inline std::optional<uint32_t> resolveLabel(const std::string &label) const;
+    static constexpr size_t MIN_CHUNK_LINES = 4096;
 
-    inline void addLabel(const std::string &label);
-    inline void handleDirective(const std::vector<Token> &line);
-    inline void reportError(const std::string &message, int lineNumber = 0) const;
-    inline void handleSectionDirective(const std::string& directive);
+    inline bool processFirstPass();
+    inline bool processSecondPass(size_t threads);
+    inline void parseLine(TokenLine line, uint32_t address, bool inText, std::vector<ParsedInstruction>& output,
+                          Diagnostics& lineDiagnostics) const;
+    inline bool handleInstruction(TokenLine line, uint32_t address, bool inText, std::vector<ParsedInstruction>& output,
+                                  Diagnostics& lineDiagnostics) const;
+
+    inline std::optional<uint32_t> resolveLabel(const std::string &label, int lineNumber, Diagnostics& lineDiagnostics) const;
+
+    inline void addLabel(std::string_view label, int lineNumber);
+    inline void handleDirective(TokenLine line);
+    inline void reportError(const std::string &message, int lineNumber = 0);
+    static inline void reportError(Diagnostics& into, const std::string &message, int lineNumber);
+    inline bool handleSectionDirective(std::string_view directive);
 };
 
-inline void Parser::handleSectionDirective(const std::string& directive) {
+// Returns false for an unknown section; the first pass reports it. A repeated .text continues
+// after the instructions already placed, so no two instructions share an address.
+inline bool Parser::handleSectionDirective(std::string_view directive) {
+    if (directive != ".data" && directive != ".text") return false;
+    if (inTextSection) textAddress = currentAddress;
     if (directive == ".data") {
         inDataSection = true;
         inTextSection = false;
         currentAddress = DATA_SEGMENT_START;
-    } else if (directive == ".text") {
+    } else {
         inTextSection = true;
         inDataSection = false;
-        currentAddress = TEXT_SEGMENT_START;
-    } else {
-        reportError("Unknown section directive: " + directive);
+        currentAddress = textAddress;
     }
+    return true;
 }
 
-inline bool Parser::parse() {
-    if (tokens.empty()) {
+inline bool Parser::parse(size_t threads) {
+    diagnostics.clear();
+    if (lines.empty()) {
         reportError("No tokens provided for parsing");
         return false;
     }
     
     parsedInstructions.clear();
-    bool firstPassResult = processFirstPass();
-    if (!firstPassResult) {
-        reportError("First pass failed with " + std::to_string(errorCount) + " errors");
-        return false;
-    }
-    
-    bool secondPassResult = processSecondPass();
-    if (!secondPassResult) {
-        reportError("Second pass failed with " + std::to_string(errorCount) + " errors");
+    processFirstPass();
+    processSecondPass(threads);
+    diagnostics.sortByLine();
+    return diagnostics.empty();
+}
+
+// First pass only: builds the symbol table without parsing any instruction.
+inline bool Parser::layout() {
+    diagnostics.clear();
+    if (lines.empty()) {
+        reportError("No tokens provided for parsing");
         return false;
     }
-    return errorCount == 0;
+    parsedInstructions.clear();
+    return processFirstPass();
+}
+
+// Second pass over a single .text line starting at address, against the current symbol table.
+// An instruction with an error is left out of the result.
+inline std::vector<ParsedInstruction> Parser::parseTextLine(TokenLine line, uint32_t address) const {
+    std::vector<ParsedInstruction> output;
+    Diagnostics lineDiagnostics;
+    parseLine(line, address, true, output, lineDiagnostics);
+    return output;
 }
 
 inline bool Parser::processFirstPass() {
     currentAddress = TEXT_SEGMENT_START;
+    textAddress = TEXT_SEGMENT_START;
     inTextSection = true;
     inDataSection = false;
     symbolTable.clear();
 
-    for (const auto &line : tokens) {
+    for (TokenLine line : lines) {
         if (line.empty()) continue;
 
         size_t tokenIndex = 0;
 
         if (line[0].type == TokenType::DIRECTIVE) {
-            handleSectionDirective(line[0].value);
+            if (!handleSectionDirective(line[0].value)) {
+                reportError("Unknown section directive: " + std::string(line[0].value), line[0].lineNumber);
+            }
             continue;
         }
 
         while (tokenIndex < line.size()) {
-            const Token &currentToken = line[tokenIndex];
+            const TokenView &currentToken = line[tokenIndex];
 
             if (currentToken.type == TokenType::LABEL) {
                 if (inDataSection) {
-                    std::vector<Token> dataPathTokens;
-                    dataPathTokens.push_back(currentToken);
+                    size_t dataStart = tokenIndex;
                     tokenIndex++;
 
                     while (tokenIndex < line.size() && (line[tokenIndex].type == TokenType::DIRECTIVE || line[tokenIndex].type == TokenType::IMMEDIATE || line[tokenIndex].type == TokenType::STRING)) {
-                        dataPathTokens.push_back(line[tokenIndex]);
                         tokenIndex++;
                     }
-                    handleDirective(dataPathTokens);
+                    handleDirective(line.slice(dataStart, tokenIndex));
                 }
                 else if (inTextSection) {
-                    addLabel(currentToken.value);
+                    addLabel(currentToken.value, currentToken.lineNumber);
                     tokenIndex++;
                     if (tokenIndex < line.size() && line[tokenIndex].type == TokenType::OPCODE) {
                         currentAddress += INSTRUCTION_SIZE;
@@ -133,16 +175,47 @@ inline bool Parser::processFirstPass() {
             }
         }
     }
-    return errorCount == 0;
+    return diagnostics.empty();
+}
+
+// Number of instructions processSecondPass finds on a .text line.
+inline size_t Parser::countInstructions(TokenLine line) {
+    size_t count = 0;
+    size_t tokenIndex = 0;
+    while (tokenIndex < line.size()) {
+        TokenType type = line[tokenIndex].type;
+        tokenIndex++;
+        if (type == TokenType::OPCODE || (type == TokenType::LABEL && tokenIndex < line.size() && line[tokenIndex].type == TokenType::OPCODE)) {
+            while (tokenIndex < line.size() && line[tokenIndex].type != TokenType::DIRECTIVE && 
+                  line[tokenIndex].type != TokenType::LABEL) {
+                tokenIndex++;
+            }
+            count++;
+        }
+    }
+    return count;
 }
 
-inline bool Parser::processSecondPass() {
+// Section changes and the address each line starts at only depend on earlier lines, so they are
+// worked out first. The lines are then independent and are parsed in chunks, in parallel when
+// threads > 1, and the chunk outputs and diagnostics are concatenated in source order.
+inline bool Parser::processSecondPass(size_t threads) {
+    struct LinePlan {
+        size_t line;
+        uint32_t address;
+        bool inText;
+    };
+
     currentAddress = TEXT_SEGMENT_START;
+    textAddress = TEXT_SEGMENT_START;
     inTextSection = true;
     inDataSection = false;
     parsedInstructions.clear();
 
-    for (const auto &line : tokens) {
+    std::vector<LinePlan> plan;
+    plan.reserve(lines.size());
+    for (size_t index = 0; index < lines.size(); index++) {
+        TokenLine line = lines[index];
         if (line.empty()) continue;
 
         if (line[0].type == TokenType::DIRECTIVE) {
@@ -150,60 +223,80 @@ inline bool Parser::processSecondPass() {
             continue;
         }
 
-        size_t tokenIndex = 0;
-        while (tokenIndex < line.size()) {
-            const Token &currentToken = line[tokenIndex];
+        plan.push_back({index, currentAddress, inTextSection});
+        if (inTextSection) {
+            currentAddress += INSTRUCTION_SIZE * countInstructions(line);
+        }
+    }
 
-            if (currentToken.type == TokenType::LABEL && inTextSection) {
-                tokenIndex++;
+    auto ranges = splitRange(plan.size(), chunkCount(plan.size(), threads, MIN_CHUNK_LINES));
+    std::vector<std::vector<ParsedInstruction>> parts(ranges.size());
+    std::vector<Diagnostics> partDiagnostics(ranges.size());
+    parallelRun(ranges.size(), threads, [&](size_t r) {
+        for (size_t i = ranges[r].first; i < ranges[r].second; i++) {
+            parseLine(lines[plan[i].line], plan[i].address, plan[i].inText, parts[r], partDiagnostics[r]);
+        }
+    });
+    for (Diagnostics& part : partDiagnostics) {
+        diagnostics.append(std::move(part));
+    }
 
-                if (tokenIndex < line.size() && line[tokenIndex].type == TokenType::OPCODE) {
-                    std::vector<Token> instructionTokens;
-                    while (tokenIndex < line.size() && line[tokenIndex].type != TokenType::DIRECTIVE && 
-                          line[tokenIndex].type != TokenType::LABEL) {
-                        instructionTokens.push_back(line[tokenIndex]);
-                        tokenIndex++;
-                    }
+    size_t total = 0;
+    for (const auto &part : parts) total += part.size();
+    parsedInstructions.reserve(total);
+    for (const auto &part : parts) {
+        parsedInstructions.insert(parsedInstructions.end(), part.begin(), part.end());
+    }
+    return diagnostics.empty();
+}
 
-                    if (!handleInstruction(instructionTokens)) {
-                        reportError("Invalid instruction following label '" + currentToken.value + "'", line[0].lineNumber);
-                    }
-                    else {
-                        currentAddress += INSTRUCTION_SIZE;
-                    }
-                }
-            }
-            else if (currentToken.type == TokenType::OPCODE) {
-                std::vector<Token> instructionTokens;
+inline void Parser::parseLine(TokenLine line, uint32_t address, bool inText, std::vector<ParsedInstruction>& output,
+                              Diagnostics& lineDiagnostics) const {
+    size_t tokenIndex = 0;
+    while (tokenIndex < line.size()) {
+        const TokenView &currentToken = line[tokenIndex];
+
+        if (currentToken.type == TokenType::LABEL && inText) {
+            tokenIndex++;
+
+            if (tokenIndex < line.size() && line[tokenIndex].type == TokenType::OPCODE) {
+                size_t instructionStart = tokenIndex;
                 while (tokenIndex < line.size() && line[tokenIndex].type != TokenType::DIRECTIVE && 
                       line[tokenIndex].type != TokenType::LABEL) {
-                    instructionTokens.push_back(line[tokenIndex]);
                     tokenIndex++;
                 }
 
-                if (!handleInstruction(instructionTokens)) {
-                    reportError("Invalid instruction", line[0].lineNumber);
-                }
-                else {
-                    currentAddress += INSTRUCTION_SIZE;
+                if (handleInstruction(line.slice(instructionStart, tokenIndex), address, inText, output, lineDiagnostics)) {
+                    address += INSTRUCTION_SIZE;
                 }
             }
-            else {
+        }
+        else if (currentToken.type == TokenType::OPCODE) {
+            size_t instructionStart = tokenIndex;
+            while (tokenIndex < line.size() && line[tokenIndex].type != TokenType::DIRECTIVE && 
+                  line[tokenIndex].type != TokenType::LABEL) {
                 tokenIndex++;
             }
+
+            if (handleInstruction(line.slice(instructionStart, tokenIndex), address, inText, output, lineDiagnostics)) {
+                address += INSTRUCTION_SIZE;
+            }
+        }
+        else {
+            tokenIndex++;
         }
     }
-    return errorCount == 0;
 }
 
-inline void Parser::handleDirective(const std::vector<Token> &line) {
+inline void Parser::handleDirective(TokenLine line) {
     if (line.empty()) {
         reportError("Empty directive encountered");
         return;
     }
+    int lineNumber = line[0].lineNumber;
 
     size_t tokenIndex = 0;
-    std::string label = "";
+    std::string_view label;
 
     if (line[0].type == TokenType::LABEL) {
         label = line[0].value;
@@ -211,30 +304,30 @@ inline void Parser::handleDirective(const std::vector<Token> &line) {
     }
 
     if (tokenIndex >= line.size() || line[tokenIndex].type != TokenType::DIRECTIVE) {
-        reportError("Expected directive after label");
+        reportError("Expected directive after label", lineNumber);
         return;
     }
 
-    const std::string &directive = line[tokenIndex].value;
+    std::string_view directive = line[tokenIndex].value;
     tokenIndex++;
 
-    auto it = directives.find(directive);
-    if (it == directives.end()) {
-        reportError("Unsupported data directive '" + directive + "'");
+    int directiveSize = DIRECTIVE_TABLE.find(directive);
+    if (directiveSize < 0) {
+        reportError("Unsupported data directive '" + std::string(directive) + "'", lineNumber);
         return;
     }
 
-    uint32_t size = it->second;
+    uint32_t size = static_cast<uint32_t>(directiveSize);
     SymbolEntry entry;
     entry.address = currentAddress;
-    entry.directive = directive;
+    entry.directive = std::string(directive);
 
     if (directive == ".asciz" || directive == ".ascii" || directive == ".asciiz") {
         if (tokenIndex >= line.size() || line[tokenIndex].type != TokenType::STRING) {
-            reportError("Invalid or missing string literal for " + directive + " directive");
+            reportError("Invalid or missing string literal for " + std::string(directive) + " directive", lineNumber);
             return;
         }
-        entry.stringValue = line[tokenIndex].value;
+        entry.stringValue = std::string(line[tokenIndex].value);
         entry.isString = true;
         uint32_t stringSize = entry.stringValue.length();
         bool addNullTerminator = (directive == ".asciz" || directive == ".asciiz");
@@ -243,7 +336,7 @@ inline void Parser::handleDirective(const std::vector<Token> &line) {
     }
     else {
         if (tokenIndex >= line.size()) {
-            reportError("Missing value(s) for " + directive + " directive");
+            reportError("Missing value(s) for " + std::string(directive) + " directive", lineNumber);
             return;
         }
 
@@ -251,33 +344,34 @@ inline void Parser::handleDirective(const std::vector<Token> &line) {
 
         while (tokenIndex < line.size()) {
             if (line[tokenIndex].type == TokenType::IMMEDIATE) {
-                try {
-                    int64_t signedValue = parseImmediate(line[tokenIndex].value);
-                    uint64_t value = static_cast<uint64_t>(signedValue);
-                    if (directive == ".byte") {
-                        if (signedValue < -128 || signedValue > 127) {
-                            reportError("Value out of range for .byte directive: " + line[tokenIndex].value);
-                            return;
-                        }
-                    } else if (directive == ".half") {
-                        if (signedValue < -32768 || signedValue > 32767) {
-                            reportError("Value out of range for .half directive: " + line[tokenIndex].value);
-                            return;
-                        }
-                    } else if (directive == ".word") {
-                        if (signedValue < -2147483648LL || signedValue > 2147483647LL) {
-                            reportError("Value out of range for .word directive: " + line[tokenIndex].value);
-                            return;
-                        }
-                    }
-                    entry.numericValues.push_back(value);
-                } catch (const std::exception& e) {
-                    reportError("Invalid numeric value in " + directive + " directive: " + e.what());
+                int32_t parsed = 0;
+                NumberError error = parseImmediate(line[tokenIndex].value, parsed);
+                if (error != NumberError::NONE) {
+                    reportError("Invalid numeric value in " + std::string(directive) + " directive: " + std::string(line[tokenIndex].value) + " - " + getNumberErrorName(error), lineNumber);
                     return;
                 }
+                int64_t signedValue = parsed;
+                uint64_t value = static_cast<uint64_t>(signedValue);
+                if (directive == ".byte") {
+                    if (signedValue < -128 || signedValue > 127) {
+                        reportError("Value out of range for .byte directive: " + std::string(line[tokenIndex].value), lineNumber);
+                        return;
+                    }
+                } else if (directive == ".half") {
+                    if (signedValue < -32768 || signedValue > 32767) {
+                        reportError("Value out of range for .half directive: " + std::string(line[tokenIndex].value), lineNumber);
+                        return;
+                    }
+                } else if (directive == ".word") {
+                    if (signedValue < -2147483648LL || signedValue > 2147483647LL) {
+                        reportError("Value out of range for .word directive: " + std::string(line[tokenIndex].value), lineNumber);
+                        return;
+                    }
+                }
+                entry.numericValues.push_back(value);
             }
             else if (line[tokenIndex].type == TokenType::STRING) {
-                std::string strValue = line[tokenIndex].value;
+                std::string_view strValue = line[tokenIndex].value;
                 uint64_t packedValue = 0;
                 size_t maxChars = 0;
 
@@ -287,8 +381,8 @@ inline void Parser::handleDirective(const std::vector<Token> &line) {
                 else if (directive == ".dword") maxChars = 8;
 
                 if (strValue.length() > maxChars) {
-                    reportError("Too many characters in " + directive + " directive; expected " + 
-                               std::to_string(maxChars) + " per entry");
+                    reportError("Too many characters in " + std::string(directive) + " directive; expected " + 
+                               std::to_string(maxChars) + " per entry", lineNumber);
                     return;
                 }
 
@@ -298,7 +392,7 @@ inline void Parser::handleDirective(const std::vector<Token> &line) {
                 entry.numericValues.push_back(packedValue);
             }
             else {
-                reportError("Invalid value in " + directive + " directive");
+                reportError("Invalid value in " + std::string(directive) + " directive", lineNumber);
                 return;
             }
             tokenIndex++;
@@ -307,268 +401,183 @@ inline void Parser::handleDirective(const std::vector<Token> &line) {
     }
 
     if (!label.empty()) {
-        symbolTable[label] = entry;
+        symbolTable[std::string(label)] = entry;
     }
 }
 
-inline void Parser::addLabel(const std::string &label) {
-    auto [it, inserted] = symbolTable.emplace(label, SymbolEntry{currentAddress, false, {}, "", ""});
+inline void Parser::addLabel(std::string_view label, int lineNumber) {
+    auto [it, inserted] = symbolTable.emplace(std::string(label), SymbolEntry{currentAddress, false, {}, "", ""});
     if (!inserted) {
-        reportError("Duplicate label '" + label + "'");
+        reportError("Duplicate label '" + std::string(label) + "'", lineNumber);
     }
 }
 
-inline bool Parser::handleInstruction(const std::vector<Token>& line) {
+inline bool Parser::handleInstruction(TokenLine line, uint32_t address, bool inText, std::vector<ParsedInstruction>& output,
+                                      Diagnostics& lineDiagnostics) const {
     if (line.empty()) {
-        reportError("Empty instruction encountered");
+        reportError(lineDiagnostics, "Empty instruction encountered", 0);
         return false;
     }
+    int lineNumber = line[0].lineNumber;
 
-    if (!inTextSection) {
-        reportError("Instruction outside of .text section");
+    if (!inText) {
+        reportError(lineDiagnostics, "Instruction outside of .text section", lineNumber);
         return false;
     }
 
-    std::string opcode = line[0].value;
-    std::vector<std::string> operands;
-
-    if (riscv::opcodes.count(opcode) == 0) {
-        reportError("Unknown opcode '" + opcode + "'");
+    std::string_view opcode = line[0].value;
+    int opcodeValue = OPCODE_TABLE.find(opcode);
+    if (opcodeValue < 0) {
+        reportError(lineDiagnostics, "Unknown opcode '" + std::string(opcode) + "'", lineNumber);
         return false;
     }
 
-    size_t expectedOperands = 0;
-    bool isMemoryOp = false;
-    bool isStore = false;
-    bool isImm = false;
-    bool isBranch = false;
-    bool isUType = false;
-    bool isUJType = false;
-    
-    const auto& iTypeEncoding = riscv::ITypeInstructions::getEncoding();
-    if (iTypeEncoding.opcodeMap.count(opcode) && 
-        iTypeEncoding.func3Map.count(opcode) &&
-        (iTypeEncoding.func3Map.at(opcode) == 0b001 || 
-         (iTypeEncoding.func3Map.at(opcode) == 0b101 && iTypeEncoding.func7Map.count(opcode)))) {
-        expectedOperands = 3;
-        isImm = true;
-    }
-    else if (riscv::RTypeInstructions::getEncoding().opcodeMap.count(opcode)) {
-        expectedOperands = 3;
-    }
-    else if (riscv::ITypeInstructions::getEncoding().opcodeMap.count(opcode)) {
-        expectedOperands = 3;
-        isImm = true;
-        if (opcode == "lb" || opcode == "lh" || opcode == "lw" || opcode == "lbu" || opcode == "lhu" || opcode == "ld") {
-            isMemoryOp = true;
-        }
-    }
-    else if (riscv::STypeInstructions::getEncoding().opcodeMap.count(opcode)) {
-        expectedOperands = 3;
-        isMemoryOp = true;
-        isStore = true;
-    }
-    else if (riscv::SBTypeInstructions::getEncoding().opcodeMap.count(opcode)) {
-        expectedOperands = 3;
-        isBranch = true;
-    }
-    else if (riscv::UTypeInstructions::getEncoding().opcodeMap.count(opcode)) {
-        expectedOperands = 2;
-        isImm = true;
-        isUType = true;
-    }
-    else if (riscv::UJTypeInstructions::getEncoding().opcodeMap.count(opcode)) {
-        expectedOperands = 2;
-        isImm = true;
-        isUJType = true;
-    }
+    ParsedInstruction inst(static_cast<Instructions>(opcodeValue), address, line[0].lineNumber);
+    const InstructionFormat& format = getInstructionFormat(inst.instruction);
+    bool isStore = format.type == InstructionType::S;
+    bool isMemoryOp = isStore || isLoadFormat(format);
+    bool isBranch = format.type == InstructionType::SB;
+    bool isUType = format.type == InstructionType::U;
+    bool isUJType = format.type == InstructionType::UJ;
+    bool isImm = format.type == InstructionType::I || isUType || isUJType;
+    size_t expectedOperands = (isUType || isUJType) ? 2 : 3;
 
-    size_t i = 1;
-    bool foundMemoryFormat = false;
-    
     if (line.size() <= 1) {
-        reportError("Missing operands for instruction '" + opcode + "'");
+        reportError(lineDiagnostics, "Missing operands for instruction '" + std::string(opcode) + "'", lineNumber);
         return false;
     }
-    
-    while (i < line.size()) {
-        const Token& token = line[i];
-        
-        if (token.value.empty()) {
-            reportError("Empty token value in instruction");
-            i++;
-            continue;
+
+    // Operands past the last slot are only counted, so the count check below can report them.
+    size_t operandCount = 0;
+    const TokenView* lastOperand = nullptr;
+    auto addOperand = [&](const TokenView& token, int32_t value, bool reg) {
+        if (operandCount < inst.operands.size()) {
+            inst.addOperand(value, reg);
         }
-        
-        if (isStore && i == 1) {
-            if (!isRegister(token.value)) {
-                reportError("First operand of store instruction must be a register");
-                return false;
-            }
-            operands.push_back(token.value);
-            i++;
+        operandCount++;
+        lastOperand = &token;
+    };
+
+    for (size_t i = 1; i < line.size(); i++) {
+        const TokenView& token = line[i];
+
+        if (token.value.empty()) {
+            reportError(lineDiagnostics, "Empty token value in instruction", lineNumber);
             continue;
         }
 
-        if (isMemoryOp && ((isStore && i == 2) || (!isStore && i == 2))) {
-            std::string offset, reg;
-            if (isMemory(token.value, offset, reg)) {
-                foundMemoryFormat = true;
-                try {
-                    int32_t regNum = getRegisterNumber(reg);
-                    if (regNum < 0) {
-                        reportError("Invalid register in memory operand: " + reg);
-                        return false;
-                    }
-                    int32_t imm = parseImmediate(offset);
-                    if (imm < -2048 || imm > 2047) {
-                        reportError("Memory offset out of range (-2048 to 2047): " + offset);
-                        return false;
-                    }
-                    
-                    operands.push_back(offset);
-                    operands.push_back(reg);
-                    i++;
-                    continue;
-                } catch (const std::exception& e) {
-                    reportError("Invalid memory offset: " + offset + " - " + e.what());
-                    return false;
-                }
-            }
+        if (isStore && i == 1 && !isRegister(token.value)) {
+            reportError(lineDiagnostics, "First operand of store instruction must be a register", lineNumber);
+            return false;
         }
 
         switch (token.type) {
             case TokenType::REGISTER: {
                 int32_t regNum = getRegisterNumber(token.value);
                 if (regNum < 0) {
-                    reportError("Invalid register: " + token.value);
+                    reportError(lineDiagnostics, "Invalid register: " + std::string(token.value), lineNumber);
                     return false;
                 }
-                operands.push_back(token.value);
+                addOperand(token, regNum, true);
                 break;
             }
             case TokenType::IMMEDIATE: {
-                try {
-                    int32_t imm = parseImmediate(token.value);
-                    
-                    if (isMemoryOp && !foundMemoryFormat) {
-                        if (imm < -2048 || imm > 2047) {
-                            reportError("Memory offset out of range (-2048 to 2047): " + token.value);
-                            return false;
-                        }
-                    }
-                    else if (isBranch) {
-                        if (imm < -4096 || imm > 4095 || (imm & 1)) {
-                            reportError("Branch offset must be even and in range (-4096 to 4095): " + token.value);
-                            return false;
-                        }
-                    }
-                    else if (isUType) {
-                        if (imm < 0 || imm > 0xFFFFF) {
-                            reportError("Immediate value out of range for U-type instruction (0 to 0xFFFFF): " + token.value);
-                            return false;
-                        }
-                    }
-                    else if (isUJType) {
-                        if (imm < -524288 || imm > 524287 || (imm & 1)) {
-                            reportError("Jump immediate must be even and in range (-524288 to 524287): " + token.value);
-                            return false;
-                        }
+                int32_t imm = 0;
+                NumberError error = parseImmediate(token.value, imm);
+                if (error != NumberError::NONE) {
+                    reportError(lineDiagnostics, "Invalid immediate value: " + std::string(token.value) + " - " + getNumberErrorName(error), lineNumber);
+                    return false;
+                }
+                if (isMemoryOp) {
+                    if (imm < -2048 || imm > 2047) {
+                        reportError(lineDiagnostics, "Memory offset out of range (-2048 to 2047): " + std::string(token.value), lineNumber);
+                        return false;
                     }
-                    else if (isImm) {
-                        if (imm < -2048 || imm > 2047) {
-                            reportError("Immediate value out of range (-2048 to 2047): " + token.value);
-                            return false;
-                        }
+                }
+                else if (isBranch) {
+                    if (imm < -4096 || imm > 4095 || (imm & 1)) {
+                        reportError(lineDiagnostics, "Branch offset must be even and in range (-4096 to 4095): " + std::string(token.value), lineNumber);
+                        return false;
                     }
-                    operands.push_back(token.value);
-                } catch (const std::exception& e) {
-                    if (isMemoryOp && !foundMemoryFormat && isRegister(token.value)) {
-                        operands.push_back(token.value);
-                    } else {
-                        reportError("Invalid immediate value: " + token.value + " - " + e.what());
+                }
+                else if (isUType) {
+                    if (imm < 0 || imm > 0xFFFFF) {
+                        reportError(lineDiagnostics, "Immediate value out of range for U-type instruction (0 to 0xFFFFF): " + std::string(token.value), lineNumber);
                         return false;
                     }
                 }
-                break;
-            }
-            case TokenType::LABEL: {
-                auto labelAddress = resolveLabel(token.value);
-                if (labelAddress == static_cast<uint32_t>(-1)) return false;
-                
-                if (isBranch || isUJType || opcode == "j") {
-                    int32_t offset = static_cast<int32_t>(*labelAddress - currentAddress);
-                    if (isBranch && (offset < -4096 || offset > 4095 || (offset & 1))) {
-                        reportError("Branch target out of range or misaligned: " + token.value);
+                else if (isUJType) {
+                    if (imm < -524288 || imm > 524287 || (imm & 1)) {
+                        reportError(lineDiagnostics, "Jump immediate must be even and in range (-524288 to 524287): " + std::string(token.value), lineNumber);
                         return false;
-                    } else if ((isUJType || opcode == "j") && (offset < -1048576 || offset > 1048575 || (offset & 1))) {
-                        reportError("Jump target out of range or misaligned: " + token.value);
+                    }
+                }
+                else if (isImm) {
+                    if (imm < -2048 || imm > 2047) {
+                        reportError(lineDiagnostics, "Immediate value out of range (-2048 to 2047): " + std::string(token.value), lineNumber);
                         return false;
                     }
-                    operands.push_back(std::to_string(offset));
-                } else {
-                    operands.push_back(std::to_string(*labelAddress));
                 }
+                addOperand(token, imm, false);
                 break;
             }
+            case TokenType::LABEL:
             case TokenType::UNKNOWN: {
-                if (symbolTable.find(token.value) != symbolTable.end()) {
-                    auto labelAddress = resolveLabel(token.value);
-                    if (labelAddress == static_cast<uint32_t>(-1)) return false;
-                    
-                    if (isBranch || isUJType || opcode == "j") {
-                        int32_t offset = static_cast<int32_t>(*labelAddress - currentAddress);
-                        if (isBranch && (offset < -4096 || offset > 4095 || (offset & 1))) {
-                            reportError("Branch target out of range or misaligned: " + token.value);
-                            return false;
-                        } else if ((isUJType || opcode == "j") && (offset < -1048576 || offset > 1048575 || (offset & 1))) {
-                            reportError("Jump target out of range or misaligned: " + token.value);
-                            return false;
-                        }
-                        operands.push_back(std::to_string(offset));
-                    } else {
-                        operands.push_back(std::to_string(*labelAddress));
+                std::string name(token.value);
+                if (symbolTable.find(name) == symbolTable.end()) {
+                    reportError(lineDiagnostics, "Invalid operand or undefined label '" + name + "' in instruction", lineNumber);
+                    return false;
+                }
+                auto labelAddress = resolveLabel(name, lineNumber, lineDiagnostics);
+                if (!labelAddress) return false;
+
+                if (inst.relocation.kind != Relocation::Kind::NONE) {
+                    reportError(lineDiagnostics, "More than one label operand in instruction", lineNumber);
+                    return false;
+                }
+                if (isBranch || isUJType) {
+                    int32_t offset = static_cast<int32_t>(*labelAddress - address);
+                    if (isBranch && (offset < -4096 || offset > 4095 || (offset & 1))) {
+                        reportError(lineDiagnostics, "Branch target out of range or misaligned: " + std::string(token.value), lineNumber);
+                        return false;
+                    } else if (isUJType && (offset < -1048576 || offset > 1048575 || (offset & 1))) {
+                        reportError(lineDiagnostics, "Jump target out of range or misaligned: " + std::string(token.value), lineNumber);
+                        return false;
                     }
-                } else if (isRegister(token.value)) {
-                    operands.push_back(token.value);
+                    inst.relocation.kind = Relocation::Kind::PC_RELATIVE;
                 } else {
-                    reportError("Invalid operand or undefined label '" + token.value + "' in instruction");
-                    return false;
+                    inst.relocation.kind = Relocation::Kind::ABSOLUTE;
                 }
+                inst.relocation.slot = static_cast<uint8_t>(operandCount);
+                inst.relocation.target = *labelAddress;
+                addOperand(token, 0, false);
                 break;
             }
             default:
-                reportError("Invalid token type '" + getTokenTypeName(token.type) + "' with value '" + 
-                           (token.value.empty() ? "empty" : token.value) + "' in instruction");
+                reportError(lineDiagnostics, "Invalid token type '" + getTokenTypeName(token.type) + "' with value '" + 
+                           (token.value.empty() ? std::string("empty") : std::string(token.value)) + "' in instruction", lineNumber);
                 return false;
         }
-        i++;
     }
 
-    if (isMemoryOp && !foundMemoryFormat && operands.size() == expectedOperands) {
-        if (operands.empty() || operands.back().empty()) {
-            reportError("Missing base register in memory operation");
-            return false;
-        }
-        if (!isRegister(operands.back())) {
-            reportError("Invalid base register in memory operation: " + operands.back());
-            return false;
-        }
+    if (isMemoryOp && operandCount == expectedOperands && !inst.isRegister(expectedOperands - 1)) {
+        reportError(lineDiagnostics, "Invalid base register in memory operation: " + std::string(lastOperand->value), lineNumber);
+        return false;
     }
     
-    if (operands.size() != expectedOperands) {
-        reportError("Incorrect number of operands for '" + opcode + "' (expected " + std::to_string(expectedOperands) + 
-                   ", got " + std::to_string(operands.size()) + ")");
+    if (operandCount != expectedOperands) {
+        reportError(lineDiagnostics, "Incorrect number of operands for '" + std::string(opcode) + "' (expected " + std::to_string(expectedOperands) + 
+                   ", got " + std::to_string(operandCount) + ")", lineNumber);
         return false;
     }
     
-    parsedInstructions.emplace_back(opcode, operands, currentAddress);
+    output.push_back(inst);
     return true;
 }
 
-inline std::optional<uint32_t> Parser::resolveLabel(const std::string &label) const {
+inline std::optional<uint32_t> Parser::resolveLabel(const std::string &label, int lineNumber, Diagnostics& lineDiagnostics) const {
     if (label.empty()) {
-        reportError("Empty label encountered");
+        reportError(lineDiagnostics, "Empty label encountered", lineNumber);
         return std::nullopt;
     }
     
@@ -577,19 +586,16 @@ inline std::optional<uint32_t> Parser::resolveLabel(const std::string &label) co
         return it->second.address;
     }
     
-    reportError("Undefined label '" + label + "'");
+    reportError(lineDiagnostics, "Undefined label '" + label + "'", lineNumber);
     return std::nullopt;
 }
 
-inline void Parser::reportError(const std::string &message, int lineNumber) const {
-    std::string errorMsg;
-    if (lineNumber > 0) {
-        errorMsg = "Parser Error on Line " + std::to_string(lineNumber) + ": " + message;
-    } else {
-        errorMsg = "Parser Error: " + message;
-    }
-    throw std::runtime_error(std::string(RED) + errorMsg + RESET);
-    ++errorCount;
+inline void Parser::reportError(Diagnostics& into, const std::string &message, int lineNumber) {
+    into.error(DiagnosticSource::PARSER, message, lineNumber);
+}
+
+inline void Parser::reportError(const std::string &message, int lineNumber) {
+    reportError(diagnostics, message, lineNumber);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "types.hpp"
+
+using namespace riscv;
+
+inline constexpr size_t NUM_STAGES = 5;
+
+// One slot per stage, indexed directly by Stage.
+struct PipelineSlots {
+    std::array<InstructionNode*, NUM_STAGES> slots;
+
+    PipelineSlots() { slots.fill(nullptr); }
+
+    inline InstructionNode*& operator[](Stage stage) { return slots[static_cast<size_t>(stage)]; }
+    inline InstructionNode* operator[](Stage stage) const { return slots[static_cast<size_t>(stage)]; }
+
+    inline auto begin() { return slots.begin(); }
+    inline auto end() { return slots.end(); }
+    inline auto begin() const { return slots.begin(); }
+    inline auto end() const { return slots.end(); }
+};
+
+// Free-list of instruction nodes. Storage grows in blocks the first few cycles and is then
+// recycled, so a running pipeline does not touch the heap.
+class InstructionNodePool {
+public:
+    static constexpr size_t BLOCK_SIZE = 8;
+
+    InstructionNodePool() = default;
+    InstructionNodePool(const InstructionNodePool&) = delete;
+    InstructionNodePool& operator=(const InstructionNodePool&) = delete;
+
+    inline InstructionNode* acquire(uint32_t pc) {
+        if (freeList.empty()) {
+            grow();
+        }
+        InstructionNode* node = freeList.back();
+        freeList.pop_back();
+        *node = InstructionNode(pc);
+        return node;
+    }
+
+    inline void release(InstructionNode* node) {
+        if (node != nullptr) {
+            freeList.push_back(node);
+        }
+    }
+
+    inline size_t capacity() const { return blocks.size() * BLOCK_SIZE; }
+
+private:
+    std::vector<std::unique_ptr<InstructionNode[]>> blocks;
+    std::vector<InstructionNode*> freeList;
+
+    void grow() {
+        blocks.push_back(std::make_unique<InstructionNode[]>(BLOCK_SIZE));
+        freeList.reserve(capacity());
+        for (size_t i = 0; i < BLOCK_SIZE; i++) {
+            freeList.push_back(&blocks.back()[i]);
+        }
+    }
+};
+
+#endif
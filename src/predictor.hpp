@@ -0,0 +1,327 @@
+#ifndef PREDICTOR_HPP
+#define PREDICTOR_HPP
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "types.hpp"
+
+using namespace riscv;
+
+enum class PredictorType { ONE_BIT, TWO_BIT, GSHARE, TOURNAMENT };
+
+inline constexpr uint32_t MAX_PREDICTOR_TABLE_BITS = 20;
+
+inline std::string predictorTypeToString(PredictorType type) {
+    switch (type) {
+        case PredictorType::ONE_BIT: return "1bit";
+        case PredictorType::TWO_BIT: return "2bit";
+        case PredictorType::GSHARE: return "gshare";
+        case PredictorType::TOURNAMENT: return "tournament";
+        default: return "UNKNOWN";
+    }
+}
+
+inline bool parsePredictorType(const std::string& name, PredictorType& type) {
+    for (PredictorType candidate : {PredictorType::ONE_BIT, PredictorType::TWO_BIT, PredictorType::GSHARE, PredictorType::TOURNAMENT}) {
+        if (name == predictorTypeToString(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Table sizes are given as log2 of the entry count. The defaults reproduce the original
+// 1-bit predictor for any program with fewer than 4096 instructions.
+struct PredictorConfig {
+    PredictorType type;
+    uint32_t phtBits;
+    uint32_t btbBits;
+    uint32_t historyBits;
+    uint32_t rasEntries;
+
+    PredictorConfig() : type(PredictorType::ONE_BIT), phtBits(12), btbBits(12), historyBits(12), rasEntries(0) {}
+};
+
+struct PredictorStats {
+    uint32_t predictions;
+    uint32_t mispredictions;
+    uint32_t btbHits;
+    uint32_t btbMisses;
+    uint32_t returnPredictions;
+    uint32_t returnMispredictions;
+
+    PredictorStats() : predictions(0), mispredictions(0), btbHits(0), btbMisses(0), returnPredictions(0), returnMispredictions(0) {}
+};
+
+inline uint32_t tableIndex(uint32_t pc, uint32_t mask) {
+    return (pc >> 2) & mask;
+}
+
+inline void validateTableBits(uint32_t bits, const std::string& name) {
+    if (bits == 0 || bits > MAX_PREDICTOR_TABLE_BITS) {
+        throw std::runtime_error(std::string(RED) + "Invalid " + name + " size: 2^" + std::to_string(bits) + " entries (expected 2^1 - 2^" + std::to_string(MAX_PREDICTOR_TABLE_BITS) + ")" + RESET);
+    }
+}
+
+class DirectionPredictor {
+public:
+    virtual ~DirectionPredictor() = default;
+    virtual bool predict(uint32_t pc) const = 0;
+    virtual void update(uint32_t pc, bool taken) = 0;
+    virtual void reset() = 0;
+    virtual std::unique_ptr<DirectionPredictor> clone() const = 0;
+};
+
+class OneBitPredictor : public DirectionPredictor {
+public:
+    explicit OneBitPredictor(uint32_t bits) : table(1u << bits, 0), mask((1u << bits) - 1) {}
+
+    bool predict(uint32_t pc) const override { return table[tableIndex(pc, mask)] != 0; }
+    void update(uint32_t pc, bool taken) override { table[tableIndex(pc, mask)] = taken ? 1 : 0; }
+    void reset() override { std::fill(table.begin(), table.end(), 0); }
+    std::unique_ptr<DirectionPredictor> clone() const override { return std::make_unique<OneBitPredictor>(*this); }
+
+private:
+    std::vector<uint8_t> table;
+    uint32_t mask;
+};
+
+// Table of 2-bit saturating counters, starting weakly not-taken.
+class CounterTable {
+public:
+    explicit CounterTable(uint32_t bits) : counters(1u << bits, 1), mask((1u << bits) - 1) {}
+
+    inline bool predict(uint32_t index) const { return counters[index & mask] >= 2; }
+
+    inline void update(uint32_t index, bool taken) {
+        uint8_t& counter = counters[index & mask];
+        if (taken && counter < 3) counter++;
+        if (!taken && counter > 0) counter--;
+    }
+
+    inline void reset() { std::fill(counters.begin(), counters.end(), 1); }
+
+private:
+    std::vector<uint8_t> counters;
+    uint32_t mask;
+};
+
+class TwoBitPredictor : public DirectionPredictor {
+public:
+    explicit TwoBitPredictor(uint32_t bits) : counters(bits) {}
+
+    bool predict(uint32_t pc) const override { return counters.predict(pc >> 2); }
+    void update(uint32_t pc, bool taken) override { counters.update(pc >> 2, taken); }
+    void reset() override { counters.reset(); }
+    std::unique_ptr<DirectionPredictor> clone() const override { return std::make_unique<TwoBitPredictor>(*this); }
+
+private:
+    CounterTable counters;
+};
+
+class GsharePredictor : public DirectionPredictor {
+public:
+    GsharePredictor(uint32_t bits, uint32_t historyBits)
+        : counters(bits), history(0), historyMask(historyBits >= 32 ? UINT32_MAX : (1u << historyBits) - 1) {}
+
+    bool predict(uint32_t pc) const override { return counters.predict(index(pc)); }
+
+    void update(uint32_t pc, bool taken) override {
+        counters.update(index(pc), taken);
+        history = ((history << 1) | (taken ? 1 : 0)) & historyMask;
+    }
+
+    void reset() override {
+        counters.reset();
+        history = 0;
+    }
+
+    std::unique_ptr<DirectionPredictor> clone() const override { return std::make_unique<GsharePredictor>(*this); }
+
+private:
+    CounterTable counters;
+    uint32_t history;
+    uint32_t historyMask;
+
+    inline uint32_t index(uint32_t pc) const { return (pc >> 2) ^ history; }
+};
+
+// Chooses per branch between a bimodal (per-PC) and a gshare (global history) component.
+class TournamentPredictor : public DirectionPredictor {
+public:
+    TournamentPredictor(uint32_t bits, uint32_t historyBits)
+        : local(bits), global(bits, historyBits), chooser(bits) {}
+
+    bool predict(uint32_t pc) const override {
+        return chooser.predict(pc >> 2) ? global.predict(pc) : local.predict(pc);
+    }
+
+    void update(uint32_t pc, bool taken) override {
+        bool localCorrect = local.predict(pc) == taken;
+        bool globalCorrect = global.predict(pc) == taken;
+        if (localCorrect != globalCorrect) {
+            chooser.update(pc >> 2, globalCorrect);
+        }
+        local.update(pc, taken);
+        global.update(pc, taken);
+    }
+
+    void reset() override {
+        local.reset();
+        global.reset();
+        chooser.reset();
+    }
+
+    std::unique_ptr<DirectionPredictor> clone() const override { return std::make_unique<TournamentPredictor>(*this); }
+
+private:
+    TwoBitPredictor local;
+    GsharePredictor global;
+    CounterTable chooser;
+};
+
+// Direction predictor plus a direct-mapped, PC-tagged BTB and an optional return address stack.
+class BranchPredictor {
+public:
+    BranchPredictor() { configure(PredictorConfig()); }
+
+    // Copies own their tables, so a snapshot keeps the predictor state it was taken with.
+    BranchPredictor(const BranchPredictor& other)
+        : config(other.config), direction(other.direction->clone()), btb(other.btb), btbMask(other.btbMask),
+          returnStack(other.returnStack), returnTop(other.returnTop), stats(other.stats) {}
+
+    BranchPredictor& operator=(const BranchPredictor& other) {
+        if (this != &other) {
+            config = other.config;
+            direction = other.direction->clone();
+            btb = other.btb;
+            btbMask = other.btbMask;
+            returnStack = other.returnStack;
+            returnTop = other.returnTop;
+            stats = other.stats;
+        }
+        return *this;
+    }
+
+    void configure(const PredictorConfig& newConfig) {
+        validateTableBits(newConfig.phtBits, "PHT");
+        validateTableBits(newConfig.btbBits, "BTB");
+        switch (newConfig.type) {
+            case PredictorType::ONE_BIT:
+                direction = std::make_unique<OneBitPredictor>(newConfig.phtBits);
+                break;
+            case PredictorType::TWO_BIT:
+                direction = std::make_unique<TwoBitPredictor>(newConfig.phtBits);
+                break;
+            case PredictorType::GSHARE:
+                direction = std::make_unique<GsharePredictor>(newConfig.phtBits, newConfig.historyBits);
+                break;
+            case PredictorType::TOURNAMENT:
+                direction = std::make_unique<TournamentPredictor>(newConfig.phtBits, newConfig.historyBits);
+                break;
+        }
+        config = newConfig;
+        btb.assign(1u << config.btbBits, BTBEntry());
+        btbMask = (1u << config.btbBits) - 1;
+        returnStack.assign(config.rasEntries, 0);
+        returnTop = 0;
+        stats = PredictorStats();
+    }
+
+    inline const PredictorConfig& getConfig() const { return config; }
+    inline const PredictorStats& getStats() const { return stats; }
+
+    inline bool predict(uint32_t pc) const { return direction->predict(pc); }
+    inline bool getPHT(uint32_t pc) const { return direction->predict(pc); }
+
+    inline bool isInBTB(uint32_t pc) const {
+        const BTBEntry& entry = btb[tableIndex(pc, btbMask)];
+        return entry.valid && entry.tag == pc;
+    }
+
+    inline uint32_t getTarget(uint32_t pc) const {
+        return isInBTB(pc) ? btb[tableIndex(pc, btbMask)].targetAddress : 0;
+    }
+
+    // Fetch-time target lookup; counts BTB hits and misses.
+    inline bool predictTarget(uint32_t pc, uint32_t& target) {
+        if (isInBTB(pc)) {
+            target = btb[tableIndex(pc, btbMask)].targetAddress;
+            stats.btbHits++;
+            return true;
+        }
+        stats.btbMisses++;
+        return false;
+    }
+
+    // Fetch-time return address stack handling. Calls (jal/jalr writing ra or t0) push their
+    // return address; returns (jalr x0 through ra or t0) pop it into target and yield true.
+    inline bool predictReturn(const DecodedInstruction& inst, uint32_t pc, uint32_t& target) {
+        if (returnStack.empty()) return false;
+        bool isJalr = inst.instructionName == Instructions::JALR;
+        if (isJalr && inst.rd == 0 && isLinkRegister(inst.rs1)) {
+            if (returnTop == 0) return false;
+            target = returnStack[(returnTop - 1) % returnStack.size()];
+            returnTop--;
+            stats.returnPredictions++;
+            return true;
+        }
+        if ((isJalr || inst.instructionName == Instructions::JAL) && isLinkRegister(inst.rd)) {
+            returnStack[returnTop % returnStack.size()] = pc + INSTRUCTION_SIZE;
+            returnTop++;
+        }
+        return false;
+    }
+
+    inline uint32_t returnCheckpoint() const { return returnTop; }
+    inline void restoreReturnCheckpoint(uint32_t checkpoint) { returnTop = checkpoint; }
+    inline void recordReturnMisprediction() { stats.returnMispredictions++; }
+
+    // mispredicted is the resolved outcome: a wrong direction or a wrong target both count.
+    void update(uint32_t pc, bool taken, uint32_t targetAddress, bool mispredicted) {
+        stats.predictions++;
+        direction->update(pc, taken);
+        if (taken) {
+            BTBEntry& entry = btb[tableIndex(pc, btbMask)];
+            entry.tag = pc;
+            entry.targetAddress = targetAddress;
+            entry.valid = true;
+        }
+        if (mispredicted) {
+            stats.mispredictions++;
+        }
+    }
+
+    void reset() {
+        direction->reset();
+        std::fill(btb.begin(), btb.end(), BTBEntry());
+        std::fill(returnStack.begin(), returnStack.end(), 0);
+        returnTop = 0;
+        stats = PredictorStats();
+    }
+
+private:
+    struct BTBEntry {
+        uint32_t tag;
+        uint32_t targetAddress;
+        bool valid;
+
+        BTBEntry() : tag(0), targetAddress(0), valid(false) {}
+    };
+
+    PredictorConfig config;
+    std::unique_ptr<DirectionPredictor> direction;
+    std::vector<BTBEntry> btb;
+    uint32_t btbMask;
+    std::vector<uint32_t> returnStack;
+    uint32_t returnTop;
+    PredictorStats stats;
+
+    static inline bool isLinkRegister(uint32_t reg) { return reg == 1 || reg == 5; }
+};
+
+#endif
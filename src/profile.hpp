@@ -0,0 +1,168 @@
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <vector>
+#include "types.hpp"
+#include "program.hpp"
+
+using namespace riscv;
+
+enum class StallCause : uint32_t { RAW, LOAD_USE, CONTROL, CACHE, COUNT };
+
+inline const char* stallCauseToString(StallCause cause) {
+    switch (cause) {
+        case StallCause::RAW: return "raw";
+        case StallCause::LOAD_USE: return "loadUse";
+        case StallCause::CONTROL: return "control";
+        case StallCause::CACHE: return "cache";
+        default: return "UNKNOWN";
+    }
+}
+
+// One row of the report, gathered from the profiler's arrays for a single instruction.
+struct ProfileEntry {
+    uint32_t pc;
+    uint64_t executions;
+    uint64_t stalls[static_cast<size_t>(StallCause::COUNT)];
+    uint64_t branches;
+    uint64_t mispredictions;
+    uint64_t memoryAccesses;
+
+    ProfileEntry() : pc(0), executions(0), stalls{}, branches(0), mispredictions(0), memoryAccesses(0) {}
+
+    inline uint64_t stallCycles() const {
+        uint64_t total = 0;
+        for (uint64_t count : stalls) total += count;
+        return total;
+    }
+    // Cycles this instruction is responsible for: one per retirement plus every stall charged to it.
+    inline uint64_t cost() const { return executions + stallCycles(); }
+};
+
+// Opt-in per-instruction counters. Every counter is a flat array indexed by
+// (PC - TEXT_SEGMENT_START) / INSTRUCTION_SIZE and sized to the loaded text segment, so a record
+// is a bounds check and an increment. The simulator only holds a pointer to a Profiler; with none
+// attached each call site costs one predictable null test.
+//
+// Stalls are charged to the instruction that waits: RAW and load-use cycles to the consumer,
+// cache cycles to the instruction whose access missed. A control flush is charged to the branch
+// that mispredicted, one cycle per squashed instruction.
+class Profiler {
+public:
+    inline void reset(size_t instructions);
+    inline size_t size() const { return executions.size(); }
+
+    inline void recordExecution(uint32_t pc) { bump(executions, pc, 1); }
+    inline void recordStall(uint32_t pc, StallCause cause, uint32_t cycles = 1) { bump(stalls[static_cast<size_t>(cause)], pc, cycles); }
+    inline void recordBranch(uint32_t pc, bool mispredicted);
+    inline void recordMemoryAccess(uint32_t pc) { bump(memoryAccesses, pc, 1); }
+
+    inline ProfileEntry entry(size_t index) const;
+    // Instructions that executed or stalled, most expensive first (see ProfileEntry::cost).
+    inline std::vector<ProfileEntry> hotspots(size_t limit = SIZE_MAX) const;
+
+private:
+    std::vector<uint64_t> executions;
+    std::vector<uint64_t> stalls[static_cast<size_t>(StallCause::COUNT)];
+    std::vector<uint64_t> branches;
+    std::vector<uint64_t> mispredictions;
+    std::vector<uint64_t> memoryAccesses;
+
+    static inline void bump(std::vector<uint64_t>& counters, uint32_t pc, uint32_t amount) {
+        size_t index = static_cast<size_t>(pc - TEXT_SEGMENT_START) / INSTRUCTION_SIZE;
+        if (index < counters.size()) counters[index] += amount;
+    }
+};
+
+inline void Profiler::reset(size_t instructions) {
+    executions.assign(instructions, 0);
+    for (std::vector<uint64_t>& counters : stalls) counters.assign(instructions, 0);
+    branches.assign(instructions, 0);
+    mispredictions.assign(instructions, 0);
+    memoryAccesses.assign(instructions, 0);
+}
+
+inline void Profiler::recordBranch(uint32_t pc, bool mispredicted) {
+    bump(branches, pc, 1);
+    if (mispredicted) bump(mispredictions, pc, 1);
+}
+
+inline ProfileEntry Profiler::entry(size_t index) const {
+    ProfileEntry result;
+    result.pc = TEXT_SEGMENT_START + static_cast<uint32_t>(index) * INSTRUCTION_SIZE;
+    result.executions = executions[index];
+    for (size_t cause = 0; cause < static_cast<size_t>(StallCause::COUNT); cause++) {
+        result.stalls[cause] = stalls[cause][index];
+    }
+    result.branches = branches[index];
+    result.mispredictions = mispredictions[index];
+    result.memoryAccesses = memoryAccesses[index];
+    return result;
+}
+
+inline std::vector<ProfileEntry> Profiler::hotspots(size_t limit) const {
+    std::vector<ProfileEntry> entries;
+    for (size_t i = 0; i < size(); i++) {
+        ProfileEntry candidate = entry(i);
+        if (candidate.cost() != 0) entries.push_back(candidate);
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const ProfileEntry& a, const ProfileEntry& b) {
+        return a.cost() > b.cost();
+    });
+    if (entries.size() > limit) entries.resize(limit);
+    return entries;
+}
+
+// Cost% is each instruction's share of the cost of all profiled instructions.
+inline void writeProfileReport(std::ostream& out, const Profiler& profiler, const ProgramImage& program, size_t limit) {
+    std::vector<ProfileEntry> entries = profiler.hotspots();
+    uint64_t totalCost = 0;
+    for (const ProfileEntry& e : entries) totalCost += e.cost();
+    if (entries.size() > limit) entries.resize(limit);
+
+    out << std::left << std::setw(12) << "PC" << std::right << std::setw(10) << "Count" << std::setw(8) << "Cost%"
+        << std::setw(8) << "RAW" << std::setw(10) << "LoadUse" << std::setw(9) << "Control" << std::setw(8) << "Cache"
+        << std::setw(12) << "Mispredict" << std::setw(8) << "Memory" << "  " << std::left << std::setw(6) << "Line" << "Instruction\n";
+    for (const ProfileEntry& e : entries) {
+        size_t index = (e.pc - TEXT_SEGMENT_START) / INSTRUCTION_SIZE;
+        double share = totalCost != 0 ? 100.0 * static_cast<double>(e.cost()) / static_cast<double>(totalCost) : 0.0;
+        std::ostringstream pc;
+        pc << "0x" << std::hex << std::setw(8) << std::setfill('0') << e.pc;
+        std::ostringstream branch;
+        if (e.branches != 0) branch << e.mispredictions << "/" << e.branches;
+        out << std::left << std::setw(12) << pc.str() << std::right << std::setw(10) << e.executions
+            << std::setw(8) << std::fixed << std::setprecision(1) << share << std::defaultfloat
+            << std::setw(8) << e.stalls[static_cast<size_t>(StallCause::RAW)]
+            << std::setw(10) << e.stalls[static_cast<size_t>(StallCause::LOAD_USE)]
+            << std::setw(9) << e.stalls[static_cast<size_t>(StallCause::CONTROL)]
+            << std::setw(8) << e.stalls[static_cast<size_t>(StallCause::CACHE)]
+            << std::setw(12) << branch.str() << std::setw(8) << e.memoryAccesses << "  "
+            << std::left << std::setw(6) << program.getSourceLine(index) << program.getDisassembly(index) << "\n";
+    }
+    out << std::right;
+}
+
+inline void writeProfileJson(std::ostream& out, const Profiler& profiler, const ProgramImage& program) {
+    out << "[\n";
+    bool first = true;
+    for (size_t i = 0; i < profiler.size(); i++) {
+        ProfileEntry e = profiler.entry(i);
+        if (e.cost() == 0) continue;
+        out << (first ? "" : ",\n") << "  {\"pc\": " << e.pc << ", \"line\": " << program.getSourceLine(i)
+            << ", \"instruction\": \"" << program.getDisassembly(i) << "\", \"executions\": " << e.executions;
+        for (size_t cause = 0; cause < static_cast<size_t>(StallCause::COUNT); cause++) {
+            out << ", \"" << stallCauseToString(static_cast<StallCause>(cause)) << "Stalls\": " << e.stalls[cause];
+        }
+        out << ", \"branches\": " << e.branches << ", \"mispredictions\": " << e.mispredictions
+            << ", \"memoryAccesses\": " << e.memoryAccesses << "}";
+        first = false;
+    }
+    out << (first ? "" : "\n") << "]\n";
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef PROGRAM_HPP
+#define PROGRAM_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "types.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "assembler.hpp"
+#include "memory.hpp"
+#include "execution.hpp"
+#include "translate.hpp"
+
+using namespace riscv;
+
+// Assembled program shared by every simulator that loads it. The image is immutable once built
+// and handed out as shared_ptr<const ProgramImage>: loading it only takes a reference, and the
+// initial data pages are shared copy-on-write with each simulator's Memory.
+class ProgramImage {
+public:
+    ProgramImage() = default;
+    ProgramImage(std::vector<uint32_t> text, Memory data, std::unordered_map<std::string, SymbolEntry> symbols,
+                 std::vector<uint32_t> sourceLines = {});
+    ProgramImage(const ProgramImage&) = delete;
+    ProgramImage& operator=(const ProgramImage&) = delete;
+
+    inline size_t size() const { return text.size(); }
+    inline bool empty() const { return text.empty(); }
+    inline const std::vector<uint32_t>& getText() const { return text; }
+    inline const std::vector<DecodedInstruction>& getDecodedText() const { return decodedText; }
+    inline const Memory& getData() const { return data; }
+    inline const std::unordered_map<std::string, SymbolEntry>& getSymbols() const { return symbols; }
+    inline uint32_t getSourceLine(size_t index) const { return index < sourceLines.size() ? sourceLines[index] : 0; }
+    inline const std::vector<uint32_t>& getSourceLines() const { return sourceLines; }
+
+    // Disassembly is only needed by front ends and is produced on request, not stored.
+    inline std::string getDisassembly(size_t index) const { return index < text.size() ? disassembleInstruction(text[index]) : ""; }
+    inline const TranslatedText& getTranslation() const;
+
+private:
+    std::vector<uint32_t> text;
+    std::vector<DecodedInstruction> decodedText;
+    Memory data;
+    std::unordered_map<std::string, SymbolEntry> symbols;
+    std::vector<uint32_t> sourceLines;
+
+    mutable std::once_flag translationBuilt;
+    mutable TranslatedText translation;
+};
+
+inline ProgramImage::ProgramImage(std::vector<uint32_t> text, Memory data, std::unordered_map<std::string, SymbolEntry> symbols,
+                                  std::vector<uint32_t> sourceLines)
+    : text(std::move(text)), data(std::move(data)), symbols(std::move(symbols)), sourceLines(std::move(sourceLines)) {
+    decodedText.reserve(this->text.size());
+    for (uint32_t word : this->text) {
+        decodedText.push_back(predecodeInstruction(word));
+    }
+}
+
+// Built on the first functional run, then shared by every simulator running this image.
+inline const TranslatedText& ProgramImage::getTranslation() const {
+    std::call_once(translationBuilt, [this]() { translation.build(decodedText); });
+    return translation;
+}
+
+inline const std::shared_ptr<const ProgramImage>& emptyProgramImage() {
+    static const std::shared_ptr<const ProgramImage> empty = std::make_shared<const ProgramImage>();
+    return empty;
+}
+
+inline std::shared_ptr<const ProgramImage> buildProgramImage(const Parser& parser, const Assembler& assembler) {
+    std::map<uint32_t, uint32_t> textWords;
+    Memory data;
+    for (const auto &[address, value] : assembler.getMachineCode()) {
+        if (address >= DATA_SEGMENT_START) {
+            data.writeByte(address, static_cast<uint8_t>(value));
+        } else {
+            textWords[address] = value;
+        }
+    }
+
+    std::unordered_map<uint32_t, uint32_t> lineOf;
+    for (const ParsedInstruction& inst : parser.getParsedInstructions()) {
+        lineOf[inst.address] = static_cast<uint32_t>(inst.lineNumber);
+    }
+
+    std::vector<uint32_t> text;
+    std::vector<uint32_t> sourceLines;
+    text.reserve(textWords.size());
+    sourceLines.reserve(textWords.size());
+    for (const auto &[address, word] : textWords) {
+        text.push_back(word);
+        auto line = lineOf.find(address);
+        sourceLines.push_back(line != lineOf.end() ? line->second : 0);
+    }
+    return std::make_shared<const ProgramImage>(std::move(text), std::move(data), parser.getSymbolTable(), std::move(sourceLines));
+}
+
+// Every lexer and parser error in the input is added to diagnostics; the program is only encoded
+// when there were none. Returns nullptr on failure without throwing.
+inline std::shared_ptr<const ProgramImage> assembleProgram(std::string_view input, Diagnostics& diagnostics, size_t threads = 1) {
+    TokenStream stream = Lexer::scan(input, diagnostics, threads);
+    if (stream.lineCount() == 0) {
+        if (diagnostics.empty()) diagnostics.error(DiagnosticSource::LEXER, "No tokens generated from input");
+        return nullptr;
+    }
+
+    Parser parser(stream);
+    bool parsed = parser.parse(threads);
+    diagnostics.append(parser.getDiagnostics());
+    diagnostics.sortByLine();
+    if (!parsed || !diagnostics.empty()) return nullptr;
+
+    Assembler assembler(parser.getSymbolTable(), parser.getParsedInstructions());
+    if (!assembler.assemble(threads)) {
+        diagnostics.append(assembler.getDiagnostics());
+        return nullptr;
+    }
+    return buildProgramImage(parser, assembler);
+}
+
+// Throws once, with every diagnostic, when the input does not assemble.
+inline std::shared_ptr<const ProgramImage> assembleProgram(const std::string& input, size_t threads = 1) {
+    Diagnostics diagnostics;
+    std::shared_ptr<const ProgramImage> image = assembleProgram(std::string_view(input), diagnostics, threads);
+    diagnostics.throwIfAny();
+    return image;
+}
+
+#endif
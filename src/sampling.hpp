@@ -0,0 +1,242 @@
+#ifndef SAMPLING_HPP
+#define SAMPLING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "types.hpp"
+#include "simulator.hpp"
+#include "snapshot.hpp"
+
+using namespace riscv;
+
+// Two-sided 95% normal quantile used for the confidence intervals.
+inline constexpr double SAMPLING_CONFIDENCE_Z = 1.96;
+
+// Systematic sampling in the style of SMARTS: fastForward instructions on the functional engine,
+// then warmup instructions on the detailed model to refill the pipeline, then measure
+// instructions whose cycles and hazards form one sample, and so on until the program ends or
+// maxInstructions have run. Caches and predictor tables keep their contents across the
+// functional stretches; they are only updated while the detailed model runs.
+struct SamplingConfig {
+    uint32_t fastForward;
+    uint32_t warmup;
+    uint32_t measure;
+    uint64_t maxInstructions;
+    bool pipeline;
+    bool dataForwarding;
+    bool branchPrediction;
+
+    SamplingConfig() : fastForward(100000), warmup(2000), measure(1000), maxInstructions(MAX_FUNCTIONAL_STEPS),
+                       pipeline(true), dataForwarding(false), branchPrediction(false) {}
+};
+
+// Per-instruction rate of one counter over the measured windows, scaled to the whole run.
+struct SampledMetric {
+    std::string name;
+    double mean;
+    double halfWidth;
+    double estimate;
+    double estimateHalfWidth;
+
+    SampledMetric() : mean(0.0), halfWidth(0.0), estimate(0.0), estimateHalfWidth(0.0) {}
+};
+
+struct SamplingResult {
+    uint32_t windows;
+    uint64_t totalInstructions;
+    uint64_t detailedInstructions;
+    uint64_t detailedCycles;
+    bool completed;
+    // When the program ends inside a detailed stretch, that stretch is replayed functionally from
+    // its start; false if the replay ends with a different PC, registers or instruction count.
+    bool matchesFunctional;
+    // The first entry is CPI, so its estimate is the extrapolated cycle count.
+    std::vector<SampledMetric> metrics;
+
+    SamplingResult() : windows(0), totalInstructions(0), detailedInstructions(0), detailedCycles(0), completed(false), matchesFunctional(true) {}
+};
+
+inline std::vector<uint32_t> parseSamplingSpec(const std::string& spec) {
+    std::vector<uint32_t> values;
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(start, end - start);
+        uint32_t parsed = 0;
+        if (parseUnsigned(item, parsed) != NumberError::NONE || parsed == 0) {
+            throw std::runtime_error(std::string(RED) + "Invalid sampling value '" + item + "' (expected FAST_FORWARD,WARMUP,MEASURE)" + RESET);
+        }
+        values.push_back(parsed);
+        start = end + 1;
+    }
+    if (values.size() != 3) {
+        throw std::runtime_error(std::string(RED) + "Sampling expects three counts: FAST_FORWARD,WARMUP,MEASURE" + RESET);
+    }
+    return values;
+}
+
+namespace sampling {
+    struct Counter {
+        const char* name;
+        uint32_t SimulationStats::*field;
+    };
+
+    inline constexpr Counter COUNTERS[] = {
+        {"CPI", &SimulationStats::totalCycles},
+        {"Stall Bubbles", &SimulationStats::stallBubbles},
+        {"Data Hazards", &SimulationStats::dataHazards},
+        {"Data Hazard Stalls", &SimulationStats::dataHazardStalls},
+        {"Control Hazards", &SimulationStats::controlHazards},
+        {"Pipeline Flushes", &SimulationStats::pipelineFlushes},
+        {"Branch Mispredictions", &SimulationStats::branchMispredictions},
+        {"Cache Stall Cycles", &SimulationStats::cacheStallCycles},
+    };
+    inline constexpr size_t COUNTER_COUNT = sizeof(COUNTERS) / sizeof(COUNTERS[0]);
+
+    // Runs the current mode until count more instructions have retired or the program ends.
+    template <typename Sim>
+    inline bool advance(Sim& sim, uint32_t count) {
+        uint32_t target = sim.getInstructionCount() + count;
+        while (sim.getInstructionCount() < target) {
+            if (!sim.step()) return false;
+        }
+        return true;
+    }
+
+    // Replays from checkpoint on the functional engine, with at most budget instructions, and
+    // compares where it ends with sim's current, terminated state. sim is left in that state.
+    template <typename Sim>
+    inline bool matchesFunctional(Sim& sim, const SimulatorSnapshot& checkpoint, uint64_t budget) {
+        SimulatorSnapshot detailed = sim.takeSnapshot();
+        EventSink* sink = sim.getEventSink();
+        Profiler* profiler = sim.getProfiler();
+        TraceWriter* tracer = sim.getTracer();
+        sim.setEventSink(nullptr);
+        sim.setProfiler(nullptr);
+        sim.setTracer(nullptr);
+        sim.restoreSnapshot(checkpoint);
+        sim.setEnvironment(false, false, false, UINT32_MAX, true);
+        RunSummary summary = sim.runCycles(static_cast<uint32_t>(std::min<uint64_t>(budget, UINT32_MAX)));
+        bool matches = summary.reason == StopReason::TERMINATED && sim.getPC() == detailed.PC &&
+                       sim.getInstructionCount() == detailed.instructionCount &&
+                       std::equal(detailed.registers, detailed.registers + NUM_REGISTERS, sim.getRegisters());
+        sim.restoreSnapshot(detailed);
+        sim.setEventSink(sink);
+        sim.setProfiler(profiler);
+        sim.setTracer(tracer);
+        return matches;
+    }
+}
+
+// Runs an already loaded program on sim under config. sim's predictor and cache configuration
+// are used as they are; the execution mode is switched back and forth by the sampler.
+template <typename Sim>
+inline SamplingResult runSampled(Sim& sim, const SamplingConfig& config) {
+    SamplingResult result;
+    std::vector<std::vector<double>> rates(sampling::COUNTER_COUNT);
+    uint64_t executed = 0;
+    bool running = sim.isRunning();
+
+    while (running && executed < config.maxInstructions) {
+        uint32_t start = sim.getInstructionCount();
+        sim.setEnvironment(false, false, false, UINT32_MAX, true);
+        RunSummary summary = sim.runCycles(static_cast<uint32_t>(std::min<uint64_t>(config.fastForward, config.maxInstructions - executed)));
+        running = summary.reason != StopReason::TERMINATED;
+        executed += sim.getInstructionCount() - start;
+        if (!running || executed >= config.maxInstructions) break;
+
+        start = sim.getInstructionCount();
+        SimulatorSnapshot checkpoint = sim.takeSnapshot();
+        sim.setEnvironment(config.pipeline, config.dataForwarding, config.branchPrediction, UINT32_MAX, false);
+        running = sampling::advance(sim, config.warmup);
+        if (running) {
+            SimulationStats before = sim.getStats();
+            running = sampling::advance(sim, config.measure);
+            SimulationStats after = sim.getStats();
+            uint32_t instructions = after.instructionsExecuted - before.instructionsExecuted;
+            // A window cut short by the end of the program is not a full sample.
+            if (running && instructions != 0) {
+                for (size_t i = 0; i < sampling::COUNTER_COUNT; i++) {
+                    uint32_t delta = after.*(sampling::COUNTERS[i].field) - before.*(sampling::COUNTERS[i].field);
+                    rates[i].push_back(static_cast<double>(delta) / instructions);
+                }
+                result.windows++;
+                result.detailedCycles += after.totalCycles - before.totalCycles;
+                result.detailedInstructions += instructions;
+            }
+        }
+        if (running) sim.drain();
+        running = sim.isRunning();
+        if (!running) result.matchesFunctional = sampling::matchesFunctional(sim, checkpoint, config.maxInstructions - executed);
+        executed += sim.getInstructionCount() - start;
+    }
+
+    result.completed = !running;
+    result.totalInstructions = executed;
+    for (size_t i = 0; i < sampling::COUNTER_COUNT; i++) {
+        SampledMetric metric;
+        metric.name = sampling::COUNTERS[i].name;
+        const std::vector<double>& samples = rates[i];
+        if (!samples.empty()) {
+            double sum = 0.0;
+            for (double value : samples) sum += value;
+            metric.mean = sum / samples.size();
+            if (samples.size() > 1) {
+                double squares = 0.0;
+                for (double value : samples) squares += (value - metric.mean) * (value - metric.mean);
+                double deviation = std::sqrt(squares / (samples.size() - 1));
+                metric.halfWidth = SAMPLING_CONFIDENCE_Z * deviation / std::sqrt(static_cast<double>(samples.size()));
+            }
+        }
+        metric.estimate = metric.mean * static_cast<double>(executed);
+        metric.estimateHalfWidth = metric.halfWidth * static_cast<double>(executed);
+        result.metrics.push_back(metric);
+    }
+    return result;
+}
+
+inline void writeSamplingReport(std::ostream& out, const SamplingResult& result) {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::dec << "Sampled Simulation:\n";
+    out << "Instructions: " << result.totalInstructions;
+    if (!result.completed) {
+        out << " (instruction limit reached)\n";
+    } else if (result.matchesFunctional) {
+        out << " (program completed)\n";
+    } else {
+        out << " (program ended in a detailed window, but not where a functional run ends)\n";
+    }
+    out << "Measured Windows: " << result.windows << "\n";
+    out << "Detailed Instructions: " << result.detailedInstructions << "\n";
+    out << "Detailed Cycles: " << result.detailedCycles << "\n";
+    if (result.windows == 0) {
+        out << "No complete measurement window; nothing to extrapolate\n";
+        out.flags(flags);
+        return;
+    }
+    out << std::fixed;
+    for (size_t i = 0; i < result.metrics.size(); i++) {
+        const SampledMetric& metric = result.metrics[i];
+        bool cpi = i == 0;
+        out << metric.name << (cpi ? ": " : " per Instruction: ") << std::setprecision(4) << metric.mean;
+        if (result.windows > 1) out << " +/- " << metric.halfWidth;
+        out << (cpi ? ", Estimated Cycles: " : ", Estimated Total: ") << std::setprecision(0) << metric.estimate;
+        if (result.windows > 1) out << " +/- " << metric.estimateHalfWidth;
+        out << "\n";
+    }
+    if (result.windows < 2) {
+        out << "Confidence intervals need at least two windows\n";
+    } else {
+        out << "Intervals are 95% confidence over " << result.windows << " windows\n";
+    }
+    out.flags(flags);
+}
+
+#endif
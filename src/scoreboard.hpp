@@ -0,0 +1,78 @@
+#ifndef SCOREBOARD_HPP
+#define SCOREBOARD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "types.hpp"
+
+using namespace riscv;
+
+// In-flight register producers, one slot per destination register and per stage an instruction
+// can report from (DECODE, EXECUTE, MEMORY). Only one instruction occupies each of those stages
+// at a time, so a slot never holds more than one producer and every lookup is a direct index.
+class RegisterScoreboard {
+public:
+    static constexpr size_t TRACKED_STAGES = 3;
+
+    RegisterScoreboard() { clear(); }
+
+    inline const RegisterDependency* find(uint32_t reg, Stage stage) const {
+        const RegisterDependency& dep = slots[reg][slotIndex(stage)];
+        return dep.valid ? &dep : nullptr;
+    }
+
+    inline void issue(uint32_t reg, uint32_t uniqueId, uint32_t pc, bool isLoad) {
+        RegisterDependency& dep = slots[reg][slotIndex(Stage::DECODE)];
+        dep.reg = reg;
+        dep.pc = pc;
+        dep.stage = Stage::DECODE;
+        dep.value = 0;
+        dep.isLoad = isLoad;
+        dep.uniqueId = uniqueId;
+        dep.valid = true;
+    }
+
+    inline void advance(uint32_t reg, uint32_t uniqueId, Stage stage, uint32_t value) {
+        RegisterDependency* dep = findProducer(reg, uniqueId);
+        if (dep == nullptr) return;
+        RegisterDependency moved = *dep;
+        dep->valid = false;
+        moved.stage = stage;
+        moved.value = value;
+        slots[reg][slotIndex(stage)] = moved;
+    }
+
+    inline void retire(uint32_t reg, uint32_t uniqueId) {
+        RegisterDependency* dep = findProducer(reg, uniqueId);
+        if (dep != nullptr) {
+            dep->valid = false;
+        }
+    }
+
+    inline void clear() {
+        for (auto& row : slots) {
+            for (auto& dep : row) {
+                dep = RegisterDependency();
+            }
+        }
+    }
+
+private:
+    std::array<std::array<RegisterDependency, TRACKED_STAGES>, NUM_REGISTERS> slots;
+
+    static inline size_t slotIndex(Stage stage) {
+        return static_cast<size_t>(stage) - static_cast<size_t>(Stage::DECODE);
+    }
+
+    inline RegisterDependency* findProducer(uint32_t reg, uint32_t uniqueId) {
+        for (auto& dep : slots[reg]) {
+            if (dep.valid && dep.uniqueId == uniqueId) {
+                return &dep;
+            }
+        }
+        return nullptr;
+    }
+};
+
+#endif
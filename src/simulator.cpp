@@ -7,6 +7,12 @@
 #include <signal.h>
 #include "types.hpp"
 #include "simulator.hpp"
+#include "sweep.hpp"
+#include "sampling.hpp"
+#include "multihart.hpp"
+#include "object.hpp"
+#include "ooo.hpp"
+#include "io.hpp"
 
 using namespace riscv;
 
@@ -40,7 +46,7 @@ void printDetails(bool reg, bool normalIR , bool follow) {
     if(follow) {
         followedRegisters = globalSimulatorPtr->getFollowedInstructionRegisters();
         uint32_t followedPC = globalSimulatorPtr->getFollowedPC();
-        std::string instrStr = globalSimulatorPtr->getTextMap()[followedPC].second;
+        std::string instrStr = globalSimulatorPtr->getProgram()->getDisassembly((followedPC - TEXT_SEGMENT_START) / INSTRUCTION_SIZE);
         
         std::cout << GREEN << "Summary for followed instruction at PC=0x" << std::hex << followedPC << std::dec << " (" << instrStr << ")" << RESET << std::endl;
         std::cout << GREEN << "Last update in cycle: " << globalSimulatorPtr->getCycles() << RESET << std::endl;
@@ -69,20 +75,181 @@ void printUsage() {
     std::cout << YELLOW << "  -l, --pipeline-regs        Print pipeline register values only" << RESET << std::endl;
     std::cout << YELLOW << "  -b, --branch-predict       Enable branch prediction" << RESET << std::endl;
     std::cout << YELLOW << "  -a, --auto                 Run simulation automatically (non-interactive)" << RESET << std::endl;
+    std::cout << YELLOW << "  -v, --verbose              Report per-cycle pipeline events in auto mode" << RESET << std::endl;
+    std::cout << YELLOW << "  -F, --functional           Fast functional (ISA-only) execution, one cycle per instruction" << RESET << std::endl;
+    std::cout << YELLOW << "  --predictor NAME           Branch predictor: 1bit (default), 2bit, gshare, tournament" << RESET << std::endl;
+    std::cout << YELLOW << "  --pht-bits N               log2 of pattern history table entries (default: 12)" << RESET << std::endl;
+    std::cout << YELLOW << "  --btb-bits N               log2 of branch target buffer entries (default: 12)" << RESET << std::endl;
+    std::cout << YELLOW << "  --history-bits N           Global history length for gshare/tournament (default: 12)" << RESET << std::endl;
+    std::cout << YELLOW << "  --ras N                    Return address stack entries, 0 disables (default: 0)" << RESET << std::endl;
+    std::cout << YELLOW << "  --icache SPEC              L1 instruction cache, e.g. size=4096,line=32,ways=2,replacement=lru,penalty=10" << RESET << std::endl;
+    std::cout << YELLOW << "  --dcache SPEC              L1 data cache, as --icache plus write=wb|wt (default: no caches)" << RESET << std::endl;
+    std::cout << YELLOW << "  --profile FILE             Record per-instruction counters, write them to FILE as JSON" << RESET << std::endl;
+    std::cout << YELLOW << "  --profile-top N            Hotspots printed after a profiled run (default: 10)" << RESET << std::endl;
+    std::cout << YELLOW << "  --trace FILE               Stream the per-cycle pipeline occupancy to FILE (binary .rvt)" << RESET << std::endl;
+    std::cout << YELLOW << "  --trace-raw                Store trace blocks uncompressed" << RESET << std::endl;
+    std::cout << YELLOW << "  --trace-export TRACE OUT   Convert a trace to Konata, or JSON when OUT ends in .json, and exit" << RESET << std::endl;
+    std::cout << YELLOW << "  --sample K,W,M             Sampled run: K functional, W warm-up and M measured instructions per window" << RESET << std::endl;
+    std::cout << YELLOW << "  --sample-limit N           Stop a sampled run after N instructions (default: 1000000000)" << RESET << std::endl;
+    std::cout << YELLOW << "  --ooo SPEC                 Out-of-order superscalar engine, e.g. width=4,rob=64,rs=32,mul=3,div=20 or default" << RESET << std::endl;
+    std::cout << YELLOW << "  --sweep SPEC               Run every configuration in SPEC (key=v1,v2;...) in parallel, see README" << RESET << std::endl;
+    std::cout << YELLOW << "  --sweep-format csv|json    Sweep output format (default: csv)" << RESET << std::endl;
+    std::cout << YELLOW << "  --sweep-output FILE        Sweep output file (default: sweep.csv or sweep.json)" << RESET << std::endl;
+    std::cout << YELLOW << "  --harts N                  Run N harts of the program over one shared memory (default: 1)" << RESET << std::endl;
+    std::cout << YELLOW << "  --quantum K                Cycles each hart runs between memory merges (default: 1000)" << RESET << std::endl;
+    std::cout << YELLOW << "  -j, --jobs N               Worker threads for --sweep and --harts (default: hardware threads)" << RESET << std::endl;
     std::cout << YELLOW << "  -f, --follow [n|p]=NUM     Track specific instruction by number (n=NUM) or PC (p=NUM), supports decimal or hex (0x prefix)" << RESET << std::endl;
-    std::cout << YELLOW << "  -i, --input FILE           Specify input assembly file (default: input.asm)" << RESET << std::endl;
+    std::cout << YELLOW << "  -i, --input FILE           Input assembly or .rvo object file, - for standard input (default: input.asm)" << RESET << std::endl;
     std::cout << YELLOW << "  -h, --help                 Display this help message" << RESET << std::endl;
 }
 
-std::string readFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file: " + filename);
+void writeSimulationStats(std::ostream& out, const SimulationStats& stats, const PredictorConfig& predictorConfig,
+                          const CacheConfig& icacheConfig, const CacheConfig& dcacheConfig) {
+    out << "Simulation Statistics:\n";
+    out << "Cycles Per Instruction: " << stats.cyclesPerInstruction << "\n";
+    out << "Total Cycles: " << stats.totalCycles << "\n";
+    out << "Instructions Executed: " << stats.instructionsExecuted << "\n";
+    out << "Data Transfer Instructions: " << stats.dataTransferInstructions << "\n";
+    out << "ALU Instructions: " << stats.aluInstructions << "\n";
+    out << "Control Instructions: " << stats.controlInstructions << "\n";
+    out << "Stall Bubbles: " << stats.stallBubbles << "\n";
+    out << "Data Hazards: " << stats.dataHazards << "\n";
+    out << "Control Hazards: " << stats.controlHazards << "\n";
+    out << "Data Hazard Stalls: " << stats.dataHazardStalls << "\n";
+    out << "Control Hazard Stalls: " << stats.controlHazardStalls << "\n";
+    out << "Pipeline Flushes: " << stats.pipelineFlushes << "\n";
+    out << "Branch Mispredictions: " << stats.branchMispredictions << "\n";
+    out << "Branch Predictor: " << predictorTypeToString(predictorConfig.type) << " (PHT 2^" << predictorConfig.phtBits
+        << ", BTB 2^" << predictorConfig.btbBits << ", history " << predictorConfig.historyBits
+        << ", RAS " << predictorConfig.rasEntries << ")\n";
+    out << "Branch Predictions: " << stats.branchPredictions << "\n";
+    out << "BTB Hits: " << stats.btbHits << "\n";
+    out << "BTB Misses: " << stats.btbMisses << "\n";
+    out << "Return Predictions: " << stats.returnPredictions << "\n";
+    out << "Return Mispredictions: " << stats.returnMispredictions << "\n";
+    for (const auto& [name, config] : {std::make_pair("I-Cache", icacheConfig), std::make_pair("D-Cache", dcacheConfig)}) {
+        out << name << ": ";
+        if (config.enabled()) {
+            out << config.sizeBytes << " bytes, " << config.lineBytes << "-byte lines, " << config.ways << "-way, "
+                << replacementPolicyToString(config.replacement) << ", " << writePolicyToString(config.write)
+                << ", miss penalty " << config.missPenalty << "\n";
+        } else {
+            out << "disabled\n";
+        }
+    }
+    out << "I-Cache Hits: " << stats.icacheHits << "\n";
+    out << "I-Cache Misses: " << stats.icacheMisses << "\n";
+    out << "I-Cache Evictions: " << stats.icacheEvictions << "\n";
+    out << "D-Cache Hits: " << stats.dcacheHits << "\n";
+    out << "D-Cache Misses: " << stats.dcacheMisses << "\n";
+    out << "D-Cache Evictions: " << stats.dcacheEvictions << "\n";
+    out << "D-Cache Writebacks: " << stats.dcacheWritebacks << "\n";
+    out << "Cache Stall Cycles: " << stats.cacheStallCycles << "\n";
+}
+
+template <typename Report>
+int writeStatsFile(const std::string& path, const std::string& label, Report report) {
+    try {
+        std::ofstream statsFile(path);
+        if (!statsFile.is_open()) {
+            std::cerr << "Error: Could not open " << path << " for writing" << std::endl;
+            return 1;
+        }
+        report(statsFile);
+        statsFile.close();
+        std::cout << label << " stats written to " << path << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error writing to " << path << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runSweepMode(const std::string& inputFile, const std::string& spec, const SweepConfig& base,
+                 bool json, std::string outputFile, uint32_t jobs) {
+    std::vector<SweepConfig> configs;
+    std::shared_ptr<const ProgramImage> program;
+    try {
+        configs = expandSweep(spec, base);
+        SourceBuffer input(inputFile);
+        if (isObjectImage(input.view())) {
+            program = parseObject(input.bytes(), input.size());
+        } else {
+            Diagnostics diagnostics;
+            program = assembleProgram(input.view(), diagnostics);
+            diagnostics.throwIfAny();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error preparing sweep: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::cout << YELLOW << "Running " << configs.size() << " configurations on " << std::min<size_t>(jobs, configs.size()) << " threads..." << RESET << std::endl;
+    std::vector<SweepResult> results = runSweep(program, configs, jobs);
+
+    if (outputFile.empty()) {
+        outputFile = json ? "sweep.json" : "sweep.csv";
+    }
+    std::ofstream out(outputFile);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << outputFile << " for writing" << std::endl;
+        return 1;
+    }
+    if (json) {
+        writeSweepJson(out, results);
+    } else {
+        writeSweepCsv(out, results);
+    }
+    std::cout << "Sweep results written to " << outputFile << std::endl;
+
+    int status = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        if (!results[i].loaded || results[i].matchesFunctional) continue;
+        if (!results[i].completed) {
+            std::cout << ORANGE << "Warning: Configuration " << i + 1 << " reached the step limit before the program ended" << RESET << std::endl;
+            continue;
+        }
+        std::cerr << RED << "Error: Configuration " << i + 1 << " ends with different registers or instruction count than a functional run" << RESET << std::endl;
+        status = 1;
+    }
+    return status;
+}
+
+int closeTrace(std::unique_ptr<TraceWriter>& tracer, const std::string& traceOutput) {
+    if (!tracer) return 0;
+    try {
+        tracer->close();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Pipeline trace (" << tracer->getCycleCount() << " cycles) written to " << traceOutput << std::endl;
+    return 0;
+}
+
+int runTraceExport(const std::string& traceFile, const std::string& outputFile) {
+    try {
+        TraceReader reader(traceFile);
+        std::ofstream out(outputFile);
+        if (!out.is_open()) {
+            std::cerr << "Error: Could not open " << outputFile << " for writing" << std::endl;
+            return 1;
+        }
+        bool json = outputFile.size() >= 5 && outputFile.compare(outputFile.size() - 5, 5, ".json") == 0;
+        if (json) {
+            writeTraceJson(out, reader);
+        } else {
+            writeKonata(out, reader);
+        }
+        std::cout << "Trace (" << reader.blockCount() << " blocks) written to " << outputFile << (json ? " as JSON" : " as Konata log") << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error exporting trace: " << e.what() << std::endl;
+        return 1;
     }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    file.close();
-    return buffer.str();
+    return 0;
 }
 
 bool fileExists(const std::string& filename) {
@@ -103,8 +270,27 @@ int main(int argc, char* argv[]) {
     uint32_t followInstrNum = UINT32_MAX;
     bool branchPredict = false;
     bool autoRun = false;
+    bool functionalMode = false;
+    bool verbose = false;
     std::string inputFile = "input.asm";
     std::string followArg;
+    PredictorConfig predictorConfig;
+    CacheConfig icacheConfig;
+    CacheConfig dcacheConfig;
+    std::string profileOutput;
+    bool sampled = false;
+    SamplingConfig samplingConfig;
+    uint32_t profileTop = 10;
+    std::string sweepSpec;
+    std::string sweepOutput;
+    bool sweepJson = false;
+    uint32_t jobs = 0;
+    uint32_t harts = 1;
+    uint32_t quantum = DEFAULT_HART_QUANTUM;
+    std::string traceOutput;
+    TraceCodec traceCodec = TraceCodec::PLANAR_RLE;
+    bool outOfOrder = false;
+    OutOfOrderConfig outOfOrderConfig;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--pipeline") == 0) {
@@ -125,10 +311,161 @@ int main(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--auto") == 0) {
             autoRun = true;
             std::cout << "Auto run: ENABLED" << std::endl;
+        } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+            std::cout << "Verbose events: ENABLED" << std::endl;
+        } else if (strcmp(argv[i], "-F") == 0 || strcmp(argv[i], "--functional") == 0) {
+            functionalMode = true;
+            std::cout << "Functional mode: ENABLED" << std::endl;
+        } else if (strcmp(argv[i], "--predictor") == 0) {
+            if (i + 1 >= argc || !parsePredictorType(argv[i + 1], predictorConfig.type)) {
+                std::cerr << "Error: Expected predictor name (1bit, 2bit, gshare, tournament)" << std::endl;
+                printUsage();
+                return 1;
+            }
+            std::cout << "Branch predictor: " << argv[++i] << std::endl;
+        } else if (strcmp(argv[i], "--pht-bits") == 0 || strcmp(argv[i], "--btb-bits") == 0 ||
+                   strcmp(argv[i], "--history-bits") == 0 || strcmp(argv[i], "--ras") == 0) {
+            uint32_t value = 0;
+            if (i + 1 >= argc || parseUnsigned(argv[i + 1], value) != NumberError::NONE) {
+                std::cerr << "Error: Missing or invalid number after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            if (strcmp(argv[i], "--pht-bits") == 0) {
+                predictorConfig.phtBits = value;
+            } else if (strcmp(argv[i], "--btb-bits") == 0) {
+                predictorConfig.btbBits = value;
+            } else if (strcmp(argv[i], "--history-bits") == 0) {
+                predictorConfig.historyBits = value;
+            } else {
+                predictorConfig.rasEntries = value;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--icache") == 0 || strcmp(argv[i], "--dcache") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: Missing cache specification after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            bool instruction = strcmp(argv[i], "--icache") == 0;
+            CacheConfig& config = instruction ? icacheConfig : dcacheConfig;
+            try {
+                config = parseCacheSpec(argv[i + 1], config);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                printUsage();
+                return 1;
+            }
+            std::cout << (instruction ? "I-cache: " : "D-cache: ") << argv[++i] << std::endl;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: Missing output file after --profile" << std::endl;
+                printUsage();
+                return 1;
+            }
+            profileOutput = argv[++i];
+            std::cout << "Profiling: ENABLED (" << profileOutput << ")" << std::endl;
+        } else if (strcmp(argv[i], "--profile-top") == 0) {
+            if (i + 1 >= argc || parseUnsigned(argv[i + 1], profileTop) != NumberError::NONE) {
+                std::cerr << "Error: Missing or invalid number after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: Missing output file after --trace" << std::endl;
+                printUsage();
+                return 1;
+            }
+            traceOutput = argv[++i];
+            std::cout << "Pipeline trace: ENABLED (" << traceOutput << ")" << std::endl;
+        } else if (strcmp(argv[i], "--trace-raw") == 0) {
+            traceCodec = TraceCodec::NONE;
+        } else if (strcmp(argv[i], "--trace-export") == 0) {
+            if (i + 2 >= argc) {
+                std::cerr << "Error: --trace-export expects a trace file and an output file" << std::endl;
+                printUsage();
+                return 1;
+            }
+            return runTraceExport(argv[i + 1], argv[i + 2]);
+        } else if (strcmp(argv[i], "--ooo") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: Missing out-of-order specification after --ooo" << std::endl;
+                printUsage();
+                return 1;
+            }
+            try {
+                outOfOrderConfig = parseOutOfOrderSpec(argv[i + 1], outOfOrderConfig);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                printUsage();
+                return 1;
+            }
+            outOfOrder = true;
+            std::cout << "Out-of-order engine: " << argv[++i] << std::endl;
+        } else if (strcmp(argv[i], "--sample") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: Missing sampling counts after --sample" << std::endl;
+                printUsage();
+                return 1;
+            }
+            try {
+                std::vector<uint32_t> counts = parseSamplingSpec(argv[i + 1]);
+                samplingConfig.fastForward = counts[0];
+                samplingConfig.warmup = counts[1];
+                samplingConfig.measure = counts[2];
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                printUsage();
+                return 1;
+            }
+            sampled = true;
+            std::cout << "Sampled simulation: " << argv[++i] << std::endl;
+        } else if (strcmp(argv[i], "--sample-limit") == 0) {
+            uint32_t limit = 0;
+            if (i + 1 >= argc || parseUnsigned(argv[i + 1], limit) != NumberError::NONE) {
+                std::cerr << "Error: Missing or invalid number after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            samplingConfig.maxInstructions = limit;
+            i++;
+        } else if (strcmp(argv[i], "--sweep") == 0 || strcmp(argv[i], "--sweep-output") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: Missing argument after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            (strcmp(argv[i], "--sweep") == 0 ? sweepSpec : sweepOutput) = argv[i + 1];
+            i++;
+        } else if (strcmp(argv[i], "--sweep-format") == 0) {
+            if (i + 1 >= argc || (strcmp(argv[i + 1], "csv") != 0 && strcmp(argv[i + 1], "json") != 0)) {
+                std::cerr << "Error: Expected sweep format (csv, json)" << std::endl;
+                printUsage();
+                return 1;
+            }
+            sweepJson = strcmp(argv[++i], "json") == 0;
+        } else if (strcmp(argv[i], "--harts") == 0 || strcmp(argv[i], "--quantum") == 0) {
+            uint32_t& value = strcmp(argv[i], "--harts") == 0 ? harts : quantum;
+            if (i + 1 >= argc || parseUnsigned(argv[i + 1], value) != NumberError::NONE || value == 0) {
+                std::cerr << "Error: Missing or invalid number after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--jobs") == 0) {
+            if (i + 1 >= argc || parseUnsigned(argv[i + 1], jobs) != NumberError::NONE) {
+                std::cerr << "Error: Missing or invalid number after " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+            i++;
         } else if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--input") == 0) {
             if (i + 1 < argc) {
                 inputFile = argv[++i];
-                if (!fileExists(inputFile)) {
+                if (!isStandardStream(inputFile) && !fileExists(inputFile)) {
                     std::cerr << "Error: Input file not found: " << inputFile << std::endl;
                     return 1;
                 }
@@ -187,8 +524,42 @@ int main(int argc, char* argv[]) {
     }
 
     try {
-        std::string program = readFile(inputFile);
-        if (!sim.loadProgram(program)) {
+        sim.setPredictorConfig(predictorConfig);
+        sim.setCacheConfig(icacheConfig, dcacheConfig);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    if (!sweepSpec.empty()) {
+        SweepConfig base;
+        base.pipeline = pipelineMode;
+        base.dataForwarding = dataForwarding;
+        base.branchPrediction = branchPredict;
+        base.functional = functionalMode;
+        base.predictor = predictorConfig;
+        base.icache = icacheConfig;
+        base.dcache = dcacheConfig;
+        return runSweepMode(inputFile, sweepSpec, base, sweepJson, sweepOutput, jobs);
+    }
+
+    if (isStandardStream(inputFile) && !autoRun) {
+        std::cout << ORANGE << "Warning: Stepping needs the terminal on standard input. Running automatically" << RESET << std::endl;
+        autoRun = true;
+    }
+
+    ConsoleEventSink eventSink(((autoRun || sampled) && !verbose) ? EventLevel::INFO : EventLevel::TRACE);
+    sim.setEventSink(&eventSink);
+    Profiler profiler;
+    if (!profileOutput.empty()) {
+        sim.setProfiler(&profiler);
+    }
+
+    try {
+        SourceBuffer input(inputFile);
+        bool loaded = isObjectImage(input.view()) ? sim.loadProgram(parseObject(input.bytes(), input.size())) : sim.loadProgram(input.view());
+        if (!loaded) {
             std::cerr << "Failed to load program!\n";
             return 1;
         }
@@ -197,7 +568,7 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    size_t length = sim.getTextMap().size();
+    size_t length = sim.getProgram()->size();
     if(length == 0) {
         std::cerr << "Error: No text segment found in the program." << std::endl;
         return 1;
@@ -228,7 +599,110 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    sim.setEnvironment(pipelineMode, dataForwarding, branchPredict, followInstrNum);
+    if (functionalMode && followInstrNum != UINT32_MAX) {
+        std::cout << ORANGE << "Warning: Instruction following is not available in functional mode. Skipping follow" << RESET << std::endl;
+        followInstrNum = UINT32_MAX;
+    }
+
+    sim.setEnvironment(pipelineMode, dataForwarding, branchPredict, followInstrNum, functionalMode);
+
+    std::unique_ptr<TraceWriter> tracer;
+    if (!traceOutput.empty()) {
+        if (functionalMode || harts > 1 || outOfOrder) {
+            std::cout << ORANGE << "Warning: Pipeline traces need a single hart on the cycle-level model. Skipping trace" << RESET << std::endl;
+        } else {
+            try {
+                tracer = std::make_unique<TraceWriter>(traceOutput, *sim.getProgram(), traceCodec);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            sim.setTracer(tracer.get());
+        }
+    }
+
+    if (harts > 1) {
+        if (sampled || !profileOutput.empty() || outOfOrder) {
+            std::cout << ORANGE << "Warning: Sampling, profiling and the out-of-order engine are not available with several harts. Skipping them" << RESET << std::endl;
+        }
+        if (jobs == 0) {
+            jobs = std::max(1u, std::thread::hardware_concurrency());
+        }
+        try {
+            MultiHartSimulator<> machine(harts, quantum);
+            machine.setPredictorConfig(predictorConfig);
+            machine.setCacheConfig(icacheConfig, dcacheConfig);
+            machine.setEnvironment(pipelineMode, dataForwarding, branchPredict, functionalMode);
+            machine.loadProgram(sim.getProgram());
+            std::cout << YELLOW << "Running " << harts << " harts on " << std::min(jobs, harts) << " threads...\n" << RESET << std::endl;
+            if (!machine.run(jobs, functionalMode ? MAX_FUNCTIONAL_STEPS : MAX_STEPS)) {
+                std::cout << ORANGE << "Warning: Cycle limit reached before every hart finished" << RESET << std::endl;
+            }
+            for (size_t hart = 0; hart < machine.size() && printRegisters; hart++) {
+                std::cout << GREEN << "Hart " << hart << ":" << RESET << std::endl;
+                globalSimulatorPtr = &machine.hart(hart);
+                printDetails(true, false, false);
+            }
+            globalSimulatorPtr = &sim;
+            writeMultiHartReport(std::cout, machine);
+            if (writeStatsFile("stats.txt", "Multi-hart", [&](std::ostream& out) { writeMultiHartReport(out, machine); }) != 0) {
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (outOfOrder) {
+        if (sampled || !profileOutput.empty() || functionalMode) {
+            std::cout << ORANGE << "Warning: Sampling, profiling and functional mode do not apply to the out-of-order engine. Skipping them" << RESET << std::endl;
+        }
+        try {
+            OutOfOrderSimulator core(outOfOrderConfig);
+            core.setPredictorConfig(predictorConfig);
+            core.setCacheConfig(icacheConfig, dcacheConfig);
+            core.loadProgram(sim.getProgram());
+            std::cout << YELLOW << "Running out-of-order simulation...\n" << RESET << std::endl;
+            if (core.runCycles(MAX_STEPS).reason == StopReason::CYCLE_LIMIT) {
+                std::cout << ORANGE << "Warning: Cycle limit reached before the program finished" << RESET << std::endl;
+            }
+            if (printRegisters) {
+                const uint32_t* registers = core.getRegisters();
+                for (uint32_t reg = 0; reg < NUM_REGISTERS; reg++) {
+                    std::cout << "x" << std::dec << reg << " = 0x" << std::hex << std::setw(8) << std::setfill('0') << registers[reg] << std::setfill(' ') << std::dec << std::endl;
+                }
+            }
+            writeOutOfOrderReport(std::cout, core);
+            if (writeStatsFile("stats.txt", "Out-of-order", [&](std::ostream& out) { writeOutOfOrderReport(out, core); }) != 0) {
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (sampled) {
+        samplingConfig.pipeline = pipelineMode;
+        samplingConfig.dataForwarding = dataForwarding;
+        samplingConfig.branchPrediction = branchPredict;
+        std::cout << YELLOW << "Running sampled simulation...\n" << RESET << std::endl;
+        SamplingResult result = runSampled(sim, samplingConfig);
+        printDetails(printRegisters, false, false);
+        writeSamplingReport(std::cout, result);
+        if (writeStatsFile("stats.txt", "Sampling", [&](std::ostream& out) { writeSamplingReport(out, result); }) != 0) {
+            return 1;
+        }
+        if (!result.matchesFunctional) {
+            std::cerr << RED << "Error: The detailed model ends the program with a different PC, registers or instruction count than a functional run" << RESET << std::endl;
+            closeTrace(tracer, traceOutput);
+            return 1;
+        }
+        return closeTrace(tracer, traceOutput);
+    }
 
     if (autoRun) {
         std::cout << YELLOW << "Running simulation in automatic mode...\n" << RESET << std::endl;
@@ -238,15 +712,28 @@ int main(int argc, char* argv[]) {
             printDetails(false, false, true);
         }
     } else {
-        std::cout << YELLOW << "Press Enter to step through execution. Press 'q' then Enter to quit.\n" << RESET << std::endl;
+        std::cout << YELLOW << "Press Enter to step through execution, 'b' then Enter to step back. Press 'q' then Enter to quit.\n" << RESET << std::endl;
         
+        CheckpointTimeline<Simulator> timeline;
+        timeline.record(sim);
         char choice;
         do {
             if (!sim.step() || simulationInterrupted) {
                 std::cout << "Simulation stopped.\n";
                 break;
             }
+            timeline.record(sim);
             choice = std::cin.get();
+            while (choice == 'b') {
+                while (std::cin.get() != '\n' && std::cin.good()) {}
+                if (timeline.stepBack(sim)) {
+                    std::cout << "Back to cycle " << sim.getCycles() << std::endl;
+                    printDetails(printRegisters, printPipelineRegs, false);
+                } else {
+                    std::cout << "Already at the first cycle" << std::endl;
+                }
+                choice = std::cin.get();
+            }
     
             if (choice == '\n') {
                 continue;
@@ -261,35 +748,22 @@ int main(int argc, char* argv[]) {
 
     std::cout << "Total cycles: " << sim.getCycles() << std::endl;
 
-    try {
-        std::ofstream statsFile("stats.txt");
-        if (!statsFile.is_open()) {
-            std::cerr << "Error: Could not open stats.txt for writing" << std::endl;
+    auto report = [&](std::ostream& out) { writeSimulationStats(out, sim.getStats(), predictorConfig, icacheConfig, dcacheConfig); };
+    if (writeStatsFile("stats.txt", "Simulation", report) != 0) {
+        return 1;
+    }
+
+    if (!profileOutput.empty()) {
+        std::ofstream profileFile(profileOutput);
+        if (!profileFile.is_open()) {
+            std::cerr << "Error: Could not open " << profileOutput << " for writing" << std::endl;
             return 1;
         }
-
-        SimulationStats stats = sim.getStats();
-        statsFile << "Simulation Statistics:\n";
-        statsFile << "Cycles Per Instruction: " << stats.cyclesPerInstruction << "\n";
-        statsFile << "Total Cycles: " << stats.totalCycles << "\n";
-        statsFile << "Instructions Executed: " << stats.instructionsExecuted << "\n";
-        statsFile << "Data Transfer Instructions: " << stats.dataTransferInstructions << "\n";
-        statsFile << "ALU Instructions: " << stats.aluInstructions << "\n";
-        statsFile << "Control Instructions: " << stats.controlInstructions << "\n";
-        statsFile << "Stall Bubbles: " << stats.stallBubbles << "\n";
-        statsFile << "Data Hazards: " << stats.dataHazards << "\n";
-        statsFile << "Control Hazards: " << stats.controlHazards << "\n";
-        statsFile << "Data Hazard Stalls: " << stats.dataHazardStalls << "\n";
-        statsFile << "Control Hazard Stalls: " << stats.controlHazardStalls << "\n";
-        statsFile << "Pipeline Flushes: " << stats.pipelineFlushes << "\n";
-        statsFile << "Branch Mispredictions: " << stats.branchMispredictions << "\n";
-
-        statsFile.close();
-        std::cout << "Simulation stats written to stats.txt" << std::endl;
-    } catch (const std::exception& e) {
-        std::cerr << "Error writing to stats.txt: " << e.what() << std::endl;
-        return 1;
+        writeProfileJson(profileFile, profiler, *sim.getProgram());
+        std::cout << GREEN << "Hotspots:" << RESET << std::endl;
+        writeProfileReport(std::cout, profiler, *sim.getProgram(), profileTop);
+        std::cout << "Profile written to " << profileOutput << std::endl;
     }
 
-    return 0;
+    return closeTrace(tracer, traceOutput);
 }
\ No newline at end of file
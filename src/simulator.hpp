@@ -1,31 +1,60 @@
 #ifndef SIMULATOR_HPP
 #define SIMULATOR_HPP
 
+#include <array>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <cstdint>
 #include <stdexcept>
 #include <cstring>
 #include <iomanip>
 #include "types.hpp"
-#include "lexer.hpp"
-#include "parser.hpp"
-#include "assembler.hpp"
+#include "program.hpp"
+#include "memory.hpp"
 #include "execution.hpp"
+#include "functional.hpp"
+#include "events.hpp"
+#include "pipeline.hpp"
+#include "scoreboard.hpp"
+#include "predictor.hpp"
+#include "cache.hpp"
+#include "profile.hpp"
+#include "snapshot.hpp"
+#include "hooks.hpp"
+#include "trace.hpp"
 
 using namespace riscv;
 
-class Simulator {
+enum class StopReason : uint32_t { CYCLE_LIMIT, TERMINATED, BREAKPOINT, WATCHPOINT };
+
+// Outcome of a batched run. address is the breakpoint PC, the first watched byte written, or
+// the PC the program terminated at.
+struct RunSummary {
+    StopReason reason;
+    uint32_t cycles;
+    uint32_t address;
+
+    RunSummary() : reason(StopReason::CYCLE_LIMIT), cycles(0), address(0) {}
+};
+
+// The one simulation engine, shared by the command-line simulator and the web front end. Hooks
+// and Log are compile-time policies (see hooks.hpp): the CLI instantiates the empty NoHooks, the
+// WASM module records per-cycle UI state through UIHooks.
+template <typename Hooks = NoHooks, typename Log = ConsoleLog>
+class BasicSimulator {
 private:
     uint32_t PC;
     uint32_t registers[NUM_REGISTERS];
 
-    std::unordered_map<uint32_t, uint8_t> dataMap;
-    std::map<uint32_t, std::pair<uint32_t, std::string>> textMap;
+    Memory memory;
+    std::shared_ptr<const ProgramImage> program;
 
-    std::map<Stage, InstructionNode*> pipeline;
+    PipelineSlots pipeline;
+    InstructionNodePool nodePool;
     InstructionRegisters instructionRegisters;
     ForwardingStatus forwardingStatus;
     InstructionRegisters followedInstructionRegisters;
@@ -35,335 +64,405 @@ private:
     bool isDataForwarding;
     bool isBranchPrediction;
     bool isFollowing;
+    bool isFunctional;
+    bool isDraining;
     uint32_t followedInstruction;
 
     SimulationStats stats;
-    std::unordered_map<uint32_t, RegisterDependency> registerDependencies;
+    RegisterScoreboard scoreboard;
+    RegisterScoreboard scoreboardSnapshot;
     BranchPredictor branchPredictor;
+    Cache instructionCache;
+    Cache dataCache;
 
     uint32_t instructionCount;
     uint32_t nextInstructionId;
+    EventSink* eventSink;
+    Profiler* profiler;
+    TraceWriter* tracer;
+    uint8_t cycleForwards;
+
+    Hooks hooks;
+    Log log;
+    uint32_t lastStoreAddress;
+    uint32_t lastStoreSize;
 
     void advancePipeline();
-    void flushPipeline(const std::string& reason = "");
-    void applyDataForwarding(InstructionNode& node, const std::unordered_map<uint32_t, RegisterDependency>& depsSnapshot);
-    bool checkDependencies(const InstructionNode& node, const std::unordered_map<uint32_t, RegisterDependency>& depsSnapshot) const;
+    void flushPipeline(const InstructionNode& cause);
+    void applyDataForwarding(InstructionNode& node, const RegisterScoreboard& depsSnapshot);
+    bool checkDependencies(const InstructionNode& node, const RegisterScoreboard& depsSnapshot) const;
     void updateDependencies(InstructionNode& node, Stage stage);
-    bool checkLoadUseHazard(const InstructionNode& node, const std::unordered_map<uint32_t, RegisterDependency>& depsSnapshot, bool isStore = false);
+    bool checkLoadUseHazard(const InstructionNode& node, const RegisterScoreboard& depsSnapshot, bool isStore = false);
     bool isPipelineEmpty() const;
-    void reset();
-    
-    public:
-    Simulator();
-    bool loadProgram(const std::string &input);
+    void releasePipeline();
+    bool stepFunctional(uint32_t maxInstructions);
+    void seedFetch();
+    uint32_t instructionAt(uint32_t pc) const;
+    void emitEvent(const Event& event) const;
+    void emitForwarding(EventKind kind, const InstructionNode& node, const RegisterDependency& dep, uint8_t operand, bool toRM);
+    void emitHazard(EventKind kind, const InstructionNode& node, const RegisterDependency& dep) const;
+    void recordStore(const InstructionNode& node);
+    void recordTraceCycle(const SimulationStats& before);
+
+public:
+    explicit BasicSimulator(Hooks hooks = Hooks(), Log log = Log());
+    bool loadProgram(std::string_view input);
+    bool loadProgram(const std::shared_ptr<const ProgramImage> &image);
     bool step();
     void run();
-    void setEnvironment(bool pipeline, bool dataForwarding, bool branchPrediction, uint32_t instruction);
+    RunSummary runCycles(uint32_t maxCycles);
+    RunSummary runUntil(const std::unordered_set<uint32_t>& breakpoints,
+                        const std::vector<std::pair<uint32_t, uint32_t>>& watchpoints, uint32_t maxCycles);
+    void reset();
+    void drain();
+    void setEnvironment(bool pipeline, bool dataForwarding, bool branchPrediction, uint32_t instruction, bool functional = false);
+    void setEventSink(EventSink* sink);
+    void setProfiler(Profiler* newProfiler);
+    void setTracer(TraceWriter* newTracer) { tracer = newTracer; }
+    SimulatorSnapshot takeSnapshot() const;
+    void restoreSnapshot(const SimulatorSnapshot& snapshot);
+    void setPredictorConfig(const PredictorConfig& config);
+    void setCacheConfig(const CacheConfig& icache, const CacheConfig& dcache);
     const uint32_t *getRegisters() const;
     uint32_t getFollowedPC() const;
-    std::map<uint32_t, std::pair<uint32_t, std::string>> getTextMap() const;
     uint32_t getCycles() const;
     SimulationStats getStats();
     InstructionRegisters getInstructionRegisters() const;
     InstructionRegisters getFollowedInstructionRegisters() const;
+
+    bool isRunning() const { return running; }
+    uint32_t getPC() const { return PC; }
+    uint32_t getInstructionCount() const { return instructionCount; }
+    uint32_t getStalls() const { return stats.stallBubbles; }
+    std::array<std::pair<bool, uint32_t>, NUM_STAGES> getActiveStages() const;
+    const Memory& getMemory() const { return memory; }
+    // Replaces the data memory without touching the pipeline; multi-hart runs use it to hand each
+    // hart the merged shared memory between quanta.
+    void setMemory(const Memory& newMemory) { memory = newMemory; }
+    void setRegister(uint32_t reg, uint32_t value) { if (reg != 0 && reg < NUM_REGISTERS) registers[reg] = value; }
+    const std::shared_ptr<const ProgramImage>& getProgram() const { return program; }
+    EventSink* getEventSink() const { return eventSink; }
+    Profiler* getProfiler() const { return profiler; }
+    TraceWriter* getTracer() const { return tracer; }
+    Hooks& getHooks() { return hooks; }
+    const Hooks& getHooks() const { return hooks; }
 };
 
-Simulator::Simulator() : PC(TEXT_SEGMENT_START),
+using Simulator = BasicSimulator<>;
+
+template <typename Hooks, typename Log>
+BasicSimulator<Hooks, Log>::BasicSimulator(Hooks hooks, Log log) : PC(TEXT_SEGMENT_START),
+                         program(emptyProgramImage()),
                          instructionRegisters(InstructionRegisters()),
                          forwardingStatus(ForwardingStatus()),
                          running(false),
                          isPipeline(true),
                          isDataForwarding(true),
+                         isBranchPrediction(false),
+                         isFollowing(false),
+                         isFunctional(false),
+                         isDraining(false),
+                         followedInstruction(UINT32_MAX),
                          stats(SimulationStats()),
-                         branchPredictor(BranchPredictor()),
                          instructionCount(0),
-                         nextInstructionId(0)
+                         nextInstructionId(0),
+                         eventSink(nullptr),
+                         profiler(nullptr),
+                         tracer(nullptr),
+                         cycleForwards(0),
+                         hooks(std::move(hooks)),
+                         log(std::move(log)),
+                         lastStoreAddress(0),
+                         lastStoreSize(0)
 {
     initialiseRegisters(registers);
-    pipeline[Stage::FETCH] = nullptr;
-    pipeline[Stage::DECODE] = nullptr;
-    pipeline[Stage::EXECUTE] = nullptr;
-    pipeline[Stage::MEMORY] = nullptr;
-    pipeline[Stage::WRITEBACK] = nullptr;
     instructionRegisters = InstructionRegisters();
     followedInstructionRegisters = InstructionRegisters();
 }
 
-bool Simulator::loadProgram(const std::string &input) {
+template <typename Hooks, typename Log>
+bool BasicSimulator<Hooks, Log>::loadProgram(std::string_view input) {
+    std::shared_ptr<const ProgramImage> image;
+    Diagnostics diagnostics;
     try {
-        bool wasPipeline = isPipeline;
-        bool wasDataForwarding = isDataForwarding;
-        bool wasBranchPrediction = isBranchPrediction;
-        bool wasFollowing = isFollowing;
-        
-        reset();
-
-        isPipeline = wasPipeline;
-        isDataForwarding = wasDataForwarding;
-        isBranchPrediction = wasBranchPrediction;
-        isFollowing = wasFollowing;
-        running = true;
-
-        std::vector<std::vector<Token>> tokenizedLines = Lexer::tokenize(input);
-        if (tokenizedLines.empty()) {
-            std::cerr << RED << "Error: No tokens generated from input" << RESET << std::endl;
-            return false;
-        }
-
-        Parser parser(tokenizedLines);
-        if (!parser.parse()) {
-            throw std::runtime_error("Parsing failed with " + std::to_string(parser.getErrorCount()) + " errors");
-            return false;
-        }
-
-        std::unordered_map<std::string, SymbolEntry> symbolTable = parser.getSymbolTable();
-        std::vector<ParsedInstruction> parsedInstructions = parser.getParsedInstructions();
-
-        Assembler assembler(symbolTable, parsedInstructions);
-        if (!assembler.assemble()) {
-            throw std::runtime_error("Assembly failed with " + std::to_string(assembler.getErrorCount()) + " errors");
-            return false;
-        }
-
-        for (const auto &[address, value] : assembler.getMachineCode()) {
-            if (address >= DATA_SEGMENT_START) {
-                dataMap[address] = static_cast<uint8_t>(value);
-            } else {
-                textMap[address] = std::make_pair(value, parseInstructions(value));
-            }
-        }
-        
-        PC = TEXT_SEGMENT_START;
-        instructionCount = 0;
-        nextInstructionId = 0;
-        std::cout << GREEN << "Program loaded successfully" << RESET << std::endl;
-        InstructionNode* firstNode = new InstructionNode(PC);
-        pipeline[Stage::FETCH] = firstNode;
-        firstNode->uniqueId = nextInstructionId++;
-        return true;
+        image = assembleProgram(input, diagnostics);
     }
     catch (const std::exception &e) {
-        std::cerr << RED << "Error: " << e.what() << RESET << std::endl;
+        reset();
+        log.error("Error: " + std::string(e.what()));
+        return false;
+    }
+    if (!image) {
+        reset();
+        log.error("Error: " + std::string(RED) + diagnostics.format() + RESET);
         return false;
     }
+    return loadProgram(image);
 }
 
-void Simulator::reset() {
-    for (auto& [stage, node] : pipeline) {
-        if (node != nullptr) {
-            delete node;
-            node = nullptr;
-        }
+template <typename Hooks, typename Log>
+bool BasicSimulator<Hooks, Log>::loadProgram(const std::shared_ptr<const ProgramImage> &image) {
+    bool wasPipeline = isPipeline;
+    bool wasDataForwarding = isDataForwarding;
+    bool wasBranchPrediction = isBranchPrediction;
+    bool wasFollowing = isFollowing;
+    bool wasFunctional = isFunctional;
+    
+    reset();
+
+    isPipeline = wasPipeline;
+    isDataForwarding = wasDataForwarding;
+    isBranchPrediction = wasBranchPrediction;
+    isFollowing = wasFollowing;
+    isFunctional = wasFunctional;
+    running = true;
+
+    program = image ? image : emptyProgramImage();
+    memory = program->getData();
+    if (profiler != nullptr) profiler->reset(program->size());
+    
+    PC = TEXT_SEGMENT_START;
+    instructionCount = 0;
+    nextInstructionId = 0;
+    emitEvent(makeEvent(EventKind::PROGRAM_LOADED, stats.totalCycles));
+    InstructionNode* firstNode = nodePool.acquire(PC);
+    pipeline[Stage::FETCH] = firstNode;
+    firstNode->uniqueId = nextInstructionId++;
+    return true;
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::releasePipeline() {
+    for (InstructionNode*& node : pipeline) {
+        nodePool.release(node);
+        node = nullptr;
     }
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::reset() {
+    releasePipeline();
     
     instructionRegisters = InstructionRegisters();
     initialiseRegisters(registers);
-    registerDependencies.clear();
-    dataMap.clear();
-    textMap.clear();
+    scoreboard.clear();
+    memory.clear();
+    program = emptyProgramImage();
     
     PC = TEXT_SEGMENT_START;
     running = false;
     stats = SimulationStats();
     forwardingStatus = ForwardingStatus();
     branchPredictor.reset();
+    instructionCache.reset();
+    dataCache.reset();
     instructionCount = 0;
+    lastStoreSize = 0;
+    if (profiler != nullptr) profiler->reset(0);
+    hooks.onReset();
 }
 
-void Simulator::applyDataForwarding(InstructionNode& node, const std::unordered_map<uint32_t, RegisterDependency>& depsSnapshot) {
+template <typename Hooks, typename Log>
+uint32_t BasicSimulator<Hooks, Log>::instructionAt(uint32_t pc) const {
+    const DecodedInstruction* decoded = findDecodedInstruction(pc, program->getDecodedText());
+    return decoded != nullptr ? decoded->instruction : 0;
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::emitEvent(const Event& event) const {
+    if (isEventEnabled(eventSink, eventLevel(event.kind))) {
+        eventSink->emit(event);
+    }
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::emitForwarding(EventKind kind, const InstructionNode& node, const RegisterDependency& dep, uint8_t operand, bool toRM) {
+    hooks.onForward(kind);
+    cycleForwards |= kind == EventKind::FORWARD_EX_EX ? TRACE_FORWARD_EX_EX : kind == EventKind::FORWARD_MEM_EX ? TRACE_FORWARD_MEM_EX : TRACE_FORWARD_MEM_MEM;
+    if (!isEventEnabled(eventSink, EventLevel::TRACE)) return;
+    Event event = makeEvent(kind, stats.totalCycles, node.PC, node.instruction);
+    event.sourcePc = dep.pc;
+    event.sourceInstruction = instructionAt(dep.pc);
+    event.reg = static_cast<uint8_t>(operand == 1 ? node.rs1 : node.rs2);
+    event.operand = operand;
+    event.isLoad = dep.isLoad;
+    event.toRM = toRM;
+    eventSink->emit(event);
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::emitHazard(EventKind kind, const InstructionNode& node, const RegisterDependency& dep) const {
+    if (!isEventEnabled(eventSink, EventLevel::TRACE)) return;
+    Event event = makeEvent(kind, stats.totalCycles, node.PC, node.instruction);
+    event.sourcePc = dep.pc;
+    event.sourceInstruction = instructionAt(dep.pc);
+    event.reg = static_cast<uint8_t>(dep.reg);
+    event.stage = dep.stage;
+    event.isLoad = dep.isLoad;
+    eventSink->emit(event);
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::applyDataForwarding(InstructionNode& node, const RegisterScoreboard& depsSnapshot) {
     if (!isPipeline || !isDataForwarding) return;
 
     forwardingStatus = ForwardingStatus();
+    bool hasRS2 = (node.instructionType == InstructionType::R || node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB);
+    bool toRM = (node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB);
 
     if (node.stage == Stage::MEMORY) {
-        for (const auto& [uniqueId, dep] : depsSnapshot) {
-            if (dep.stage == Stage::MEMORY && dep.reg != 0 && dep.isLoad) {
-                if (node.rs1 != 0 && node.rs1 == dep.reg && !forwardingStatus.raForwarded) {
-                    instructionRegisters.RA = dep.value;
-                    forwardingStatus.raForwarded = true;
-                    std::cout << YELLOW << "\nData Forwarding: MEM->MEM for rs1 (reg " << node.rs1
-                              << ") of instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ")"
-                              << (dep.isLoad ? " [Load]" : "") << " from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                }
-                if (node.rs2 != 0 && node.rs2 == dep.reg && !forwardingStatus.rbForwarded && !forwardingStatus.rmForwarded) {
-                    if (node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB) {
-                        instructionRegisters.RM = dep.value;
-                        forwardingStatus.rmForwarded = true;
-                        std::cout << YELLOW << "\nData Forwarding: MEM->MEM for rs2 (reg " << node.rs2
-                                  << ") to RM of instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ")"
-                                  << (dep.isLoad ? " [Load]" : "") << " from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                    } else {
-                        instructionRegisters.RB = dep.value;
-                        forwardingStatus.rbForwarded = true;
-                        std::cout << YELLOW << "\nData Forwarding: MEM->MEM for rs2 (reg " << node.rs2
-                                  << ") of instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ")"
-                                  << (dep.isLoad ? " [Load]" : "") << " from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                    }
-                }
+        const RegisterDependency* dep = node.rs1 != 0 ? depsSnapshot.find(node.rs1, Stage::MEMORY) : nullptr;
+        if (dep != nullptr && dep->isLoad && !forwardingStatus.raForwarded) {
+            instructionRegisters.RA = dep->value;
+            forwardingStatus.raForwarded = true;
+            emitForwarding(EventKind::FORWARD_MEM_MEM, node, *dep, 1, false);
+        }
+        dep = node.rs2 != 0 ? depsSnapshot.find(node.rs2, Stage::MEMORY) : nullptr;
+        if (dep != nullptr && dep->isLoad && !forwardingStatus.rbForwarded && !forwardingStatus.rmForwarded) {
+            if (toRM) {
+                instructionRegisters.RM = dep->value;
+                forwardingStatus.rmForwarded = true;
+            } else {
+                instructionRegisters.RB = dep->value;
+                forwardingStatus.rbForwarded = true;
             }
+            emitForwarding(EventKind::FORWARD_MEM_MEM, node, *dep, 2, toRM);
         }
         return;
     }
 
-    for (const auto& [uniqueId, dep] : depsSnapshot) {
-        if (dep.stage == Stage::EXECUTE && dep.reg != 0) {
-            if (!dep.isLoad) {
-                if (node.rs1 != 0 && node.rs1 == dep.reg) {
-                    instructionRegisters.RA = dep.value;
-                    forwardingStatus.raForwarded = true;
+    // DECODE read the operands; a producer that wrote back while this instruction waited here
+    // has left the scoreboard, so start again from the register file.
+    instructionRegisters.RA = registers[node.rs1];
+    if (node.instructionType == InstructionType::R) instructionRegisters.RB = registers[node.rs2];
 
-                    std::cout << YELLOW << "\nData Forwarding: EX->EX for rs1 (reg " << node.rs1 << ") of instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ") from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                }
-                if ((node.instructionType == InstructionType::R || node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB) && node.rs2 != 0 && node.rs2 == dep.reg) {
-                    if (node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB) {
-                        instructionRegisters.RM = dep.value;
-                        forwardingStatus.rmForwarded = true;
-
-                        std::cout << YELLOW << "Data Forwarding: EX->EX for rs2 (reg " << node.rs2
-                        << ") to RM of instruction at PC=" << node.PC << " (" << textMap[node.PC].second
-                        << ") from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                    } else {
-                        instructionRegisters.RB = dep.value;
-                        forwardingStatus.rbForwarded = true;
-
-                        std::cout << YELLOW << "\nData Forwarding: EX->EX for rs2 (reg " << node.rs2
-                        << ") of instruction at PC=" << node.PC << " (" << textMap[node.PC].second
-                        << ") from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                    }
-                }
-            }
+    const RegisterDependency* dep = node.rs1 != 0 ? depsSnapshot.find(node.rs1, Stage::EXECUTE) : nullptr;
+    if (dep != nullptr && !dep->isLoad) {
+        instructionRegisters.RA = dep->value;
+        forwardingStatus.raForwarded = true;
+        emitForwarding(EventKind::FORWARD_EX_EX, node, *dep, 1, false);
+    }
+    dep = (hasRS2 && node.rs2 != 0) ? depsSnapshot.find(node.rs2, Stage::EXECUTE) : nullptr;
+    if (dep != nullptr && !dep->isLoad) {
+        if (toRM) {
+            instructionRegisters.RM = dep->value;
+            forwardingStatus.rmForwarded = true;
+        } else {
+            instructionRegisters.RB = dep->value;
+            forwardingStatus.rbForwarded = true;
         }
+        emitForwarding(EventKind::FORWARD_EX_EX, node, *dep, 2, toRM);
     }
 
-    for (const auto& [pc, dep] : depsSnapshot) {
-        if (dep.stage == Stage::MEMORY && dep.reg != 0) {
-            if (node.rs1 != 0 && node.rs1 == dep.reg && !forwardingStatus.raForwarded) {
-                instructionRegisters.RA = dep.value;
-                forwardingStatus.raForwarded = true;
-
-                std::cout << YELLOW << "\nData Forwarding: MEM->EX for rs1 (reg " << node.rs1
-                << ") of instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ")"
-                << (dep.isLoad ? " [Load]" : "") << " from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-            }
-
-            if ((node.instructionType == InstructionType::R || node.instructionType == InstructionType::S ||
-                 node.instructionType == InstructionType::SB) && node.rs2 != 0 && node.rs2 == dep.reg &&
-                !forwardingStatus.rbForwarded && !forwardingStatus.rmForwarded) {
-                if (node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB) {
-                    instructionRegisters.RM = dep.value;
-                    forwardingStatus.rmForwarded = true;
-
-                    std::cout << YELLOW << "\nData Forwarding: MEM->EX for rs2 (reg " << node.rs2
-                    << ") to RM of instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ")"
-                    << (dep.isLoad ? " [Load]" : "") << " from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                } else {
-                    instructionRegisters.RB = dep.value;
-                    forwardingStatus.rbForwarded = true;
-
-                    std::cout << YELLOW << "\nData Forwarding: MEM->EX for rs2 (reg " << node.rs2
-                    << ") of instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ")"
-                    << (dep.isLoad ? " [Load]" : "") << " from instruction (" << textMap[dep.pc].second << ")" << RESET << std::endl;
-                }
-            }
+    dep = node.rs1 != 0 ? depsSnapshot.find(node.rs1, Stage::MEMORY) : nullptr;
+    if (dep != nullptr && !forwardingStatus.raForwarded) {
+        instructionRegisters.RA = dep->value;
+        forwardingStatus.raForwarded = true;
+        emitForwarding(EventKind::FORWARD_MEM_EX, node, *dep, 1, false);
+    }
+    dep = (hasRS2 && node.rs2 != 0) ? depsSnapshot.find(node.rs2, Stage::MEMORY) : nullptr;
+    if (dep != nullptr && !forwardingStatus.rbForwarded && !forwardingStatus.rmForwarded) {
+        if (toRM) {
+            instructionRegisters.RM = dep->value;
+            forwardingStatus.rmForwarded = true;
+        } else {
+            instructionRegisters.RB = dep->value;
+            forwardingStatus.rbForwarded = true;
         }
+        emitForwarding(EventKind::FORWARD_MEM_EX, node, *dep, 2, toRM);
     }
 }
 
-bool Simulator::checkDependencies(const InstructionNode& node, const std::unordered_map<uint32_t, RegisterDependency>& depsSnapshot) const {
+template <typename Hooks, typename Log>
+bool BasicSimulator<Hooks, Log>::checkDependencies(const InstructionNode& node, const RegisterScoreboard& depsSnapshot) const {
     if (!isPipeline || isDataForwarding) {
         return false;
     }
-    
-    for (const auto& [uniqueId, dep] : depsSnapshot) {
-        if (dep.stage == Stage::MEMORY) continue;
-        if (uniqueId != node.uniqueId) {
-            if (node.rs1 != 0 && node.rs1 == dep.reg) {
-                std::cout << YELLOW << "Data Hazard: Instruction at PC=" + std::to_string(node.PC) + " (" + parseInstructions(node.instruction) + ") depends on reg " + std::to_string(dep.reg) + " in " + stageToString(dep.stage) << RESET << std::endl;
-                return true;
-            } else if ((node.instructionType == InstructionType::R || node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB) && node.rs2 != 0 && node.rs2 == dep.reg) {
-                std::cout << YELLOW << "Data Hazard: Instruction at PC=" + std::to_string(node.PC) + " (" + parseInstructions(node.instruction) + ") depends on reg " + std::to_string(dep.reg) + " in " + stageToString(dep.stage) << RESET << std::endl;
-                return true;
-            }
+
+    bool hasRS2 = (node.instructionType == InstructionType::R || node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB);
+    for (Stage stage : {Stage::DECODE, Stage::EXECUTE}) {
+        const RegisterDependency* dep = node.rs1 != 0 ? depsSnapshot.find(node.rs1, stage) : nullptr;
+        if (dep == nullptr || dep->uniqueId == node.uniqueId) {
+            dep = (hasRS2 && node.rs2 != 0) ? depsSnapshot.find(node.rs2, stage) : nullptr;
+        }
+        if (dep != nullptr && dep->uniqueId != node.uniqueId) {
+            emitHazard(EventKind::DATA_HAZARD, node, *dep);
+            return true;
         }
     }
     return false;
 }
 
-bool Simulator::checkLoadUseHazard(const InstructionNode& node, const std::unordered_map<uint32_t, RegisterDependency>& depsSnapshot, bool isStore) {
-    if (!isPipeline) {
+template <typename Hooks, typename Log>
+bool BasicSimulator<Hooks, Log>::checkLoadUseHazard(const InstructionNode& node, const RegisterScoreboard& depsSnapshot, bool isStore) {
+    if (!isPipeline || isStore) {
         return false;
     }
 
-    uint32_t rs1 = node.rs1;
-    uint32_t rs2 = node.rs2;
     bool hasRS2 = (node.instructionType == InstructionType::R || node.instructionType == InstructionType::S || node.instructionType == InstructionType::SB);
-
-    for (const auto& [uniqueId, dep] : depsSnapshot) {
-        if (uniqueId != node.uniqueId && dep.stage == Stage::EXECUTE && dep.isLoad && !isStore) {
-            if ((rs1 != 0 && rs1 == dep.reg) || (hasRS2 && rs2 != 0 && rs2 == dep.reg)) {
-                std::cout << GREEN << "Load-Use Hazard: Instruction at PC=" << node.PC << " (" << textMap[node.PC].second << ") depends on load at PC=" << dep.pc << " (rd=" << dep.reg << ")" << RESET << std::endl;
-                stats.stallBubbles++;
-                stats.dataHazardStalls++;
-                return true;
-            }
-        }
+    const RegisterDependency* dep = node.rs1 != 0 ? depsSnapshot.find(node.rs1, Stage::EXECUTE) : nullptr;
+    if (dep == nullptr || !dep->isLoad || dep->uniqueId == node.uniqueId) {
+        dep = (hasRS2 && node.rs2 != 0) ? depsSnapshot.find(node.rs2, Stage::EXECUTE) : nullptr;
+    }
+    if (dep != nullptr && dep->isLoad && dep->uniqueId != node.uniqueId) {
+        emitHazard(EventKind::LOAD_USE_HAZARD, node, *dep);
+        hooks.onStall();
+        stats.stallBubbles++;
+        stats.dataHazardStalls++;
+        if (profiler != nullptr) profiler->recordStall(node.PC, StallCause::LOAD_USE);
+        return true;
     }
     return false;
 }
 
-void Simulator::updateDependencies(InstructionNode& node, Stage stage) {
-    if (stage == Stage::DECODE && node.rd != 0) {
-        RegisterDependency dep;
-        dep.stage = stage;
-        dep.opcode = node.opcode;
-        dep.value = 0;
-        dep.reg = node.rd;
-        dep.isLoad = node.isLoad;
-        dep.uniqueId = node.uniqueId;
-        dep.pc = node.PC;
-        registerDependencies[node.uniqueId] = dep;
-    }
-    else if (stage == Stage::EXECUTE && node.rd != 0) {
-        if (registerDependencies.find(node.uniqueId) != registerDependencies.end()) {
-            registerDependencies[node.uniqueId].stage = stage;
-            registerDependencies[node.uniqueId].value = instructionRegisters.RY;
-        }
-    }
-    else if (stage == Stage::MEMORY && node.rd != 0) {
-        if (registerDependencies.find(node.uniqueId) != registerDependencies.end()) {
-            registerDependencies[node.uniqueId].stage = stage;
-            registerDependencies[node.uniqueId].value = instructionRegisters.RZ;
-        }
-    } 
-    else if (stage == Stage::WRITEBACK && node.rd != 0) {
-        if (registerDependencies.find(node.uniqueId) != registerDependencies.end()) {
-            registerDependencies.erase(node.uniqueId);
-        }
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::updateDependencies(InstructionNode& node, Stage stage) {
+    if (node.rd == 0) return;
+    switch (stage) {
+        case Stage::DECODE:
+            scoreboard.issue(node.rd, node.uniqueId, node.PC, node.isLoad);
+            break;
+        case Stage::EXECUTE:
+            scoreboard.advance(node.rd, node.uniqueId, stage, instructionRegisters.RY);
+            break;
+        case Stage::MEMORY:
+            scoreboard.advance(node.rd, node.uniqueId, stage, instructionRegisters.RZ);
+            break;
+        case Stage::WRITEBACK:
+            scoreboard.retire(node.rd, node.uniqueId);
+            break;
+        default:
+            break;
     }
 }
 
-bool Simulator::isPipelineEmpty() const {
-    for (const auto& pair : pipeline) {
-        if (pair.second != nullptr) {
+template <typename Hooks, typename Log>
+bool BasicSimulator<Hooks, Log>::isPipelineEmpty() const {
+    for (const InstructionNode* node : pipeline) {
+        if (node != nullptr) {
             return false;
         }
     }
     return true;
 }
 
-void Simulator::advancePipeline() {
-    std::map<Stage, InstructionNode*> newPipeline;
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::advancePipeline() {
+    PipelineSlots newPipeline;
     bool stalled = false;
     bool instructionProcessed = false;
     bool loadUseHazard = false;
+    bool memoryStall = false;
 
-    for (auto& pair : pipeline) {
-        newPipeline[pair.first] = nullptr;
-    }
-
-    const std::unordered_map<uint32_t, RegisterDependency> depsSnapshot = registerDependencies;
+    scoreboardSnapshot = scoreboard;
 
     forwardingStatus = ForwardingStatus();
+    hooks.onCycleBegin();
+    SimulationStats before;
+    if (tracer != nullptr) {
+        before = stats;
+        cycleForwards = 0;
+    }
 
     for (const auto& stage : reverseStageOrder) {
         InstructionNode* node = pipeline[stage];
@@ -375,19 +474,21 @@ void Simulator::advancePipeline() {
             bool shouldStall = false;
             if (node->stage == Stage::FETCH && (stalled || loadUseHazard)) {
                 shouldStall = true;
-            } else if (node->stage == Stage::DECODE && (stalled || loadUseHazard || (!isDataForwarding && checkDependencies(*node, depsSnapshot)))) {
+            } else if (node->stage == Stage::DECODE && (stalled || loadUseHazard || (!isDataForwarding && checkDependencies(*node, scoreboardSnapshot)))) {
                 shouldStall = true;
-                if (!isDataForwarding && checkDependencies(*node, depsSnapshot)) {
+                if (!isDataForwarding && checkDependencies(*node, scoreboardSnapshot)) {
                     stats.dataHazards++;
                     stats.stallBubbles++;
                     stats.dataHazardStalls++;
-                    std::cout << YELLOW << "Stalling DECODE (resume) at PC=" + std::to_string(node->PC) + " due to RAW hazard" << RESET << std::endl;
+                    if (profiler != nullptr) profiler->recordStall(node->PC, StallCause::RAW);
+                    emitEvent(makeEvent(EventKind::STALL_DECODE_RESUME, stats.totalCycles, node->PC, node->instruction));
                 }
-            } else if (node->stage == Stage::EXECUTE && loadUseHazard) {
+            } else if (node->stage == Stage::EXECUTE && (loadUseHazard || memoryStall)) {
                 shouldStall = true;
             }
 
             if (shouldStall) {
+                hooks.onStall();
                 node->stalled = true;
                 newPipeline[node->stage] = node;
                 pipeline[stage] = nullptr;
@@ -399,32 +500,61 @@ void Simulator::advancePipeline() {
             }
         }
 
-        if (isFollowing && node->PC == followedInstruction) {
-            std::cout << GREEN << "Cycle " << stats.totalCycles << ": Followed instruction at PC=0x" << std::hex << node->PC << std::dec << " (" << textMap[node->PC].second << ") completes " << stageToString(node->stage) << RESET << std::endl;
+        if (isFollowing && node->PC == followedInstruction && isEventEnabled(eventSink, EventLevel::INFO)) {
+            Event event = makeEvent(EventKind::FOLLOWED_STAGE, stats.totalCycles, node->PC, instructionAt(node->PC));
+            event.stage = node->stage;
+            eventSink->emit(event);
         }
 
         switch (node->stage) {
             case Stage::FETCH:
                 {
                     if (stalled || loadUseHazard) {
+                        hooks.onStall();
                         node->stalled = true;
                         newPipeline[Stage::FETCH] = node;
                         pipeline[stage] = nullptr;
                         instructionProcessed = true;
                         continue;
                     }
-                    instructionCount++;
-                    fetchInstruction(node, PC, running, textMap);
+                    if (instructionCache.enabled() && running && !node->cacheAccessed) {
+                        node->cacheAccessed = true;
+                        node->cacheWait = instructionCache.access(node->PC, false);
+                    }
+                    if (node->cacheWait > 0) {
+                        node->cacheWait--;
+                        stats.cacheStallCycles++;
+                        if (profiler != nullptr) profiler->recordStall(node->PC, StallCause::CACHE);
+                        hooks.onStall();
+                        newPipeline[Stage::FETCH] = node;
+                        pipeline[stage] = nullptr;
+                        instructionProcessed = true;
+                        continue;
+                    }
+                    fetchInstruction(node, PC, running, program->getDecodedText());
                     if (running && node->instruction != 0) {
                         if (isPipeline && isBranchPrediction) {
-                            bool predictedTaken = branchPredictor.predict(node->PC);
-                            std::cout << YELLOW << (node->isBranch ? "Branch" : "Jump") + std::string(" predicted ") + (predictedTaken ? "taken" : "not taken") + " at PC=" + std::to_string(node->PC) + " (" + parseInstructions(node->instruction) + ")" << RESET << std::endl;
-                            if (predictedTaken && branchPredictor.isInBTB(node->PC)) {
-                                PC = branchPredictor.getTarget(node->PC);
+                            node->returnCheckpoint = branchPredictor.returnCheckpoint();
+                        }
+                        if (isPipeline && isBranchPrediction && (node->decoded->isBranch || node->decoded->isJump)) {
+                            uint32_t predictedTarget = 0;
+                            node->returnPredicted = branchPredictor.predictReturn(*node->decoded, node->PC, predictedTarget);
+                            node->predictedTaken = node->returnPredicted || branchPredictor.predict(node->PC);
+                            if (isEventEnabled(eventSink, EventLevel::TRACE)) {
+                                Event event = makeEvent(EventKind::BRANCH_PREDICTED, stats.totalCycles, node->PC, node->instruction);
+                                event.isBranch = node->decoded->isBranch;
+                                event.predictedTaken = node->predictedTaken;
+                                eventSink->emit(event);
+                            }
+                            if (node->returnPredicted || (node->predictedTaken && branchPredictor.predictTarget(node->PC, predictedTarget))) {
+                                PC = predictedTarget;
+                                hooks.onBranchToFetch();
                             }
                         }
+                        node->predictedTarget = PC;
 
                         node->stage = Stage::DECODE;
+                        node->cacheAccessed = false;
                         newPipeline[Stage::DECODE] = node;
                         pipeline[stage] = nullptr;
                         instructionProcessed = true;
@@ -435,6 +565,7 @@ void Simulator::advancePipeline() {
             case Stage::DECODE:
                 {
                     if (stalled || loadUseHazard) {
+                        hooks.onStall();
                         node->stalled = true;
                         newPipeline[Stage::DECODE] = node;
                         pipeline[stage] = nullptr;
@@ -445,7 +576,8 @@ void Simulator::advancePipeline() {
 
                     decodeInstruction(node, instructionRegisters, registers);
 
-                    if (!isDataForwarding && checkDependencies(*node, depsSnapshot)) {
+                    if (!isDataForwarding && checkDependencies(*node, scoreboardSnapshot)) {
+                        hooks.onStall();
                         node->stalled = true;
                         newPipeline[Stage::DECODE] = node;
                         pipeline[stage] = nullptr;
@@ -454,7 +586,8 @@ void Simulator::advancePipeline() {
                         stats.dataHazards++;
                         stats.stallBubbles++;
                         stats.dataHazardStalls++;
-                        std::cout << YELLOW << "Stalling DECODE at PC=" + std::to_string(node->PC) + " due to RAW hazard" << RESET << std::endl;
+                        if (profiler != nullptr) profiler->recordStall(node->PC, StallCause::RAW);
+                        emitEvent(makeEvent(EventKind::STALL_DECODE, stats.totalCycles, node->PC, node->instruction));
                         continue;
                     }
 
@@ -484,15 +617,24 @@ void Simulator::advancePipeline() {
                 
             case Stage::EXECUTE:
                 {
-                    loadUseHazard = checkLoadUseHazard(*node, depsSnapshot, node->isStore);
+                    if (memoryStall) {
+                        hooks.onStall();
+                        node->stalled = true;
+                        newPipeline[Stage::EXECUTE] = node;
+                        pipeline[stage] = nullptr;
+                        instructionProcessed = true;
+                        continue;
+                    }
+                    loadUseHazard = checkLoadUseHazard(*node, scoreboardSnapshot, node->isStore);
                     if (loadUseHazard) {
                         node->stalled = true;
-                        newPipeline[Stage::EXECUTE] = new InstructionNode(*node);
+                        newPipeline[Stage::EXECUTE] = node;
+                        pipeline[stage] = nullptr;
                         instructionProcessed = true;
                         continue;
                     }
 
-                    applyDataForwarding(*node, depsSnapshot);
+                    applyDataForwarding(*node, scoreboardSnapshot);
 
                     bool taken = false;
                     uint32_t oldPC = PC;
@@ -500,40 +642,51 @@ void Simulator::advancePipeline() {
                     updateDependencies(*node, Stage::EXECUTE);
                     
                     if (isPipeline && (node->isBranch || node->isJump)) {
-                        bool predictedTaken = branchPredictor.getPHT(node->PC);
-                        bool targetMismatch = false;
+                        hooks.onBranchResolved();
+                        // Fetch carried on from predictedTarget; anything else squashes the
+                        // younger instructions and refetches from the resolved address.
+                        uint32_t resolvedPC = taken ? PC : node->PC + INSTRUCTION_SIZE;
+                        bool mispredicted = resolvedPC != node->predictedTarget;
                     
-                        if (predictedTaken && taken && branchPredictor.isInBTB(node->PC)) {
-                            uint32_t predictedTarget = branchPredictor.getTarget(node->PC);
-                            targetMismatch = (PC != predictedTarget);
+                        if (isBranchPrediction) {
+                            if (node->returnPredicted && mispredicted) {
+                                branchPredictor.recordReturnMisprediction();
+                            }
+                            branchPredictor.update(node->PC, taken, PC, mispredicted);
+                            if (profiler != nullptr) profiler->recordBranch(node->PC, mispredicted);
+                        } else if (profiler != nullptr) {
+                            profiler->recordBranch(node->PC, false);
                         }
                     
-                        branchPredictor.update(node->PC, taken, PC);
-                    
-                        if (predictedTaken != taken || targetMismatch) {
-                            flushPipeline(node->isBranch ? "Branch misprediction" : "Jump misprediction");
+                        if (mispredicted) {
+                            flushPipeline(*node);
                             newPipeline[Stage::FETCH] = nullptr;
                             newPipeline[Stage::DECODE] = nullptr;
+                            PC = resolvedPC;
+                            running = true;
                             stats.controlHazards++;
                             stats.controlHazardStalls++;
                             
-                            std::string misType = predictedTaken != taken ? "direction" : "target address";
-                            std::string predictionDetails = predictedTaken ? "taken to " + std::to_string(branchPredictor.getTarget(node->PC)) : "not taken";
-
-                            std::cout << YELLOW << (node->isBranch ? "Branch" : "Jump")
-                            << " misprediction (" << misType << ") at PC=" << node->PC
-                            << " (" << parseInstructions(node->instruction) << "), predicted: "
-                            << predictionDetails << ", actual: "
-                            << (taken ? "taken to " + std::to_string(PC) : "not taken")
-                            << RESET << std::endl;
-
+                            if (isEventEnabled(eventSink, EventLevel::TRACE)) {
+                                Event event = makeEvent(EventKind::BRANCH_MISPREDICTED, stats.totalCycles, node->PC, node->instruction);
+                                event.isBranch = node->isBranch;
+                                event.predictedTaken = node->predictedTarget != node->PC + INSTRUCTION_SIZE;
+                                event.taken = taken;
+                                event.target = node->predictedTarget;
+                                event.actual = PC;
+                                eventSink->emit(event);
+                            }
                         } else {
                             PC = oldPC;
-                            std::cout << YELLOW << (node->isBranch ? "Branch" : "Jump")
-                            << " correctly predicted at PC=" << node->PC
-                            << ", restored PC=" << PC
-                            << RESET << std::endl;
+                            if (isEventEnabled(eventSink, EventLevel::TRACE)) {
+                                Event event = makeEvent(EventKind::BRANCH_CORRECT, stats.totalCycles, node->PC, node->instruction);
+                                event.isBranch = node->isBranch;
+                                event.actual = PC;
+                                eventSink->emit(event);
+                            }
                         }
+                    } else if (profiler != nullptr && (node->isBranch || node->isJump)) {
+                        profiler->recordBranch(node->PC, false);
                     }
                     
                     if (isFollowing && node->PC == followedInstruction) {
@@ -550,8 +703,30 @@ void Simulator::advancePipeline() {
                 
             case Stage::MEMORY:
                 {
-                    applyDataForwarding(*node, depsSnapshot);
-                    memoryAccess(node, instructionRegisters, registers, dataMap);
+                    // Operands are forwarded on arrival; a D-cache miss then holds the access,
+                    // and every stage behind it, for the miss penalty.
+                    if (!node->cacheAccessed) {
+                        node->cacheAccessed = true;
+                        applyDataForwarding(*node, scoreboardSnapshot);
+                        if (dataCache.enabled() && (node->isLoad || node->isStore)) {
+                            node->cacheWait = dataCache.access(instructionRegisters.RY, node->isStore);
+                        }
+                    }
+                    if (node->cacheWait > 0) {
+                        node->cacheWait--;
+                        stats.cacheStallCycles++;
+                        if (profiler != nullptr) profiler->recordStall(node->PC, StallCause::CACHE);
+                        hooks.onStall();
+                        memoryStall = true;
+                        stalled = true;
+                        newPipeline[Stage::MEMORY] = node;
+                        pipeline[stage] = nullptr;
+                        instructionProcessed = true;
+                        continue;
+                    }
+                    memoryAccess(node, instructionRegisters, registers, memory);
+                    if (node->isStore) recordStore(*node);
+                    if (profiler != nullptr && (node->isLoad || node->isStore)) profiler->recordMemoryAccess(node->PC);
                     updateDependencies(*node, Stage::MEMORY);
 
                     if (isFollowing && node->PC == followedInstruction) {
@@ -569,25 +744,27 @@ void Simulator::advancePipeline() {
                 {
                     writeback(node, instructionRegisters, registers);
                     updateDependencies(*node, Stage::WRITEBACK);
+                    instructionCount++;
+                    if (profiler != nullptr) profiler->recordExecution(node->PC);
                     instructionProcessed = true;
 
                     if (isFollowing && node->PC == followedInstruction) {
                         followedInstructionRegisters = instructionRegisters;
                     }
 
-                    delete node;
+                    nodePool.release(node);
                     pipeline[Stage::WRITEBACK] = nullptr;
                     
-                    if (!isPipeline && running && textMap.find(PC) != textMap.end()) {
+                    if (!isPipeline && running && !isDraining && findDecodedInstruction(PC, program->getDecodedText()) != nullptr) {
                         bool pipelineEmpty = true;
-                        for (const auto& [_, node] : newPipeline) {
+                        for (const InstructionNode* node : newPipeline) {
                             if (node != nullptr) {
                                 pipelineEmpty = false;
                                 break;
                             }
                         }
                         if (pipelineEmpty) {
-                            newPipeline[Stage::FETCH] = new InstructionNode(PC);
+                            newPipeline[Stage::FETCH] = nodePool.acquire(PC);
                             newPipeline[Stage::FETCH]->uniqueId = nextInstructionId++;
                         }
                     }
@@ -596,22 +773,19 @@ void Simulator::advancePipeline() {
         }
     }
 
-    if (isPipeline && !stalled && newPipeline[Stage::FETCH] == nullptr && running && textMap.find(PC) != textMap.end()) {
-        InstructionNode* newNode = new InstructionNode(PC);
+    if (isPipeline && !stalled && !isDraining && newPipeline[Stage::FETCH] == nullptr && running && findDecodedInstruction(PC, program->getDecodedText()) != nullptr) {
+        InstructionNode* newNode = nodePool.acquire(PC);
         newNode->uniqueId = nextInstructionId++;
         newPipeline[Stage::FETCH] = newNode;
     }
 
-    for (auto& pair : pipeline) {
-        if (pair.second != nullptr) {
-            delete pair.second;
-            pair.second = nullptr;
-        }
+    for (InstructionNode* node : pipeline) {
+        nodePool.release(node);
     }
     pipeline = newPipeline;
 
     bool isEmpty = isPipelineEmpty();
-    if (isEmpty && !textMap.empty() && textMap.find(PC) == textMap.end()) {
+    if (isEmpty && !program->empty() && findDecodedInstruction(PC, program->getDecodedText()) == nullptr) {
         running = false;
     }
 
@@ -620,98 +794,394 @@ void Simulator::advancePipeline() {
         if (instructionCount > 0) {
             stats.cyclesPerInstruction = static_cast<double>(stats.totalCycles) / instructionCount;
         }
+        if (tracer != nullptr) recordTraceCycle(before);
+    }
+}
+
+// A stall counted without a matching data hazard is a load-use stall; RAW stalls count both.
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::recordTraceCycle(const SimulationStats& before) {
+    TraceCycle cycle;
+    cycle.cycle = stats.totalCycles;
+    cycle.newestId = nextInstructionId - 1;
+    for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+        const InstructionNode* node = pipeline[static_cast<Stage>(stage)];
+        if (node == nullptr) continue;
+        cycle.ids[stage] = node->uniqueId;
+        cycle.pcs[stage] = node->PC;
+    }
+    uint32_t hazards = stats.dataHazards - before.dataHazards;
+    cycle.flags = cycleForwards;
+    if (hazards != 0) cycle.flags |= TRACE_RAW_STALL;
+    if (stats.dataHazardStalls - before.dataHazardStalls > hazards) cycle.flags |= TRACE_LOAD_USE_STALL;
+    if (stats.cacheStallCycles != before.cacheStallCycles) cycle.flags |= TRACE_CACHE_STALL;
+    if (stats.pipelineFlushes != before.pipelineFlushes) cycle.flags |= TRACE_FLUSH;
+    tracer->record(cycle);
+}
+
+template <typename Hooks, typename Log>
+bool BasicSimulator<Hooks, Log>::stepFunctional(uint32_t maxInstructions) {
+    releasePipeline();
+    // The translated blocks have no per-instruction hooks, so profiled runs use the interpreter.
+    uint32_t executed = profiler == nullptr
+        ? runTranslated(program->getTranslation(), registers, PC, memory, stats, maxInstructions, running)
+        : runFunctional(program->getDecodedText(), registers, PC, memory, stats, maxInstructions, running, profiler);
+    instructionCount += executed;
+    stats.totalCycles += executed;
+    stats.instructionsExecuted = instructionCount;
+    if (instructionCount > 0) {
+        stats.cyclesPerInstruction = static_cast<double>(stats.totalCycles) / instructionCount;
     }
+    return running;
 }
 
-bool Simulator::step() {
+template <typename Hooks, typename Log>
+bool BasicSimulator<Hooks, Log>::step() {
     try {
+        if (isFunctional) {
+            if (!stepFunctional(1)) {
+                hooks.onTerminated();
+                emitEvent(makeEvent(EventKind::PROGRAM_COMPLETED, stats.totalCycles, PC));
+                return false;
+            }
+            return true;
+        }
         advancePipeline();
         stats.instructionsExecuted = instructionCount;
         bool pipelineEmpty = isPipelineEmpty();
         if (!running && pipelineEmpty) {
-            std::cout << GREEN << "Program execution completed" << RESET << std::endl;
+            hooks.onTerminated();
+            emitEvent(makeEvent(EventKind::PROGRAM_COMPLETED, stats.totalCycles, PC));
             return false;
         }
         return true;
     }
     catch (const std::runtime_error &e) {
-        std::cerr << RED << "Runtime error during step execution: " + std::string(e.what()) << RESET << std::endl;
+        log.error("Runtime error during step execution: " + std::string(e.what()));
         running = false;
+        hooks.onTerminated();
         return false;
     }
 }
 
-void Simulator::run() {
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::run() {
+    if (isFunctional) {
+        try {
+            if (!stepFunctional(MAX_FUNCTIONAL_STEPS)) {
+                emitEvent(makeEvent(EventKind::PROGRAM_COMPLETED, stats.totalCycles, PC));
+            } else {
+                Event event = makeEvent(EventKind::INSTRUCTION_LIMIT, stats.totalCycles, PC);
+                event.target = MAX_FUNCTIONAL_STEPS;
+                emitEvent(event);
+            }
+        }
+        catch (const std::runtime_error &e) {
+            log.error("Runtime error during step execution: " + std::string(e.what()));
+            running = false;
+        }
+        return;
+    }
+
     int stepCount = 0;
     while (step()) {   
         stepCount++;
         if (stepCount > MAX_STEPS) {
-            std::cout << RED << "Program execution terminated - exceeded maximum step count (" + std::to_string(MAX_STEPS) + ")" << RESET;
+            Event event = makeEvent(EventKind::STEP_LIMIT, stats.totalCycles, PC);
+            event.target = MAX_STEPS;
+            emitEvent(event);
+            hooks.onTerminated();
+            break;
+        }
+    }
+}
+
+template <typename Hooks, typename Log>
+RunSummary BasicSimulator<Hooks, Log>::runCycles(uint32_t maxCycles) {
+    return runUntil({}, {}, maxCycles);
+}
+
+// Steps until maxCycles have run, the program ends, an instruction at a breakpoint is fetched or
+// a store hits a watched [begin, end) range. Functional runs with neither go straight to the
+// functional engine for the whole batch. A breakpoint only fires on a new fetch, so running
+// again from a breakpoint moves past it. The functional model has no fetch stage and stops at a
+// breakpoint PC before executing it, after at least one step.
+template <typename Hooks, typename Log>
+RunSummary BasicSimulator<Hooks, Log>::runUntil(const std::unordered_set<uint32_t>& breakpoints,
+                                                const std::vector<std::pair<uint32_t, uint32_t>>& watchpoints, uint32_t maxCycles) {
+    RunSummary summary;
+    if (isFunctional && breakpoints.empty() && watchpoints.empty()) {
+        uint32_t startCycles = stats.totalCycles;
+        bool stillRunning = false;
+        try {
+            stillRunning = stepFunctional(maxCycles);
+        }
+        catch (const std::runtime_error &e) {
+            log.error("Runtime error during step execution: " + std::string(e.what()));
+            running = false;
+        }
+        summary.cycles = stats.totalCycles - startCycles;
+        if (!stillRunning) {
+            hooks.onTerminated();
+            emitEvent(makeEvent(EventKind::PROGRAM_COMPLETED, stats.totalCycles, PC));
+            summary.reason = StopReason::TERMINATED;
+            summary.address = PC;
+        }
+        return summary;
+    }
+
+    const InstructionNode* fetched = pipeline[Stage::FETCH];
+    uint32_t fetchedId = fetched != nullptr ? fetched->uniqueId : UINT32_MAX;
+
+    while (summary.cycles < maxCycles) {
+        lastStoreSize = 0;
+        bool stillRunning = step();
+        summary.cycles++;
+        if (!stillRunning) {
+            summary.reason = StopReason::TERMINATED;
+            summary.address = PC;
             break;
         }
+        for (const auto& [begin, end] : watchpoints) {
+            if (lastStoreSize != 0 && lastStoreAddress < end && begin < lastStoreAddress + lastStoreSize) {
+                summary.reason = StopReason::WATCHPOINT;
+                summary.address = std::max(begin, lastStoreAddress);
+                return summary;
+            }
+        }
+        if (isFunctional) {
+            if (breakpoints.count(PC)) {
+                summary.reason = StopReason::BREAKPOINT;
+                summary.address = PC;
+                break;
+            }
+            continue;
+        }
+        fetched = pipeline[Stage::FETCH];
+        if (fetched != nullptr && fetched->uniqueId != fetchedId) {
+            fetchedId = fetched->uniqueId;
+            if (breakpoints.count(fetched->PC)) {
+                summary.reason = StopReason::BREAKPOINT;
+                summary.address = fetched->PC;
+                break;
+            }
+        }
     }
+    return summary;
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::recordStore(const InstructionNode& node) {
+    uint32_t size = node.instructionName == Instructions::SB ? 1 : node.instructionName == Instructions::SH ? 2 : 4;
+    lastStoreAddress = instructionRegisters.RY;
+    lastStoreSize = size;
+    hooks.onStore(lastStoreAddress, size);
+}
+
+// Runs the instructions already in flight to completion without fetching new ones. The
+// instruction waiting in FETCH has not been fetched yet and is dropped, so afterwards PC is the
+// next instruction to execute and the functional engine can continue from it exactly.
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::drain() {
+    if (isFunctional) return;
+    nodePool.release(pipeline[Stage::FETCH]);
+    pipeline[Stage::FETCH] = nullptr;
+    isDraining = true;
+    while (!isPipelineEmpty() && step()) {}
+    isDraining = false;
 }
 
-void Simulator::setEnvironment(bool pipeline, bool dataForwarding, bool branchPrediction, uint32_t instruction) {
-    isPipeline = pipeline;
+// Leaving a detailed mode for functional execution drains the pipeline first; entering one from
+// functional mode refills it from PC.
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::setEnvironment(bool pipeline, bool dataForwarding, bool branchPrediction, uint32_t instruction, bool functional) {
+    if (functional && !isFunctional && running) drain();
+    isFunctional = functional;
+    isPipeline = pipeline && !functional;
     isDataForwarding = dataForwarding;
     isBranchPrediction = branchPrediction;
     followedInstruction = instruction;
     if(followedInstruction != UINT32_MAX) {
         isFollowing = true;
     }
+    seedFetch();
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::setEventSink(EventSink* sink) {
+    eventSink = sink;
+}
+
+// The profiler is sized to the program on every load; setting it before loadProgram is enough.
+// Attaching one that already matches the program keeps its counts.
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::setProfiler(Profiler* newProfiler) {
+    profiler = newProfiler;
+    if (profiler != nullptr && profiler->size() != program->size()) profiler->reset(program->size());
+}
+
+template <typename Hooks, typename Log>
+SimulatorSnapshot BasicSimulator<Hooks, Log>::takeSnapshot() const {
+    SimulatorSnapshot snapshot;
+    snapshot.cycle = stats.totalCycles;
+    snapshot.PC = PC;
+    std::memcpy(snapshot.registers, registers, sizeof(registers));
+    snapshot.memory = memory;
+    snapshot.program = program;
+    for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+        const InstructionNode* node = pipeline[static_cast<Stage>(stage)];
+        snapshot.occupied[stage] = node != nullptr;
+        if (node != nullptr) snapshot.stages[stage] = *node;
+    }
+    snapshot.instructionRegisters = instructionRegisters;
+    snapshot.forwardingStatus = forwardingStatus;
+    snapshot.followedInstructionRegisters = followedInstructionRegisters;
+    snapshot.running = running;
+    snapshot.stats = stats;
+    snapshot.scoreboard = scoreboard;
+    snapshot.branchPredictor = branchPredictor;
+    snapshot.instructionCache = instructionCache;
+    snapshot.dataCache = dataCache;
+    snapshot.instructionCount = instructionCount;
+    snapshot.nextInstructionId = nextInstructionId;
+    return snapshot;
+}
+
+// The current mode is kept, so a snapshot taken in functional mode can be continued pipelined:
+// the pipeline is then empty and refills from the snapshot PC. The other direction drops the
+// instructions in flight.
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::restoreSnapshot(const SimulatorSnapshot& snapshot) {
+    releasePipeline();
+    PC = snapshot.PC;
+    std::memcpy(registers, snapshot.registers, sizeof(registers));
+    memory = snapshot.memory;
+    program = snapshot.program ? snapshot.program : emptyProgramImage();
+    for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+        if (!snapshot.occupied[stage]) continue;
+        InstructionNode* node = nodePool.acquire(snapshot.stages[stage].PC);
+        *node = snapshot.stages[stage];
+        pipeline[static_cast<Stage>(stage)] = node;
+    }
+    instructionRegisters = snapshot.instructionRegisters;
+    forwardingStatus = snapshot.forwardingStatus;
+    followedInstructionRegisters = snapshot.followedInstructionRegisters;
+    running = snapshot.running;
+    stats = snapshot.stats;
+    scoreboard = snapshot.scoreboard;
+    branchPredictor = snapshot.branchPredictor;
+    instructionCache = snapshot.instructionCache;
+    dataCache = snapshot.dataCache;
+    instructionCount = snapshot.instructionCount;
+    nextInstructionId = snapshot.nextInstructionId;
+    lastStoreSize = 0;
+    if (profiler != nullptr && profiler->size() != program->size()) profiler->reset(program->size());
+    hooks.onReset();
+    seedFetch();
+}
+
+// Puts an instruction into FETCH when the pipelined engine takes over an empty pipeline, as
+// after functional execution.
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::seedFetch() {
+    if (isFunctional || !running || !isPipelineEmpty()) return;
+    if (findDecodedInstruction(PC, program->getDecodedText()) == nullptr) return;
+    InstructionNode* node = nodePool.acquire(PC);
+    node->uniqueId = nextInstructionId++;
+    pipeline[Stage::FETCH] = node;
+}
+
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::setPredictorConfig(const PredictorConfig& config) {
+    branchPredictor.configure(config);
 }
 
-std::map<uint32_t, std::pair<uint32_t, std::string>> Simulator::getTextMap() const {
-    return textMap;
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::setCacheConfig(const CacheConfig& icache, const CacheConfig& dcache) {
+    instructionCache.configure(icache, "I-cache");
+    dataCache.configure(dcache, "D-cache");
 }
 
-uint32_t Simulator::getCycles() const {
+template <typename Hooks, typename Log>
+uint32_t BasicSimulator<Hooks, Log>::getCycles() const {
     return stats.totalCycles;
 }
 
-void Simulator::flushPipeline(const std::string& reason) {
+template <typename Hooks, typename Log>
+void BasicSimulator<Hooks, Log>::flushPipeline(const InstructionNode& cause) {
     if (!isPipeline) return;
-    std::vector<uint32_t> idsToRemove;
-    
-    if (pipeline[Stage::FETCH] != nullptr) {
-        idsToRemove.push_back(pipeline[Stage::FETCH]->uniqueId);
-        delete pipeline[Stage::FETCH];
-        pipeline[Stage::FETCH] = nullptr;
-    }
-    
     if (pipeline[Stage::DECODE] != nullptr) {
-        idsToRemove.push_back(pipeline[Stage::DECODE]->uniqueId);
-        delete pipeline[Stage::DECODE];
-        pipeline[Stage::DECODE] = nullptr;
+        branchPredictor.restoreReturnCheckpoint(pipeline[Stage::DECODE]->returnCheckpoint);
     }
-
-    for (const auto& id : idsToRemove) {
-        registerDependencies.erase(id);
+    uint32_t squashed = 0;
+    for (Stage stage : {Stage::FETCH, Stage::DECODE}) {
+        InstructionNode* node = pipeline[stage];
+        if (node != nullptr) {
+            squashed++;
+            scoreboard.retire(node->rd, node->uniqueId);
+            nodePool.release(node);
+            pipeline[stage] = nullptr;
+        }
     }
-    
+
     stats.pipelineFlushes++;
-    std::cout << YELLOW << "Pipeline flushed: " + reason;
+    if (profiler != nullptr) profiler->recordStall(cause.PC, StallCause::CONTROL, squashed);
+    hooks.onFlush();
+    if (isEventEnabled(eventSink, EventLevel::TRACE)) {
+        Event event = makeEvent(EventKind::PIPELINE_FLUSH, stats.totalCycles, cause.PC, cause.instruction);
+        event.isBranch = cause.isBranch;
+        eventSink->emit(event);
+    }
+}
+
+template <typename Hooks, typename Log>
+std::array<std::pair<bool, uint32_t>, NUM_STAGES> BasicSimulator<Hooks, Log>::getActiveStages() const {
+    std::array<std::pair<bool, uint32_t>, NUM_STAGES> activeStages{};
+    for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+        const InstructionNode* node = pipeline[static_cast<Stage>(stage)];
+        if (node != nullptr) {
+            activeStages[stage] = std::make_pair(true, node->PC);
+        }
+    }
+    return activeStages;
 }
 
-InstructionRegisters Simulator::getInstructionRegisters() const {
+template <typename Hooks, typename Log>
+InstructionRegisters BasicSimulator<Hooks, Log>::getInstructionRegisters() const {
     return instructionRegisters;
 }
 
-InstructionRegisters Simulator::getFollowedInstructionRegisters() const {
+template <typename Hooks, typename Log>
+InstructionRegisters BasicSimulator<Hooks, Log>::getFollowedInstructionRegisters() const {
     return followedInstructionRegisters;
 }
 
-const uint32_t *Simulator::getRegisters() const {
+template <typename Hooks, typename Log>
+const uint32_t *BasicSimulator<Hooks, Log>::getRegisters() const {
     return registers;
 }
 
-SimulationStats Simulator::getStats() {
-    stats.branchMispredictions = branchPredictor.mispredictions;
+template <typename Hooks, typename Log>
+SimulationStats BasicSimulator<Hooks, Log>::getStats() {
+    const PredictorStats& predictorStats = branchPredictor.getStats();
+    stats.branchPredictions = predictorStats.predictions;
+    stats.branchMispredictions = predictorStats.mispredictions;
+    stats.btbHits = predictorStats.btbHits;
+    stats.btbMisses = predictorStats.btbMisses;
+    stats.returnPredictions = predictorStats.returnPredictions;
+    stats.returnMispredictions = predictorStats.returnMispredictions;
+    stats.icacheHits = instructionCache.getStats().hits;
+    stats.icacheMisses = instructionCache.getStats().misses;
+    stats.icacheEvictions = instructionCache.getStats().evictions;
+    stats.dcacheHits = dataCache.getStats().hits;
+    stats.dcacheMisses = dataCache.getStats().misses;
+    stats.dcacheEvictions = dataCache.getStats().evictions;
+    stats.dcacheWritebacks = dataCache.getStats().writebacks;
     return stats;
 }
 
-uint32_t Simulator::getFollowedPC() const {
+template <typename Hooks, typename Log>
+uint32_t BasicSimulator<Hooks, Log>::getFollowedPC() const {
     return followedInstruction;
 }
 
@@ -0,0 +1,131 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "types.hpp"
+#include "memory.hpp"
+#include "program.hpp"
+#include "pipeline.hpp"
+#include "scoreboard.hpp"
+#include "predictor.hpp"
+#include "cache.hpp"
+#include "events.hpp"
+#include "profile.hpp"
+#include "trace.hpp"
+
+using namespace riscv;
+
+inline constexpr uint32_t DEFAULT_CHECKPOINT_INTERVAL = 1000;
+inline constexpr size_t DEFAULT_MAX_CHECKPOINTS = 256;
+
+// Complete engine state at the end of one cycle. Memory is a copy of the page directory, so the
+// pages themselves stay shared copy-on-write with the simulator and with every other snapshot.
+// In-flight instructions are stored by value and get fresh pool nodes on restore. The execution
+// mode, event sink and profiler are configuration, not state, and are left out.
+struct SimulatorSnapshot {
+    uint32_t cycle;
+    uint32_t PC;
+    uint32_t registers[NUM_REGISTERS];
+    Memory memory;
+    std::shared_ptr<const ProgramImage> program;
+
+    std::array<InstructionNode, NUM_STAGES> stages;
+    std::array<bool, NUM_STAGES> occupied;
+    InstructionRegisters instructionRegisters;
+    ForwardingStatus forwardingStatus;
+    InstructionRegisters followedInstructionRegisters;
+
+    bool running;
+    SimulationStats stats;
+    RegisterScoreboard scoreboard;
+    BranchPredictor branchPredictor;
+    Cache instructionCache;
+    Cache dataCache;
+    uint32_t instructionCount;
+    uint32_t nextInstructionId;
+};
+
+// Periodic checkpoints of one simulation for reverse stepping and seeking. record() is called
+// after every step (or batch of at most interval cycles) and keeps a snapshot once interval
+// cycles have passed since the last one; seek() restores the closest checkpoint at or before the
+// target and re-simulates forward, so reaching any earlier cycle costs at most one interval of
+// simulation. Past maxCheckpoints every other checkpoint is dropped and the interval doubles.
+//
+// Replayed cycles are run with the event sink and profiler detached, so they are not logged
+// again; a profiler still holds the counts of cycles that were stepped back over. Checkpoints
+// are only valid for the program and configuration they were recorded with; clear() after
+// loading another program or changing the mode.
+template <typename Sim>
+class CheckpointTimeline {
+public:
+    explicit CheckpointTimeline(uint32_t interval = DEFAULT_CHECKPOINT_INTERVAL, size_t maxCheckpoints = DEFAULT_MAX_CHECKPOINTS)
+        : interval(std::max<uint32_t>(interval, 1)), maxCheckpoints(std::max<size_t>(maxCheckpoints, 2)) {}
+
+    inline void clear() { checkpoints.clear(); }
+    inline size_t size() const { return checkpoints.size(); }
+    inline uint32_t getInterval() const { return interval; }
+
+    inline void record(const Sim& sim);
+    inline bool seek(Sim& sim, uint32_t cycle);
+    inline bool stepBack(Sim& sim) { return sim.getCycles() > 0 && seek(sim, sim.getCycles() - 1); }
+
+private:
+    uint32_t interval;
+    size_t maxCheckpoints;
+    std::vector<SimulatorSnapshot> checkpoints;
+
+    inline void thin();
+};
+
+template <typename Sim>
+inline void CheckpointTimeline<Sim>::record(const Sim& sim) {
+    uint32_t cycle = sim.getCycles();
+    if (!checkpoints.empty() && cycle < checkpoints.back().cycle + interval) return;
+    checkpoints.push_back(sim.takeSnapshot());
+    if (checkpoints.size() > maxCheckpoints) thin();
+}
+
+template <typename Sim>
+inline void CheckpointTimeline<Sim>::thin() {
+    interval *= 2;
+    size_t kept = 0;
+    for (size_t i = 0; i < checkpoints.size(); i += 2) {
+        if (kept != i) checkpoints[kept] = std::move(checkpoints[i]);
+        kept++;
+    }
+    checkpoints.erase(checkpoints.begin() + kept, checkpoints.end());
+}
+
+// Returns false when no checkpoint precedes cycle or the program ends before reaching it; in the
+// latter case the simulator is left at its final cycle.
+template <typename Sim>
+inline bool CheckpointTimeline<Sim>::seek(Sim& sim, uint32_t cycle) {
+    auto after = std::upper_bound(checkpoints.begin(), checkpoints.end(), cycle,
+                                  [](uint32_t target, const SimulatorSnapshot& snapshot) { return target < snapshot.cycle; });
+    if (after == checkpoints.begin()) return false;
+    sim.restoreSnapshot(*(after - 1));
+
+    EventSink* sink = sim.getEventSink();
+    Profiler* profiler = sim.getProfiler();
+    TraceWriter* tracer = sim.getTracer();
+    sim.setEventSink(nullptr);
+    sim.setProfiler(nullptr);
+    sim.setTracer(nullptr);
+    bool reached = true;
+    while (sim.getCycles() < cycle) {
+        if (!sim.step()) {
+            reached = sim.getCycles() == cycle;
+            break;
+        }
+    }
+    sim.setEventSink(sink);
+    sim.setProfiler(profiler);
+    sim.setTracer(tracer);
+    return reached;
+}
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "types.hpp"
+#include "program.hpp"
+#include "parallel.hpp"
+#include "predictor.hpp"
+#include "cache.hpp"
+#include "simulator.hpp"
+
+using namespace riscv;
+
+struct SweepConfig {
+    bool pipeline;
+    bool dataForwarding;
+    bool branchPrediction;
+    bool functional;
+    PredictorConfig predictor;
+    CacheConfig icache;
+    CacheConfig dcache;
+
+    SweepConfig() : pipeline(false), dataForwarding(false), branchPrediction(false), functional(false) {}
+};
+
+struct SweepResult {
+    SweepConfig config;
+    SimulationStats stats;
+    bool loaded;
+    // Ran to the end of the program rather than into the step limit.
+    bool completed;
+    // Timing settings must never change what the program computes: the final registers and the
+    // number of retired instructions are checked against a functional run of the same program.
+    bool matchesFunctional;
+    std::array<uint32_t, NUM_REGISTERS> registers;
+
+    SweepResult() : loaded(false), completed(false), matchesFunctional(false), registers{} {}
+};
+
+inline std::vector<std::string> splitList(const std::string& text, char separator) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, separator)) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+inline uint32_t parseSweepNumber(const std::string& key, const std::string& value) {
+    uint32_t parsed = 0;
+    if (parseUnsigned(value, parsed) != NumberError::NONE) {
+        throw std::runtime_error(std::string(RED) + "Invalid sweep value '" + value + "' for " + key + RESET);
+    }
+    return parsed;
+}
+
+inline bool parseSweepFlag(const std::string& key, const std::string& value) {
+    if (value == "1" || value == "on") return true;
+    if (value == "0" || value == "off") return false;
+    throw std::runtime_error(std::string(RED) + "Invalid sweep value '" + value + "' for " + key + " (expected 0/1 or on/off)" + RESET);
+}
+
+inline void applySweepValue(SweepConfig& config, const std::string& key, const std::string& value) {
+    if (key == "mode") {
+        if (value != "single" && value != "pipeline" && value != "functional") {
+            throw std::runtime_error(std::string(RED) + "Invalid sweep mode '" + value + "' (expected single, pipeline, functional)" + RESET);
+        }
+        config.pipeline = value == "pipeline";
+        config.functional = value == "functional";
+    } else if (key == "forwarding") {
+        config.dataForwarding = parseSweepFlag(key, value);
+    } else if (key == "prediction") {
+        config.branchPrediction = parseSweepFlag(key, value);
+    } else if (key == "predictor") {
+        if (!parsePredictorType(value, config.predictor.type)) {
+            throw std::runtime_error(std::string(RED) + "Invalid sweep predictor '" + value + "'" + RESET);
+        }
+    } else if (key == "pht-bits") {
+        config.predictor.phtBits = parseSweepNumber(key, value);
+    } else if (key == "btb-bits") {
+        config.predictor.btbBits = parseSweepNumber(key, value);
+    } else if (key == "history-bits") {
+        config.predictor.historyBits = parseSweepNumber(key, value);
+    } else if (key == "ras") {
+        config.predictor.rasEntries = parseSweepNumber(key, value);
+    } else if (key.rfind("icache-", 0) == 0) {
+        applyCacheValue(config.icache, key.substr(7), value);
+    } else if (key.rfind("dcache-", 0) == 0) {
+        applyCacheValue(config.dcache, key.substr(7), value);
+    } else {
+        throw std::runtime_error(std::string(RED) + "Unknown sweep parameter '" + key + "'" + RESET);
+    }
+}
+
+// Expands "key=v1,v2;key=v1,..." into the cartesian product of all listed values. Parameters not
+// named in the spec keep their value from base.
+inline std::vector<SweepConfig> expandSweep(const std::string& spec, const SweepConfig& base) {
+    std::vector<SweepConfig> configs = {base};
+    for (const std::string& dimension : splitList(spec, ';')) {
+        size_t equalPos = dimension.find('=');
+        if (equalPos == std::string::npos) {
+            throw std::runtime_error(std::string(RED) + "Invalid sweep parameter '" + dimension + "' (expected key=v1,v2,...)" + RESET);
+        }
+        std::string key = dimension.substr(0, equalPos);
+        std::vector<std::string> values = splitList(dimension.substr(equalPos + 1), ',');
+        if (values.empty()) {
+            throw std::runtime_error(std::string(RED) + "No values given for sweep parameter '" + key + "'" + RESET);
+        }
+        std::vector<SweepConfig> expanded;
+        expanded.reserve(configs.size() * values.size());
+        for (const SweepConfig& config : configs) {
+            for (const std::string& value : values) {
+                SweepConfig next = config;
+                applySweepValue(next, key, value);
+                expanded.push_back(next);
+            }
+        }
+        configs = std::move(expanded);
+    }
+    for (const SweepConfig& config : configs) {
+        validateTableBits(config.predictor.phtBits, "PHT");
+        validateTableBits(config.predictor.btbBits, "BTB");
+        validateCacheConfig(config.icache, "I-cache");
+        validateCacheConfig(config.dcache, "D-cache");
+    }
+    return configs;
+}
+
+inline SweepResult runSweepConfig(const std::shared_ptr<const ProgramImage>& program, const SweepConfig& config) {
+    SweepResult result;
+    result.config = config;
+    Simulator sim;
+    sim.setPredictorConfig(config.predictor);
+    sim.setCacheConfig(config.icache, config.dcache);
+    sim.setEnvironment(config.pipeline, config.dataForwarding, config.branchPrediction, UINT32_MAX, config.functional);
+    result.loaded = sim.loadProgram(program);
+    if (result.loaded) {
+        sim.run();
+        result.stats = sim.getStats();
+        result.completed = !sim.isRunning();
+        std::copy(sim.getRegisters(), sim.getRegisters() + NUM_REGISTERS, result.registers.begin());
+    }
+    return result;
+}
+
+inline bool matchesArchitecturally(const SweepResult& result, const SweepResult& reference) {
+    return result.loaded && result.completed && reference.completed && result.registers == reference.registers &&
+           result.stats.instructionsExecuted == reference.stats.instructionsExecuted;
+}
+
+// Runs every configuration against the same assembled program, plus one functional reference run
+// that every result is checked against. Results keep the order of configs.
+inline std::vector<SweepResult> runSweep(const std::shared_ptr<const ProgramImage>& program, const std::vector<SweepConfig>& configs, size_t threads) {
+    std::vector<SweepResult> results(configs.size());
+    SweepResult reference;
+    SweepConfig referenceConfig;
+    referenceConfig.functional = true;
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(configs.size() + 1);
+    tasks.push_back([&program, &referenceConfig, &reference]() {
+        reference = runSweepConfig(program, referenceConfig);
+    });
+    for (size_t i = 0; i < configs.size(); i++) {
+        tasks.push_back([&program, &configs, &results, i]() {
+            results[i] = runSweepConfig(program, configs[i]);
+        });
+    }
+    WorkStealingPool pool(std::min(threads, tasks.size()));
+    pool.run(tasks);
+    for (SweepResult& result : results) {
+        result.matchesFunctional = matchesArchitecturally(result, reference);
+    }
+    return results;
+}
+
+inline const char* sweepModeName(const SweepConfig& config) {
+    return config.functional ? "functional" : config.pipeline ? "pipeline" : "single";
+}
+
+inline void writeSweepCsv(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "mode,forwarding,prediction,predictor,pht_bits,btb_bits,history_bits,ras,loaded,"
+        << "cpi,total_cycles,instructions,data_transfer,alu,control,stall_bubbles,data_hazards,"
+        << "control_hazards,data_hazard_stalls,control_hazard_stalls,pipeline_flushes,"
+        << "branch_predictions,branch_mispredictions,btb_hits,btb_misses,return_predictions,return_mispredictions,"
+        << "icache_size,icache_ways,dcache_size,dcache_ways,icache_hits,icache_misses,dcache_hits,dcache_misses,"
+        << "dcache_writebacks,cache_stall_cycles,completed,matches_functional\n";
+    for (const SweepResult& result : results) {
+        const SweepConfig& c = result.config;
+        const SimulationStats& s = result.stats;
+        out << sweepModeName(c) << "," << c.dataForwarding << "," << c.branchPrediction << ","
+            << predictorTypeToString(c.predictor.type) << "," << c.predictor.phtBits << "," << c.predictor.btbBits << ","
+            << c.predictor.historyBits << "," << c.predictor.rasEntries << "," << result.loaded << ","
+            << s.cyclesPerInstruction << "," << s.totalCycles << "," << s.instructionsExecuted << ","
+            << s.dataTransferInstructions << "," << s.aluInstructions << "," << s.controlInstructions << ","
+            << s.stallBubbles << "," << s.dataHazards << "," << s.controlHazards << "," << s.dataHazardStalls << ","
+            << s.controlHazardStalls << "," << s.pipelineFlushes << "," << s.branchPredictions << ","
+            << s.branchMispredictions << "," << s.btbHits << "," << s.btbMisses << ","
+            << s.returnPredictions << "," << s.returnMispredictions << ","
+            << c.icache.sizeBytes << "," << c.icache.ways << "," << c.dcache.sizeBytes << "," << c.dcache.ways << ","
+            << s.icacheHits << "," << s.icacheMisses << "," << s.dcacheHits << "," << s.dcacheMisses << ","
+            << s.dcacheWritebacks << "," << s.cacheStallCycles << "," << result.completed << "," << result.matchesFunctional << "\n";
+    }
+}
+
+inline void writeSweepJson(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const SweepConfig& c = results[i].config;
+        const SimulationStats& s = results[i].stats;
+        out << "  {\"mode\": \"" << sweepModeName(c) << "\", \"forwarding\": " << std::boolalpha << c.dataForwarding
+            << ", \"prediction\": " << c.branchPrediction << ", \"predictor\": \"" << predictorTypeToString(c.predictor.type)
+            << "\", \"phtBits\": " << c.predictor.phtBits << ", \"btbBits\": " << c.predictor.btbBits
+            << ", \"historyBits\": " << c.predictor.historyBits << ", \"ras\": " << c.predictor.rasEntries
+            << ", \"icacheSize\": " << c.icache.sizeBytes << ", \"icacheWays\": " << c.icache.ways
+            << ", \"dcacheSize\": " << c.dcache.sizeBytes << ", \"dcacheWays\": " << c.dcache.ways
+            << ", \"loaded\": " << results[i].loaded << ", \"completed\": " << results[i].completed
+            << ", \"matchesFunctional\": " << results[i].matchesFunctional << std::noboolalpha
+            << ", \"stats\": {\"cyclesPerInstruction\": " << s.cyclesPerInstruction << ", \"totalCycles\": " << s.totalCycles
+            << ", \"instructionsExecuted\": " << s.instructionsExecuted << ", \"dataTransferInstructions\": " << s.dataTransferInstructions
+            << ", \"aluInstructions\": " << s.aluInstructions << ", \"controlInstructions\": " << s.controlInstructions
+            << ", \"stallBubbles\": " << s.stallBubbles << ", \"dataHazards\": " << s.dataHazards
+            << ", \"controlHazards\": " << s.controlHazards << ", \"dataHazardStalls\": " << s.dataHazardStalls
+            << ", \"controlHazardStalls\": " << s.controlHazardStalls << ", \"pipelineFlushes\": " << s.pipelineFlushes
+            << ", \"branchPredictions\": " << s.branchPredictions << ", \"branchMispredictions\": " << s.branchMispredictions
+            << ", \"btbHits\": " << s.btbHits << ", \"btbMisses\": " << s.btbMisses
+            << ", \"returnPredictions\": " << s.returnPredictions << ", \"returnMispredictions\": " << s.returnMispredictions
+            << ", \"icacheHits\": " << s.icacheHits << ", \"icacheMisses\": " << s.icacheMisses
+            << ", \"dcacheHits\": " << s.dcacheHits << ", \"dcacheMisses\": " << s.dcacheMisses
+            << ", \"dcacheWritebacks\": " << s.dcacheWritebacks << ", \"cacheStallCycles\": " << s.cacheStallCycles
+            << "}}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+#endif
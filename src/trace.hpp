@@ -0,0 +1,655 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "types.hpp"
+#include "encoding.hpp"
+#include "program.hpp"
+
+using namespace riscv;
+
+// Binary pipeline trace (.rvt), little-endian:
+//   header, text words (so the trace can be disassembled on its own)
+//   blocks:  { TraceBlockHeader, payload } where the payload is recordCount 16-byte records,
+//            stored raw or compressed by the block's codec
+//   index:   blockCount x TraceIndexEntry
+//   footer
+// Every block starts with a SYNC record, so any block decodes without the ones before it; the
+// index maps first cycles to file offsets, which makes the trace seekable by cycle.
+inline constexpr uint32_t TRACE_MAGIC = 0x54525652; // "RVRT"
+inline constexpr uint32_t TRACE_VERSION = 1;
+inline constexpr uint32_t TRACE_BLOCK_RECORDS = 4096;
+inline constexpr size_t TRACE_MAX_PENDING_BLOCKS = 16;
+inline constexpr uint8_t TRACE_EMPTY_STAGE = 0xFF;
+inline constexpr uint32_t TRACE_NO_INSTRUCTION = UINT32_MAX;
+
+// Per-cycle event bits.
+inline constexpr uint8_t TRACE_RAW_STALL = 1 << 0;
+inline constexpr uint8_t TRACE_LOAD_USE_STALL = 1 << 1;
+inline constexpr uint8_t TRACE_CACHE_STALL = 1 << 2;
+inline constexpr uint8_t TRACE_FLUSH = 1 << 3;
+inline constexpr uint8_t TRACE_FORWARD_EX_EX = 1 << 4;
+inline constexpr uint8_t TRACE_FORWARD_MEM_EX = 1 << 5;
+inline constexpr uint8_t TRACE_FORWARD_MEM_MEM = 1 << 6;
+
+inline constexpr const char* TRACE_FLAG_NAMES[] = {
+    "rawStall", "loadUseStall", "cacheStall", "flush", "forwardExEx", "forwardMemEx", "forwardMemMem"
+};
+
+// NONE stores records as they are. PLANAR_RLE transposes a block into 16 byte planes (byte 0 of
+// every record, then byte 1, ...) and run-length encodes them; consecutive records differ in
+// few bytes, so the planes are long runs.
+enum class TraceCodec : uint32_t { NONE, PLANAR_RLE };
+
+// Pipeline at the end of one cycle. ids are the simulator's instruction ids,
+// TRACE_NO_INSTRUCTION for an empty stage; newestId is the last id handed out.
+struct TraceCycle {
+    uint32_t cycle;
+    uint32_t newestId;
+    std::array<uint32_t, NUM_STAGES> ids;
+    std::array<uint32_t, NUM_STAGES> pcs;
+    uint8_t flags;
+
+    TraceCycle() : cycle(0), newestId(0), ids{}, pcs{}, flags(0) { ids.fill(TRACE_NO_INSTRUCTION); }
+};
+
+enum class TraceRecordKind : uint8_t { CYCLE, SYNC, PC };
+
+// CYCLE: ages are newestId - id per stage, and the deltas are against the previous CYCLE or SYNC
+// record. pcDelta moves the FETCH PC, which is how the PC of every new instruction is recorded.
+struct TraceRecord {
+    TraceRecordKind kind;
+    uint8_t flags;
+    uint8_t ages[NUM_STAGES];
+    uint8_t idDelta;
+    uint16_t cycleDelta;
+    uint16_t reserved;
+    int32_t pcDelta;
+};
+
+// SYNC sets the base cycle, newest id and FETCH PC; PC gives the PC of an instruction that was
+// already in flight when the block started. Stored in a TraceRecord slot.
+struct TraceMarker {
+    TraceRecordKind kind;
+    uint8_t stage;
+    uint16_t reserved;
+    uint32_t cycle;
+    uint32_t id;
+    uint32_t pc;
+};
+
+static_assert(sizeof(TraceRecord) == 16 && sizeof(TraceMarker) == sizeof(TraceRecord), "trace record size");
+
+struct TraceHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t textStart;
+    uint32_t textWords;
+    uint32_t reserved[3];
+};
+
+struct TraceBlockHeader {
+    uint32_t firstCycle;
+    uint32_t recordCount;
+    uint32_t storedSize;
+    TraceCodec codec;
+};
+
+struct TraceIndexEntry {
+    uint64_t offset;
+    uint32_t firstCycle;
+    uint32_t recordCount;
+};
+
+struct TraceFooter {
+    uint64_t indexOffset;
+    uint32_t blockCount;
+    uint32_t magic;
+};
+
+namespace trace {
+    inline TraceRecord toRecord(const TraceMarker& marker) {
+        TraceRecord record;
+        std::memcpy(&record, &marker, sizeof(record));
+        return record;
+    }
+
+    inline TraceMarker toMarker(const TraceRecord& record) {
+        TraceMarker marker;
+        std::memcpy(&marker, &record, sizeof(marker));
+        return marker;
+    }
+
+    // Literal runs are a control byte 0..127 followed by control + 1 bytes; repeats are a control
+    // byte 128..255 followed by one byte repeated control - 125 times (3..130).
+    inline void compressPlanes(const std::vector<TraceRecord>& records, std::vector<uint8_t>& out) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(records.data());
+        size_t count = records.size();
+        std::vector<uint8_t> planes(count * sizeof(TraceRecord));
+        for (size_t r = 0; r < count; r++) {
+            for (size_t b = 0; b < sizeof(TraceRecord); b++) {
+                planes[b * count + r] = bytes[r * sizeof(TraceRecord) + b];
+            }
+        }
+        out.clear();
+        size_t i = 0;
+        size_t literal = 0;
+        auto flushLiteral = [&](size_t end) {
+            while (literal < end) {
+                size_t length = std::min<size_t>(end - literal, 128);
+                out.push_back(static_cast<uint8_t>(length - 1));
+                out.insert(out.end(), planes.begin() + literal, planes.begin() + literal + length);
+                literal += length;
+            }
+        };
+        while (i < planes.size()) {
+            size_t run = 1;
+            while (i + run < planes.size() && run < 130 && planes[i + run] == planes[i]) run++;
+            if (run >= 3) {
+                flushLiteral(i);
+                out.push_back(static_cast<uint8_t>(run + 125));
+                out.push_back(planes[i]);
+                i += run;
+                literal = i;
+            } else {
+                i += run;
+            }
+        }
+        flushLiteral(planes.size());
+    }
+
+    inline void decompressPlanes(const std::vector<uint8_t>& in, size_t count, std::vector<TraceRecord>& records) {
+        std::vector<uint8_t> planes;
+        planes.reserve(count * sizeof(TraceRecord));
+        for (size_t i = 0; i < in.size();) {
+            uint8_t control = in[i++];
+            if (control < 128) {
+                size_t length = control + 1u;
+                if (i + length > in.size()) break;
+                planes.insert(planes.end(), in.begin() + i, in.begin() + i + length);
+                i += length;
+            } else {
+                if (i >= in.size()) break;
+                planes.insert(planes.end(), control - 125u, in[i++]);
+            }
+        }
+        if (planes.size() != count * sizeof(TraceRecord)) {
+            throw std::runtime_error(std::string(RED) + "Corrupt trace block" + RESET);
+        }
+        records.resize(count);
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(records.data());
+        for (size_t r = 0; r < count; r++) {
+            for (size_t b = 0; b < sizeof(TraceRecord); b++) {
+                bytes[r * sizeof(TraceRecord) + b] = planes[b * count + r];
+            }
+        }
+    }
+}
+
+// Streams TraceCycles into a .rvt file. record() only delta-encodes into the current block; full
+// blocks go to a background thread that compresses and writes them. At most
+// TRACE_MAX_PENDING_BLOCKS blocks wait for it, after which record() blocks, so a slow disk bounds
+// memory rather than the trace growing in RAM.
+class TraceWriter {
+public:
+    TraceWriter(const std::string& filename, const ProgramImage& program, TraceCodec codec = TraceCodec::PLANAR_RLE);
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+    ~TraceWriter();
+
+    inline void record(const TraceCycle& cycle);
+    // Writes the last block, the index and the footer. Throws if any write failed.
+    void close();
+
+    inline uint64_t getCycleCount() const { return cycles; }
+
+private:
+    std::ofstream file;
+    TraceCodec codec;
+    std::vector<TraceRecord> block;
+    uint32_t blockFirstCycle;
+    bool synced;
+    uint32_t baseCycle;
+    uint32_t baseId;
+    uint32_t baseFetchPc;
+    uint64_t cycles;
+    bool closed;
+
+    std::mutex mutex;
+    std::condition_variable queued;
+    std::condition_variable drained;
+    std::deque<std::pair<uint32_t, std::vector<TraceRecord>>> pending;
+    std::vector<std::vector<TraceRecord>> spare;
+    bool closing;
+    bool failed;
+    std::thread worker;
+
+    uint64_t offset;
+    std::vector<TraceIndexEntry> index;
+
+    inline void sync(const TraceCycle& cycle);
+    void submitBlock();
+    void writeBlocks();
+};
+
+inline TraceWriter::TraceWriter(const std::string& filename, const ProgramImage& program, TraceCodec codec)
+    : file(filename, std::ios::binary), codec(codec), blockFirstCycle(0), synced(false), baseCycle(0), baseId(0),
+      baseFetchPc(0), cycles(0), closed(false), closing(false), failed(false), offset(0) {
+    if (!file.is_open()) {
+        throw std::runtime_error(std::string(RED) + "Could not open trace file for writing: " + filename + RESET);
+    }
+    TraceHeader header{};
+    header.magic = TRACE_MAGIC;
+    header.version = TRACE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.textStart = TEXT_SEGMENT_START;
+    header.textWords = static_cast<uint32_t>(program.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(program.getText().data()), static_cast<std::streamsize>(program.size() * sizeof(uint32_t)));
+    offset = sizeof(header) + program.size() * sizeof(uint32_t);
+    block.reserve(TRACE_BLOCK_RECORDS + NUM_STAGES + 2);
+    worker = std::thread(&TraceWriter::writeBlocks, this);
+}
+
+inline TraceWriter::~TraceWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+    }
+}
+
+inline void TraceWriter::sync(const TraceCycle& cycle) {
+    TraceMarker marker{};
+    marker.kind = TraceRecordKind::SYNC;
+    marker.cycle = cycle.cycle;
+    marker.id = cycle.newestId;
+    marker.pc = cycle.ids[static_cast<size_t>(Stage::FETCH)] != TRACE_NO_INSTRUCTION ? cycle.pcs[static_cast<size_t>(Stage::FETCH)] : baseFetchPc;
+    block.push_back(trace::toRecord(marker));
+    for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+        if (cycle.ids[stage] == TRACE_NO_INSTRUCTION) continue;
+        TraceMarker pc{};
+        pc.kind = TraceRecordKind::PC;
+        pc.stage = static_cast<uint8_t>(stage);
+        pc.id = cycle.ids[stage];
+        pc.pc = cycle.pcs[stage];
+        block.push_back(trace::toRecord(pc));
+    }
+    baseCycle = marker.cycle;
+    baseId = marker.id;
+    baseFetchPc = marker.pc;
+    synced = true;
+}
+
+inline void TraceWriter::record(const TraceCycle& cycle) {
+    if (block.size() >= TRACE_BLOCK_RECORDS) submitBlock();
+    if (block.empty()) {
+        blockFirstCycle = cycle.cycle;
+        synced = false;
+    }
+    if (!synced || cycle.cycle < baseCycle || cycle.cycle - baseCycle > UINT16_MAX ||
+        cycle.newestId < baseId || cycle.newestId - baseId > UINT8_MAX) {
+        sync(cycle);
+    }
+
+    TraceRecord record{};
+    record.kind = TraceRecordKind::CYCLE;
+    record.flags = cycle.flags;
+    record.idDelta = static_cast<uint8_t>(cycle.newestId - baseId);
+    record.cycleDelta = static_cast<uint16_t>(cycle.cycle - baseCycle);
+    for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+        uint32_t age = cycle.newestId - cycle.ids[stage];
+        record.ages[stage] = cycle.ids[stage] == TRACE_NO_INSTRUCTION || age >= TRACE_EMPTY_STAGE ? TRACE_EMPTY_STAGE : static_cast<uint8_t>(age);
+    }
+    if (cycle.ids[static_cast<size_t>(Stage::FETCH)] != TRACE_NO_INSTRUCTION) {
+        uint32_t fetchPc = cycle.pcs[static_cast<size_t>(Stage::FETCH)];
+        record.pcDelta = static_cast<int32_t>(fetchPc - baseFetchPc);
+        baseFetchPc = fetchPc;
+    }
+    block.push_back(record);
+    baseCycle = cycle.cycle;
+    baseId = cycle.newestId;
+    cycles++;
+}
+
+inline void TraceWriter::submitBlock() {
+    if (block.empty()) return;
+    std::vector<TraceRecord> next;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this]() { return pending.size() < TRACE_MAX_PENDING_BLOCKS; });
+        pending.emplace_back(blockFirstCycle, std::move(block));
+        if (!spare.empty()) {
+            next = std::move(spare.back());
+            spare.pop_back();
+        }
+    }
+    queued.notify_one();
+    next.clear();
+    next.reserve(TRACE_BLOCK_RECORDS + NUM_STAGES + 2);
+    block = std::move(next);
+}
+
+inline void TraceWriter::writeBlocks() {
+    std::vector<uint8_t> compressed;
+    while (true) {
+        std::pair<uint32_t, std::vector<TraceRecord>> item;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queued.wait(lock, [this]() { return closing || !pending.empty(); });
+            if (pending.empty()) return;
+            item = std::move(pending.front());
+            pending.pop_front();
+        }
+        drained.notify_one();
+
+        const std::vector<TraceRecord>& records = item.second;
+        TraceBlockHeader header{};
+        header.firstCycle = item.first;
+        header.recordCount = static_cast<uint32_t>(records.size());
+        header.codec = TraceCodec::NONE;
+        const char* payload = reinterpret_cast<const char*>(records.data());
+        size_t size = records.size() * sizeof(TraceRecord);
+        if (codec == TraceCodec::PLANAR_RLE) {
+            trace::compressPlanes(records, compressed);
+            if (compressed.size() < size) {
+                header.codec = TraceCodec::PLANAR_RLE;
+                payload = reinterpret_cast<const char*>(compressed.data());
+                size = compressed.size();
+            }
+        }
+        header.storedSize = static_cast<uint32_t>(size);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(payload, static_cast<std::streamsize>(size));
+        index.push_back({offset, header.firstCycle, header.recordCount});
+        offset += sizeof(header) + size;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file) failed = true;
+        item.second.clear();
+        spare.push_back(std::move(item.second));
+    }
+}
+
+inline void TraceWriter::close() {
+    if (closed) return;
+    closed = true;
+    submitBlock();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    queued.notify_one();
+    worker.join();
+
+    TraceFooter footer{};
+    footer.indexOffset = offset;
+    footer.blockCount = static_cast<uint32_t>(index.size());
+    footer.magic = TRACE_MAGIC;
+    file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(TraceIndexEntry)));
+    file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    file.close();
+    if (failed || !file) {
+        throw std::runtime_error(std::string(RED) + "Failed writing trace file" + RESET);
+    }
+}
+
+// Random access to a .rvt file through its index; blocks are read and decoded on demand.
+class TraceReader {
+public:
+    explicit TraceReader(const std::string& filename);
+
+    inline const std::vector<uint32_t>& getText() const { return text; }
+    inline size_t blockCount() const { return index.size(); }
+    inline const TraceIndexEntry& block(size_t i) const { return index[i]; }
+
+    // Block holding cycle, or the first block after it when cycle falls in a gap.
+    size_t findBlock(uint32_t cycle) const;
+    std::vector<TraceCycle> readBlock(size_t i);
+    // Visits every cycle from fromCycle on, in order.
+    template <typename Visit>
+    void forEachCycle(Visit&& visit, uint32_t fromCycle = 0);
+    // Disassembly of the instruction at pc from the embedded text, or "" outside it.
+    std::string instructionText(uint32_t pc) const;
+
+private:
+    std::ifstream file;
+    TraceHeader header;
+    std::vector<uint32_t> text;
+    std::vector<TraceIndexEntry> index;
+    std::vector<uint8_t> payload;
+    std::vector<TraceRecord> records;
+};
+
+inline TraceReader::TraceReader(const std::string& filename) : file(filename, std::ios::binary), header{} {
+    if (!file.is_open()) {
+        throw std::runtime_error(std::string(RED) + "Could not open trace file: " + filename + RESET);
+    }
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != TRACE_MAGIC || header.version != TRACE_VERSION || header.recordSize != sizeof(TraceRecord)) {
+        throw std::runtime_error(std::string(RED) + "Not a trace file: " + filename + RESET);
+    }
+    text.resize(header.textWords);
+    file.read(reinterpret_cast<char*>(text.data()), static_cast<std::streamsize>(text.size() * sizeof(uint32_t)));
+
+    TraceFooter footer{};
+    file.seekg(-static_cast<std::streamoff>(sizeof(footer)), std::ios::end);
+    file.read(reinterpret_cast<char*>(&footer), sizeof(footer));
+    if (!file || footer.magic != TRACE_MAGIC) {
+        throw std::runtime_error(std::string(RED) + "Trace file is truncated (no index): " + filename + RESET);
+    }
+    index.resize(footer.blockCount);
+    file.seekg(static_cast<std::streamoff>(footer.indexOffset));
+    file.read(reinterpret_cast<char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(TraceIndexEntry)));
+    if (!file) {
+        throw std::runtime_error(std::string(RED) + "Trace file is truncated (no index): " + filename + RESET);
+    }
+}
+
+inline size_t TraceReader::findBlock(uint32_t cycle) const {
+    auto after = std::upper_bound(index.begin(), index.end(), cycle,
+                                  [](uint32_t target, const TraceIndexEntry& entry) { return target < entry.firstCycle; });
+    return after == index.begin() ? 0 : static_cast<size_t>(after - index.begin()) - 1;
+}
+
+inline std::vector<TraceCycle> TraceReader::readBlock(size_t i) {
+    TraceBlockHeader blockHeader{};
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(index.at(i).offset));
+    file.read(reinterpret_cast<char*>(&blockHeader), sizeof(blockHeader));
+    payload.resize(blockHeader.storedSize);
+    file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    if (!file) {
+        throw std::runtime_error(std::string(RED) + "Corrupt trace block" + RESET);
+    }
+    if (blockHeader.codec == TraceCodec::PLANAR_RLE) {
+        trace::decompressPlanes(payload, blockHeader.recordCount, records);
+    } else if (blockHeader.codec == TraceCodec::NONE && payload.size() == blockHeader.recordCount * sizeof(TraceRecord)) {
+        records.resize(blockHeader.recordCount);
+        std::memcpy(records.data(), payload.data(), payload.size());
+    } else {
+        throw std::runtime_error(std::string(RED) + "Corrupt trace block" + RESET);
+    }
+
+    std::vector<TraceCycle> cycles;
+    cycles.reserve(records.size());
+    TraceCycle previous;
+    uint32_t baseCycle = 0;
+    uint32_t baseId = 0;
+    uint32_t baseFetchPc = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> inFlight;
+    for (const TraceRecord& record : records) {
+        if (record.kind == TraceRecordKind::SYNC) {
+            TraceMarker marker = trace::toMarker(record);
+            baseCycle = marker.cycle;
+            baseId = marker.id;
+            baseFetchPc = marker.pc;
+            inFlight.clear();
+            continue;
+        }
+        if (record.kind == TraceRecordKind::PC) {
+            TraceMarker marker = trace::toMarker(record);
+            inFlight.emplace_back(marker.id, marker.pc);
+            continue;
+        }
+        TraceCycle cycle;
+        cycle.cycle = baseCycle + record.cycleDelta;
+        cycle.newestId = baseId + record.idDelta;
+        cycle.flags = record.flags;
+        baseFetchPc += static_cast<uint32_t>(record.pcDelta);
+        for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+            if (record.ages[stage] == TRACE_EMPTY_STAGE) continue;
+            uint32_t id = cycle.newestId - record.ages[stage];
+            cycle.ids[stage] = id;
+            if (stage == static_cast<size_t>(Stage::FETCH)) {
+                cycle.pcs[stage] = baseFetchPc;
+                continue;
+            }
+            for (size_t from = 0; from < NUM_STAGES; from++) {
+                if (previous.ids[from] == id) cycle.pcs[stage] = previous.pcs[from];
+            }
+            for (const auto& [knownId, pc] : inFlight) {
+                if (knownId == id) cycle.pcs[stage] = pc;
+            }
+        }
+        inFlight.clear();
+        baseCycle = cycle.cycle;
+        baseId = cycle.newestId;
+        cycles.push_back(cycle);
+        previous = cycle;
+    }
+    return cycles;
+}
+
+template <typename Visit>
+inline void TraceReader::forEachCycle(Visit&& visit, uint32_t fromCycle) {
+    for (size_t i = index.empty() ? 0 : findBlock(fromCycle); i < index.size(); i++) {
+        for (const TraceCycle& cycle : readBlock(i)) {
+            if (cycle.cycle >= fromCycle) visit(cycle);
+        }
+    }
+}
+
+inline std::string TraceReader::instructionText(uint32_t pc) const {
+    size_t i = (pc - header.textStart) / INSTRUCTION_SIZE;
+    if (pc < header.textStart || i >= text.size() || decodeInstructionName(text[i]) == Instructions::INVALID) return "";
+    return disassembleInstruction(text[i]);
+}
+
+inline std::string traceFlagsToString(uint8_t flags, const char* separator) {
+    std::string names;
+    for (size_t bit = 0; bit < std::size(TRACE_FLAG_NAMES); bit++) {
+        if ((flags >> bit) & 1) names += (names.empty() ? "" : separator) + std::string(TRACE_FLAG_NAMES[bit]);
+    }
+    return names;
+}
+
+// Konata (https://github.com/shioyadan/Konata) log: one lane, stages F/D/X/M/W. Instructions
+// leaving from WRITEBACK retire, any other exit is a flush. A cycle's events are attached as
+// notes to the instruction they concern.
+inline void writeKonata(std::ostream& out, TraceReader& reader) {
+    static constexpr const char* STAGE_NAMES[NUM_STAGES] = {"F", "D", "X", "M", "W"};
+    struct Live {
+        uint32_t id;
+        uint32_t fileId;
+        size_t stage;
+    };
+    std::vector<Live> live;
+    uint64_t nextFileId = 0;
+    uint64_t retired = 0;
+    bool first = true;
+    uint32_t lastCycle = 0;
+
+    out << "Kanata\t0004\n";
+    reader.forEachCycle([&](const TraceCycle& cycle) {
+        if (first) {
+            out << "C=\t" << cycle.cycle << "\n";
+            first = false;
+        } else {
+            out << "C\t" << (cycle.cycle - lastCycle) << "\n";
+        }
+        lastCycle = cycle.cycle;
+
+        std::vector<Live> next;
+        for (const Live& entry : live) {
+            if (std::find(cycle.ids.begin(), cycle.ids.end(), entry.id) != cycle.ids.end()) {
+                next.push_back(entry);
+                continue;
+            }
+            bool retires = entry.stage == static_cast<size_t>(Stage::WRITEBACK);
+            out << "E\t" << entry.fileId << "\t0\t" << STAGE_NAMES[entry.stage] << "\n";
+            out << "R\t" << entry.fileId << "\t" << (retires ? retired++ : entry.fileId) << "\t" << (retires ? 0 : 1) << "\n";
+        }
+        for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+            uint32_t id = cycle.ids[stage];
+            if (id == TRACE_NO_INSTRUCTION) continue;
+            auto it = std::find_if(next.begin(), next.end(), [id](const Live& entry) { return entry.id == id; });
+            if (it == next.end()) {
+                Live entry{id, static_cast<uint32_t>(nextFileId++), stage};
+                out << "I\t" << entry.fileId << "\t" << id << "\t0\n";
+                out << "L\t" << entry.fileId << "\t0\t" << std::hex << std::setw(8) << std::setfill('0') << cycle.pcs[stage]
+                    << std::dec << std::setfill(' ') << ": " << reader.instructionText(cycle.pcs[stage]) << "\n";
+                out << "S\t" << entry.fileId << "\t0\t" << STAGE_NAMES[stage] << "\n";
+                next.push_back(entry);
+            } else if (it->stage != stage) {
+                out << "E\t" << it->fileId << "\t0\t" << STAGE_NAMES[it->stage] << "\n";
+                out << "S\t" << it->fileId << "\t0\t" << STAGE_NAMES[stage] << "\n";
+                it->stage = stage;
+            }
+        }
+        live = std::move(next);
+
+        // Stalls are noted on the waiting instruction; forwards and flushes on the instruction that
+        // executed this cycle and has just moved on.
+        static constexpr Stage FLAG_STAGES[] = {Stage::DECODE, Stage::EXECUTE, Stage::MEMORY, Stage::MEMORY,
+                                                Stage::MEMORY, Stage::MEMORY, Stage::WRITEBACK};
+        for (size_t bit = 0; bit < std::size(FLAG_STAGES); bit++) {
+            if (!((cycle.flags >> bit) & 1)) continue;
+            size_t stage = static_cast<size_t>(FLAG_STAGES[bit]);
+            if ((1u << bit) == TRACE_CACHE_STALL && cycle.ids[stage] == TRACE_NO_INSTRUCTION) stage = static_cast<size_t>(Stage::FETCH);
+            for (const Live& entry : live) {
+                if (entry.id == cycle.ids[stage]) {
+                    out << "L\t" << entry.fileId << "\t1\tcycle " << cycle.cycle << ": " << TRACE_FLAG_NAMES[bit] << "\\n\n";
+                }
+            }
+        }
+    });
+}
+
+// One object per cycle, in the profile JSON style.
+inline void writeTraceJson(std::ostream& out, TraceReader& reader) {
+    out << "[\n";
+    bool first = true;
+    reader.forEachCycle([&](const TraceCycle& cycle) {
+        out << (first ? "" : ",\n") << "  {\"cycle\": " << cycle.cycle << ", \"stages\": {";
+        for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+            out << (stage == 0 ? "" : ", ") << "\"" << stageToString(static_cast<Stage>(stage)) << "\": ";
+            if (cycle.ids[stage] == TRACE_NO_INSTRUCTION) {
+                out << "null";
+            } else {
+                out << "{\"id\": " << cycle.ids[stage] << ", \"pc\": " << cycle.pcs[stage]
+                    << ", \"instruction\": \"" << reader.instructionText(cycle.pcs[stage]) << "\"}";
+            }
+        }
+        std::string flags = traceFlagsToString(cycle.flags, "\", \"");
+        out << "}, \"events\": [" << (flags.empty() ? "" : "\"" + flags + "\"") << "]}";
+        first = false;
+    });
+    out << (first ? "" : "\n") << "]\n";
+}
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef TRANSLATE_HPP
+#define TRANSLATE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "types.hpp"
+#include "memory.hpp"
+#include "execution.hpp"
+
+using namespace riscv;
+
+struct TranslatedOp;
+
+struct TranslationContext {
+    uint32_t* registers;
+    Memory& memory;
+    const TranslatedOp* ops;
+    uint32_t opCount;
+    uint32_t nextPC;
+};
+
+// One instruction of the text segment, translated to a handler specialised for its operation and
+// operands. A basic block runs from any instruction up to and including the next branch or jump
+// (or the end of the text): the instructions before the terminator only have `run`, the
+// terminator only has `exit`, which executes it and returns the op to continue at, or nullptr
+// when the target lies outside the text. Direct branches and jal carry their target op, so a
+// taken branch chains straight into the next block without a PC lookup.
+//
+// Entering a block part way through is the same as entering a shorter block, so blockLength and
+// the instruction-mix counts are stored as suffixes: from this op to the end of its block.
+struct TranslatedOp {
+    void (*run)(const TranslatedOp&, TranslationContext&);
+    const TranslatedOp* (*exit)(const TranslatedOp&, TranslationContext&);
+    const TranslatedOp* taken;
+    const TranslatedOp* next;
+    uint32_t pc;
+    uint32_t instruction;
+    int32_t immediate;
+    uint8_t rd, rs1, rs2;
+    uint32_t blockLength;
+    uint32_t aluInstructions;
+    uint32_t dataTransferInstructions;
+    uint32_t controlInstructions;
+};
+
+namespace translate {
+    inline uint32_t add(uint32_t a, uint32_t b) { return a + b; }
+    inline uint32_t sub(uint32_t a, uint32_t b) { return a - b; }
+    inline uint32_t mul(uint32_t a, uint32_t b) { return a * b; }
+    inline uint32_t bitAnd(uint32_t a, uint32_t b) { return a & b; }
+    inline uint32_t bitOr(uint32_t a, uint32_t b) { return a | b; }
+    inline uint32_t bitXor(uint32_t a, uint32_t b) { return a ^ b; }
+    inline uint32_t sll(uint32_t a, uint32_t b) { return a << (b & 0x1F); }
+    inline uint32_t srl(uint32_t a, uint32_t b) { return a >> (b & 0x1F); }
+    inline uint32_t sra(uint32_t a, uint32_t b) { return static_cast<uint32_t>(static_cast<int32_t>(a) >> (b & 0x1F)); }
+    inline uint32_t slt(uint32_t a, uint32_t b) { return (static_cast<int32_t>(a) < static_cast<int32_t>(b)) ? 1 : 0; }
+
+    inline bool equal(uint32_t a, uint32_t b) { return a == b; }
+    inline bool notEqual(uint32_t a, uint32_t b) { return a != b; }
+    inline bool lessThan(uint32_t a, uint32_t b) { return static_cast<int32_t>(a) < static_cast<int32_t>(b); }
+    inline bool greaterEqual(uint32_t a, uint32_t b) { return static_cast<int32_t>(a) >= static_cast<int32_t>(b); }
+
+    inline void nop(const TranslatedOp&, TranslationContext&) {}
+
+    template <uint32_t (*Operation)(uint32_t, uint32_t)>
+    inline void registerOp(const TranslatedOp& op, TranslationContext& ctx) {
+        ctx.registers[op.rd] = Operation(ctx.registers[op.rs1], ctx.registers[op.rs2]);
+    }
+
+    template <uint32_t (*Operation)(uint32_t, uint32_t)>
+    inline void immediateOp(const TranslatedOp& op, TranslationContext& ctx) {
+        ctx.registers[op.rd] = Operation(ctx.registers[op.rs1], static_cast<uint32_t>(op.immediate));
+    }
+
+    inline void lui(const TranslatedOp& op, TranslationContext& ctx) {
+        ctx.registers[op.rd] = static_cast<uint32_t>(op.immediate);
+    }
+
+    inline void auipc(const TranslatedOp& op, TranslationContext& ctx) {
+        ctx.registers[op.rd] = op.pc + static_cast<uint32_t>(op.immediate);
+    }
+
+    // Division keeps the interpreter's operand choice: rs2 for R-type words, the immediate otherwise.
+    template <bool Remainder, bool RegisterForm>
+    inline void divide(const TranslatedOp& op, TranslationContext& ctx) {
+        uint32_t a = ctx.registers[op.rs1];
+        uint32_t b = RegisterForm ? ctx.registers[op.rs2] : static_cast<uint32_t>(op.immediate);
+        if (b == 0) {
+            std::stringstream ss;
+            ss << (Remainder ? "Remainder" : "Division") << " by zero at PC 0x" << std::hex << op.pc << "\n";
+            throw std::runtime_error(std::string(RED) + ss.str() + RESET);
+        }
+        uint32_t result = Remainder ? static_cast<uint32_t>(static_cast<int32_t>(a) % static_cast<int32_t>(b))
+                                    : static_cast<uint32_t>(static_cast<int32_t>(a) / static_cast<int32_t>(b));
+        if (op.rd != 0) ctx.registers[op.rd] = result;
+    }
+
+    template <uint32_t Size, bool Signed>
+    inline void load(const TranslatedOp& op, TranslationContext& ctx) {
+        uint32_t value = loadData(ctx.memory, ctx.registers[op.rs1] + static_cast<uint32_t>(op.immediate), Size);
+        if (Signed && Size == 1) value = static_cast<uint32_t>(static_cast<int8_t>(value));
+        if (Signed && Size == 2) value = static_cast<uint32_t>(static_cast<int16_t>(value));
+        if (op.rd != 0) ctx.registers[op.rd] = value;
+    }
+
+    template <uint32_t Size>
+    inline void store(const TranslatedOp& op, TranslationContext& ctx) {
+        storeData(ctx.memory, ctx.registers[op.rs1] + static_cast<uint32_t>(op.immediate), ctx.registers[op.rs2], Size);
+    }
+
+    inline void clear(const TranslatedOp& op, TranslationContext& ctx) {
+        ctx.registers[op.rd] = 0;
+    }
+
+    inline void invalid(const TranslatedOp& op, TranslationContext&) {
+        classifyInstructions(op.instruction);
+    }
+
+    // Same bounds rule as the interpreter: anything outside the text, or misaligned, ends the run.
+    inline const TranslatedOp* lookup(const TranslationContext& ctx, uint32_t pc) {
+        uint32_t offset = pc - TEXT_SEGMENT_START;
+        if (pc < TEXT_SEGMENT_START || (offset % INSTRUCTION_SIZE) != 0 || offset / INSTRUCTION_SIZE >= ctx.opCount) {
+            return nullptr;
+        }
+        return ctx.ops + offset / INSTRUCTION_SIZE;
+    }
+
+    template <bool (*Condition)(uint32_t, uint32_t)>
+    inline const TranslatedOp* branch(const TranslatedOp& op, TranslationContext& ctx) {
+        if (Condition(ctx.registers[op.rs1], ctx.registers[op.rs2])) {
+            ctx.nextPC = op.pc + static_cast<uint32_t>(op.immediate);
+            return op.taken;
+        }
+        ctx.nextPC = op.pc + INSTRUCTION_SIZE;
+        return op.next;
+    }
+
+    inline const TranslatedOp* jal(const TranslatedOp& op, TranslationContext& ctx) {
+        if (op.rd != 0) ctx.registers[op.rd] = op.pc + INSTRUCTION_SIZE;
+        ctx.nextPC = op.pc + static_cast<uint32_t>(op.immediate);
+        return op.taken;
+    }
+
+    inline const TranslatedOp* jalr(const TranslatedOp& op, TranslationContext& ctx) {
+        uint32_t target = (ctx.registers[op.rs1] + static_cast<uint32_t>(op.immediate)) & ~1u;
+        if (op.rd != 0) ctx.registers[op.rd] = op.pc + INSTRUCTION_SIZE;
+        ctx.nextPC = target;
+        return lookup(ctx, target);
+    }
+
+    // Ends a block that reaches the end of the text without a branch.
+    inline const TranslatedOp* fallThrough(const TranslatedOp& op, TranslationContext& ctx) {
+        op.run(op, ctx);
+        ctx.nextPC = op.pc + INSTRUCTION_SIZE;
+        return op.next;
+    }
+}
+
+// Translation of a whole text segment, built once per program image. The text segment is not
+// part of data memory and stores below DATA_SEGMENT_START fault, so a translation never goes
+// stale and needs no invalidation.
+class TranslatedText {
+public:
+    TranslatedText() = default;
+    TranslatedText(const TranslatedText&) = delete;
+    TranslatedText& operator=(const TranslatedText&) = delete;
+
+    inline void build(const std::vector<DecodedInstruction>& decodedText);
+    inline size_t size() const { return ops.size(); }
+    inline const TranslatedOp* data() const { return ops.data(); }
+
+private:
+    std::vector<TranslatedOp> ops;
+
+    static inline void translate(const DecodedInstruction& inst, TranslatedOp& op);
+};
+
+inline void TranslatedText::translate(const DecodedInstruction& inst, TranslatedOp& op) {
+    using namespace translate;
+    bool registerForm = inst.instructionType == InstructionType::R;
+    auto alu = [&](void (*registerHandler)(const TranslatedOp&, TranslationContext&),
+                   void (*immediateHandler)(const TranslatedOp&, TranslationContext&)) {
+        op.run = op.rd == 0 ? &nop : registerForm ? registerHandler : immediateHandler;
+        op.aluInstructions = 1;
+    };
+
+    if (!inst.isValid) {
+        op.run = &invalid;
+        return;
+    }
+    switch (inst.instructionName) {
+        case Instructions::ADD:
+        case Instructions::ADDI: alu(&registerOp<add>, &immediateOp<add>); break;
+        case Instructions::SUB: alu(&registerOp<sub>, &immediateOp<sub>); break;
+        case Instructions::MUL: alu(&registerOp<mul>, &immediateOp<mul>); break;
+        case Instructions::AND:
+        case Instructions::ANDI: alu(&registerOp<bitAnd>, &immediateOp<bitAnd>); break;
+        case Instructions::OR:
+        case Instructions::ORI: alu(&registerOp<bitOr>, &immediateOp<bitOr>); break;
+        case Instructions::XOR: alu(&registerOp<bitXor>, &immediateOp<bitXor>); break;
+        case Instructions::SLL: alu(&registerOp<sll>, &immediateOp<sll>); break;
+        case Instructions::SRL: alu(&registerOp<srl>, &immediateOp<srl>); break;
+        case Instructions::SRA: alu(&registerOp<sra>, &immediateOp<sra>); break;
+        case Instructions::SLT: alu(&registerOp<slt>, &immediateOp<slt>); break;
+        case Instructions::LUI: alu(&lui, &lui); break;
+        case Instructions::AUIPC: alu(&auipc, &auipc); break;
+        case Instructions::DIV:
+        case Instructions::REM:
+            // Division faults on zero even when the result is discarded, so rd == 0 is kept.
+            if (inst.instructionName == Instructions::DIV) {
+                op.run = registerForm ? &divide<false, true> : &divide<false, false>;
+            } else {
+                op.run = registerForm ? &divide<true, true> : &divide<true, false>;
+            }
+            op.aluInstructions = 1;
+            break;
+        case Instructions::LB: op.run = &load<1, true>; op.dataTransferInstructions = 1; break;
+        case Instructions::LH: op.run = &load<2, true>; op.dataTransferInstructions = 1; break;
+        case Instructions::LW: op.run = &load<4, false>; op.dataTransferInstructions = 1; break;
+        case Instructions::SB: op.run = &store<1>; op.dataTransferInstructions = 1; break;
+        case Instructions::SH: op.run = &store<2>; op.dataTransferInstructions = 1; break;
+        case Instructions::SW: op.run = &store<4>; op.dataTransferInstructions = 1; break;
+        case Instructions::BEQ: op.exit = &branch<equal>; op.controlInstructions = 1; break;
+        case Instructions::BNE: op.exit = &branch<notEqual>; op.controlInstructions = 1; break;
+        case Instructions::BLT: op.exit = &branch<lessThan>; op.controlInstructions = 1; break;
+        case Instructions::BGE: op.exit = &branch<greaterEqual>; op.controlInstructions = 1; break;
+        case Instructions::JAL: op.exit = &jal; op.controlInstructions = 1; break;
+        case Instructions::JALR: op.exit = &jalr; op.controlInstructions = 1; break;
+        default:
+            // The interpreter writes 0 to rd for encodings it has no case for.
+            op.run = op.rd == 0 ? &nop : &clear;
+            break;
+    }
+}
+
+inline void TranslatedText::build(const std::vector<DecodedInstruction>& decodedText) {
+    ops.assign(decodedText.size(), TranslatedOp());
+    for (size_t i = 0; i < ops.size(); i++) {
+        const DecodedInstruction& inst = decodedText[i];
+        TranslatedOp& op = ops[i];
+        op = TranslatedOp{nullptr, nullptr, nullptr, nullptr, TEXT_SEGMENT_START + static_cast<uint32_t>(i) * INSTRUCTION_SIZE,
+                          inst.instruction, inst.immediate, inst.rd, inst.rs1, inst.rs2, 0, 0, 0, 0};
+        translate(inst, op);
+        op.next = i + 1 < ops.size() ? &ops[i + 1] : nullptr;
+        if (op.exit != nullptr && op.exit != &translate::jalr) {
+            uint32_t target = op.pc + static_cast<uint32_t>(op.immediate);
+            uint32_t offset = target - TEXT_SEGMENT_START;
+            bool inside = target >= TEXT_SEGMENT_START && offset % INSTRUCTION_SIZE == 0 && offset / INSTRUCTION_SIZE < ops.size();
+            op.taken = inside ? &ops[offset / INSTRUCTION_SIZE] : nullptr;
+        }
+    }
+    for (size_t i = ops.size(); i-- > 0;) {
+        TranslatedOp& op = ops[i];
+        if (op.exit == nullptr && i + 1 == ops.size()) op.exit = &translate::fallThrough;
+        if (op.exit != nullptr) {
+            op.blockLength = 1;
+            continue;
+        }
+        const TranslatedOp& next = ops[i + 1];
+        op.blockLength = next.blockLength + 1;
+        op.aluInstructions += next.aluInstructions;
+        op.dataTransferInstructions += next.dataTransferInstructions;
+        op.controlInstructions += next.controlInstructions;
+    }
+}
+
+// Functional execution over a translated text: same results and instruction mix as runFunctional
+// without a profiler. Whole blocks run without per-instruction bounds checks or PC updates, and
+// the mix is added once per block. A fault inside a block leaves PC, registers and the counts of
+// the instructions before it exactly as the interpreter would.
+inline uint32_t runTranslated(const TranslatedText& text, uint32_t* registers, uint32_t& PC, Memory& memory,
+                              SimulationStats& stats, uint32_t maxInstructions, bool& running) {
+    TranslationContext ctx{registers, memory, text.data(), static_cast<uint32_t>(text.size()), PC};
+    uint32_t executed = 0;
+    if (!running) return 0;
+
+    const TranslatedOp* op = translate::lookup(ctx, PC);
+    while (executed < maxInstructions) {
+        if (op == nullptr) {
+            running = false;
+            break;
+        }
+        const TranslatedOp* entry = op;
+        uint32_t count = std::min(entry->blockLength, maxInstructions - executed);
+        bool completes = count == entry->blockLength;
+        const TranslatedOp* stop = entry + (completes ? count - 1 : count);
+        try {
+            for (; op != stop; op++) op->run(*op, ctx);
+        } catch (...) {
+            stats.aluInstructions += entry->aluInstructions - op->aluInstructions;
+            stats.dataTransferInstructions += entry->dataTransferInstructions - op->dataTransferInstructions;
+            stats.controlInstructions += entry->controlInstructions - op->controlInstructions;
+            PC = op->pc;
+            throw;
+        }
+        const TranslatedOp* after = stop;
+        if (completes) {
+            try {
+                op = stop->exit(*stop, ctx);
+            } catch (...) {
+                stats.aluInstructions += entry->aluInstructions - stop->aluInstructions;
+                stats.dataTransferInstructions += entry->dataTransferInstructions - stop->dataTransferInstructions;
+                stats.controlInstructions += entry->controlInstructions - stop->controlInstructions;
+                PC = stop->pc;
+                throw;
+            }
+            after = nullptr;
+            PC = ctx.nextPC;
+        } else {
+            PC = stop->pc;
+        }
+        stats.aluInstructions += entry->aluInstructions - (after != nullptr ? after->aluInstructions : 0);
+        stats.dataTransferInstructions += entry->dataTransferInstructions - (after != nullptr ? after->dataTransferInstructions : 0);
+        stats.controlInstructions += entry->controlInstructions - (after != nullptr ? after->controlInstructions : 0);
+        executed += count;
+    }
+    return executed;
+}
+
+#endif
@@ -7,6 +7,10 @@
 #include <algorithm>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <array>
+#include <iterator>
 #include <vector>
 #include <iostream>
 
@@ -25,6 +29,7 @@ namespace riscv {
 
     inline constexpr int NUM_REGISTERS = 32;
     inline constexpr int MAX_STEPS = 100000;
+    inline constexpr uint32_t MAX_FUNCTIONAL_STEPS = 1000000000;
 
     enum class Stage { FETCH, DECODE, EXECUTE, MEMORY, WRITEBACK };
 
@@ -74,28 +79,6 @@ namespace riscv {
         INVALID
     };
 
-    inline const std::unordered_map<std::string, Instructions> stringToInstruction = {
-        {"add", Instructions::ADD},   {"sub", Instructions::SUB},   {"mul", Instructions::MUL},
-        {"div", Instructions::DIV},   {"rem", Instructions::REM},   {"and", Instructions::AND},
-        {"or", Instructions::OR},     {"xor", Instructions::XOR},   {"sll", Instructions::SLL},
-        {"slt", Instructions::SLT},   {"sra", Instructions::SRA},   {"srl", Instructions::SRL},
-        {"addi", Instructions::ADDI}, {"andi", Instructions::ANDI}, {"ori", Instructions::ORI},
-        {"lb", Instructions::LB},     {"lh", Instructions::LH},     {"lw", Instructions::LW},
-        {"jalr", Instructions::JALR},
-        {"sb", Instructions::SB},     {"sh", Instructions::SH},     {"sw", Instructions::SW},
-        {"beq", Instructions::BEQ},   {"bne", Instructions::BNE},   {"bge", Instructions::BGE},
-        {"blt", Instructions::BLT},
-        {"auipc", Instructions::AUIPC}, {"lui", Instructions::LUI}, {"jal", Instructions::JAL}
-    };
-
-    inline const std::unordered_set<std::string> opcodes = {
-        "add", "sub", "mul", "div", "rem", "and", "or", "xor", "sll", "slt", "sra", "srl",
-        "addi", "andi", "ori", "lb", "lh", "lw", "jalr",
-        "sb", "sh", "sw",
-        "beq", "bne", "bge", "blt",
-        "auipc", "lui", "jal"
-    };
-
     inline const std::unordered_map<std::string, int> directives = {
         {".text", 0}, {".data", 0}, {".word", 4}, {".byte", 1},
         {".half", 2}, {".dword", 8}, {".asciz", 1}, {".asciiz", 1}, {".ascii", 1}
@@ -115,70 +98,86 @@ namespace riscv {
         {"t5", 30}, {"x30", 30}, {"t6", 31}, {"x31", 31}
     };
 
-    struct BranchPredictor {
-        struct BTBEntry {
-            uint32_t targetAddress;
-            bool valid;
-            
-            BTBEntry() : targetAddress(0), valid(false) {}
-            BTBEntry(uint32_t target) : targetAddress(target), valid(true) {}
-        };
-        
-        std::unordered_map<uint32_t, bool> PHT;
-        std::unordered_map<uint32_t, BTBEntry> BTB;
-        
-        uint32_t totalPredictions;
-        uint32_t mispredictions;
-        
-        BranchPredictor() : totalPredictions(0), mispredictions(0) {}
-        
-        bool predict(uint32_t branchPC) {
-            return PHT.count(branchPC) > 0 ? PHT[branchPC] : false;
-        }
-        
-        uint32_t getTarget(uint32_t branchPC) {
-            return BTB.count(branchPC) > 0 && BTB[branchPC].valid ? BTB[branchPC].targetAddress : 0;
+    struct Keyword {
+        std::string_view name;
+        int value;
+    };
+
+    // Open-addressed hash table built at compile time. Lookups hash the string_view once and
+    // compare against at most a couple of entries, with no allocation.
+    template <size_t SIZE>
+    class KeywordTable {
+    public:
+        static_assert((SIZE & (SIZE - 1)) == 0, "KeywordTable size must be a power of two");
+
+        template <size_t N>
+        constexpr explicit KeywordTable(const Keyword (&entries)[N]) : KeywordTable(entries, N) {
+            static_assert(N < SIZE, "KeywordTable is too small");
         }
 
-        bool getPHT(uint32_t branchPC) const {
-            return PHT.count(branchPC) > 0 ? PHT.at(branchPC) : false;
+        template <size_t N>
+        constexpr explicit KeywordTable(const std::array<Keyword, N>& entries) : KeywordTable(entries.data(), N) {
+            static_assert(N < SIZE, "KeywordTable is too small");
         }
-        
-        void update(uint32_t branchPC, bool taken, uint32_t targetAddress) {
-            totalPredictions++;
-            bool predicted = predict(branchPC);
-            PHT[branchPC] = taken;
-            if (taken) {
-                BTB[branchPC] = BTBEntry(targetAddress);
-            }
-            if (predicted != taken) {
-                mispredictions++;
+
+        constexpr int find(std::string_view key) const {
+            if (key.empty()) return -1;
+            for (size_t slot = hash(key); !names[slot].empty(); slot = (slot + 1) & (SIZE - 1)) {
+                if (names[slot] == key) return values[slot];
             }
+            return -1;
         }
 
-        bool isInBTB(uint32_t branchPC) const {
-            return BTB.count(branchPC) > 0 && BTB.at(branchPC).valid;
-        }
-        
-        double getAccuracy() const {
-            return totalPredictions > 0 ? static_cast<double>(totalPredictions - mispredictions) / totalPredictions * 100.0 : 0.0;
+        constexpr bool contains(std::string_view key) const { return find(key) >= 0; }
+
+    private:
+        std::array<std::string_view, SIZE> names;
+        std::array<int, SIZE> values;
+
+        constexpr KeywordTable(const Keyword* entries, size_t count) : names{}, values{} {
+            for (size_t i = 0; i < count; i++) {
+                size_t slot = hash(entries[i].name);
+                while (!names[slot].empty()) {
+                    slot = (slot + 1) & (SIZE - 1);
+                }
+                names[slot] = entries[i].name;
+                values[slot] = entries[i].value;
+            }
         }
-        
-        void reset() {
-            PHT.clear();
-            BTB.clear();
-            totalPredictions = 0;
-            mispredictions = 0;
+
+        static constexpr size_t hash(std::string_view key) {
+            uint32_t h = 2166136261u;
+            for (char c : key) {
+                h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+            }
+            return h & (SIZE - 1);
         }
     };
 
-    struct Token {
-        TokenType type;
-        std::string value;
-        int lineNumber;
-        Token(TokenType t, const std::string& v, int ln) : type(t), value(v), lineNumber(ln) {}
+    inline constexpr Keyword REGISTER_KEYWORDS[] = {
+        {"zero", 0}, {"x0", 0}, {"ra", 1}, {"x1", 1}, {"sp", 2}, {"x2", 2},
+        {"gp", 3}, {"x3", 3}, {"tp", 4}, {"x4", 4}, {"t0", 5}, {"x5", 5},
+        {"t1", 6}, {"x6", 6}, {"t2", 7}, {"x7", 7}, {"s0", 8}, {"fp", 8}, {"x8", 8},
+        {"s1", 9}, {"x9", 9}, {"a0", 10}, {"x10", 10}, {"a1", 11}, {"x11", 11},
+        {"a2", 12}, {"x12", 12}, {"a3", 13}, {"x13", 13}, {"a4", 14}, {"x14", 14},
+        {"a5", 15}, {"x15", 15}, {"a6", 16}, {"x16", 16}, {"a7", 17}, {"x17", 17},
+        {"s2", 18}, {"x18", 18}, {"s3", 19}, {"x19", 19}, {"s4", 20}, {"x20", 20},
+        {"s5", 21}, {"x21", 21}, {"s6", 22}, {"x22", 22}, {"s7", 23}, {"x23", 23},
+        {"s8", 24}, {"x24", 24}, {"s9", 25}, {"x25", 25}, {"s10", 26}, {"x26", 26},
+        {"s11", 27}, {"x27", 27}, {"t3", 28}, {"x28", 28}, {"t4", 29}, {"x29", 29},
+        {"t5", 30}, {"x30", 30}, {"t6", 31}, {"x31", 31}
+    };
+
+    inline constexpr Keyword DIRECTIVE_KEYWORDS[] = {
+        {".text", 0}, {".data", 0}, {".word", 4}, {".byte", 1},
+        {".half", 2}, {".dword", 8}, {".asciz", 1}, {".asciiz", 1}, {".ascii", 1}
     };
 
+    inline constexpr KeywordTable<128> REGISTER_TABLE(REGISTER_KEYWORDS);
+    inline constexpr KeywordTable<16> DIRECTIVE_TABLE(DIRECTIVE_KEYWORDS);
+
+    static_assert(REGISTER_TABLE.find("s11") == 27 && REGISTER_TABLE.find("x32") < 0, "register table");
+
     struct SymbolEntry {
         uint32_t address;
         bool isString;
@@ -187,13 +186,53 @@ namespace riscv {
         std::string directive;
     };
     
+    // Label reference left for the assembler: slot receives target, or target - address for
+    // branches and jumps.
+    struct Relocation {
+        enum class Kind : uint8_t { NONE, ABSOLUTE, PC_RELATIVE };
+
+        Kind kind;
+        uint8_t slot;
+        uint32_t target;
+
+        Relocation() : kind(Kind::NONE), slot(0), target(0) {}
+    };
+
+    // Operands in source order; a slot holds a register number when its bit in registerMask is
+    // set and an immediate otherwise.
     struct ParsedInstruction {
-        std::string opcode;
-        std::vector<std::string> operands;
+        Instructions instruction;
+        uint8_t operandCount;
+        uint8_t registerMask;
+        std::array<int32_t, 3> operands;
+        Relocation relocation;
         uint32_t address;
-    
-        ParsedInstruction(std::string opc, std::vector<std::string> ops, uint32_t addr) 
-            : opcode(std::move(opc)), operands(std::move(ops)), address(addr) {}
+        int lineNumber;
+
+        ParsedInstruction(Instructions inst, uint32_t addr, int ln = 0)
+            : instruction(inst), operandCount(0), registerMask(0), operands{}, address(addr), lineNumber(ln) {}
+
+        inline bool isRegister(size_t slot) const { return (registerMask >> slot) & 1; }
+
+        inline void addOperand(int32_t value, bool reg) {
+            registerMask |= (reg ? 1 : 0) << operandCount;
+            operands[operandCount++] = value;
+        }
+    };
+
+    struct DecodedInstruction {
+        uint32_t instruction;
+        int32_t immediate;
+        InstructionType instructionType;
+        Instructions instructionName;
+        uint8_t opcode, func3, func7;
+        uint8_t rd, rs1, rs2;
+        bool isValid, isBranch, isJump, isLoad, isStore;
+
+        DecodedInstruction()
+            : instruction(0), immediate(0), instructionType(InstructionType::R), instructionName(Instructions::INVALID),
+              opcode(0), func3(0), func7(0), rd(0), rs1(0), rs2(0),
+              isValid(false), isBranch(false), isJump(false), isLoad(false), isStore(false) {}
     };
 
     struct InstructionNode {
@@ -203,16 +242,16 @@ namespace riscv {
         bool stalled, isBranch, isJump, isLoad, isStore;
         Instructions instructionName;
         uint32_t uniqueId;
+        const DecodedInstruction* decoded;
+        // What fetch did with the instruction: the direction the predictor gave and the address
+        // fetch carried on from. A branch resolves against these, not against a fresh lookup.
+        bool predictedTaken, returnPredicted;
+        uint32_t predictedTarget, returnCheckpoint;
+        uint32_t cacheWait;
+        bool cacheAccessed;
     
         InstructionNode(uint32_t pc = 0) 
-            : PC(pc), opcode(0), rs1(0), rs2(0), rd(0), instruction(0), func3(0), func7(0), stage(Stage::FETCH), stalled(false), isBranch(false), isJump(false), isLoad(false), isStore(false), instructionName(Instructions::INVALID), uniqueId(0){}
-
-        InstructionNode(const InstructionNode& other)
-            : PC(other.PC), opcode(other.opcode), rs1(other.rs1), rs2(other.rs2), rd(other.rd), 
-              instruction(other.instruction), func3(other.func3), func7(other.func7),
-              instructionType(other.instructionType), stage(other.stage), 
-              stalled(other.stalled), isBranch(other.isBranch), isJump(other.isJump), isLoad(other.isLoad), isStore(other.isStore), 
-              instructionName(other.instructionName), uniqueId(other.uniqueId) {}
+            : PC(pc), opcode(0), rs1(0), rs2(0), rd(0), instruction(0), func3(0), func7(0), instructionType(InstructionType::R), stage(Stage::FETCH), stalled(false), isBranch(false), isJump(false), isLoad(false), isStore(false), instructionName(Instructions::INVALID), uniqueId(0), decoded(nullptr), predictedTaken(false), returnPredicted(false), predictedTarget(0), returnCheckpoint(0), cacheWait(0), cacheAccessed(false) {}
     };
 
     struct InstructionRegisters {
@@ -222,12 +261,14 @@ namespace riscv {
 
     struct RegisterDependency {
         uint32_t reg;
-        uint32_t opcode;
         uint32_t pc;
         Stage stage;
         uint32_t value;
-        bool isLoad;
         uint32_t uniqueId;
+        bool isLoad;
+        bool valid;
+
+        RegisterDependency() : reg(0), pc(0), stage(Stage::DECODE), value(0), uniqueId(0), isLoad(false), valid(false) {}
     };
 
     struct SimulationStats {
@@ -244,20 +285,82 @@ namespace riscv {
         uint32_t controlHazardStalls;
         uint32_t pipelineFlushes;
         uint32_t branchMispredictions;
+        uint32_t branchPredictions;
+        uint32_t btbHits;
+        uint32_t btbMisses;
+        uint32_t returnPredictions;
+        uint32_t returnMispredictions;
+        uint32_t icacheHits;
+        uint32_t icacheMisses;
+        uint32_t icacheEvictions;
+        uint32_t dcacheHits;
+        uint32_t dcacheMisses;
+        uint32_t dcacheEvictions;
+        uint32_t dcacheWritebacks;
+        uint32_t cacheStallCycles;
 
         SimulationStats()
             : cyclesPerInstruction(0.0), totalCycles(0), instructionsExecuted(0),
               dataTransferInstructions(0), aluInstructions(0), controlInstructions(0),
               stallBubbles(0), dataHazards(0), controlHazards(0), dataHazardStalls(0),
-              controlHazardStalls(0), pipelineFlushes(0), branchMispredictions(0) {}
+              controlHazardStalls(0), pipelineFlushes(0), branchMispredictions(0),
+              branchPredictions(0), btbHits(0), btbMisses(0), returnPredictions(0),
+              returnMispredictions(0), icacheHits(0), icacheMisses(0), icacheEvictions(0),
+              dcacheHits(0), dcacheMisses(0), dcacheEvictions(0), dcacheWritebacks(0), cacheStallCycles(0) {}
+    };
+
+    struct InstructionFormat {
+        std::string_view name;
+        InstructionType type;
+        uint8_t opcode;
+        uint8_t func3;
+        uint8_t func7;
     };
 
-    struct InstructionEncoding {
-        std::unordered_map<std::string, uint32_t> func7Map;
-        std::unordered_map<std::string, uint32_t> func3Map;
-        std::unordered_map<std::string, uint32_t> opcodeMap;
+    // The instruction set, indexed by Instructions. The lexer's opcode table, the encoder, the
+    // decode tables and the disassembler (encoding.hpp) are all generated from it.
+    inline constexpr InstructionFormat INSTRUCTION_FORMATS[] = {
+        {"add", InstructionType::R, 0b0110011, 0b000, 0b0000000},   {"sub", InstructionType::R, 0b0110011, 0b000, 0b0100000},
+        {"mul", InstructionType::R, 0b0110011, 0b000, 0b0000001},   {"div", InstructionType::R, 0b0110011, 0b100, 0b0000001},
+        {"rem", InstructionType::R, 0b0110011, 0b110, 0b0000001},   {"and", InstructionType::R, 0b0110011, 0b111, 0b0000000},
+        {"or", InstructionType::R, 0b0110011, 0b110, 0b0000000},    {"xor", InstructionType::R, 0b0110011, 0b100, 0b0000000},
+        {"sll", InstructionType::R, 0b0110011, 0b001, 0b0000000},   {"slt", InstructionType::R, 0b0110011, 0b010, 0b0000000},
+        {"sra", InstructionType::R, 0b0110011, 0b101, 0b0100000},   {"srl", InstructionType::R, 0b0110011, 0b101, 0b0000000},
+        {"addi", InstructionType::I, 0b0010011, 0b000, 0},          {"andi", InstructionType::I, 0b0010011, 0b111, 0},
+        {"ori", InstructionType::I, 0b0010011, 0b110, 0},           {"lb", InstructionType::I, 0b0000011, 0b000, 0},
+        {"lh", InstructionType::I, 0b0000011, 0b001, 0},            {"lw", InstructionType::I, 0b0000011, 0b010, 0},
+        {"jalr", InstructionType::I, 0b1100111, 0b000, 0},
+        {"sb", InstructionType::S, 0b0100011, 0b000, 0},            {"sh", InstructionType::S, 0b0100011, 0b001, 0},
+        {"sw", InstructionType::S, 0b0100011, 0b010, 0},
+        {"beq", InstructionType::SB, 0b1100011, 0b000, 0},          {"bne", InstructionType::SB, 0b1100011, 0b001, 0},
+        {"bge", InstructionType::SB, 0b1100011, 0b101, 0},          {"blt", InstructionType::SB, 0b1100011, 0b100, 0},
+        {"auipc", InstructionType::U, 0b0010111, 0, 0},             {"lui", InstructionType::U, 0b0110111, 0, 0},
+        {"jal", InstructionType::UJ, 0b1101111, 0, 0}
     };
 
+    inline constexpr size_t INSTRUCTION_COUNT = std::size(INSTRUCTION_FORMATS);
+    static_assert(INSTRUCTION_COUNT == static_cast<size_t>(Instructions::INVALID), "format table");
+
+    inline constexpr const InstructionFormat& getInstructionFormat(Instructions inst) {
+        return INSTRUCTION_FORMATS[static_cast<size_t>(inst)];
+    }
+
+    inline constexpr std::array<Keyword, INSTRUCTION_COUNT> makeOpcodeKeywords() {
+        std::array<Keyword, INSTRUCTION_COUNT> keywords{};
+        for (size_t i = 0; i < INSTRUCTION_COUNT; i++) {
+            keywords[i] = {INSTRUCTION_FORMATS[i].name, static_cast<int>(i)};
+        }
+        return keywords;
+    }
+
+    inline constexpr KeywordTable<64> OPCODE_TABLE(makeOpcodeKeywords());
+
+    static_assert(OPCODE_TABLE.find("jal") == static_cast<int>(Instructions::JAL), "opcode table");
+
+    inline constexpr bool isLoadFormat(const InstructionFormat& format) {
+        return format.type == InstructionType::I && format.opcode == 0b0000011;
+    }
+
     inline std::string getTokenTypeName(TokenType type) {
         switch (type) {
             case TokenType::OPCODE: return "OPCODE";
@@ -273,11 +376,11 @@ namespace riscv {
         }
     }
 
-    inline bool isRegister(const std::string& token) {
-        return validRegisters.count(token) > 0;
+    inline bool isRegister(std::string_view token) {
+        return REGISTER_TABLE.contains(token);
     }
 
-    inline bool isImmediate(const std::string& token) {
+    inline bool isImmediate(std::string_view token) {
         if (token.empty()) return false;
         
         size_t pos = 0;
@@ -303,6 +406,13 @@ namespace riscv {
         return str.substr(first, last - first + 1);
     }
 
+    inline std::string_view trimView(std::string_view str) {
+        size_t first = str.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos) return {};
+        size_t last = str.find_last_not_of(" \t\r\n");
+        return str.substr(first, last - first + 1);
+    }
+
     inline bool isMemory(const std::string& token, std::string& offset, std::string& reg) {
         size_t open = token.find('(');
         size_t close = token.find(')', open);
@@ -320,135 +430,81 @@ namespace riscv {
         return (it != directives.end()) ? it->second : 0;
     }
 
-    inline int32_t getRegisterNumber(const std::string& reg) {
-        auto it = validRegisters.find(reg);
-        if (it != validRegisters.end()) {
-            return it->second;
-        }
-        
-        if (reg.length() > 1 && reg[0] == 'x') {
-            try {
-                int num = std::stoi(reg.substr(1));
-                return (num >= 0 && num < 32) ? num : -1;
-            } catch (...) {
-                return -1;
-            }
+    enum class NumberError { NONE, EMPTY, INVALID, OUT_OF_RANGE };
+
+    inline const char* getNumberErrorName(NumberError error) {
+        switch (error) {
+            case NumberError::NONE: return "no error";
+            case NumberError::EMPTY: return "empty value";
+            case NumberError::INVALID: return "not a number";
+            case NumberError::OUT_OF_RANGE: return "does not fit in 64 bits";
         }
-        
-        return -1;
+        return "unknown error";
     }
 
-    inline int32_t parseImmediate(const std::string& imm) {
-        try {
-            std::string cleanImm = trim(imm);
-            if (cleanImm.empty()) {
-                throw std::invalid_argument("Empty immediate value");
-                return 0;
-            }
-            
-            bool isNegative = cleanImm[0] == '-';
-            if (isNegative) {
-                cleanImm = cleanImm.substr(1);
-                if (cleanImm.empty()) {
-                    throw std::invalid_argument("Invalid immediate value");
-                    return 0;
-                }
-            }
-            
-            uint64_t value = 0;
-            if (cleanImm.length() > 2 && cleanImm[0] == '0') {
-                char format = ::tolower(cleanImm[1]);
-                if (format == 'x') {
-                    value = std::stoull(cleanImm, nullptr, 16);
-                } else if (format == 'b') {
-                    value = std::stoull(cleanImm.substr(2), nullptr, 2);
-                } else {
-                    value = std::stoull(cleanImm, nullptr, 10);
-                }
-            } else {
-                value = std::stoull(cleanImm, nullptr, 10);
+    // Parses an optionally signed decimal, 0x hex or 0b binary literal without throwing. The
+    // magnitude must fit in 64 bits; a negative value wraps like unary minus on uint64_t.
+    inline NumberError parseInteger(std::string_view text, uint64_t& value) {
+        std::string_view digits = trimView(text);
+        if (digits.empty()) return NumberError::EMPTY;
+        bool isNegative = digits[0] == '-';
+        if (isNegative || digits[0] == '+') digits.remove_prefix(1);
+        int base = 10;
+        if (digits.length() > 2 && digits[0] == '0') {
+            char format = static_cast<char>(::tolower(static_cast<unsigned char>(digits[1])));
+            if (format == 'x' || format == 'b') {
+                base = format == 'x' ? 16 : 2;
+                digits.remove_prefix(2);
             }
-            
-            return isNegative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
-        } catch (const std::exception& e) {
-            std::string errorMsg = "Error parsing immediate value: " + std::string(e.what());
-            throw std::runtime_error(errorMsg);
         }
+        if (digits.empty()) return NumberError::INVALID;
+        uint64_t magnitude = 0;
+        auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), magnitude, base);
+        if (error == std::errc::result_out_of_range) return NumberError::OUT_OF_RANGE;
+        if (error != std::errc() || end != digits.data() + digits.size()) return NumberError::INVALID;
+        value = isNegative ? 0 - magnitude : magnitude;
+        return NumberError::NONE;
     }
-    
-    struct RTypeInstructions {
-        static inline const InstructionEncoding& getEncoding() {
-            static const InstructionEncoding encoding = {
-                {{"add", 0b0000000}, {"sub", 0b0100000}, {"mul", 0b0000001}, {"div", 0b0000001}, 
-                 {"rem", 0b0000001}, {"and", 0b0000000}, {"or", 0b0000000}, {"xor", 0b0000000}, 
-                 {"sll", 0b0000000}, {"slt", 0b0000000}, {"sra", 0b0100000}, {"srl", 0b0000000}},
-                {{"add", 0b000}, {"sub", 0b000}, {"mul", 0b000}, {"div", 0b100}, {"rem", 0b110}, 
-                 {"and", 0b111}, {"or", 0b110}, {"xor", 0b100}, {"sll", 0b001}, {"slt", 0b010}, 
-                 {"sra", 0b101}, {"srl", 0b101}},
-                {{"add", 0b0110011}, {"sub", 0b0110011}, {"mul", 0b0110011}, {"div", 0b0110011}, 
-                 {"rem", 0b0110011}, {"and", 0b0110011}, {"or", 0b0110011}, {"xor", 0b0110011}, 
-                 {"sll", 0b0110011}, {"slt", 0b0110011}, {"sra", 0b0110011}, {"srl", 0b0110011}}
-            };
-            return encoding;
-        }
-    };
-
-    struct ITypeInstructions {
-        static inline const InstructionEncoding& getEncoding() {
-            static const InstructionEncoding encoding = {
-                {},
-                {{"addi", 0b000}, {"andi", 0b111}, {"ori", 0b110}, 
-                 {"lb", 0b000}, {"lh", 0b001}, {"lw", 0b010}, {"jalr", 0b000}},
-                {{"addi", 0b0010011}, {"andi", 0b0010011}, {"ori", 0b0010011}, 
-                 {"lb", 0b0000011}, {"lh", 0b0000011}, {"lw", 0b0000011}, {"jalr", 0b1100111}}
-            };
-            return encoding;
-        }
-    };
 
-    struct STypeInstructions {
-        static inline const InstructionEncoding& getEncoding() {
-            static const InstructionEncoding encoding = {
-                {},
-                {{"sb", 0b000}, {"sh", 0b001}, {"sw", 0b010}},
-                {{"sb", 0b0100011}, {"sh", 0b0100011}, {"sw", 0b0100011}}
-            };
-            return encoding;
-        }
-    };
+    // Immediate operands keep the low 32 bits of the literal.
+    inline NumberError parseImmediate(std::string_view text, int32_t& value) {
+        uint64_t parsed = 0;
+        NumberError error = parseInteger(text, parsed);
+        if (error == NumberError::NONE) value = static_cast<int32_t>(static_cast<uint32_t>(parsed));
+        return error;
+    }
 
-    struct SBTypeInstructions {
-        static inline const InstructionEncoding& getEncoding() {
-            static const InstructionEncoding encoding = {
-                {},
-                {{"beq", 0b000}, {"bne", 0b001}, {"bge", 0b101}, {"blt", 0b100}},
-                {{"beq", 0b1100011}, {"bne", 0b1100011}, {"bge", 0b1100011}, {"blt", 0b1100011}}
-            };
-            return encoding;
-        }
-    };
+    // Counts and sizes from the command line and config specs: a decimal, 0x hex or 0b binary
+    // literal without a sign, at most max.
+    inline NumberError parseUnsigned(std::string_view text, uint32_t& value, uint32_t max = UINT32_MAX) {
+        std::string_view digits = trimView(text);
+        if (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) return NumberError::INVALID;
+        uint64_t parsed = 0;
+        NumberError error = parseInteger(digits, parsed);
+        if (error != NumberError::NONE) return error;
+        if (parsed > max) return NumberError::OUT_OF_RANGE;
+        value = static_cast<uint32_t>(parsed);
+        return NumberError::NONE;
+    }
 
-    struct UTypeInstructions {
-        static inline const InstructionEncoding& getEncoding() {
-            static const InstructionEncoding encoding = {
-                {},
-                {},
-                {{"lui", 0b0110111}, {"auipc", 0b0010111}}
-            };
-            return encoding;
+    inline int32_t parseImmediate(const std::string& imm) {
+        int32_t value = 0;
+        NumberError error = parseImmediate(std::string_view(imm), value);
+        if (error != NumberError::NONE) {
+            throw std::runtime_error("Error parsing immediate value: " + std::string(getNumberErrorName(error)));
         }
-    };
+        return value;
+    }
 
-    struct UJTypeInstructions {
-        static inline const InstructionEncoding& getEncoding() {
-            static const InstructionEncoding encoding = {
-                {},
-                {},
-                {{"jal", 0b1101111}}
-            };
-            return encoding;
+    inline int32_t getRegisterNumber(std::string_view reg) {
+        int number = REGISTER_TABLE.find(reg);
+        if (number >= 0) return number;
+        if (reg.length() > 1 && reg[0] == 'x') {
+            auto [end, error] = std::from_chars(reg.data() + 1, reg.data() + reg.size(), number);
+            if (error == std::errc() && end == reg.data() + reg.size() && number >= 0 && number < 32) return number;
         }
-    };
+        return -1;
+    }
 }
 
 #endif
\ No newline at end of file
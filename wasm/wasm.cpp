@@ -1,36 +1,43 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
-#include "simulator.hpp"
+#include "../src/simulator.hpp"
+#include "../src/incremental.hpp"
 
 using namespace emscripten;
 
-val mapToVal(const std::map<uint32_t, std::pair<uint32_t, std::string>>& m) {
+// Words are disassembled here, when the front end asks, rather than kept as strings.
+val textToVal(const std::vector<std::pair<uint32_t, uint32_t>>& text) {
     val result = val::object();
-    for (const auto& [key, value] : m) {
+    for (const auto& [address, word] : text) {
         val pair = val::object();
-        pair.set("first", value.first);
-        pair.set("second", value.second);
-        result.set(std::to_string(key), pair);
+        pair.set("first", word);
+        pair.set("second", disassembleInstruction(word));
+        result.set(std::to_string(address), pair);
     }
     return result;
 }
 
-val activeStageToVal(const std::map<Stage, std::pair<bool, uint32_t>>& m) {
+val activeStageToVal(const std::array<std::pair<bool, uint32_t>, NUM_STAGES>& stages) {
     val result = val::object();
-    for (const auto& [stage, data] : m) {
+    for (size_t stage = 0; stage < NUM_STAGES; stage++) {
         val stageData = val::object();
-        stageData.set("active", data.first);
-        stageData.set("instruction", data.second);
+        stageData.set("active", stages[stage].first);
+        stageData.set("instruction", stages[stage].second);
         result.set(static_cast<int>(stage), stageData);
     }
     return result;
 }
 
-val unorderedMapToVal(const std::unordered_map<uint32_t, uint8_t>& m) {
+// Nonzero data bytes; untouched memory reads as zero.
+val memoryToVal(const Memory& memory) {
     val result = val::object();
-    for (const auto& [key, value] : m) {
-        result.set(std::to_string(key), value);
-    }
+    memory.forEachPage([&result](uint32_t base, const uint8_t* bytes) {
+        for (uint32_t offset = 0; offset < Memory::PAGE_SIZE; offset++) {
+            if (bytes[offset] != 0) {
+                result.set(std::to_string(base + offset), bytes[offset]);
+            }
+        }
+    });
     return result;
 }
 
@@ -75,7 +82,10 @@ val simulationStatsToVal(const SimulationStats& stats) {
     result.set("controlInstructions", stats.controlInstructions);
     result.set("cyclesPerInstruction", stats.cyclesPerInstruction);
     result.set("instructionsExecuted", stats.instructionsExecuted);
-    result.set("branchPredictionAccuracy", stats.branchPredictionAccuracy);
+    double accuracy = stats.branchPredictions > 0
+        ? static_cast<double>(stats.branchPredictions - stats.branchMispredictions) / stats.branchPredictions * 100.0
+        : 0.0;
+    result.set("branchPredictionAccuracy", accuracy);
     return result;
 }
 
@@ -90,24 +100,184 @@ val pipelineDiagramInfoToVal(const PipelineDiagramInfo& info) {
     return result;
 }
 
+val programDiffToVal(const ProgramDiff& diff) {
+    val text = val::object();
+    val changedText = val::array();
+    for (size_t i = 0; i < diff.textChanged.size(); i++) {
+        val entry = val::object();
+        entry.set("address", diff.textChanged[i].first);
+        entry.set("code", diff.textChanged[i].second);
+        entry.set("text", disassembleInstruction(diff.textChanged[i].second));
+        changedText.set(i, entry);
+    }
+    text.set("changed", changedText);
+    text.set("removed", val::array(diff.textRemoved));
+
+    val data = val::object();
+    val changedData = val::array();
+    for (size_t i = 0; i < diff.dataChanged.size(); i++) {
+        val entry = val::object();
+        entry.set("address", diff.dataChanged[i].first);
+        entry.set("value", diff.dataChanged[i].second);
+        changedData.set(i, entry);
+    }
+    data.set("changed", changedData);
+    data.set("removed", val::array(diff.dataRemoved));
+
+    val result = val::object();
+    result.set("success", diff.success);
+    result.set("reencoded", diff.reencoded);
+    result.set("text", text);
+    result.set("data", data);
+    return result;
+}
+
+const char* stopReasonName(StopReason reason) {
+    switch (reason) {
+        case StopReason::CYCLE_LIMIT: return "cycleLimit";
+        case StopReason::TERMINATED: return "terminated";
+        case StopReason::BREAKPOINT: return "breakpoint";
+        case StopReason::WATCHPOINT: return "watchpoint";
+    }
+    return "unknown";
+}
+
+std::vector<std::string> splitSourceLines(const std::string& input) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (true) {
+        size_t end = input.find('\n', start);
+        lines.push_back(input.substr(start, end == std::string::npos ? std::string::npos : end - start));
+        if (end == std::string::npos) break;
+        start = end + 1;
+    }
+    return lines;
+}
+
+// Flat snapshot behind getStateView(), one uint32_t per field so JS can read it as a Uint32Array.
+struct PipelineState {
+    uint32_t pc;
+    uint32_t cycles;
+    uint32_t stalls;
+    uint32_t running;
+    uint32_t stageActive[NUM_STAGES];
+    uint32_t stagePC[NUM_STAGES];
+    uint32_t RA, RB, RM, RY, RZ;
+    uint32_t isFlushed, isStalled, isDataForwarded, isProgramTerminated;
+    uint32_t exExForwarding, memMemForwarding, memExForwarding, branchToFetch, exToBranch;
+};
+
+// JS-facing adapter over the shared engine. Everything the browser needs beyond the CLI (stall,
+// flush and forwarding flags, dirty data ranges) comes from the UIHooks policy; load and runtime
+// errors land in logs through LogMapLog.
 class SimulatorWrapper {
 public:
-    SimulatorWrapper() : sim() {}
+    SimulatorWrapper() : logSink(logs), sim(UIHooks(), LogMapLog(logs)), textLoaded(false), dataGeneration(0) {
+        sim.setEventSink(&logSink);
+        sim.setEnvironment(true, true, true, UINT32_MAX);
+    }
     
     bool loadProgram(const std::string& input) { 
-        return sim.loadProgram(input);
+        return load(0, assembler.lineCount(), splitSourceLines(input)).success;
+    }
+
+    // Replaces removedLines editor lines starting at firstLine (0-based) with lines and returns
+    // what changed in the text and data segments.
+    val updateProgram(int firstLine, int removedLines, val lines) {
+        ProgramDiff diff = load(static_cast<size_t>(std::max(firstLine, 0)), static_cast<size_t>(std::max(removedLines, 0)),
+                                vecFromJSArray<std::string>(lines));
+        return programDiffToVal(diff);
     }
     
     bool step() { 
-        return sim.step();
+        bool running = sim.step();
+        timeline.record(sim);
+        return running;
     }
     
     void run() { 
         sim.run();
     }
 
+    // Batched execution: the cycles run inside WASM and the caller gets one summary, including
+    // the packed state and dirty data ranges, in place of a round of getters per cycle. TRACE
+    // events (forwarding, hazards) are not logged during a batch.
+    val runCycles(int cycles) {
+        return runBatch([&]() {
+            return runRecorded(static_cast<uint32_t>(std::max(cycles, 0)), [&](uint32_t chunk) { return sim.runCycles(chunk); });
+        });
+    }
+
+    // breakpoints: PCs; watchpoints: flattened [begin, end, ...] data address ranges.
+    val runUntil(val breakpoints, val watchpoints, int maxCycles) {
+        std::vector<uint32_t> pcs = vecFromJSArray<uint32_t>(breakpoints);
+        std::vector<uint32_t> bounds = vecFromJSArray<uint32_t>(watchpoints);
+        std::unordered_set<uint32_t> breakpointSet(pcs.begin(), pcs.end());
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+            ranges.emplace_back(bounds[i], bounds[i + 1]);
+        }
+        return runBatch([&]() {
+            return runRecorded(static_cast<uint32_t>(std::max(maxCycles, 0)),
+                               [&](uint32_t chunk) { return sim.runUntil(breakpointSet, ranges, chunk); });
+        });
+    }
+
+    // Reverse stepping through the checkpoint timeline: the closest earlier checkpoint is
+    // restored and re-simulated up to the target. Data pages have to be fetched again afterwards.
+    bool stepBack() {
+        return seek([&]() { return timeline.stepBack(sim); });
+    }
+
+    bool seekCycle(int cycle) {
+        return seek([&]() { return timeline.seek(sim, static_cast<uint32_t>(std::max(cycle, 0))); });
+    }
+
     void reset() {
         sim.reset();
+        timeline.clear();
+        textLoaded = false;
+        logs.clear();
+    }
+
+    // Zero-copy views into WASM memory. They are invalidated when the heap grows, so callers
+    // take fresh views after each call rather than holding on to them.
+    val getRegisterView() {
+        return val(typed_memory_view(NUM_REGISTERS, sim.getRegisters()));
+    }
+
+    val getStateView() {
+        fillState();
+        return val(typed_memory_view(sizeof(PipelineState) / sizeof(uint32_t), reinterpret_cast<const uint32_t*>(&state)));
+    }
+
+    // A page view stays valid until pagesChanged is reported: copy-on-write and new pages both
+    // move the generation of the engine memory.
+    val getDataPages() {
+        val result = val::array();
+        int index = 0;
+        sim.getMemory().forEachPage([&](uint32_t base, const uint8_t* bytes) {
+            val entry = val::object();
+            entry.set("base", base);
+            entry.set("bytes", val(typed_memory_view(Memory::PAGE_SIZE, bytes)));
+            result.set(index++, entry);
+        });
+        dataGeneration = sim.getMemory().generation();
+        return result;
+    }
+
+    // Byte ranges stored to since the previous call, flattened as [begin, end, begin, end, ...].
+    // pagesChanged means getDataPages() has to be fetched again.
+    val takeDirtyRanges() {
+        dirtyRanges.clear();
+        for (const auto& [begin, end] : sim.getHooks().takeDirtyRanges()) {
+            dirtyRanges.push_back(begin);
+            dirtyRanges.push_back(end);
+        }
+        val result = val::object();
+        result.set("pagesChanged", sim.getMemory().generation() != dataGeneration);
+        result.set("ranges", val(typed_memory_view(dirtyRanges.size(), dirtyRanges.data())));
+        return result;
     }
 
     val getRegisters() {
@@ -118,25 +288,35 @@ public:
         }
         return result;
     }
-    
+
     uint32_t getPC() const { return sim.getPC(); }
     uint32_t getCycles() const { return sim.getCycles(); }
-    val getDataMap() const { return unorderedMapToVal(sim.getDataMap()); }
-    val getTextMap() const { return mapToVal(sim.getTextMap()); }
-    val getLogs() { return unorderedMapIntStringToVal(sim.getLogs()); }
+    val getDataMap() const { return memoryToVal(sim.getMemory()); }
+    val getTextMap() const { return textLoaded ? textToVal(assembler.getText()) : val::object(); }
     bool isRunning() const { return sim.isRunning(); }
+    void setLogLevel(int level) { logSink.setLevel(static_cast<EventLevel>(level)); }
+
+    val getLogs() {
+        val result = unorderedMapIntStringToVal(logs);
+        logs.clear();
+        return result;
+    }
     
     val getActiveStages() const { 
         return activeStageToVal(sim.getActiveStages());
     }
     
     uint32_t getStalls() const { return sim.getStalls(); }
+
+    // The web view always runs with branch prediction in pipelined mode.
     void setEnvironment(bool pipeline, bool dataForwarding) {
-        sim.setEnvironment(pipeline, dataForwarding);
+        sim.setEnvironment(pipeline, dataForwarding, pipeline, UINT32_MAX);
+        timeline.clear();
+        timeline.record(sim);
     }
 
     val getUIResponse() const {
-        return uiResponseToVal(sim.getUIResponse());
+        return uiResponseToVal(sim.getHooks().getUIResponse());
     }
 
     val getInstructionRegisters() const {
@@ -144,15 +324,115 @@ public:
     }
 
     val getStats() {
-        return simulationStatsToVal(sim.Stats());
+        return simulationStatsToVal(sim.getStats());
     }
 
     val getPipelineDiagramInfo() const {
-        return pipelineDiagramInfoToVal(sim.getPipelineDiagramInfo());
+        return pipelineDiagramInfoToVal(sim.getHooks().getPipelineDiagramInfo());
     }
 
 private:
-    Simulator sim;
+    ProgramDiff load(size_t firstLine, size_t removedLines, const std::vector<std::string>& lines) {
+        logs.clear();
+        ProgramDiff diff = assembler.update(firstLine, removedLines, lines);
+        textLoaded = true;
+
+        if (!diff.success) {
+            sim.reset();
+            timeline.clear();
+            if (diff.empty) {
+                logs[300] = "Empty Code";
+            } else if (!diff.error.empty()) {
+                logs[404] = "Error: " + LogMapLog::stripColor(diff.error);
+            }
+            return diff;
+        }
+        sim.loadProgram(assembler.buildImage());
+        timeline.clear();
+        timeline.record(sim);
+        return diff;
+    }
+
+    void fillState() {
+        state = PipelineState();
+        state.pc = sim.getPC();
+        state.cycles = sim.getCycles();
+        state.stalls = sim.getStalls();
+        state.running = sim.isRunning();
+        std::array<std::pair<bool, uint32_t>, NUM_STAGES> stages = sim.getActiveStages();
+        for (size_t stage = 0; stage < NUM_STAGES; stage++) {
+            state.stageActive[stage] = stages[stage].first;
+            state.stagePC[stage] = stages[stage].second;
+        }
+        InstructionRegisters registers = sim.getInstructionRegisters();
+        state.RA = registers.RA;
+        state.RB = registers.RB;
+        state.RM = registers.RM;
+        state.RY = registers.RY;
+        state.RZ = registers.RZ;
+        const UIResponse& response = sim.getHooks().getUIResponse();
+        state.isFlushed = response.isFlushed;
+        state.isStalled = response.isStalled;
+        state.isDataForwarded = response.isDataForwarded;
+        state.isProgramTerminated = response.isProgramTerminated;
+        const PipelineDiagramInfo& diagram = sim.getHooks().getPipelineDiagramInfo();
+        state.exExForwarding = diagram.ExExForwarding;
+        state.memMemForwarding = diagram.MemMemForwarding;
+        state.memExForwarding = diagram.MemExForwarding;
+        state.branchToFetch = diagram.BranchToFetch;
+        state.exToBranch = diagram.ExToBranch;
+    }
+
+    // Runs a batch in pieces of at most one checkpoint interval so the timeline keeps up.
+    template <typename Run>
+    RunSummary runRecorded(uint32_t maxCycles, Run run) {
+        RunSummary total;
+        while (total.cycles < maxCycles) {
+            RunSummary part = run(std::min(maxCycles - total.cycles, timeline.getInterval()));
+            total.cycles += part.cycles;
+            timeline.record(sim);
+            if (part.reason != StopReason::CYCLE_LIMIT) {
+                total.reason = part.reason;
+                total.address = part.address;
+                break;
+            }
+        }
+        return total;
+    }
+
+    template <typename Seek>
+    bool seek(Seek move) {
+        bool moved = move();
+        dataGeneration = 0;
+        return moved;
+    }
+
+    template <typename Run>
+    val runBatch(Run run) {
+        EventLevel level = logSink.getLevel();
+        logSink.setLevel(std::min(level, EventLevel::INFO));
+        RunSummary summary = run();
+        logSink.setLevel(level);
+
+        val result = val::object();
+        result.set("reason", std::string(stopReasonName(summary.reason)));
+        result.set("cycles", summary.cycles);
+        result.set("address", summary.address);
+        result.set("running", sim.isRunning());
+        result.set("state", getStateView());
+        result.set("dirty", takeDirtyRanges());
+        return result;
+    }
+
+    std::unordered_map<int, std::string> logs;
+    LogMapSink logSink;
+    BasicSimulator<UIHooks, LogMapLog> sim;
+    IncrementalAssembler assembler;
+    CheckpointTimeline<BasicSimulator<UIHooks, LogMapLog>> timeline;
+    bool textLoaded;
+    PipelineState state;
+    uint64_t dataGeneration;
+    std::vector<uint32_t> dirtyRanges;
 };
 
 EMSCRIPTEN_BINDINGS(simulator_module) {
@@ -188,8 +468,7 @@ EMSCRIPTEN_BINDINGS(simulator_module) {
         .field("dataTransferInstructions", &SimulationStats::dataTransferInstructions)
         .field("controlInstructions", &SimulationStats::controlInstructions)
         .field("cyclesPerInstruction", &SimulationStats::cyclesPerInstruction)
-        .field("instructionsExecuted", &SimulationStats::instructionsExecuted)
-        .field("branchPredictionAccuracy", &SimulationStats::branchPredictionAccuracy);
+        .field("instructionsExecuted", &SimulationStats::instructionsExecuted);
 
     value_object<PipelineDiagramInfo>("PipelineDiagramInfo")
         .field("ExExForwarding", &PipelineDiagramInfo::ExExForwarding)
@@ -201,16 +480,26 @@ EMSCRIPTEN_BINDINGS(simulator_module) {
     class_<SimulatorWrapper>("Simulator")
         .constructor<>()
         .function("loadProgram", &SimulatorWrapper::loadProgram)
+        .function("updateProgram", &SimulatorWrapper::updateProgram)
         .function("step", &SimulatorWrapper::step)
         .function("run", &SimulatorWrapper::run)
+        .function("runCycles", &SimulatorWrapper::runCycles)
+        .function("runUntil", &SimulatorWrapper::runUntil)
+        .function("stepBack", &SimulatorWrapper::stepBack)
+        .function("seekCycle", &SimulatorWrapper::seekCycle)
         .function("reset", &SimulatorWrapper::reset)
         .function("getRegisters", &SimulatorWrapper::getRegisters)
+        .function("getRegisterView", &SimulatorWrapper::getRegisterView)
+        .function("getStateView", &SimulatorWrapper::getStateView)
+        .function("getDataPages", &SimulatorWrapper::getDataPages)
+        .function("takeDirtyRanges", &SimulatorWrapper::takeDirtyRanges)
         .function("getPC", &SimulatorWrapper::getPC)
         .function("getCycles", &SimulatorWrapper::getCycles)
         .function("getDataMap", &SimulatorWrapper::getDataMap)
         .function("getTextMap", &SimulatorWrapper::getTextMap)
         .function("getLogs", &SimulatorWrapper::getLogs)
         .function("isRunning", &SimulatorWrapper::isRunning)
+        .function("setLogLevel", &SimulatorWrapper::setLogLevel)
         .function("getActiveStages", &SimulatorWrapper::getActiveStages)
         .function("getStalls", &SimulatorWrapper::getStalls)
         .function("setEnvironment", &SimulatorWrapper::setEnvironment)